@@ -6,6 +6,7 @@
 #include "debug/debug_overlay.h"
 #include "input/input_handler.h"
 #include "render/font.h"
+#include "render/ui_command_list.h"
 #include <GLFW/glfw3.h>
 
 namespace {
@@ -192,4 +193,21 @@ TEST_CASE(TestUpdateAndRender) {
     // Should complete without crashing
 }
 
+// Test recording the overlay for the render thread (no GL needed)
+TEST_CASE(TestRecordOverlay) {
+    DebugOverlay overlay;
+    InputHandler input;
+    UiCommandList commands;
+
+    overlay.Record(&commands, input);
+    ASSERT_EQ(commands.GetCommands().size(), 0u);
+
+    overlay.SetVisible(true);
+    overlay.SetFrameTimes(4.0, 6.0, 0.5);
+    overlay.Record(&commands, input);
+    ASSERT_GT(commands.GetCommands().size(), 5u);
+    ASSERT_TRUE(commands.GetCommands().front().type == UiCommandType::EnableBlending);
+    ASSERT_TRUE(commands.GetCommands().back().type == UiCommandType::DisableBlending);
+}
+
 TEST_MAIN()
@@ -0,0 +1,128 @@
+// code_testing/render/test_batch_2d.cpp
+// Unit tests for batched 2D overlay drawing
+// Tests vertex emission, deferral between Begin and End, flushes on
+// primitive changes and the draw call counters (draws reach GL, which
+// ignores them without a current context)
+
+#include "../test_framework.h"
+#include "render/batch_2d.h"
+#include "render/renderer.h"
+
+using blec::render::Batch2D;
+using blec::render::Batch2DPrimitive;
+using blec::render::Batch2DVertex;
+using blec::render::Renderer;
+
+// ============================================================================
+// TEST SUITE: Vertices
+// ============================================================================
+
+TEST_CASE(TestBatch2DRectVertices) {
+    Batch2D batch;
+    batch.Begin();
+    batch.SetColor(1.0f, 0.5f, 0.0f, 2.0f);
+    batch.AddRect(10.0f, 20.0f, 30.0f, 40.0f);
+
+    const std::vector<Batch2DVertex>& vertices = batch.GetPendingVertices();
+    ASSERT_EQ(vertices.size(), 6u);
+    ASSERT_TRUE(batch.GetPrimitive() == Batch2DPrimitive::Triangles);
+
+    // Two triangles covering the corners, in the current color (clamped)
+    ASSERT_EQ(vertices[0].x, 10.0f);
+    ASSERT_EQ(vertices[0].y, 20.0f);
+    ASSERT_EQ(vertices[2].x, 40.0f);
+    ASSERT_EQ(vertices[2].y, 60.0f);
+    ASSERT_EQ(vertices[5].x, 10.0f);
+    ASSERT_EQ(vertices[5].y, 60.0f);
+    ASSERT_EQ(vertices[3].color[0], 255u);
+    ASSERT_EQ(vertices[3].color[1], 128u);
+    ASSERT_EQ(vertices[3].color[2], 0u);
+    ASSERT_EQ(vertices[3].color[3], 255u);
+    batch.End();
+}
+
+TEST_CASE(TestBatch2DColorChangesKeepBatch) {
+    Batch2D batch;
+    batch.Begin();
+    batch.SetColor(0.0f, 0.0f, 0.0f, 1.0f);
+    batch.AddRect(0.0f, 0.0f, 1.0f, 1.0f);
+    batch.SetColor(1.0f, 1.0f, 1.0f, 1.0f);
+    batch.AddRect(2.0f, 0.0f, 1.0f, 1.0f);
+
+    ASSERT_EQ(batch.GetPendingVertices().size(), 12u);
+    ASSERT_EQ(batch.GetPendingVertices()[0].color[0], 0u);
+    ASSERT_EQ(batch.GetPendingVertices()[6].color[0], 255u);
+    ASSERT_EQ(batch.GetDrawCallCount(), 0u);
+    batch.End();
+    ASSERT_EQ(batch.GetDrawCallCount(), 1u);
+    ASSERT_EQ(batch.GetPrimitiveCount(), 2u);
+}
+
+// ============================================================================
+// TEST SUITE: Flushing
+// ============================================================================
+
+TEST_CASE(TestBatch2DFlushesOnPrimitiveChange) {
+    Batch2D batch;
+    batch.Begin();
+    batch.AddLine(0.0f, 0.0f, 5.0f, 5.0f);
+    batch.AddLine(5.0f, 0.0f, 0.0f, 5.0f);
+    ASSERT_TRUE(batch.GetPrimitive() == Batch2DPrimitive::Lines);
+    ASSERT_EQ(batch.GetPendingVertices().size(), 4u);
+
+    // Quads after lines draw the lines first to keep the order
+    batch.AddRect(0.0f, 0.0f, 5.0f, 5.0f);
+    ASSERT_EQ(batch.GetDrawCallCount(), 1u);
+    ASSERT_EQ(batch.GetPendingVertices().size(), 6u);
+    batch.End();
+
+    ASSERT_EQ(batch.GetDrawCallCount(), 2u);
+    ASSERT_EQ(batch.GetPrimitiveCount(), 3u);
+    ASSERT_FALSE(batch.IsActive());
+}
+
+TEST_CASE(TestBatch2DImmediateOutsideBegin) {
+    Batch2D batch;
+    batch.AddRect(0.0f, 0.0f, 1.0f, 1.0f);
+    batch.AddLine(0.0f, 0.0f, 1.0f, 1.0f);
+    ASSERT_EQ(batch.GetPendingVertices().size(), 0u);
+    ASSERT_EQ(batch.GetDrawCallCount(), 2u);
+}
+
+TEST_CASE(TestBatch2DFrameCounters) {
+    Batch2D batch;
+    batch.Begin();
+    for (int i = 0; i < 100; ++i) {
+        batch.AddRect(static_cast<float>(i), 0.0f, 1.0f, 1.0f);
+    }
+    batch.End();
+    batch.EndFrame();
+    ASSERT_EQ(batch.GetLastFrameDrawCallCount(), 1u);
+    ASSERT_EQ(batch.GetLastFramePrimitiveCount(), 100u);
+    ASSERT_EQ(batch.GetDrawCallCount(), 0u);
+    batch.Release();
+}
+
+TEST_CASE(TestRendererBatchesBetweenBegin2DAndEnd2D) {
+    Batch2D& batch = Batch2D::ForCurrentContext();
+    batch.EndFrame();
+
+    Renderer::Begin2D(800, 600);
+    Renderer::SetColor(1.0f, 1.0f, 1.0f, 1.0f);
+    for (int i = 0; i < 20; ++i) {
+        Renderer::DrawFilledRect(static_cast<float>(i) * 4.0f, 0.0f, 2.0f, 2.0f);
+    }
+    ASSERT_EQ(batch.GetPendingVertices().size(), 120u);
+
+    // Blending changes split the batch
+    Renderer::EnableBlending();
+    Renderer::DrawFilledRect(0.0f, 10.0f, 2.0f, 2.0f);
+    Renderer::DisableBlending();
+    Renderer::End2D();
+
+    batch.EndFrame();
+    ASSERT_EQ(batch.GetLastFrameDrawCallCount(), 2u);
+    ASSERT_EQ(batch.GetLastFramePrimitiveCount(), 21u);
+}
+
+TEST_MAIN()
@@ -0,0 +1,136 @@
+// code_testing/render/test_block_instancer.cpp
+// Unit tests for instanced cube drawing
+// Tests the shared cube geometry, the batched expansion and behavior without
+// a GL context (no path can be set up, so no GL calls are made)
+
+#include "../test_framework.h"
+#include "render/block_instancer.h"
+#include "render/chunk_mesher.h"
+#include <glm/glm.hpp>
+#include <cmath>
+#include <vector>
+
+using blec::render::BatchVertex;
+using blec::render::BlockInstance;
+using blec::render::BlockInstancer;
+using blec::render::ChunkMesher;
+using blec::render::CubeVertex;
+using blec::render::InstancingPath;
+using blec::render::kCubeIndexCount;
+using blec::render::kCubeVertexCount;
+
+namespace {
+
+glm::vec3 CornerOf(int index) {
+    const CubeVertex& vertex = BlockInstancer::GetCubeVertex(index);
+    return glm::vec3(vertex.corner[0], vertex.corner[1], vertex.corner[2]);
+}
+
+// Outward normals in world::SectionFace order
+const glm::vec3 kFaceNormals[6] = {
+    glm::vec3(-1, 0, 0), glm::vec3(1, 0, 0), glm::vec3(0, -1, 0),
+    glm::vec3(0, 1, 0),  glm::vec3(0, 0, -1), glm::vec3(0, 0, 1),
+};
+
+} // namespace
+
+// ============================================================================
+// TEST SUITE: Cube geometry
+// ============================================================================
+
+TEST_CASE(TestCubeTrianglesFaceOutward) {
+    for (int triangle = 0; triangle < kCubeIndexCount / 3; ++triangle) {
+        const int i0 = BlockInstancer::GetCubeIndex(triangle * 3);
+        const int i1 = BlockInstancer::GetCubeIndex(triangle * 3 + 1);
+        const int i2 = BlockInstancer::GetCubeIndex(triangle * 3 + 2);
+        ASSERT_LT(i0, kCubeVertexCount);
+        ASSERT_LT(i1, kCubeVertexCount);
+        ASSERT_LT(i2, kCubeVertexCount);
+
+        // All three corners belong to the triangle's face
+        const int face = triangle / 2;
+        ASSERT_EQ(static_cast<int>(BlockInstancer::GetCubeVertex(i0).face), face);
+        ASSERT_EQ(static_cast<int>(BlockInstancer::GetCubeVertex(i2).face), face);
+
+        // Counter-clockwise winding seen from outside
+        const glm::vec3 normal =
+            glm::cross(CornerOf(i1) - CornerOf(i0), CornerOf(i2) - CornerOf(i0));
+        ASSERT_GT(glm::dot(normal, kFaceNormals[face]), 0.0f);
+    }
+}
+
+TEST_CASE(TestCubeCornersLieOnTheirFace) {
+    for (int i = 0; i < kCubeVertexCount; ++i) {
+        const int face = static_cast<int>(BlockInstancer::GetCubeVertex(i).face);
+        const glm::vec3 center_to_corner = CornerOf(i) - glm::vec3(0.5f);
+        ASSERT_LT(std::abs(glm::dot(center_to_corner, kFaceNormals[face]) - 0.5f), 1e-6f);
+    }
+}
+
+// ============================================================================
+// TEST SUITE: Instances
+// ============================================================================
+
+TEST_CASE(TestBlockInstancerQueuesPaletteIndices) {
+    BlockInstancer instancer;
+    ASSERT_EQ(instancer.GetInstanceCount(), 0u);
+
+    instancer.Add(glm::vec3(1.5f, 2.5f, 3.5f), 3);
+    instancer.Add(glm::vec3(-4.0f, 0.0f, 8.0f), 1);
+    ASSERT_EQ(instancer.GetInstanceCount(), 2u);
+
+    const BlockInstance& first = instancer.GetInstances()[0];
+    ASSERT_EQ(first.x, 1.5f);
+    ASSERT_EQ(first.y, 2.5f);
+    ASSERT_EQ(first.z, 3.5f);
+    ASSERT_EQ(first.palette, ChunkMesher::GetPaletteIndex(3));
+    ASSERT_EQ(instancer.GetInstances()[1].palette, ChunkMesher::GetPaletteIndex(1));
+
+    instancer.Clear();
+    ASSERT_EQ(instancer.GetInstanceCount(), 0u);
+}
+
+TEST_CASE(TestBatchExpansionCopiesInstancePerVertex) {
+    BlockInstancer instancer;
+    for (int i = 0; i < 10; ++i) {
+        instancer.Add(glm::vec3(static_cast<float>(i), 0.0f, 0.0f), static_cast<uint8_t>(i));
+    }
+
+    std::vector<BatchVertex> vertices;
+    BlockInstancer::BuildBatchVertices(instancer.GetInstances(), &vertices);
+    ASSERT_EQ(vertices.size(), 10u * kCubeVertexCount);
+
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const size_t cube = i / kCubeVertexCount;
+        const int corner = static_cast<int>(i % kCubeVertexCount);
+        ASSERT_EQ(vertices[i].instance.x, static_cast<float>(cube));
+        ASSERT_EQ(vertices[i].instance.palette, instancer.GetInstances()[cube].palette);
+        ASSERT_EQ(vertices[i].cube.face, BlockInstancer::GetCubeVertex(corner).face);
+    }
+
+    // Re-expanding a smaller set shrinks the batch
+    instancer.Clear();
+    instancer.Add(glm::vec3(0.0f), 1);
+    BlockInstancer::BuildBatchVertices(instancer.GetInstances(), &vertices);
+    ASSERT_EQ(vertices.size(), static_cast<size_t>(kCubeVertexCount));
+}
+
+// ============================================================================
+// TEST SUITE: Without GL
+// ============================================================================
+
+TEST_CASE(TestBlockInstancerWithoutGl) {
+    // Entry points are not loaded, so the immediate path is chosen and
+    // nothing is registered with the shader manager
+    BlockInstancer instancer;
+    blec::render::ShaderManager shaders;
+    blec::render::StreamBuffer stream;
+    instancer.Render(&shaders, &stream);
+    ASSERT_TRUE(instancer.GetPath() == InstancingPath::Immediate);
+    ASSERT_EQ(instancer.GetLastDrawCallCount(), 0u);
+    ASSERT_EQ(shaders.GetProgramCount(), 0u);
+    ASSERT_STREQ(BlockInstancer::GetPathName(InstancingPath::Instanced), "Instanced");
+    instancer.ReleaseGpuResources();
+}
+
+TEST_MAIN()
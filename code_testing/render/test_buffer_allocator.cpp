@@ -0,0 +1,171 @@
+// code_testing/render/test_buffer_allocator.cpp
+// Unit tests for size-class sub-allocation
+// Tests class rounding, fits, in-place resizing, coalescing, compaction
+// planning and the occupancy statistics (no GL calls)
+
+#include "../test_framework.h"
+#include "render/buffer_allocator.h"
+#include <cmath>
+#include <vector>
+
+using blec::render::BufferAllocator;
+using blec::render::BufferAllocatorStats;
+using blec::render::BufferMove;
+using blec::render::kInvalidAllocation;
+using blec::render::kMinAllocationClass;
+
+// ============================================================================
+// TEST SUITE: Size Classes
+// ============================================================================
+
+TEST_CASE(TestAllocatorClassSizes) {
+    ASSERT_EQ(BufferAllocator::GetClassSize(1), kMinAllocationClass);
+    ASSERT_EQ(BufferAllocator::GetClassSize(16), 16u);
+    ASSERT_EQ(BufferAllocator::GetClassSize(17), 20u);
+    ASSERT_EQ(BufferAllocator::GetClassSize(40), 40u);
+    ASSERT_EQ(BufferAllocator::GetClassSize(41), 48u);
+    ASSERT_EQ(BufferAllocator::GetClassSize(1000), 1024u);
+
+    // Rounding never wastes more than a quarter
+    for (uint32_t size = kMinAllocationClass; size < 5000; ++size) {
+        const uint32_t class_size = BufferAllocator::GetClassSize(size);
+        ASSERT_GE(class_size, size);
+        ASSERT_LE(class_size - size, size / 4);
+        ASSERT_EQ(BufferAllocator::GetClassSize(class_size), class_size);
+    }
+}
+
+// ============================================================================
+// TEST SUITE: Allocation
+// ============================================================================
+
+TEST_CASE(TestAllocatorAllocatesAndCoalesces) {
+    BufferAllocator allocator(256);
+    const uint32_t a = allocator.Allocate(1, 30);
+    const uint32_t b = allocator.Allocate(2, 30);
+    const uint32_t c = allocator.Allocate(3, 30);
+    ASSERT_EQ(a, 0u);
+    ASSERT_EQ(b, 32u);
+    ASSERT_EQ(c, 64u);
+    ASSERT_EQ(allocator.GetAllocationSize(b), 32u);
+
+    BufferAllocatorStats stats = allocator.GetStats();
+    ASSERT_EQ(stats.allocations, 3u);
+    ASSERT_EQ(stats.allocated, 96u);
+    ASSERT_EQ(stats.requested, 90u);
+    ASSERT_EQ(stats.free, 160u);
+
+    // Freeing the middle leaves a hole, freeing its neighbors merges it
+    allocator.Free(b);
+    ASSERT_EQ(allocator.GetStats().free_blocks, 2u);
+    allocator.Free(a);
+    allocator.Free(c);
+    stats = allocator.GetStats();
+    ASSERT_EQ(stats.free_blocks, 1u);
+    ASSERT_EQ(stats.largest_free, 256u);
+    ASSERT_EQ(stats.allocations, 0u);
+}
+
+TEST_CASE(TestAllocatorPrefersSmallestFittingClass) {
+    BufferAllocator allocator(1024);
+    const uint32_t a = allocator.Allocate(1, 64);
+    allocator.Allocate(2, 16);
+    const uint32_t c = allocator.Allocate(3, 32);
+    allocator.Allocate(4, 16);
+    allocator.Free(a);
+    allocator.Free(c);
+
+    // A 32-unit request takes the 32 hole, not the larger first one
+    ASSERT_EQ(allocator.Allocate(5, 32), c);
+    ASSERT_EQ(allocator.Allocate(6, 48), a);
+}
+
+TEST_CASE(TestAllocatorReportsFullAndGrows) {
+    BufferAllocator allocator(64);
+    ASSERT_EQ(allocator.Allocate(1, 48), 0u);
+    ASSERT_EQ(allocator.Allocate(2, 32), kInvalidAllocation);
+
+    allocator.Grow(128);
+    ASSERT_EQ(allocator.GetCapacity(), 128u);
+    ASSERT_EQ(allocator.Allocate(2, 32), 48u);
+    ASSERT_EQ(allocator.GetStats().free_blocks, 1u);
+}
+
+TEST_CASE(TestAllocatorResizesInPlace) {
+    BufferAllocator allocator(256);
+    const uint32_t a = allocator.Allocate(1, 18);  // Class 20
+    const uint32_t b = allocator.Allocate(2, 16);
+
+    // Slack inside the class absorbs small growth
+    ASSERT_TRUE(allocator.Resize(a, 20));
+    ASSERT_EQ(allocator.GetAllocationSize(a), 20u);
+
+    // Blocked by b, so the allocation has to move
+    ASSERT_FALSE(allocator.Resize(a, 40));
+
+    // With b gone the free block after it is taken
+    allocator.Free(b);
+    ASSERT_TRUE(allocator.Resize(a, 40));
+    ASSERT_EQ(allocator.GetAllocationSize(a), 40u);
+    ASSERT_EQ(allocator.GetStats().requested, 40u);
+
+    // Shrinking far below the class returns the tail
+    ASSERT_TRUE(allocator.Resize(a, 8));
+    ASSERT_EQ(allocator.GetAllocationSize(a), 16u);
+    ASSERT_EQ(allocator.GetStats().free, 240u);
+    ASSERT_EQ(allocator.GetStats().free_blocks, 1u);
+}
+
+// ============================================================================
+// TEST SUITE: Compaction
+// ============================================================================
+
+TEST_CASE(TestAllocatorCompactionPacksAllocations) {
+    BufferAllocator allocator(512);
+    std::vector<uint32_t> offsets;
+    for (uint32_t key = 0; key < 8; ++key) {
+        offsets.push_back(allocator.Allocate(key, 32));
+    }
+
+    // Free every other allocation: four 32-unit holes plus the tail
+    for (uint32_t key = 0; key < 8; key += 2) {
+        allocator.Free(offsets[key]);
+    }
+    BufferAllocatorStats stats = allocator.GetStats();
+    ASSERT_EQ(stats.free_blocks, 5u);
+    ASSERT_GT(stats.GetFragmentation(), 0.25f);
+    const float utilization = stats.GetUtilization();
+
+    BufferMove move{};
+    int moves = 0;
+    while (allocator.PlanCompaction(&move)) {
+        ASSERT_LT(move.to, move.from);
+        ASSERT_EQ(move.key % 2, 1u);
+        ASSERT_EQ(move.size, 32u);
+        allocator.ApplyMove(move);
+        ++moves;
+        ASSERT_LT(moves, 10);
+    }
+
+    // Everything live sits at the start, free space is one block
+    stats = allocator.GetStats();
+    ASSERT_EQ(stats.free_blocks, 1u);
+    ASSERT_EQ(stats.largest_free, 512u - 128u);
+    ASSERT_LT(std::abs(stats.GetFragmentation()), 1e-6f);
+    ASSERT_LT(std::abs(stats.GetUtilization() - utilization), 1e-6f);
+    ASSERT_EQ(stats.allocations, 4u);
+}
+
+TEST_CASE(TestAllocatorStatsWhenEmpty) {
+    BufferAllocator allocator;
+    const BufferAllocatorStats stats = allocator.GetStats();
+    ASSERT_EQ(stats.capacity, 0u);
+    ASSERT_EQ(stats.GetUtilization(), 0.0f);
+    ASSERT_EQ(stats.GetFragmentation(), 0.0f);
+    ASSERT_EQ(allocator.Allocate(1, 4), kInvalidAllocation);
+
+    BufferMove move{};
+    ASSERT_FALSE(allocator.PlanCompaction(&move));
+}
+
+TEST_MAIN()
@@ -0,0 +1,188 @@
+// code_testing/render/test_chunk_arena.cpp
+// Unit tests for the shared section vertex arena
+// Tests range allocation, reuse, coalescing, growth, compaction and section
+// stamping on the arena's CPU copy (no GL calls)
+
+#include "../test_framework.h"
+#include "render/chunk_arena.h"
+#include "render/chunk_mesher.h"
+#include "render/chunk_renderer.h"
+#include "world/block_system.h"
+#include <glm/glm.hpp>
+#include <vector>
+
+using blec::render::ArenaRange;
+using blec::render::ChunkArena;
+using blec::render::ChunkRenderer;
+using blec::render::VoxelVertex;
+
+namespace {
+
+// Vertices of n quads with distinct colors
+std::vector<VoxelVertex> MakeVertices(uint32_t quads, uint8_t color) {
+    std::vector<VoxelVertex> vertices(quads * 4);
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        vertices[i].x = static_cast<uint8_t>(i % 17);
+        vertices[i].color = color;
+    }
+    return vertices;
+}
+
+} // namespace
+
+// ============================================================================
+// TEST SUITE: Allocation
+// ============================================================================
+
+TEST_CASE(TestChunkArenaPacksRangesBackToBack) {
+    ChunkArena arena(1024);
+    arena.Store(3, MakeVertices(10, 1), glm::ivec3(0));
+    arena.Store(7, MakeVertices(5, 2), glm::ivec3(0));
+
+    const ArenaRange first = arena.GetRange(3);
+    const ArenaRange second = arena.GetRange(7);
+    ASSERT_EQ(first.first, 0u);
+    ASSERT_EQ(first.count, 40u);
+    ASSERT_EQ(second.first, 40u);
+    ASSERT_EQ(second.count, 20u);
+    ASSERT_EQ(arena.GetUsedVertexCount(), 60u);
+    ASSERT_EQ(arena.GetRange(5).count, 0u);
+    ASSERT_EQ(arena.GetRange(100).count, 0u);
+}
+
+TEST_CASE(TestChunkArenaShrinksInPlaceAndCoalesces) {
+    ChunkArena arena(1024);
+    arena.Store(0, MakeVertices(10, 1), glm::ivec3(0));
+    arena.Store(1, MakeVertices(10, 2), glm::ivec3(0));
+    arena.Store(2, MakeVertices(10, 3), glm::ivec3(0));
+
+    // A smaller mesh keeps its start and frees its tail
+    arena.Store(1, MakeVertices(4, 2), glm::ivec3(0));
+    ASSERT_EQ(arena.GetRange(1).first, 40u);
+    ASSERT_EQ(arena.GetRange(1).count, 16u);
+    ASSERT_EQ(arena.GetFreeRangeCount(), 2u);
+
+    // Freeing the neighbors merges everything back into one range
+    arena.Remove(0);
+    arena.Remove(1);
+    arena.Remove(2);
+    ASSERT_EQ(arena.GetFreeRangeCount(), 1u);
+    ASSERT_EQ(arena.GetUsedVertexCount(), 0u);
+
+    // Empty meshes hold no range
+    arena.Store(4, MakeVertices(2, 1), glm::ivec3(0));
+    arena.Store(4, std::vector<VoxelVertex>(), glm::ivec3(0));
+    ASSERT_EQ(arena.GetRange(4).count, 0u);
+    ASSERT_EQ(arena.GetUsedVertexCount(), 0u);
+}
+
+TEST_CASE(TestChunkArenaReusesFreedGaps) {
+    ChunkArena arena(1024);
+    arena.Store(0, MakeVertices(8, 1), glm::ivec3(0));
+    arena.Store(1, MakeVertices(8, 2), glm::ivec3(0));
+    arena.Remove(0);
+
+    // First fit lands in the gap left by section 0
+    arena.Store(2, MakeVertices(6, 3), glm::ivec3(0));
+    ASSERT_EQ(arena.GetRange(2).first, 0u);
+
+    // A larger mesh moves to free space past the others
+    arena.Store(2, MakeVertices(12, 3), glm::ivec3(0));
+    ASSERT_EQ(arena.GetRange(2).first, 64u);
+    ASSERT_EQ(arena.GetGrowthCount(), 0u);
+}
+
+TEST_CASE(TestChunkArenaGrowsAndKeepsContents) {
+    ChunkArena arena(64);
+    arena.Store(0, MakeVertices(10, 1), glm::ivec3(0));
+    arena.Store(1, MakeVertices(10, 2), glm::ivec3(0));
+    ASSERT_EQ(arena.GetGrowthCount(), 1u);
+    ASSERT_GE(arena.GetCapacity(), 80u);
+
+    const ArenaRange range = arena.GetRange(0);
+    for (uint32_t i = 0; i < range.count; ++i) {
+        ASSERT_EQ(arena.GetVertices()[range.first + i].color, 1);
+    }
+    ASSERT_EQ(arena.GetVertices()[arena.GetRange(1).first].color, 2);
+
+    // Growth before EnableGpu uploads nothing
+    ASSERT_FALSE(arena.IsGpuEnabled());
+    ASSERT_EQ(arena.GetGpuBytes(), 0u);
+}
+
+TEST_CASE(TestChunkArenaStampsSectionCoordinates) {
+    ChunkArena arena(256);
+    const std::vector<VoxelVertex> vertices = MakeVertices(3, 5);
+    arena.Store(9, vertices, glm::ivec3(1, 2, 3));
+
+    const ArenaRange range = arena.GetRange(9);
+    for (uint32_t i = 0; i < range.count; ++i) {
+        const VoxelVertex& stored = arena.GetVertices()[range.first + i];
+        ASSERT_EQ(stored.x, vertices[i].x);
+        ASSERT_EQ(stored.color, 5);
+        ASSERT_EQ(stored.section[0], 1);
+        ASSERT_EQ(stored.section[1], 2);
+        ASSERT_EQ(stored.section[2], 3);
+    }
+
+    // Source meshes are left untouched
+    ASSERT_EQ(vertices[0].section[0], 0);
+}
+
+TEST_CASE(TestChunkArenaCompactionKeepsContents) {
+    // Eight 32-vertex sections fill the arena exactly
+    ChunkArena arena(256);
+    for (uint32_t key = 0; key < 8; ++key) {
+        arena.Store(key, MakeVertices(8, static_cast<uint8_t>(key)), glm::ivec3(key, 0, 0));
+    }
+    for (uint32_t key = 0; key < 8; key += 2) {
+        arena.Remove(key);
+    }
+    ASSERT_GT(arena.GetStats().GetFragmentation(), blec::render::kArenaCompactionThreshold);
+
+    // A budget of one range moves one range per call
+    ASSERT_EQ(arena.Compact(1), 32u);
+    ASSERT_EQ(arena.GetCompactionMoveCount(), 1u);
+    while (arena.Compact(1) > 0) {
+    }
+    ASSERT_EQ(arena.GetStats().free_blocks, 1u);
+
+    // Moved ranges still hold their own section's vertices
+    for (uint32_t key = 1; key < 8; key += 2) {
+        const ArenaRange range = arena.GetRange(key);
+        ASSERT_EQ(range.count, 32u);
+        ASSERT_LT(range.first, 128u);
+        for (uint32_t i = 0; i < range.count; ++i) {
+            const VoxelVertex& vertex = arena.GetVertices()[range.first + i];
+            ASSERT_EQ(vertex.color, key);
+            ASSERT_EQ(vertex.section[0], key);
+        }
+    }
+
+    // Nothing left to do once the free space is one block
+    ASSERT_EQ(arena.Compact(1u << 20), 0u);
+}
+
+// ============================================================================
+// TEST SUITE: Renderer
+// ============================================================================
+
+TEST_CASE(TestChunkRendererDrawsEachSectionWithoutGl) {
+    // Without buffer objects the arena stays empty and every visible section
+    // is drawn on its own in immediate mode
+    blec::world::BlockSystem blocks;
+    blocks.Initialize(32, 16, 16, 1.0f);
+    blocks.SetBlock(2, 2, 2, blec::world::Block{1});
+    blocks.SetBlock(20, 2, 2, blec::world::Block{1});
+
+    ChunkRenderer chunks;
+    const std::vector<uint32_t> sections = {0, 1};
+    chunks.Update(blocks, sections);
+    chunks.Render(sections, glm::mat4(1.0f));
+    ASSERT_FALSE(chunks.IsUsingGpuPath());
+    ASSERT_EQ(chunks.GetLastDrawCallCount(), 2u);
+    ASSERT_EQ(chunks.GetRenderedFaceCount(), 12u);
+    ASSERT_EQ(chunks.GetArena().GetUsedVertexCount(), 0u);
+}
+
+TEST_MAIN()
@@ -0,0 +1,480 @@
+// code_testing/render/test_chunk_mesher.cpp
+// Unit tests for section meshing and the chunk mesh cache
+// Tests face culling, greedy merging, winding, and cache invalidation (no GL calls)
+
+#include "../test_framework.h"
+#include "render/chunk_mesher.h"
+#include "render/chunk_renderer.h"
+#include "world/block_system.h"
+#include <glm/glm.hpp>
+#include <cmath>
+#include <vector>
+
+using blec::render::ChunkMesher;
+using blec::render::ChunkMeshStats;
+using blec::render::ChunkRenderer;
+using blec::render::ChunkRenderPath;
+using blec::render::MeshingMode;
+using blec::render::QuadIndexBuffer;
+using blec::render::VoxelMesh;
+using blec::render::VoxelVertex;
+using blec::world::Block;
+using blec::world::BlockSystem;
+
+namespace {
+
+// Fill a box of blocks (inclusive min, exclusive max)
+void FillBox(BlockSystem* system, int x0, int y0, int z0, int x1, int y1, int z1,
+             uint8_t type = 1) {
+    for (int z = z0; z < z1; ++z) {
+        for (int y = y0; y < y1; ++y) {
+            for (int x = x0; x < x1; ++x) {
+                system->SetBlock(x, y, z, Block{type});
+            }
+        }
+    }
+}
+
+// Check that every triangle is counter-clockwise around its outward normal
+bool AllTrianglesOutward(const VoxelMesh& mesh) {
+    const std::vector<VoxelVertex>& vertices = mesh.GetVertices();
+    for (size_t i = 0; i + 2 < mesh.GetIndexCount(); i += 3) {
+        const glm::vec3 a = VoxelMesh::DecodePosition(vertices[QuadIndexBuffer::GetIndex(i)]);
+        const glm::vec3 b = VoxelMesh::DecodePosition(vertices[QuadIndexBuffer::GetIndex(i + 1)]);
+        const glm::vec3 c = VoxelMesh::DecodePosition(vertices[QuadIndexBuffer::GetIndex(i + 2)]);
+        const glm::vec3 normal =
+            VoxelMesh::GetFaceNormal(VoxelMesh::DecodeFace(vertices[QuadIndexBuffer::GetIndex(i)]));
+        if (glm::dot(glm::cross(b - a, c - a), normal) <= 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Sum of the areas of all triangles in a mesh (in blocks)
+float SurfaceArea(const VoxelMesh& mesh) {
+    const std::vector<VoxelVertex>& vertices = mesh.GetVertices();
+    float area = 0.0f;
+    for (size_t i = 0; i + 2 < mesh.GetIndexCount(); i += 3) {
+        const glm::vec3 a = VoxelMesh::DecodePosition(vertices[QuadIndexBuffer::GetIndex(i)]);
+        const glm::vec3 b = VoxelMesh::DecodePosition(vertices[QuadIndexBuffer::GetIndex(i + 1)]);
+        const glm::vec3 c = VoxelMesh::DecodePosition(vertices[QuadIndexBuffer::GetIndex(i + 2)]);
+        area += 0.5f * glm::length(glm::cross(b - a, c - a));
+    }
+    return area;
+}
+
+} // namespace
+
+// ============================================================================
+// TEST SUITE: Hidden-Face Culling
+// ============================================================================
+
+TEST_CASE(TestMesherSingleBlockHasSixFaces) {
+    BlockSystem system;
+    system.Initialize(16, 16, 16, 1.0f);
+    system.SetBlock(4, 4, 4, Block{1});
+
+    VoxelMesh mesh;
+    ChunkMeshStats stats = ChunkMesher::BuildSectionMesh(system, 0, &mesh);
+    ASSERT_EQ(stats.solid_blocks, 1u);
+    ASSERT_EQ(stats.faces, 6u);
+    ASSERT_EQ(mesh.GetVertexCount(), 24u);
+    ASSERT_EQ(mesh.GetIndexCount(), 36u);
+}
+
+TEST_CASE(TestMesherCullsSharedFaces) {
+    BlockSystem system;
+    system.Initialize(16, 16, 16, 1.0f);
+    system.SetBlock(4, 4, 4, Block{1});
+    system.SetBlock(5, 4, 4, Block{2});
+
+    VoxelMesh mesh;
+    ChunkMeshStats stats = ChunkMesher::BuildSectionMesh(system, 0, &mesh);
+    ASSERT_EQ(stats.faces, 10u);  // Two touching faces removed
+
+    // A solid 4x4x4 cube only shows its surface
+    BlockSystem cube;
+    cube.Initialize(16, 16, 16, 1.0f);
+    FillBox(&cube, 2, 2, 2, 6, 6, 6);
+    stats = ChunkMesher::BuildSectionMesh(cube, 0, &mesh);
+    ASSERT_EQ(stats.solid_blocks, 64u);
+    ASSERT_EQ(stats.faces, 6u * 16u);
+}
+
+TEST_CASE(TestMesherEmitsSectionLocalPackedVertices) {
+    BlockSystem system;
+    system.Initialize(32, 32, 16, 2.0f);
+    system.SetBlock(31, 17, 3, Block{4});  // Section (1, 1, 0), local (15, 1, 3)
+
+    VoxelMesh mesh;
+    const uint32_t section = static_cast<uint32_t>(system.GetSectionIndex(1, 1, 0));
+    ChunkMesher::BuildSectionMesh(system, section, &mesh);
+    ASSERT_EQ(mesh.GetVertexCount(), 24u);
+
+    // Corners stay within the block's local cell, independent of block size
+    glm::vec3 min(1000.0f);
+    glm::vec3 max(-1000.0f);
+    for (const VoxelVertex& vertex : mesh.GetVertices()) {
+        min = glm::min(min, VoxelMesh::DecodePosition(vertex));
+        max = glm::max(max, VoxelMesh::DecodePosition(vertex));
+        ASSERT_EQ(vertex.color, ChunkMesher::GetPaletteIndex(4));
+    }
+    ASSERT_TRUE(min == glm::vec3(15.0f, 1.0f, 3.0f));
+    ASSERT_TRUE(max == glm::vec3(16.0f, 2.0f, 4.0f));
+}
+
+TEST_CASE(TestMesherCullsAcrossSectionBorder) {
+    BlockSystem system;
+    system.Initialize(32, 16, 16, 1.0f);
+    system.SetBlock(15, 4, 4, Block{1});  // Last column of section 0
+    system.SetBlock(16, 4, 4, Block{1});  // First column of section 1
+
+    VoxelMesh mesh;
+    ASSERT_EQ(ChunkMesher::BuildSectionMesh(system, 0, &mesh).faces, 5u);
+    ASSERT_EQ(ChunkMesher::BuildSectionMesh(system, 1, &mesh).faces, 5u);
+}
+
+TEST_CASE(TestMesherWindingFacesOutward) {
+    BlockSystem system;
+    system.Initialize(16, 16, 16, 1.0f);
+    system.SetBlock(4, 4, 4, Block{3});
+
+    VoxelMesh mesh;
+    ChunkMesher::BuildSectionMesh(system, 0, &mesh);
+    ASSERT_TRUE(AllTrianglesOutward(mesh));
+}
+
+// ============================================================================
+// TEST SUITE: Greedy Meshing
+// ============================================================================
+
+TEST_CASE(TestGreedyMergesFlatFloor) {
+    BlockSystem system;
+    system.Initialize(16, 16, 16, 1.0f);
+    FillBox(&system, 0, 0, 0, 16, 1, 16);
+
+    VoxelMesh culled;
+    VoxelMesh greedy;
+    const ChunkMeshStats culled_stats =
+        ChunkMesher::BuildSectionMesh(system, 0, &culled, MeshingMode::Culled);
+    const ChunkMeshStats greedy_stats =
+        ChunkMesher::BuildSectionMesh(system, 0, &greedy, MeshingMode::Greedy);
+
+    // 256 top + 256 bottom + 64 sides collapse to one quad per face direction
+    ASSERT_EQ(culled_stats.faces, 576u);
+    ASSERT_EQ(greedy_stats.faces, 6u);
+    ASSERT_EQ(greedy.GetIndexCount(), 36u);
+    ASSERT_GE(greedy_stats.build_time_ms, 0.0);
+
+    // Same surface, fewer quads
+    ASSERT_LT(std::abs(SurfaceArea(culled) - SurfaceArea(greedy)), 0.01f);
+}
+
+TEST_CASE(TestGreedyKeepsBlockTypesSeparate) {
+    BlockSystem system;
+    system.Initialize(16, 16, 16, 1.0f);
+    FillBox(&system, 0, 0, 0, 8, 1, 16, 1);
+    FillBox(&system, 8, 0, 0, 16, 1, 16, 2);
+
+    VoxelMesh mesh;
+    const ChunkMeshStats stats =
+        ChunkMesher::BuildSectionMesh(system, 0, &mesh, MeshingMode::Greedy);
+
+    // Top and bottom split in two; the +Z/-Z sides split too; X sides stay whole
+    ASSERT_EQ(stats.faces, 10u);
+}
+
+TEST_CASE(TestBinaryMatchesGreedy) {
+    BlockSystem system;
+    system.Initialize(40, 20, 24, 1.0f);  // Edge sections clamped by the grid
+
+    // Layered terrain with mixed types, holes and overhangs
+    for (int z = 0; z < 24; ++z) {
+        for (int x = 0; x < 40; ++x) {
+            const int height = 3 + (x * 7 + z * 3) % 11;
+            for (int y = 0; y < height; ++y) {
+                const uint8_t type = static_cast<uint8_t>(y < 4 ? 3 : (y < height - 1 ? 2 : 1));
+                if ((x * 5 + y * 3 + z) % 13 != 0) {
+                    system.SetBlock(x, y, z, Block{type});
+                }
+            }
+        }
+    }
+
+    VoxelMesh greedy;
+    VoxelMesh binary;
+    for (uint32_t section = 0; section < system.GetSectionCount(); ++section) {
+        const ChunkMeshStats greedy_stats =
+            ChunkMesher::BuildSectionMesh(system, section, &greedy, MeshingMode::Greedy);
+        const ChunkMeshStats binary_stats =
+            ChunkMesher::BuildSectionMesh(system, section, &binary, MeshingMode::Binary);
+        ASSERT_EQ(binary_stats.faces, greedy_stats.faces);
+        ASSERT_EQ(binary_stats.solid_blocks, greedy_stats.solid_blocks);
+        ASSERT_LT(std::abs(SurfaceArea(binary) - SurfaceArea(greedy)), 0.01f);
+        ASSERT_TRUE(AllTrianglesOutward(binary));
+    }
+}
+
+TEST_CASE(TestBinaryHandlesEveryBlockType) {
+    BlockSystem system;
+    system.Initialize(16, 16, 16, 1.0f);
+
+    // Isolated blocks of all 255 solid types, so no faces merge
+    int type = 1;
+    for (int z = 0; z < 16 && type < 256; z += 2) {
+        for (int y = 0; y < 16 && type < 256; y += 2) {
+            for (int x = 0; x < 16 && type < 256; x += 2) {
+                system.SetBlock(x, y, z, Block{static_cast<uint8_t>(type++)});
+            }
+        }
+    }
+
+    VoxelMesh mesh;
+    ChunkMeshStats stats = ChunkMesher::BuildSectionMesh(system, 0, &mesh, MeshingMode::Binary);
+    ASSERT_EQ(stats.faces, 255u * 6u);
+    ASSERT_EQ(mesh.GetQuadCount(), 255u * 6u);
+
+    // The next build reuses the thread's planes; none of the old faces remain
+    BlockSystem floor;
+    floor.Initialize(16, 16, 16, 1.0f);
+    FillBox(&floor, 0, 0, 0, 16, 1, 16, 7);
+    stats = ChunkMesher::BuildSectionMesh(floor, 0, &mesh, MeshingMode::Binary);
+    ASSERT_EQ(stats.faces, 6u);
+}
+
+TEST_CASE(TestBinaryCullsAcrossSectionBorder) {
+    BlockSystem system;
+    system.Initialize(32, 16, 16, 1.0f);
+    FillBox(&system, 12, 0, 0, 20, 16, 16);  // Slab straddling x = 16
+
+    // Each half shows no face on the shared border
+    VoxelMesh mesh;
+    for (uint32_t section = 0; section < 2; ++section) {
+        const ChunkMeshStats stats =
+            ChunkMesher::BuildSectionMesh(system, section, &mesh, MeshingMode::Binary);
+        ASSERT_EQ(stats.faces, 5u);
+    }
+}
+
+TEST_CASE(TestGreedyMatchesCulledSurface) {
+    BlockSystem system;
+    system.Initialize(32, 16, 16, 0.5f);
+    FillBox(&system, 2, 2, 2, 6, 6, 6);
+    FillBox(&system, 10, 0, 3, 20, 3, 9, 3);  // Crosses into section 1
+    system.SetBlock(4, 6, 4, Block{2});        // Bump on top of the cube
+
+    VoxelMesh culled;
+    VoxelMesh greedy;
+    for (uint32_t section = 0; section < 2; ++section) {
+        const ChunkMeshStats culled_stats =
+            ChunkMesher::BuildSectionMesh(system, section, &culled, MeshingMode::Culled);
+        const ChunkMeshStats greedy_stats =
+            ChunkMesher::BuildSectionMesh(system, section, &greedy, MeshingMode::Greedy);
+        ASSERT_LT(greedy_stats.faces, culled_stats.faces);
+        ASSERT_LT(std::abs(SurfaceArea(culled) - SurfaceArea(greedy)), 0.01f);
+        ASSERT_TRUE(AllTrianglesOutward(greedy));
+    }
+}
+
+// ============================================================================
+// TEST SUITE: Ambient Occlusion
+// ============================================================================
+
+TEST_CASE(TestAmbientOcclusionAroundPillar) {
+    BlockSystem system;
+    system.Initialize(16, 16, 16, 1.0f);
+    FillBox(&system, 0, 0, 0, 3, 1, 3);  // 3x3 floor
+    system.SetBlock(1, 1, 1, Block{1});  // Pillar on its center
+
+    // Floor corners touching the pillar's footprint are shaded one level,
+    // the rest of the floor and the pillar's top are unoccluded
+    VoxelMesh mesh;
+    ChunkMesher::BuildSectionMesh(system, 0, &mesh, MeshingMode::Culled);
+    for (const VoxelVertex& vertex : mesh.GetVertices()) {
+        if (VoxelMesh::DecodeFace(vertex) != 3) {
+            continue;
+        }
+        const bool footprint = vertex.x >= 1 && vertex.x <= 2 && vertex.z >= 1 && vertex.z <= 2;
+        const int expected = (vertex.y == 1 && footprint) ? 1 : 0;
+        ASSERT_EQ(VoxelMesh::DecodeAmbientOcclusion(vertex), expected);
+    }
+
+    // Occluded faces are not merged: all eight floor tops stay separate
+    const ChunkMeshStats greedy = ChunkMesher::BuildSectionMesh(system, 0, &mesh,
+                                                                MeshingMode::Greedy);
+    const ChunkMeshStats binary = ChunkMesher::BuildSectionMesh(system, 0, &mesh,
+                                                                MeshingMode::Binary);
+    ASSERT_EQ(binary.faces, greedy.faces);
+    size_t floor_tops = 0;
+    for (size_t i = 0; i < mesh.GetVertexCount(); i += 4) {
+        const VoxelVertex& vertex = mesh.GetVertices()[i];
+        if (VoxelMesh::DecodeFace(vertex) == 3 && vertex.y == 1) {
+            floor_tops += 1;
+        }
+    }
+    ASSERT_EQ(floor_tops, 8u);
+}
+
+TEST_CASE(TestAmbientOcclusionFollowsDiagonalEdit) {
+    BlockSystem system;
+    system.Initialize(32, 16, 32, 1.0f);
+    FillBox(&system, 16, 0, 16, 32, 1, 32);  // Floor in section (1, 0, 1)
+    const uint32_t diagonal = static_cast<uint32_t>(system.GetSectionIndex(1, 0, 1));
+    std::vector<uint32_t> sections;
+    for (uint32_t section = 0; section < system.GetSectionCount(); ++section) {
+        sections.push_back(section);
+    }
+
+    ChunkRenderer chunks;
+    chunks.SetMeshingMode(MeshingMode::Culled);
+    chunks.Update(system, sections);
+
+    // Floor top corner at the section's minimum X/Z corner
+    auto corner_ao = [&chunks, diagonal]() {
+        for (const VoxelVertex& vertex : chunks.GetSectionMesh(diagonal).GetVertices()) {
+            if (VoxelMesh::DecodeFace(vertex) == 3 && vertex.x == 0 && vertex.y == 1 &&
+                vertex.z == 0) {
+                return VoxelMesh::DecodeAmbientOcclusion(vertex);
+            }
+        }
+        return -1;
+    };
+    ASSERT_EQ(corner_ao(), 0);
+
+    // A block in section (0, 0, 0), touching the floor section only diagonally
+    const uint32_t revision = system.GetSectionMeshRevision(diagonal);
+    system.SetBlock(15, 1, 15, Block{1});
+    ASSERT_NE(system.GetSectionMeshRevision(diagonal), revision);
+    chunks.Update(system, sections);
+    ASSERT_EQ(corner_ao(), 1);
+}
+
+// ============================================================================
+// TEST SUITE: Mesh Cache
+// ============================================================================
+
+TEST_CASE(TestChunkRendererRebuildsOnlyStaleSections) {
+    BlockSystem system;
+    system.Initialize(32, 16, 16, 1.0f);
+    system.SetBlock(4, 4, 4, Block{1});
+    system.SetBlock(20, 4, 4, Block{1});
+    std::vector<uint32_t> sections = {0, 1};
+
+    ChunkRenderer chunks;
+    chunks.Update(system, sections);
+    ASSERT_EQ(chunks.GetRebuiltSectionCount(), 2u);
+    ASSERT_EQ(chunks.GetMeshedFaceCount(), 12u);
+
+    // Nothing changed
+    chunks.Update(system, sections);
+    ASSERT_EQ(chunks.GetRebuiltSectionCount(), 0u);
+
+    // Edit on the border of section 1 also invalidates section 0
+    system.SetBlock(16, 4, 4, Block{1});
+    chunks.Update(system, sections);
+    ASSERT_EQ(chunks.GetRebuiltSectionCount(), 2u);
+    ASSERT_EQ(chunks.GetMeshedFaceCount(), 18u);
+
+    // Interior edits leave the neighbor alone, and several edits to one
+    // section before the next Update cost a single rebuild
+    system.SetBlock(24, 8, 8, Block{1});
+    system.SetBlock(25, 8, 8, Block{2});
+    system.SetBlock(24, 8, 8, Block{0});
+    chunks.Update(system, sections);
+    ASSERT_EQ(chunks.GetRebuiltSectionCount(), 1u);
+    ASSERT_EQ(chunks.GetMeshedFaceCount(), 24u);
+}
+
+TEST_CASE(TestChunkRendererMeshingModeSwitch) {
+    BlockSystem system;
+    system.Initialize(16, 16, 16, 1.0f);
+    FillBox(&system, 0, 0, 0, 16, 1, 16);
+    std::vector<uint32_t> sections = {0};
+
+    ChunkRenderer chunks;
+    chunks.SetMeshingMode(MeshingMode::Culled);
+    chunks.Update(system, sections);
+    ASSERT_EQ(chunks.GetMeshedTriangleCount(), 2u * 576u);
+
+    // Switching modes rebuilds the cached meshes
+    chunks.SetMeshingMode(MeshingMode::Greedy);
+    ASSERT_TRUE(chunks.GetMeshingMode() == MeshingMode::Greedy);
+    chunks.Update(system, sections);
+    ASSERT_EQ(chunks.GetRebuiltSectionCount(), 1u);
+    ASSERT_EQ(chunks.GetMeshedTriangleCount(), 12u);
+    ASSERT_GE(chunks.GetLastBuildTimeMs(), 0.0);
+
+    // Selecting the active mode again keeps the cache
+    chunks.SetMeshingMode(MeshingMode::Greedy);
+    chunks.Update(system, sections);
+    ASSERT_EQ(chunks.GetRebuiltSectionCount(), 0u);
+}
+
+TEST_CASE(TestChunkRendererRenderPathSwitch) {
+    BlockSystem system;
+    system.Initialize(16, 16, 16, 1.0f);
+    FillBox(&system, 0, 0, 0, 16, 1, 16);
+    std::vector<uint32_t> sections = {0};
+
+    ChunkRenderer chunks;
+    chunks.SetMeshingMode(MeshingMode::Greedy);
+    chunks.Update(system, sections);
+    ASSERT_TRUE(chunks.GetRenderPath() == ChunkRenderPath::PackedVertices);
+    ASSERT_EQ(chunks.GetSectionMesh(0).GetVertexCount(), 24u);
+
+    // Vertex pulling rebuilds the section as one record per face
+    chunks.SetRenderPath(ChunkRenderPath::VertexPulling);
+    ASSERT_EQ(chunks.GetSectionMesh(0).GetVertexCount(), 0u);
+    chunks.Update(system, sections);
+    ASSERT_EQ(chunks.GetRebuiltSectionCount(), 1u);
+    ASSERT_EQ(chunks.GetSectionFaces(0).GetFaceCount(), 6u);
+    ASSERT_EQ(chunks.GetMeshedTriangleCount(), 12u);
+}
+
+TEST_CASE(TestChunkRendererRenderPathFallbackSticks) {
+    BlockSystem system;
+    system.Initialize(16, 16, 16, 1.0f);
+    FillBox(&system, 0, 0, 0, 16, 1, 16);
+    std::vector<uint32_t> sections = {0};
+
+    ChunkRenderer chunks;
+    chunks.SetMeshingMode(MeshingMode::Greedy);
+    chunks.RequestRenderPath(ChunkRenderPath::VertexPulling);
+    ASSERT_TRUE(chunks.GetRenderPath() == ChunkRenderPath::VertexPulling);
+
+    // Render found no vertex pulling support and fell back
+    chunks.FallBackToPackedVertices();
+    ASSERT_TRUE(chunks.GetRenderPath() == ChunkRenderPath::PackedVertices);
+    ASSERT_TRUE(chunks.GetRequestedRenderPath() == ChunkRenderPath::VertexPulling);
+    chunks.Update(system, sections);
+    ASSERT_EQ(chunks.GetRebuiltSectionCount(), 1u);
+
+    // The next frame requests the same path; the fallback and its meshes stay
+    chunks.RequestRenderPath(ChunkRenderPath::VertexPulling);
+    ASSERT_TRUE(chunks.GetRenderPath() == ChunkRenderPath::PackedVertices);
+    chunks.Update(system, sections);
+    ASSERT_EQ(chunks.GetRebuiltSectionCount(), 0u);
+    ASSERT_EQ(chunks.GetSectionMesh(0).GetVertexCount(), 24u);
+
+    // A changed request is applied again
+    chunks.RequestRenderPath(ChunkRenderPath::PackedVertices);
+    chunks.RequestRenderPath(ChunkRenderPath::VertexPulling);
+    ASSERT_TRUE(chunks.GetRenderPath() == ChunkRenderPath::VertexPulling);
+}
+
+TEST_CASE(TestChunkRendererFacesPerBlock) {
+    BlockSystem system;
+    system.Initialize(16, 16, 16, 1.0f);
+    FillBox(&system, 0, 0, 0, 16, 1, 16);  // Flat 16x16 floor
+    std::vector<uint32_t> sections = {0};
+
+    ChunkRenderer chunks;
+    chunks.Update(system, sections);
+
+    // Top + bottom per block, plus the 64 outer side faces
+    const float expected = (2.0f * 256.0f + 64.0f) / 256.0f;
+    ASSERT_LT(std::abs(chunks.GetFacesPerBlock() - expected), 0.001f);
+}
+
+TEST_MAIN()
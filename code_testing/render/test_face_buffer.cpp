@@ -0,0 +1,160 @@
+// code_testing/render/test_face_buffer.cpp
+// Unit tests for the vertex-pulling face records
+// Tests record size, encoding round trips and CPU corner expansion against
+// packed-vertex meshes of the same sections (no GL calls)
+
+#include "../test_framework.h"
+#include "render/chunk_mesher.h"
+#include "render/face_buffer.h"
+#include "render/voxel_mesh.h"
+#include "world/block_system.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+using blec::render::ChunkMesher;
+using blec::render::ChunkMeshStats;
+using blec::render::FaceBuffer;
+using blec::render::FaceRecord;
+using blec::render::MeshingMode;
+using blec::render::QuadIndexBuffer;
+using blec::render::VoxelMesh;
+using blec::render::kVerticesPerFace;
+using blec::world::Block;
+using blec::world::BlockSystem;
+
+namespace {
+
+// One triangle as three corner positions
+using Triangle = std::array<int, 9>;
+
+// Expand every face into triangles, sorted for comparison
+std::vector<Triangle> ExpandTriangles(const FaceBuffer& faces) {
+    std::vector<Triangle> triangles;
+    for (const FaceRecord& record : faces.GetFaces()) {
+        for (int first = 0; first < kVerticesPerFace; first += 3) {
+            Triangle triangle;
+            for (int i = 0; i < 3; ++i) {
+                const glm::ivec3 corner = FaceBuffer::ExpandCorner(record, first + i);
+                triangle[i * 3 + 0] = corner.x;
+                triangle[i * 3 + 1] = corner.y;
+                triangle[i * 3 + 2] = corner.z;
+            }
+            triangles.push_back(triangle);
+        }
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+// Decode indexed triangles of a packed mesh, sorted for comparison
+std::vector<Triangle> DecodeTriangles(const VoxelMesh& mesh) {
+    std::vector<Triangle> triangles;
+    for (size_t first = 0; first + 2 < mesh.GetIndexCount(); first += 3) {
+        Triangle triangle;
+        for (int i = 0; i < 3; ++i) {
+            const glm::vec3 corner =
+                VoxelMesh::DecodePosition(mesh.GetVertices()[QuadIndexBuffer::GetIndex(first + i)]);
+            triangle[i * 3 + 0] = static_cast<int>(corner.x);
+            triangle[i * 3 + 1] = static_cast<int>(corner.y);
+            triangle[i * 3 + 2] = static_cast<int>(corner.z);
+        }
+        triangles.push_back(triangle);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+} // namespace
+
+// ============================================================================
+// TEST SUITE: Record Format
+// ============================================================================
+
+TEST_CASE(TestFaceRecordReplacesFourVertices) {
+    // One record stands in for four packed vertices and six indices
+    ASSERT_EQ(sizeof(FaceRecord), 8u);
+    ASSERT_EQ(sizeof(FaceRecord), sizeof(blec::render::VoxelVertex));
+}
+
+TEST_CASE(TestFaceRecordRoundTrip) {
+    const uint8_t ao[4] = {3, 2, 1, 0};
+
+    FaceBuffer faces;
+    faces.AddFace(glm::ivec3(15, 0, 7), 3, 16, 16, 4, ao);
+    ASSERT_EQ(faces.GetFaceCount(), 1u);
+
+    const FaceRecord& record = faces.GetFaces()[0];
+    ASSERT_EQ(FaceBuffer::DecodeFace(record), 3);
+    ASSERT_EQ(FaceBuffer::DecodeColor(record), 4);
+
+    // Vertices 0-1-2 and 0-2-3 map back to the quad corners
+    ASSERT_EQ(FaceBuffer::DecodeAmbientOcclusion(record, 0), 3);
+    ASSERT_EQ(FaceBuffer::DecodeAmbientOcclusion(record, 1), 2);
+    ASSERT_EQ(FaceBuffer::DecodeAmbientOcclusion(record, 2), 1);
+    ASSERT_EQ(FaceBuffer::DecodeAmbientOcclusion(record, 3), 3);
+    ASSERT_EQ(FaceBuffer::DecodeAmbientOcclusion(record, 5), 0);
+
+    // PosY face on top of cell (15, 0, 7), spanning 16 along z and x
+    ASSERT_TRUE(FaceBuffer::ExpandCorner(record, 0) == glm::ivec3(15, 1, 7));
+    ASSERT_TRUE(FaceBuffer::ExpandCorner(record, 1) == glm::ivec3(15, 1, 23));
+    ASSERT_TRUE(FaceBuffer::ExpandCorner(record, 2) == glm::ivec3(31, 1, 23));
+    ASSERT_TRUE(FaceBuffer::ExpandCorner(record, 5) == glm::ivec3(31, 1, 7));
+}
+
+TEST_CASE(TestFaceBufferClearAndMove) {
+    FaceBuffer faces;
+    faces.AddFace(glm::ivec3(0, 0, 0), 0, 1, 1, 0);
+    ASSERT_FALSE(faces.IsUploaded());
+    ASSERT_EQ(faces.GetGpuBytes(), 0u);
+    ASSERT_EQ(FaceBuffer::DecodeAmbientOcclusion(faces.GetFaces()[0], 2), 0);
+
+    FaceBuffer moved(std::move(faces));
+    ASSERT_EQ(moved.GetFaceCount(), 1u);
+
+    moved.Clear();
+    ASSERT_EQ(moved.GetFaceCount(), 0u);
+}
+
+// ============================================================================
+// TEST SUITE: Expansion
+// ============================================================================
+
+TEST_CASE(TestExpandedFacesMatchPackedMesh) {
+    BlockSystem system;
+    system.Initialize(32, 20, 16, 1.0f);
+    for (int z = 0; z < 16; ++z) {
+        for (int x = 0; x < 32; ++x) {
+            const int height = 2 + (x * 5 + z * 3) % 9;
+            for (int y = 0; y < height; ++y) {
+                if ((x + y * 7 + z * 3) % 11 != 0) {
+                    system.SetBlock(x, y, z, Block{static_cast<uint8_t>(1 + (y % 3))});
+                }
+            }
+        }
+    }
+
+    const MeshingMode modes[] = {MeshingMode::Culled, MeshingMode::Greedy, MeshingMode::Binary};
+    VoxelMesh mesh;
+    FaceBuffer faces;
+    for (MeshingMode mode : modes) {
+        for (uint32_t section = 0; section < system.GetSectionCount(); ++section) {
+            const ChunkMeshStats mesh_stats =
+                ChunkMesher::BuildSectionMesh(system, section, &mesh, mode);
+            const ChunkMeshStats face_stats =
+                ChunkMesher::BuildSectionMesh(system, section, &faces, mode);
+            ASSERT_EQ(face_stats.faces, mesh_stats.faces);
+            ASSERT_EQ(faces.GetFaceCount(), static_cast<size_t>(face_stats.faces));
+
+            // Same triangles with the same winding, at a quarter of the bytes
+            ASSERT_TRUE(ExpandTriangles(faces) == DecodeTriangles(mesh));
+            ASSERT_LE(faces.GetFaceCount() * sizeof(FaceRecord) * 4,
+                      mesh.GetVertexCount() * sizeof(blec::render::VoxelVertex));
+        }
+    }
+}
+
+TEST_MAIN()
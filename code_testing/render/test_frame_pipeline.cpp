@@ -0,0 +1,139 @@
+// code_testing/render/test_frame_pipeline.cpp
+// Unit tests for the simulation to render thread packet hand-off
+// Tests packet order and contents across a consumer thread, the one-frame
+// lead of the producer, WaitForIdle, Stop and statistics (no GL calls)
+
+#include "../test_framework.h"
+#include "render/frame_pipeline.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using blec::render::FramePacket;
+using blec::render::FramePipeline;
+using blec::render::FrameStats;
+
+// ============================================================================
+// TEST SUITE: Hand-off
+// ============================================================================
+
+TEST_CASE(TestFramePipelineDeliversInOrder) {
+    FramePipeline pipeline;
+    std::vector<int> seen_widths;
+    std::vector<size_t> seen_sections;
+
+    std::thread consumer([&]() {
+        while (const FramePacket* packet = pipeline.AcquirePacket()) {
+            seen_widths.push_back(packet->framebuffer_width);
+            seen_sections.push_back(packet->visible_sections.size());
+            FrameStats stats{};
+            stats.frame_index = packet->frame_index;
+            pipeline.ReleasePacket(stats);
+        }
+    });
+
+    for (int frame = 0; frame < 50; ++frame) {
+        FramePacket& packet = pipeline.GetWritePacket();
+        packet.framebuffer_width = frame;
+        packet.visible_sections.assign(static_cast<size_t>(frame % 7), 0u);
+        pipeline.Submit();
+    }
+    pipeline.Stop();
+    consumer.join();
+
+    // Every packet arrives once, in order, even after Stop
+    ASSERT_EQ(seen_widths.size(), 50u);
+    for (int frame = 0; frame < 50; ++frame) {
+        ASSERT_EQ(seen_widths[frame], frame);
+        ASSERT_EQ(seen_sections[frame], static_cast<size_t>(frame % 7));
+    }
+    ASSERT_EQ(pipeline.GetSubmittedCount(), 50u);
+    ASSERT_EQ(pipeline.GetStats().frame_index, 49u);
+}
+
+TEST_CASE(TestFramePipelineWritesOtherPacket) {
+    FramePipeline pipeline;
+    const FramePacket* first_write = &pipeline.GetWritePacket();
+    pipeline.Submit();
+
+    // The simulation moves on to the second packet while the first waits
+    ASSERT_TRUE(&pipeline.GetWritePacket() != first_write);
+    const FramePacket* acquired = pipeline.AcquirePacket();
+    ASSERT_TRUE(acquired == first_write);
+    ASSERT_EQ(acquired->frame_index, 0u);
+    pipeline.ReleasePacket(FrameStats{});
+}
+
+TEST_CASE(TestFramePipelineSubmitWaitsForRenderer) {
+    FramePipeline pipeline;
+    std::atomic<bool> released(false);
+
+    pipeline.Submit();
+    const FramePacket* packet = pipeline.AcquirePacket();
+    ASSERT_NOT_NULL(packet);
+
+    // The producer may fill the other packet but not hand it over while the
+    // first one is being drawn
+    std::thread renderer([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        released = true;
+        pipeline.ReleasePacket(FrameStats{});
+    });
+    pipeline.Submit();
+    ASSERT_TRUE(released.load());
+    ASSERT_GT(pipeline.GetLastSubmitWaitMs(), 0.0);
+    renderer.join();
+}
+
+// ============================================================================
+// TEST SUITE: Idle and Stop
+// ============================================================================
+
+TEST_CASE(TestFramePipelineWaitForIdle) {
+    FramePipeline pipeline;
+    std::atomic<int> drawn(0);
+
+    std::thread consumer([&]() {
+        while (pipeline.AcquirePacket() != nullptr) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            drawn += 1;
+            pipeline.ReleasePacket(FrameStats{});
+        }
+    });
+
+    pipeline.Submit();
+    pipeline.Submit();
+    pipeline.WaitForIdle();
+    ASSERT_EQ(drawn.load(), 2);
+
+    pipeline.Stop();
+    consumer.join();
+}
+
+TEST_CASE(TestFramePipelineStopWithoutPackets) {
+    FramePipeline pipeline;
+    pipeline.Stop();
+    ASSERT_NULL(pipeline.AcquirePacket());
+
+    // Nothing draws after Stop, so Submit must not block
+    pipeline.Submit();
+    pipeline.WaitForIdle();
+}
+
+TEST_CASE(TestFramePipelineStats) {
+    FramePipeline pipeline;
+    ASSERT_EQ(pipeline.GetStats().flushed_commands, 0u);
+
+    pipeline.Submit();
+    pipeline.AcquirePacket();
+    FrameStats stats{};
+    stats.flushed_commands = 12;
+    stats.meshing_name = "Greedy";
+    pipeline.ReleasePacket(stats);
+
+    ASSERT_EQ(pipeline.GetStats().flushed_commands, 12u);
+    ASSERT_TRUE(pipeline.GetStats().meshing_name == "Greedy");
+}
+
+TEST_MAIN()
@@ -0,0 +1,90 @@
+// code_testing/render/test_gl_state_cache.cpp
+// Unit tests for redundant GL state elimination
+// Tests issued and skipped call counting, invalidation and the frame
+// counters (calls reach GL, which ignores them without a current context)
+
+#include "../test_framework.h"
+#include "render/gl_state_cache.h"
+
+using blec::render::GlStateCache;
+using blec::render::kStateBlend;
+using blec::render::kStateOpaque;
+using blec::render::kStateOverlay;
+
+// ============================================================================
+// TEST SUITE: Skipping
+// ============================================================================
+
+TEST_CASE(TestStateCacheSkipsRepeats) {
+    GlStateCache cache;
+    cache.SetDepthTest(true);  // Enable + depth func
+    ASSERT_EQ(cache.GetIssuedCount(), 2u);
+    ASSERT_EQ(cache.GetSkippedCount(), 0u);
+
+    cache.SetDepthTest(true);
+    ASSERT_EQ(cache.GetIssuedCount(), 2u);
+    ASSERT_EQ(cache.GetSkippedCount(), 2u);
+
+    // Disabling keeps the depth func shadowed for the next enable
+    cache.SetDepthTest(false);
+    cache.SetDepthTest(true);
+    ASSERT_EQ(cache.GetIssuedCount(), 4u);
+    ASSERT_EQ(cache.GetSkippedCount(), 3u);
+}
+
+TEST_CASE(TestStateCacheApplyChangesOnlyDifferences) {
+    GlStateCache cache;
+    cache.Apply(kStateOpaque);
+    const uint32_t first = cache.GetIssuedCount();
+    ASSERT_GT(first, 0u);
+
+    // Same state again costs nothing
+    cache.Apply(kStateOpaque);
+    ASSERT_EQ(cache.GetIssuedCount(), first);
+
+    // Overlay turns off depth test, depth write and culling and enables
+    // blending with its function: four capability calls plus one blend func
+    cache.Apply(kStateOverlay);
+    ASSERT_EQ(cache.GetIssuedCount(), first + 5);
+    cache.Apply(kStateOverlay | kStateBlend);
+    ASSERT_EQ(cache.GetIssuedCount(), first + 5);
+}
+
+TEST_CASE(TestStateCacheMatrixMode) {
+    GlStateCache cache;
+    cache.SetMatrixMode(GL_PROJECTION);
+    cache.SetMatrixMode(GL_MODELVIEW);
+    cache.SetMatrixMode(GL_MODELVIEW);
+    ASSERT_EQ(cache.GetIssuedCount(), 2u);
+    ASSERT_EQ(cache.GetSkippedCount(), 1u);
+}
+
+// ============================================================================
+// TEST SUITE: Invalidation and Frames
+// ============================================================================
+
+TEST_CASE(TestStateCacheInvalidateReissues) {
+    GlStateCache cache;
+    cache.SetBlend(false);
+    cache.Invalidate();
+    cache.SetBlend(false);
+    ASSERT_EQ(cache.GetIssuedCount(), 2u);
+    ASSERT_EQ(cache.GetSkippedCount(), 0u);
+}
+
+TEST_CASE(TestStateCacheFrameCounters) {
+    GlStateCache cache;
+    cache.SetCullFace(false);
+    cache.SetCullFace(false);
+    cache.EndFrame();
+    ASSERT_EQ(cache.GetLastFrameIssuedCount(), 1u);
+    ASSERT_EQ(cache.GetLastFrameSkippedCount(), 1u);
+    ASSERT_EQ(cache.GetIssuedCount(), 0u);
+    ASSERT_EQ(cache.GetSkippedCount(), 0u);
+
+    // The shadow survives the frame boundary
+    cache.SetCullFace(false);
+    ASSERT_EQ(cache.GetSkippedCount(), 1u);
+}
+
+TEST_MAIN()
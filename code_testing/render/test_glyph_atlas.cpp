@@ -0,0 +1,105 @@
+// code_testing/render/test_glyph_atlas.cpp
+// Unit tests for the BitmapFont glyph atlas
+// Tests rasterization against the font data, glyph texture rectangles, the
+// opaque cell and batching without an atlas (no GL context needed)
+
+#include "../test_framework.h"
+#include "render/batch_2d.h"
+#include "render/font.h"
+#include "render/glyph_atlas.h"
+#include <cmath>
+#include <vector>
+
+using blec::render::Batch2D;
+using blec::render::BitmapFont;
+using blec::render::GlyphAtlas;
+using blec::render::GlyphRect;
+using blec::render::kGlyphAtlasHeight;
+using blec::render::kGlyphAtlasWidth;
+using blec::render::kGlyphCellSize;
+
+namespace {
+
+// Alpha of one atlas texel
+uint8_t AlphaAt(const std::vector<uint8_t>& texels, int x, int y) {
+    return texels[(static_cast<size_t>(y) * kGlyphAtlasWidth + x) * 4 + 3];
+}
+
+} // namespace
+
+// ============================================================================
+// TEST SUITE: Rasterization
+// ============================================================================
+
+TEST_CASE(TestAtlasMatchesFontData) {
+    std::vector<uint8_t> texels;
+    GlyphAtlas::Rasterize(&texels);
+    ASSERT_EQ(texels.size(), static_cast<size_t>(kGlyphAtlasWidth * kGlyphAtlasHeight * 4));
+
+    // Every lit font pixel is an opaque texel and every other one transparent
+    for (char c = 32; c <= 126; ++c) {
+        const unsigned char* glyph = BitmapFont::GetGlyph(c);
+        ASSERT_NOT_NULL(glyph);
+        GlyphRect rect{};
+        ASSERT_TRUE(GlyphAtlas::GetGlyphRect(c, &rect));
+        const int x0 = static_cast<int>(std::lround(rect.u0 * kGlyphAtlasWidth));
+        const int y0 = static_cast<int>(std::lround(rect.v0 * kGlyphAtlasHeight));
+        for (int col = 0; col < kGlyphCellSize; ++col) {
+            for (int row = 0; row < kGlyphCellSize; ++row) {
+                const bool lit = col < 5 && row < 7 && (glyph[col] & (1u << row)) != 0;
+                ASSERT_EQ(AlphaAt(texels, x0 + col, y0 + row), lit ? 255u : 0u);
+            }
+        }
+    }
+}
+
+TEST_CASE(TestAtlasSolidCell) {
+    std::vector<uint8_t> texels;
+    GlyphAtlas::Rasterize(&texels);
+
+    float u = 0.0f;
+    float v = 0.0f;
+    GlyphAtlas::GetSolidTexel(&u, &v);
+    const int x = static_cast<int>(u * kGlyphAtlasWidth);
+    const int y = static_cast<int>(v * kGlyphAtlasHeight);
+    ASSERT_EQ(AlphaAt(texels, x, y), 255u);
+    ASSERT_EQ(AlphaAt(texels, x - 4, y - 4), 255u);
+    ASSERT_EQ(AlphaAt(texels, x + 3, y + 3), 255u);
+
+    // Texels are white so the vertex color passes through unchanged
+    ASSERT_EQ(texels[(static_cast<size_t>(y) * kGlyphAtlasWidth + x) * 4], 255u);
+}
+
+// ============================================================================
+// TEST SUITE: Lookup
+// ============================================================================
+
+TEST_CASE(TestGlyphRects) {
+    GlyphRect rect{};
+    ASSERT_TRUE(GlyphAtlas::GetGlyphRect(' ', &rect));
+    ASSERT_EQ(rect.u0, 0.0f);
+    ASSERT_EQ(rect.v0, 0.0f);
+    ASSERT_EQ(rect.u1, 5.0f / kGlyphAtlasWidth);
+    ASSERT_EQ(rect.v1, 7.0f / kGlyphAtlasHeight);
+
+    // 'A' is glyph 33: third row, second column
+    ASSERT_TRUE(GlyphAtlas::GetGlyphRect('A', &rect));
+    ASSERT_EQ(rect.u0, 8.0f / kGlyphAtlasWidth);
+    ASSERT_EQ(rect.v0, 16.0f / kGlyphAtlasHeight);
+
+    ASSERT_FALSE(GlyphAtlas::GetGlyphRect('\n', &rect));
+    ASSERT_FALSE(GlyphAtlas::GetGlyphRect(127, &rect));
+    ASSERT_NULL(BitmapFont::GetGlyph(31));
+}
+
+TEST_CASE(TestBatchWithoutAtlasSkipsGlyphs) {
+    // Without a context no atlas exists; the font falls back to rectangles
+    Batch2D batch;
+    ASSERT_FALSE(batch.HasAtlas());
+    batch.Begin();
+    batch.AddGlyph(0.0f, 0.0f, 2.0f, 'A');
+    ASSERT_EQ(batch.GetPendingVertices().size(), 0u);
+    batch.End();
+}
+
+TEST_MAIN()
@@ -1,9 +1,39 @@
 // code_testing/render/test_mesh.cpp
 // Unit tests for Mesh class
-// Tests cube creation and culling state
+// Tests cube creation, culling state and GPU buffer ownership (GL entry points stubbed)
 
 #include "../test_framework.h"
+#include "render/gl_functions.h"
 #include "render/mesh.h"
+#include <cstddef>
+#include <utility>
+
+namespace {
+
+// Stand-in buffer entry points so ownership can be checked without a context
+GLuint g_next_buffer = 1;
+int g_deleted_buffers = 0;
+
+void BLEC_GLAPIENTRY FakeGenBuffers(GLsizei n, GLuint* buffers) {
+    for (GLsizei i = 0; i < n; ++i) {
+        buffers[i] = g_next_buffer++;
+    }
+}
+
+void BLEC_GLAPIENTRY FakeDeleteBuffers(GLsizei n, const GLuint*) {
+    g_deleted_buffers += n;
+}
+
+void BLEC_GLAPIENTRY FakeBindBuffer(GLenum, GLuint) {
+}
+
+void BLEC_GLAPIENTRY FakeBufferData(GLenum, std::ptrdiff_t, const void*, GLenum) {
+}
+
+void BLEC_GLAPIENTRY FakeBufferSubData(GLenum, std::ptrdiff_t, std::ptrdiff_t, const void*) {
+}
+
+} // anonymous namespace
 
 // ============================================================================
 // TEST SUITE: Mesh Creation and Basic Properties
@@ -39,4 +69,72 @@ TEST_CASE(TestMeshMultipleCubes) {
     ASSERT_EQ(cube1.GetIndexCount(), cube2.GetIndexCount());
 }
 
+// ============================================================================
+// TEST SUITE: GPU Buffers
+// ============================================================================
+
+TEST_CASE(TestMeshStartsWithoutGpuCopy) {
+    blec::render::Mesh cube = blec::render::Mesh::CreateCube();
+    ASSERT_FALSE(cube.IsUploaded());
+    ASSERT_EQ(cube.GetGpuBytes(), 0u);
+
+    // Releasing without buffers is a no-op
+    cube.Release();
+    ASSERT_EQ(cube.GetVertexCount(), 24u);
+}
+
+TEST_CASE(TestMeshMoveKeepsGeometryAndState) {
+    blec::render::Mesh cube = blec::render::Mesh::CreateCube();
+    cube.SetBackfaceCulling(true);
+
+    blec::render::Mesh moved(std::move(cube));
+    ASSERT_EQ(moved.GetIndexCount(), 36u);
+    ASSERT_TRUE(moved.IsBackfaceCullingEnabled());
+    ASSERT_FALSE(moved.IsUploaded());
+
+    blec::render::Mesh assigned;
+    assigned = std::move(moved);
+    ASSERT_EQ(assigned.GetVertexCount(), 24u);
+    ASSERT_EQ(assigned.GetGpuBytes(), 0u);
+}
+
+TEST_CASE(TestMeshMoveAssignTransfersBuffers) {
+    namespace gl = blec::render::gl;
+    gl::GenBuffers = FakeGenBuffers;
+    gl::DeleteBuffers = FakeDeleteBuffers;
+    gl::BindBuffer = FakeBindBuffer;
+    gl::BufferData = FakeBufferData;
+    gl::BufferSubData = FakeBufferSubData;
+    g_deleted_buffers = 0;
+
+    blec::render::Mesh source = blec::render::Mesh::CreateCube();
+    source.Upload();
+    blec::render::Mesh target = blec::render::Mesh::CreateCube();
+    target.Upload();
+
+    // The target's own buffers are deleted instead of handed to source
+    target = std::move(source);
+    ASSERT_EQ(g_deleted_buffers, 2);
+    ASSERT_TRUE(target.IsUploaded());
+    ASSERT_GT(target.GetGpuBytes(), 0u);
+
+    // The moved-from mesh owns nothing left to delete
+    ASSERT_FALSE(source.IsUploaded());
+    ASSERT_EQ(source.GetGpuBytes(), 0u);
+    source.Release();
+    ASSERT_EQ(g_deleted_buffers, 2);
+
+    blec::render::Mesh constructed(std::move(target));
+    target.Release();
+    ASSERT_EQ(g_deleted_buffers, 2);
+    constructed.Release();
+    ASSERT_EQ(g_deleted_buffers, 4);
+
+    gl::GenBuffers = nullptr;
+    gl::DeleteBuffers = nullptr;
+    gl::BindBuffer = nullptr;
+    gl::BufferData = nullptr;
+    gl::BufferSubData = nullptr;
+}
+
 TEST_MAIN()
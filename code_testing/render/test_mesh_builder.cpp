@@ -0,0 +1,138 @@
+// code_testing/render/test_mesh_builder.cpp
+// Unit tests for MeshBuilder and MeshStagingPool
+// Tests quad emission, moving geometry into meshes and staging reuse
+
+#include "../test_framework.h"
+#include "render/mesh_builder.h"
+#include <memory>
+#include <thread>
+#include <vector>
+
+using blec::render::Mesh;
+using blec::render::MeshBuilder;
+using blec::render::MeshStagingPool;
+using blec::render::Vertex;
+
+namespace {
+
+// Emit a row of quad_count unit quads along X
+void EmitRow(MeshBuilder* builder, size_t quad_count) {
+    const glm::vec3 color(1.0f);
+    const glm::vec3 normal(0.0f, 0.0f, 1.0f);
+    for (size_t i = 0; i < quad_count; ++i) {
+        const float x = static_cast<float>(i);
+        const glm::vec3 corners[4] = {
+            glm::vec3(x, 0, 0), glm::vec3(x + 1, 0, 0), glm::vec3(x + 1, 1, 0), glm::vec3(x, 1, 0)
+        };
+        builder->AddQuad(corners, color, normal);
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// TEST SUITE: Emission
+// ============================================================================
+
+TEST_CASE(TestMeshBuilderQuadIndices) {
+    MeshStagingPool pool;
+    MeshBuilder builder(&pool);
+    EmitRow(&builder, 2);
+    ASSERT_EQ(builder.GetVertexCount(), 8u);
+    ASSERT_EQ(builder.GetIndexCount(), 12u);
+
+    Mesh mesh;
+    builder.Build(&mesh);
+    ASSERT_EQ(builder.GetVertexCount(), 0u);
+    ASSERT_EQ(mesh.GetVertexCount(), 8u);
+
+    // Second quad uses 4-5-6 and 4-6-7
+    const uint32_t expected[12] = {0, 1, 2, 0, 2, 3, 4, 5, 6, 4, 6, 7};
+    for (size_t i = 0; i < 12; ++i) {
+        ASSERT_EQ(mesh.GetIndices()[i], expected[i]);
+    }
+    ASSERT_TRUE(mesh.GetVertices()[5].position == glm::vec3(2, 0, 0));
+}
+
+TEST_CASE(TestMeshBuilderMixesTrianglesAndQuads) {
+    MeshStagingPool pool;
+    MeshBuilder builder(&pool);
+    const uint32_t a = builder.AddVertex(Vertex());
+    const uint32_t b = builder.AddVertex(Vertex());
+    const uint32_t c = builder.AddVertex(Vertex());
+    builder.AddTriangle(a, b, c);
+    EmitRow(&builder, 1);
+
+    Mesh mesh;
+    builder.Build(&mesh);
+    ASSERT_EQ(mesh.GetVertexCount(), 7u);
+    ASSERT_EQ(mesh.GetIndexCount(), 9u);
+    ASSERT_EQ(mesh.GetIndices()[3], 3u);
+    ASSERT_EQ(mesh.GetIndices()[8], 6u);
+}
+
+TEST_CASE(TestMeshBuilderBuildReplacesMesh) {
+    Mesh mesh = Mesh::CreateCube();
+    mesh.SetBackfaceCulling(true);
+
+    MeshStagingPool pool;
+    MeshBuilder builder(&pool);
+    EmitRow(&builder, 1);
+    builder.Build(&mesh);
+    ASSERT_EQ(mesh.GetVertexCount(), 4u);
+    ASSERT_EQ(mesh.GetIndexCount(), 6u);
+    ASSERT_TRUE(mesh.IsBackfaceCullingEnabled());
+}
+
+// ============================================================================
+// TEST SUITE: Staging Pool
+// ============================================================================
+
+TEST_CASE(TestMeshBuilderSteadyStateDoesNotGrow) {
+    MeshStagingPool pool;
+    Mesh mesh;
+
+    // First builds size the staging buffers and the mesh storage
+    for (int frame = 0; frame < 2; ++frame) {
+        MeshBuilder builder(&pool);
+        builder.ReserveQuads(64);
+        EmitRow(&builder, 64);
+        builder.Build(&mesh);
+    }
+    ASSERT_EQ(pool.GetFreeCount(), 1u);
+
+    const uint64_t warm_growths = pool.GetGrowthCount();
+    for (int frame = 0; frame < 10; ++frame) {
+        MeshBuilder builder(&pool);
+        builder.ReserveQuads(64);
+        EmitRow(&builder, 64);
+        builder.Build(&mesh);
+    }
+    ASSERT_EQ(pool.GetGrowthCount(), warm_growths);
+    ASSERT_EQ(mesh.GetIndexCount(), 64u * 6u);
+    ASSERT_EQ(pool.GetFreeCount(), 1u);
+}
+
+TEST_CASE(TestMeshStagingPoolIsBounded) {
+    MeshStagingPool pool;
+    {
+        std::vector<std::unique_ptr<MeshBuilder>> builders;
+        for (size_t i = 0; i < blec::render::kMaxPooledStagingBuffers + 2; ++i) {
+            builders.push_back(std::make_unique<MeshBuilder>(&pool));
+        }
+    }
+    ASSERT_EQ(pool.GetFreeCount(), blec::render::kMaxPooledStagingBuffers);
+}
+
+TEST_CASE(TestMeshStagingPoolPerThread) {
+    MeshStagingPool* main_pool = &MeshStagingPool::ForCurrentThread();
+    MeshStagingPool* worker_pool = nullptr;
+    std::thread worker([&worker_pool]() { worker_pool = &MeshStagingPool::ForCurrentThread(); });
+    worker.join();
+
+    ASSERT_NOT_NULL(worker_pool);
+    ASSERT_TRUE(worker_pool != main_pool);
+    ASSERT_TRUE(&MeshStagingPool::ForCurrentThread() == main_pool);
+}
+
+TEST_MAIN()
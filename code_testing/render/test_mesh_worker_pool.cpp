@@ -0,0 +1,252 @@
+// code_testing/render/test_mesh_worker_pool.cpp
+// Unit tests for background section meshing
+// Tests worker results against synchronous meshing, stale-version discard in
+// the chunk renderer and snapshot isolation from later edits (no GL calls)
+
+#include "../test_framework.h"
+#include "render/chunk_mesher.h"
+#include "render/chunk_renderer.h"
+#include "render/mesh_worker_pool.h"
+#include "world/block_system.h"
+#include <vector>
+
+using blec::render::ChunkMesher;
+using blec::render::ChunkMeshStats;
+using blec::render::ChunkRenderer;
+using blec::render::MeshingMode;
+using blec::render::MeshJob;
+using blec::render::MeshResult;
+using blec::render::MeshWorkerPool;
+using blec::render::VoxelMesh;
+using blec::render::VoxelVertex;
+using blec::world::Block;
+using blec::world::BlockSystem;
+
+namespace {
+
+// Terrain spanning several sections
+void FillTerrain(BlockSystem* system) {
+    for (int z = 0; z < 32; ++z) {
+        for (int x = 0; x < 32; ++x) {
+            const int height = 2 + (x * 3 + z * 5) % 13;
+            for (int y = 0; y < height; ++y) {
+                system->SetBlock(x, y, z, Block{static_cast<uint8_t>(1 + y % 3)});
+            }
+        }
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// TEST SUITE: Worker Pool
+// ============================================================================
+
+TEST_CASE(TestWorkerPoolMatchesSynchronousMeshing) {
+    BlockSystem system;
+    system.Initialize(32, 16, 32, 1.0f);
+    FillTerrain(&system);
+
+    MeshWorkerPool pool;
+    ASSERT_TRUE(pool.Start(3));
+    ASSERT_EQ(pool.GetThreadCount(), 3u);
+
+    MeshJob job;
+    for (uint32_t section = 0; section < system.GetSectionCount(); ++section) {
+        job.section_index = section;
+        job.version = section + 100;
+        job.mode = MeshingMode::Binary;
+        job.build_faces = (section % 2) == 1;
+        ChunkMesher::CaptureSection(system, section, &job.snapshot);
+        pool.Submit(job);
+    }
+    pool.WaitForIdle();
+    ASSERT_EQ(pool.GetPendingJobCount(), 0u);
+
+    std::vector<MeshResult> results;
+    pool.CollectResults(&results);
+    ASSERT_EQ(results.size(), static_cast<size_t>(system.GetSectionCount()));
+
+    VoxelMesh mesh;
+    for (const MeshResult& result : results) {
+        ASSERT_EQ(result.version, result.section_index + 100u);
+        const ChunkMeshStats expected = ChunkMesher::BuildSectionMesh(
+            system, result.section_index, &mesh, MeshingMode::Binary);
+        ASSERT_EQ(result.stats.faces, expected.faces);
+        if (result.build_faces) {
+            ASSERT_EQ(result.faces.GetFaceCount(), static_cast<size_t>(expected.faces));
+        } else {
+            ASSERT_TRUE(result.mesh.GetVertices().size() == mesh.GetVertices().size());
+        }
+    }
+
+    // Nothing left to collect
+    results.clear();
+    pool.CollectResults(&results);
+    ASSERT_EQ(results.size(), 0u);
+    pool.Stop();
+    ASSERT_FALSE(pool.IsRunning());
+}
+
+TEST_CASE(TestSnapshotIgnoresLaterEdits) {
+    BlockSystem system;
+    system.Initialize(16, 16, 16, 1.0f);
+    system.SetBlock(4, 4, 4, Block{1});
+
+    MeshJob job;
+    job.section_index = 0;
+    job.version = 1;
+    job.mode = MeshingMode::Culled;
+    job.build_faces = false;
+    ChunkMesher::CaptureSection(system, 0, &job.snapshot);
+
+    // Edit after capturing; the worker still sees one block
+    system.SetBlock(5, 4, 4, Block{1});
+
+    MeshWorkerPool pool;
+    pool.Start(1);
+    pool.Submit(job);
+    pool.WaitForIdle();
+    std::vector<MeshResult> results;
+    pool.CollectResults(&results);
+    ASSERT_EQ(results.size(), 1u);
+    ASSERT_EQ(results[0].stats.faces, 6u);
+}
+
+TEST_CASE(TestRecycledResultsReuseStorage) {
+    BlockSystem system;
+    system.Initialize(16, 16, 16, 1.0f);
+    FillTerrain(&system);
+
+    MeshJob job;
+    job.section_index = 0;
+    job.version = 1;
+    job.mode = MeshingMode::Culled;
+    job.build_faces = false;
+    ChunkMesher::CaptureSection(system, 0, &job.snapshot);
+
+    MeshWorkerPool pool;
+    pool.Start(1);
+    pool.Submit(job);
+    pool.WaitForIdle();
+    std::vector<MeshResult> results;
+    pool.CollectResults(&results);
+    ASSERT_EQ(results.size(), 1u);
+    const size_t vertex_count = results[0].mesh.GetVertexCount();
+    const VoxelVertex* storage = results[0].mesh.GetVertices().data();
+
+    // The returned result is emptied and the next job builds into it
+    pool.RecycleResults(&results);
+    ASSERT_EQ(results.size(), 0u);
+    ASSERT_EQ(pool.GetRecycledCount(), 1u);
+    pool.Submit(job);
+    pool.WaitForIdle();
+    pool.CollectResults(&results);
+    ASSERT_EQ(pool.GetRecycledCount(), 0u);
+    ASSERT_EQ(results[0].mesh.GetVertexCount(), vertex_count);
+    ASSERT_TRUE(results[0].mesh.GetVertices().data() == storage);
+}
+
+// ============================================================================
+// TEST SUITE: Asynchronous Chunk Renderer
+// ============================================================================
+
+TEST_CASE(TestAsyncRendererMatchesSynchronous) {
+    BlockSystem system;
+    system.Initialize(32, 16, 32, 1.0f);
+    FillTerrain(&system);
+    std::vector<uint32_t> sections;
+    for (uint32_t section = 0; section < system.GetSectionCount(); ++section) {
+        sections.push_back(section);
+    }
+
+    ChunkRenderer sync_chunks;
+    sync_chunks.Update(system, sections);
+
+    ChunkRenderer async_chunks;
+    ASSERT_TRUE(async_chunks.StartWorkers(2));
+    ASSERT_TRUE(async_chunks.IsMeshingAsync());
+    async_chunks.Update(system, sections);
+
+    // Queued sections are not queued twice
+    async_chunks.Update(system, sections);
+    async_chunks.FlushWorkers();
+    ASSERT_EQ(async_chunks.GetPendingMeshCount(), 0u);
+    ASSERT_EQ(async_chunks.GetRebuiltSectionCount(), static_cast<uint32_t>(sections.size()));
+    ASSERT_EQ(async_chunks.GetMeshedFaceCount(), sync_chunks.GetMeshedFaceCount());
+
+    // Up to date afterwards
+    async_chunks.Update(system, sections);
+    ASSERT_EQ(async_chunks.GetRebuiltSectionCount(), 0u);
+    ASSERT_EQ(async_chunks.GetPendingMeshCount(), 0u);
+}
+
+TEST_CASE(TestAsyncModeSwitchKeepsOldMeshes) {
+    BlockSystem system;
+    system.Initialize(16, 16, 16, 1.0f);
+    for (int z = 0; z < 16; ++z) {
+        for (int x = 0; x < 16; ++x) {
+            system.SetBlock(x, 0, z, Block{1});
+        }
+    }
+    std::vector<uint32_t> sections = {0};
+
+    ChunkRenderer chunks;
+    chunks.SetMeshingMode(MeshingMode::Culled);
+    chunks.StartWorkers(1);
+    chunks.Update(system, sections);
+    chunks.FlushWorkers();
+    ASSERT_EQ(chunks.GetSectionMesh(0).GetQuadCount(), 576u);
+
+    // The culled mesh stays drawable while the greedy one is being built
+    chunks.SetMeshingMode(MeshingMode::Greedy);
+    chunks.Update(system, sections);
+    ASSERT_EQ(chunks.GetPendingMeshCount(), 1u);
+    ASSERT_EQ(chunks.GetSectionMesh(0).GetQuadCount(), 576u);
+    ASSERT_EQ(chunks.GetMeshedFaceCount(), 576u);
+
+    chunks.FlushWorkers();
+    ASSERT_EQ(chunks.GetSectionMesh(0).GetQuadCount(), 6u);
+    chunks.Update(system, sections);
+    ASSERT_EQ(chunks.GetRebuiltSectionCount(), 0u);
+    ASSERT_EQ(chunks.GetPendingMeshCount(), 0u);
+}
+
+TEST_CASE(TestAsyncRendererDiscardsStaleResults) {
+    BlockSystem system;
+    system.Initialize(16, 16, 16, 1.0f);
+    system.SetBlock(4, 4, 4, Block{1});
+    std::vector<uint32_t> sections = {0};
+
+    ChunkRenderer chunks;
+    chunks.StartWorkers(1);
+    chunks.Update(system, sections);
+
+    // Edit again before the first build is adopted; only the newest counts
+    system.SetBlock(8, 4, 4, Block{1});
+    chunks.Update(system, sections);
+    chunks.FlushWorkers();
+    ASSERT_EQ(chunks.GetPendingMeshCount(), 0u);
+    ASSERT_EQ(chunks.GetMeshedFaceCount(), 12u);
+    ASSERT_EQ(chunks.GetSectionMesh(0).GetQuadCount(), 12u);
+
+    // Switching modes discards builds in flight as well
+    system.SetBlock(12, 4, 4, Block{1});
+    chunks.Update(system, sections);
+    chunks.SetMeshingMode(MeshingMode::Greedy == chunks.GetMeshingMode()
+                              ? MeshingMode::Culled : MeshingMode::Greedy);
+    chunks.FlushWorkers();
+    ASSERT_EQ(chunks.GetRebuiltSectionCount(), 0u);
+    chunks.Update(system, sections);
+    chunks.FlushWorkers();
+    ASSERT_EQ(chunks.GetMeshedFaceCount(), 18u);
+
+    // Stopping the workers falls back to synchronous builds
+    chunks.StopWorkers();
+    system.SetBlock(0, 0, 0, Block{1});
+    chunks.Update(system, sections);
+    ASSERT_EQ(chunks.GetRebuiltSectionCount(), 1u);
+    ASSERT_EQ(chunks.GetMeshedFaceCount(), 24u);
+}
+
+TEST_MAIN()
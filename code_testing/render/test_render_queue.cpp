@@ -0,0 +1,153 @@
+// code_testing/render/test_render_queue.cpp
+// Unit tests for sorted draw submission
+// Tests sort key layout, depth ordering per pass, the radix sort against
+// std::sort and command lookup after sorting (no GL calls)
+
+#include "../test_framework.h"
+#include "render/render_queue.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using blec::render::RenderCommand;
+using blec::render::RenderCommandType;
+using blec::render::RenderPass;
+using blec::render::RenderQueue;
+using blec::render::kInvalidShader;
+using blec::render::kStateOpaque;
+using blec::render::kStateTranslucent;
+
+namespace {
+
+// A mesh command with no mesh attached (never executed here)
+RenderCommand MakeCommand(RenderPass pass, blec::render::ShaderId shader, float depth) {
+    RenderCommand command{};
+    command.type = RenderCommandType::Mesh;
+    command.pass = pass;
+    command.state = (pass == RenderPass::Opaque) ? kStateOpaque : kStateTranslucent;
+    command.shader = shader;
+    command.depth = depth;
+    return command;
+}
+
+} // namespace
+
+// ============================================================================
+// TEST SUITE: Sort Keys
+// ============================================================================
+
+TEST_CASE(TestSortKeyFieldPriority) {
+    // Pass outranks shader, shader outranks state, state outranks depth
+    ASSERT_LT(RenderQueue::MakeSortKey(RenderPass::Opaque, 5, kStateOpaque, 900.0f, 0),
+              RenderQueue::MakeSortKey(RenderPass::Translucent, 0, kStateOpaque, 0.0f, 0));
+    ASSERT_LT(RenderQueue::MakeSortKey(RenderPass::Opaque, 1, kStateTranslucent, 900.0f, 0),
+              RenderQueue::MakeSortKey(RenderPass::Opaque, 2, 0, 0.0f, 0));
+    ASSERT_LT(RenderQueue::MakeSortKey(RenderPass::Opaque, 1, 0, 900.0f, 0),
+              RenderQueue::MakeSortKey(RenderPass::Opaque, 1, kStateOpaque, 0.0f, 0));
+
+    // Draws binding their own program sort after every registered one
+    ASSERT_LT(RenderQueue::MakeSortKey(RenderPass::Opaque, 4000, 0, 0.0f, 0),
+              RenderQueue::MakeSortKey(RenderPass::Opaque, kInvalidShader, 0, 0.0f, 0));
+
+    // The submission index occupies the low 16 bits
+    ASSERT_EQ(RenderQueue::MakeSortKey(RenderPass::Opaque, 0, 0, 0.0f, 123) & 0xFFFFu, 123u);
+}
+
+TEST_CASE(TestSortKeyDepthDirection) {
+    // Opaque draws go front to back, translucent ones back to front
+    ASSERT_LT(RenderQueue::MakeSortKey(RenderPass::Opaque, 0, 0, 1.0f, 0),
+              RenderQueue::MakeSortKey(RenderPass::Opaque, 0, 0, 2.0f, 0));
+    ASSERT_GT(RenderQueue::MakeSortKey(RenderPass::Translucent, 0, 0, 1.0f, 0),
+              RenderQueue::MakeSortKey(RenderPass::Translucent, 0, 0, 2.0f, 0));
+
+    // Depth saturates outside the range
+    ASSERT_EQ(RenderQueue::QuantizeDepth(-5.0f), 0u);
+    ASSERT_EQ(RenderQueue::QuantizeDepth(blec::render::kSortDepthRange * 2.0f), 0xFFFFFFu);
+    ASSERT_LT(RenderQueue::QuantizeDepth(10.0f), RenderQueue::QuantizeDepth(10.1f));
+}
+
+// ============================================================================
+// TEST SUITE: Radix Sort
+// ============================================================================
+
+TEST_CASE(TestRadixSortMatchesStdSort) {
+    std::mt19937_64 random(42);
+    std::vector<uint64_t> keys(5000);
+    for (uint64_t& key : keys) {
+        key = random();
+    }
+    std::vector<uint64_t> expected = keys;
+    std::sort(expected.begin(), expected.end());
+
+    std::vector<uint64_t> scratch;
+    ASSERT_EQ(RenderQueue::RadixSort(&keys, &scratch), 8u);
+    ASSERT_TRUE(keys == expected);
+}
+
+TEST_CASE(TestRadixSortSkipsSharedDigits) {
+    // Keys differing only in their lowest byte need a single pass
+    std::vector<uint64_t> keys = {0xAB00000000000005ull, 0xAB00000000000001ull,
+                                  0xAB00000000000003ull};
+    std::vector<uint64_t> scratch;
+    ASSERT_EQ(RenderQueue::RadixSort(&keys, &scratch), 1u);
+    ASSERT_EQ(keys[0], 0xAB00000000000001ull);
+    ASSERT_EQ(keys[2], 0xAB00000000000005ull);
+
+    // Nothing to do for fewer than two keys
+    std::vector<uint64_t> single = {7};
+    ASSERT_EQ(RenderQueue::RadixSort(&single, &scratch), 0u);
+}
+
+// ============================================================================
+// TEST SUITE: Queue
+// ============================================================================
+
+TEST_CASE(TestRenderQueueExecutionOrder) {
+    RenderQueue queue;
+    queue.Submit(MakeCommand(RenderPass::Translucent, 0, 5.0f));   // 0
+    queue.Submit(MakeCommand(RenderPass::Opaque, 1, 8.0f));        // 1
+    queue.Submit(MakeCommand(RenderPass::Translucent, 0, 20.0f));  // 2
+    queue.Submit(MakeCommand(RenderPass::Opaque, 0, 9.0f));        // 3
+    queue.Submit(MakeCommand(RenderPass::Opaque, 1, 2.0f));        // 4
+    queue.Submit(MakeCommand(RenderPass::Overlay, 0, 0.0f));       // 5
+
+    // Before sorting commands come back in submission order
+    ASSERT_EQ(queue.GetSortedCommand(1).depth, 8.0f);
+
+    queue.Sort();
+    const float expected_depths[] = {9.0f, 2.0f, 8.0f, 20.0f, 5.0f, 0.0f};
+    ASSERT_EQ(queue.GetCommandCount(), 6u);
+    for (size_t i = 0; i < 6; ++i) {
+        ASSERT_EQ(queue.GetSortedCommand(i).depth, expected_depths[i]);
+    }
+    ASSERT_TRUE(queue.GetSortedCommand(5).pass == RenderPass::Overlay);
+    ASSERT_GT(queue.GetLastSortPassCount(), 0u);
+
+    queue.Clear();
+    ASSERT_EQ(queue.GetCommandCount(), 0u);
+}
+
+TEST_CASE(TestRenderQueueKeepsEqualKeysInOrder) {
+    RenderQueue queue;
+    for (int i = 0; i < 10; ++i) {
+        RenderCommand command = MakeCommand(RenderPass::Opaque, 3, 4.0f);
+        command.model[3][0] = static_cast<float>(i);
+        queue.Submit(command);
+    }
+    queue.Sort();
+    for (size_t i = 0; i < 10; ++i) {
+        ASSERT_EQ(queue.GetSortedCommand(i).model[3][0], static_cast<float>(i));
+    }
+}
+
+TEST_CASE(TestRenderQueueRejectsOverflow) {
+    RenderQueue queue;
+    const RenderCommand command = MakeCommand(RenderPass::Opaque, 0, 0.0f);
+    for (size_t i = 0; i < blec::render::kMaxRenderCommands; ++i) {
+        ASSERT_TRUE(queue.Submit(command));
+    }
+    ASSERT_FALSE(queue.Submit(command));
+    ASSERT_EQ(queue.GetCommandCount(), blec::render::kMaxRenderCommands);
+}
+
+TEST_MAIN()
@@ -7,6 +7,7 @@
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
 
 namespace {
 
@@ -84,6 +85,29 @@ TEST_CASE(TestRendererSetMatrices) {
     ASSERT_TRUE(true);
 }
 
+TEST_CASE(TestRendererConcatenatesViewProjectionOnCpu) {
+    REQUIRE_GL_CONTEXT();
+    blec::render::Renderer renderer;
+    renderer.Initialize();
+
+    glm::mat4 projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 5.0f),
+                                 glm::vec3(0.0f, 0.0f, 0.0f),
+                                 glm::vec3(0.0f, 1.0f, 0.0f));
+    renderer.SetProjection(projection);
+    renderer.SetView(view);
+
+    const glm::mat4 expected = projection * view;
+    const glm::mat4& view_projection = renderer.GetViewProjection();
+    for (int column = 0; column < 4; ++column) {
+        for (int row = 0; row < 4; ++row) {
+            ASSERT_LT(std::abs(view_projection[column][row] - expected[column][row]), 1e-5f);
+        }
+    }
+    renderer.ReleaseGpuResources();
+    ASSERT_FALSE(renderer.UsesShaderPipeline());
+}
+
 TEST_CASE(TestRendererDepthAndCulling) {
     REQUIRE_GL_CONTEXT();
     blec::render::Renderer renderer;
@@ -0,0 +1,89 @@
+// code_testing/render/test_shader_manager.cpp
+// Unit tests for the shader registry
+// Tests CPU-side matrix concatenation and behavior without a GL context
+// (programs cannot be built, so no GL calls are made)
+
+#include "../test_framework.h"
+#include "render/shader_manager.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+
+using blec::render::ShaderManager;
+using blec::render::kInvalidShader;
+
+namespace {
+
+bool MatricesNearlyEqual(const glm::mat4& a, const glm::mat4& b) {
+    for (int column = 0; column < 4; ++column) {
+        for (int row = 0; row < 4; ++row) {
+            if (std::abs(a[column][row] - b[column][row]) > 1e-5f) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+// ============================================================================
+// TEST SUITE: Matrices
+// ============================================================================
+
+TEST_CASE(TestShaderManagerViewProjectionProduct) {
+    ShaderManager shaders;
+    ASSERT_TRUE(MatricesNearlyEqual(shaders.GetViewProjection(), glm::mat4(1.0f)));
+
+    const glm::mat4 projection = glm::perspective(glm::radians(45.0f), 1.5f, 0.1f, 100.0f);
+    const glm::mat4 view = glm::lookAt(glm::vec3(3.0f, 4.0f, 5.0f), glm::vec3(0.0f),
+                                       glm::vec3(0.0f, 1.0f, 0.0f));
+    shaders.SetProjection(projection);
+    shaders.SetView(view);
+    ASSERT_TRUE(MatricesNearlyEqual(shaders.GetViewProjection(), projection * view));
+}
+
+TEST_CASE(TestShaderManagerConcatenatesOncePerChange) {
+    ShaderManager shaders;
+    const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 1.0f, 0.1f, 50.0f);
+    shaders.SetProjection(projection);
+    shaders.SetView(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -2.0f)));
+
+    // Setting both matrices then reading many times costs one product
+    for (int i = 0; i < 5; ++i) {
+        shaders.GetViewProjection();
+    }
+    ASSERT_EQ(shaders.GetConcatenationCount(), 1u);
+
+    // A new frame's view triggers exactly one more
+    shaders.SetView(glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, 0.0f, -2.0f)));
+    shaders.GetViewProjection();
+    shaders.GetViewProjection();
+    ASSERT_EQ(shaders.GetConcatenationCount(), 2u);
+
+    // Model changes never touch the view-projection
+    shaders.SetModel(glm::scale(glm::mat4(1.0f), glm::vec3(2.0f)));
+    shaders.GetViewProjection();
+    ASSERT_EQ(shaders.GetConcatenationCount(), 2u);
+}
+
+// ============================================================================
+// TEST SUITE: Registry
+// ============================================================================
+
+TEST_CASE(TestShaderManagerWithoutShaders) {
+    // Entry points are not loaded, so nothing builds and nothing is bound
+    ShaderManager shaders;
+    ASSERT_FALSE(shaders.InitializeBuiltins());
+    ASSERT_EQ(shaders.GetColorShader(), kInvalidShader);
+    ASSERT_EQ(shaders.GetProgramCount(), 0u);
+    ASSERT_EQ(shaders.Find("color"), kInvalidShader);
+    ASSERT_NULL(shaders.Get(0));
+
+    shaders.Use(0);
+    ASSERT_EQ(shaders.GetActive(), kInvalidShader);
+    shaders.Release();
+    ASSERT_EQ(shaders.GetProgramCount(), 0u);
+}
+
+TEST_MAIN()
@@ -0,0 +1,103 @@
+// code_testing/render/test_stream_buffer.cpp
+// Unit tests for the per-frame upload ring
+// Entry points are not loaded here, so the ring runs in client mode; tests
+// cover span placement, alignment, wrapping, growth and frame accounting
+
+#include "../test_framework.h"
+#include "render/stream_buffer.h"
+#include <cstring>
+
+using blec::render::StreamBuffer;
+using blec::render::StreamMode;
+using blec::render::StreamSpan;
+
+// ============================================================================
+// TEST SUITE: Spans
+// ============================================================================
+
+TEST_CASE(TestStreamBufferAlignsSpans) {
+    StreamBuffer stream(256);
+    const StreamSpan first = stream.Allocate(10);
+    const StreamSpan second = stream.Allocate(10);
+    const StreamSpan third = stream.Allocate(3, 4);
+    ASSERT_TRUE(stream.GetMode() == StreamMode::Client);
+    ASSERT_EQ(first.offset, 0u);
+    ASSERT_EQ(second.offset, 16u);
+    ASSERT_EQ(third.offset, 28u);
+    ASSERT_EQ(second.size, 10u);
+
+    // Client spans are written where the attribute pointer reads them
+    std::memset(second.data, 7, second.size);
+    stream.Commit(second);
+    const unsigned char* read = static_cast<const unsigned char*>(stream.GetPointer(16));
+    ASSERT_TRUE(read == second.data);
+    ASSERT_EQ(read[9], 7);
+}
+
+TEST_CASE(TestStreamBufferWrapsWithoutStraddling) {
+    StreamBuffer stream(256);
+    ASSERT_EQ(stream.Allocate(100).offset, 0u);
+    ASSERT_EQ(stream.Allocate(100).offset, 112u);
+
+    // 212 + 100 passes the end, so the span restarts at the front
+    const StreamSpan wrapped = stream.Allocate(100);
+    ASSERT_EQ(wrapped.offset, 0u);
+    ASSERT_EQ(stream.Allocate(100).offset, 112u);
+    ASSERT_EQ(stream.GetCapacity(), 256u);
+    ASSERT_EQ(stream.GetGrowthCount(), 0u);
+
+    // Orphaning only applies to buffer objects
+    ASSERT_EQ(stream.GetOrphanCount(), 0u);
+}
+
+TEST_CASE(TestStreamBufferGrowsForLargeSpans) {
+    StreamBuffer stream(64);
+    stream.Allocate(16);
+    const StreamSpan large = stream.Allocate(200);
+    ASSERT_EQ(large.offset, 0u);
+    ASSERT_GE(stream.GetCapacity(), 200u);
+    ASSERT_EQ(stream.GetGrowthCount(), 1u);
+
+    // The grown ring keeps handing out spans from the front
+    std::memset(large.data, 1, large.size);
+    ASSERT_EQ(stream.Allocate(8).offset, 208u);
+}
+
+TEST_CASE(TestStreamBufferEmptySpan) {
+    StreamBuffer stream(64);
+    const StreamSpan span = stream.Allocate(0);
+    ASSERT_NULL(span.data);
+    ASSERT_EQ(span.size, 0u);
+    stream.Commit(span);
+    ASSERT_EQ(stream.Allocate(4).offset, 0u);
+}
+
+// ============================================================================
+// TEST SUITE: Frames
+// ============================================================================
+
+TEST_CASE(TestStreamBufferCountsFrameBytes) {
+    StreamBuffer stream(1024);
+    stream.Allocate(40);
+    stream.Allocate(24);
+    stream.EndFrame();
+    ASSERT_EQ(stream.GetLastFrameBytes(), 64u);
+
+    // Client memory is read by the draw itself, so nothing stays in flight
+    ASSERT_EQ(stream.GetFramesInFlight(), 0u);
+
+    stream.EndFrame();
+    ASSERT_EQ(stream.GetLastFrameBytes(), 0u);
+}
+
+TEST_CASE(TestStreamBufferReleaseWithoutGl) {
+    StreamBuffer stream(128);
+    stream.Allocate(32);
+    stream.Release();
+    ASSERT_TRUE(stream.GetMode() == StreamMode::Client);
+    ASSERT_EQ(stream.Allocate(8).offset, 0u);
+    ASSERT_STREQ(StreamBuffer::GetModeName(StreamMode::Persistent), "Persistent");
+    ASSERT_STREQ(StreamBuffer::GetModeName(StreamMode::Orphan), "Orphan");
+}
+
+TEST_MAIN()
@@ -0,0 +1,68 @@
+// code_testing/render/test_ui_command_list.cpp
+// Unit tests for recorded 2D overlay drawing
+// Tests command order and arguments, text storage and clearing (replay
+// reaches GL, which ignores it without a current context)
+
+#include "../test_framework.h"
+#include "render/font.h"
+#include "render/ui_command_list.h"
+
+using blec::render::BitmapFont;
+using blec::render::UiCommand;
+using blec::render::UiCommandList;
+using blec::render::UiCommandType;
+
+// ============================================================================
+// TEST SUITE: Recording
+// ============================================================================
+
+TEST_CASE(TestUiCommandListRecordsInOrder) {
+    UiCommandList list;
+    list.EnableBlending();
+    list.SetColor(0.1f, 0.2f, 0.3f, 0.4f);
+    list.DrawFilledRect(10.0f, 20.0f, 30.0f, 40.0f);
+    list.DrawLine(1.0f, 2.0f, 3.0f, 4.0f);
+    list.DisableBlending();
+
+    const std::vector<UiCommand>& commands = list.GetCommands();
+    ASSERT_EQ(commands.size(), 5u);
+    ASSERT_TRUE(commands[0].type == UiCommandType::EnableBlending);
+    ASSERT_TRUE(commands[1].type == UiCommandType::SetColor);
+    ASSERT_EQ(commands[1].values[3], 0.4f);
+    ASSERT_TRUE(commands[2].type == UiCommandType::FilledRect);
+    ASSERT_EQ(commands[2].values[0], 10.0f);
+    ASSERT_EQ(commands[2].values[3], 40.0f);
+    ASSERT_TRUE(commands[3].type == UiCommandType::Line);
+    ASSERT_EQ(commands[3].values[2], 3.0f);
+    ASSERT_TRUE(commands[4].type == UiCommandType::DisableBlending);
+}
+
+TEST_CASE(TestUiCommandListCopiesText) {
+    UiCommandList list;
+    std::string text = "FPS: 60";
+    list.DrawText(5.0f, 6.0f, 2.0f, text);
+    list.DrawText(5.0f, 22.0f, 2.0f, "");
+    list.DrawText(5.0f, 38.0f, 2.0f, "Line\nTwo");
+    text = "changed";
+
+    const std::vector<UiCommand>& commands = list.GetCommands();
+    ASSERT_EQ(commands.size(), 3u);
+    ASSERT_TRUE(list.GetText(commands[0]) == "FPS: 60");
+    ASSERT_TRUE(list.GetText(commands[1]).empty());
+    ASSERT_TRUE(list.GetText(commands[2]) == "Line\nTwo");
+    ASSERT_EQ(commands[2].values[2], 2.0f);
+}
+
+TEST_CASE(TestUiCommandListClearAndReplay) {
+    UiCommandList list;
+    list.SetColor(1.0f, 1.0f, 1.0f, 1.0f);
+    list.DrawText(0.0f, 0.0f, 1.0f, "abc");
+    list.Execute(BitmapFont());
+
+    list.Clear();
+    ASSERT_EQ(list.GetCommands().size(), 0u);
+    list.DrawText(0.0f, 0.0f, 1.0f, "xy");
+    ASSERT_TRUE(list.GetText(list.GetCommands()[0]) == "xy");
+}
+
+TEST_MAIN()
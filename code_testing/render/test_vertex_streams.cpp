@@ -0,0 +1,146 @@
+// code_testing/render/test_vertex_streams.cpp
+// Unit tests for structure-of-arrays vertex streams and batch transforms
+// Tests batch results against per-vertex glm math, including counts that
+// are not a multiple of the SIMD width
+
+#include "../test_framework.h"
+#include "render/mesh.h"
+#include "render/vertex_streams.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <vector>
+
+using blec::render::Mesh;
+using blec::render::Vertex;
+using blec::render::VertexStreams;
+
+namespace {
+
+constexpr float kEpsilon = 1e-4f;
+
+// Deterministic vertices with varied positions and unit normals
+std::vector<Vertex> MakeVertices(size_t count) {
+    std::vector<Vertex> vertices;
+    for (size_t i = 0; i < count; ++i) {
+        const float f = static_cast<float>(i);
+        const glm::vec3 position(std::sin(f) * 10.0f, std::cos(f * 0.7f) * 5.0f, f * 0.01f);
+        const glm::vec3 normal = glm::normalize(glm::vec3(std::cos(f), 1.0f, std::sin(f * 1.3f)));
+        vertices.push_back(Vertex(position, glm::vec3(f / count, 0.5f, 1.0f), normal));
+    }
+    return vertices;
+}
+
+// Reference per-vertex transform (the original Mesh::ApplyTransform math)
+Vertex ReferenceTransform(const Vertex& vertex, const glm::mat4& transform) {
+    const glm::vec4 position = transform * glm::vec4(vertex.position, 1.0f);
+    const glm::mat3 normal_matrix = glm::mat3(glm::transpose(glm::inverse(transform)));
+    return Vertex(glm::vec3(position) / position.w, vertex.color,
+                  glm::normalize(normal_matrix * vertex.normal));
+}
+
+bool NearlyEqual(const glm::vec3& a, const glm::vec3& b) {
+    return std::abs(a.x - b.x) < kEpsilon && std::abs(a.y - b.y) < kEpsilon &&
+           std::abs(a.z - b.z) < kEpsilon;
+}
+
+glm::mat4 MakeModelMatrix() {
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(3.0f, -2.0f, 7.5f));
+    model = glm::rotate(model, 0.6f, glm::vec3(0.3f, 1.0f, 0.2f));
+    return glm::scale(model, glm::vec3(2.0f, 0.5f, 1.5f));  // Non-uniform
+}
+
+} // namespace
+
+// ============================================================================
+// TEST SUITE: Streams
+// ============================================================================
+
+TEST_CASE(TestVertexStreamsRoundTrip) {
+    const std::vector<Vertex> vertices = MakeVertices(5);
+    VertexStreams streams;
+    streams.CopyFrom(vertices);
+    ASSERT_EQ(streams.GetCount(), 5u);
+    ASSERT_EQ(streams.normal_z.size(), 5u);
+
+    std::vector<Vertex> copy;
+    streams.CopyTo(&copy);
+    ASSERT_EQ(copy.size(), 5u);
+    for (size_t i = 0; i < copy.size(); ++i) {
+        ASSERT_TRUE(copy[i].position == vertices[i].position);
+        ASSERT_TRUE(copy[i].color == vertices[i].color);
+        ASSERT_TRUE(copy[i].normal == vertices[i].normal);
+    }
+
+    streams.Clear();
+    ASSERT_EQ(streams.GetCount(), 0u);
+}
+
+TEST_CASE(TestVertexStreamsTransformMatchesReference) {
+    // 1027 leaves a remainder for the scalar tail after 4-wide batches
+    const std::vector<Vertex> vertices = MakeVertices(1027);
+    const glm::mat4 model = MakeModelMatrix();
+
+    VertexStreams streams;
+    streams.CopyFrom(vertices);
+    streams.ApplyTransform(model);
+
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const Vertex expected = ReferenceTransform(vertices[i], model);
+        const Vertex actual = streams.GetVertex(i);
+        ASSERT_TRUE(NearlyEqual(actual.position, expected.position));
+        ASSERT_TRUE(NearlyEqual(actual.normal, expected.normal));
+        ASSERT_TRUE(actual.color == vertices[i].color);
+    }
+}
+
+TEST_CASE(TestTransformPositionsProjective) {
+    // Points in front of the camera land inside clip space after the divide
+    const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 1.5f, 0.1f, 100.0f);
+    float x[6] = {0.0f, 1.0f, -1.0f, 2.0f, 0.5f, -3.0f};
+    float y[6] = {0.0f, 0.5f, -0.5f, 1.0f, 2.0f, 0.0f};
+    float z[6] = {-1.0f, -2.0f, -4.0f, -8.0f, -16.0f, -32.0f};
+    const float original_x[6] = {0.0f, 1.0f, -1.0f, 2.0f, 0.5f, -3.0f};
+    const float original_y[6] = {0.0f, 0.5f, -0.5f, 1.0f, 2.0f, 0.0f};
+    const float original_z[6] = {-1.0f, -2.0f, -4.0f, -8.0f, -16.0f, -32.0f};
+
+    blec::render::TransformPositions(projection, x, y, z, 6);
+    for (int i = 0; i < 6; ++i) {
+        const glm::vec4 clip =
+            projection * glm::vec4(original_x[i], original_y[i], original_z[i], 1.0f);
+        ASSERT_TRUE(NearlyEqual(glm::vec3(x[i], y[i], z[i]), glm::vec3(clip) / clip.w));
+    }
+}
+
+// ============================================================================
+// TEST SUITE: Mesh
+// ============================================================================
+
+TEST_CASE(TestMeshApplyTransformMatchesReference) {
+    // Several staging blocks plus a partial one
+    Mesh mesh;
+    const std::vector<Vertex> vertices = MakeVertices(600);
+    for (const Vertex& vertex : vertices) {
+        mesh.AddVertex(vertex);
+    }
+
+    const glm::mat4 model = MakeModelMatrix();
+    mesh.ApplyTransform(model);
+    ASSERT_EQ(mesh.GetVertexCount(), vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const Vertex expected = ReferenceTransform(vertices[i], model);
+        ASSERT_TRUE(NearlyEqual(mesh.GetVertices()[i].position, expected.position));
+        ASSERT_TRUE(NearlyEqual(mesh.GetVertices()[i].normal, expected.normal));
+    }
+}
+
+TEST_CASE(TestMeshApplyTransformCube) {
+    Mesh cube = Mesh::CreateCube();
+    cube.ApplyTransform(glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, 2.0f, 3.0f)));
+
+    // Front face first corner moves, its normal does not
+    ASSERT_TRUE(NearlyEqual(cube.GetVertices()[0].position, glm::vec3(0.5f, 1.5f, 3.5f)));
+    ASSERT_TRUE(NearlyEqual(cube.GetVertices()[0].normal, glm::vec3(0.0f, 0.0f, 1.0f)));
+}
+
+TEST_MAIN()
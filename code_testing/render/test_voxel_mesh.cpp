@@ -0,0 +1,122 @@
+// code_testing/render/test_voxel_mesh.cpp
+// Unit tests for the packed voxel vertex format
+// Tests vertex size, encoding round trips, move semantics and the shared
+// quad index pattern (no GL calls)
+
+#include "../test_framework.h"
+#include "render/mesh.h"
+#include "render/chunk_mesher.h"
+#include "render/quad_index_buffer.h"
+#include "render/voxel_mesh.h"
+#include "world/block_system.h"
+#include <glm/glm.hpp>
+#include <utility>
+
+using blec::render::QuadIndexBuffer;
+using blec::render::VoxelMesh;
+using blec::render::VoxelVertex;
+
+// ============================================================================
+// TEST SUITE: Vertex Format
+// ============================================================================
+
+TEST_CASE(TestVoxelVertexIsQuarterOfFullVertex) {
+    ASSERT_EQ(sizeof(VoxelVertex), 8u);
+    ASSERT_GE(sizeof(blec::render::Vertex) / sizeof(VoxelVertex), 4u);
+}
+
+TEST_CASE(TestVoxelVertexRoundTrip) {
+    const glm::ivec3 corners[4] = {
+        glm::ivec3(0, 16, 3), glm::ivec3(16, 16, 3), glm::ivec3(16, 16, 16), glm::ivec3(0, 16, 16)
+    };
+    const uint8_t ao[4] = {0, 1, 2, 3};
+
+    VoxelMesh mesh;
+    mesh.AddQuad(corners, 3, 4, ao);
+    ASSERT_EQ(mesh.GetVertexCount(), 4u);
+    ASSERT_EQ(mesh.GetIndexCount(), 6u);
+
+    for (int i = 0; i < 4; ++i) {
+        const VoxelVertex& vertex = mesh.GetVertices()[i];
+        ASSERT_TRUE(VoxelMesh::DecodePosition(vertex) == glm::vec3(corners[i]));
+        ASSERT_EQ(VoxelMesh::DecodeFace(vertex), 3);
+        ASSERT_EQ(VoxelMesh::DecodeAmbientOcclusion(vertex), i);
+        ASSERT_EQ(vertex.color, 4);
+    }
+    ASSERT_TRUE(VoxelMesh::GetFaceNormal(3) == glm::vec3(0.0f, 1.0f, 0.0f));
+}
+
+TEST_CASE(TestVoxelMeshDefaultsToUnoccluded) {
+    const glm::ivec3 corners[4] = {
+        glm::ivec3(1, 0, 0), glm::ivec3(0, 0, 0), glm::ivec3(0, 1, 0), glm::ivec3(1, 1, 0)
+    };
+
+    VoxelMesh mesh;
+    mesh.AddQuad(corners, 4, 0);
+    mesh.AddQuad(corners, 4, 0);
+    ASSERT_EQ(VoxelMesh::DecodeAmbientOcclusion(mesh.GetVertices()[0]), 0);
+
+    // Second quad indexes its own vertices
+    ASSERT_EQ(mesh.GetQuadCount(), 2u);
+    ASSERT_EQ(mesh.GetIndexCount(), 12u);
+    ASSERT_EQ(QuadIndexBuffer::GetIndex(6), 4u);
+    ASSERT_EQ(QuadIndexBuffer::GetIndex(11), 7u);
+}
+
+TEST_CASE(TestVoxelMeshClearAndMove) {
+    const glm::ivec3 corners[4] = {
+        glm::ivec3(0, 0, 0), glm::ivec3(0, 0, 1), glm::ivec3(0, 1, 1), glm::ivec3(0, 1, 0)
+    };
+
+    VoxelMesh mesh;
+    mesh.AddQuad(corners, 0, 1);
+
+    VoxelMesh moved(std::move(mesh));
+    ASSERT_EQ(moved.GetVertexCount(), 4u);
+
+    moved.Clear();
+    ASSERT_EQ(moved.GetVertexCount(), 0u);
+    ASSERT_EQ(moved.GetIndexCount(), 0u);
+}
+
+// ============================================================================
+// TEST SUITE: Shared Quad Indices
+// ============================================================================
+
+TEST_CASE(TestQuadIndexPattern) {
+    const uint32_t expected[6] = {0, 1, 2, 0, 2, 3};
+    for (size_t i = 0; i < 6; ++i) {
+        ASSERT_EQ(QuadIndexBuffer::GetIndex(i), expected[i]);
+    }
+
+    // Last index of a full buffer still fits 16 bits
+    const size_t last = static_cast<size_t>(blec::render::kMaxQuadsPerSection) *
+                        blec::render::kIndicesPerQuad - 1;
+    ASSERT_LE(QuadIndexBuffer::GetIndex(last), 65535u);
+
+    QuadIndexBuffer indices;
+    ASSERT_FALSE(indices.IsUploaded());
+    ASSERT_EQ(indices.GetGpuBytes(), 0u);
+}
+
+TEST_CASE(TestCheckerboardFillsQuadIndexBuffer) {
+    // The densest section a mesh can come from
+    blec::world::BlockSystem system;
+    system.Initialize(16, 16, 16, 1.0f);
+    for (int z = 0; z < 16; ++z) {
+        for (int y = 0; y < 16; ++y) {
+            for (int x = 0; x < 16; ++x) {
+                if ((x + y + z) % 2 == 0) {
+                    system.SetBlock(x, y, z, blec::world::Block{1});
+                }
+            }
+        }
+    }
+
+    VoxelMesh mesh;
+    blec::render::ChunkMesher::BuildSectionMesh(system, 0, &mesh,
+                                                blec::render::MeshingMode::Culled);
+    ASSERT_EQ(mesh.GetQuadCount(), static_cast<size_t>(blec::render::kMaxQuadsPerSection));
+}
+
+TEST_MAIN()
@@ -1,5 +1,6 @@
 #include "../test_framework.h"
 #include "ui/ui_manager.h"
+#include "render/ui_command_list.h"
 
 // Test the Button hit detection
 TEST_CASE(TestButtonContains) {
@@ -244,4 +245,23 @@ TEST_CASE(TestButtonBoundaryClick) {
                 result1 == blec::ui::UIManager::ButtonAction::Resume);
 }
 
+// Test recording the crosshair and pause menu for the render thread
+TEST_CASE(TestRecordOverlay) {
+    blec::ui::UIManager ui;
+    ui.Initialize(1280, 720);
+    blec::render::UiCommandList commands;
+
+    // Crosshair: one color and four lines
+    ui.RecordCrosshair(&commands);
+    ASSERT_EQ(commands.GetCommands().size(), 5u);
+
+    // Pause menu records nothing until paused
+    ui.RecordPauseMenu(&commands);
+    ASSERT_EQ(commands.GetCommands().size(), 5u);
+
+    ui.TogglePause();
+    ui.RecordPauseMenu(&commands);
+    ASSERT_GT(commands.GetCommands().size(), 5u);
+}
+
 TEST_MAIN()
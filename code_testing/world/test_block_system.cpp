@@ -6,6 +6,7 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <cmath>
+#include <vector>
 
 // ============================================================================
 // TEST SUITE: Initialization
@@ -108,4 +109,199 @@ TEST_CASE(TestCreateTestBlocksCount) {
     ASSERT_EQ(system.GetTotalBlockCount(), 27u);
 }
 
+// ============================================================================
+// TEST SUITE: Sections
+// ============================================================================
+
+TEST_CASE(TestSectionGridDimensions) {
+    blec::world::BlockSystem system;
+    system.Initialize(32, 40, 16, 1.0f);
+
+    ASSERT_EQ(system.GetSectionCountX(), 2u);
+    ASSERT_EQ(system.GetSectionCountY(), 3u);  // Partial top section
+    ASSERT_EQ(system.GetSectionCountZ(), 1u);
+    ASSERT_EQ(system.GetSectionCount(), 6u);
+    ASSERT_EQ(system.GetSectionIndex(2, 0, 0), -1);
+
+    int32_t sx = 0;
+    int32_t sy = 0;
+    int32_t sz = 0;
+    system.GetSectionCoordinates(static_cast<uint32_t>(system.GetSectionIndex(1, 2, 0)),
+                                 &sx, &sy, &sz);
+    ASSERT_TRUE(sx == 1 && sy == 2 && sz == 0);
+
+    // Edge section bounds are clamped to the grid
+    blec::world::AABB top = system.GetSectionAABB(
+        static_cast<uint32_t>(system.GetSectionIndex(0, 2, 0)));
+    ASSERT_EQ(top.min.y, 32.0f);
+    ASSERT_EQ(top.max.y, 40.0f);
+}
+
+TEST_CASE(TestSectionBlockCountAndRevision) {
+    blec::world::BlockSystem system;
+    system.Initialize(32, 32, 32, 1.0f);
+    const uint32_t section = static_cast<uint32_t>(system.GetSectionIndex(1, 0, 0));
+
+    ASSERT_EQ(system.GetSectionBlockCount(section), 0u);
+    system.SetBlock(20, 3, 3, blec::world::Block{1});
+    ASSERT_EQ(system.GetSectionBlockCount(section), 1u);
+    ASSERT_EQ(system.GetSectionRevision(section), 1u);
+
+    // Re-setting the same type is not an edit
+    system.SetBlock(20, 3, 3, blec::world::Block{1});
+    ASSERT_EQ(system.GetSectionRevision(section), 1u);
+
+    system.SetBlock(20, 3, 3, blec::world::Block{0});
+    ASSERT_EQ(system.GetSectionBlockCount(section), 0u);
+    ASSERT_EQ(system.GetSectionRevision(section), 2u);
+}
+
+TEST_CASE(TestSectionMeshRevisionMarksBorderNeighbors) {
+    blec::world::BlockSystem system;
+    system.Initialize(48, 48, 48, 1.0f);
+    const uint32_t center = static_cast<uint32_t>(system.GetSectionIndex(1, 1, 1));
+    const uint32_t neg_x = static_cast<uint32_t>(system.GetSectionIndex(0, 1, 1));
+    const uint32_t pos_x = static_cast<uint32_t>(system.GetSectionIndex(2, 1, 1));
+    const uint32_t pos_y = static_cast<uint32_t>(system.GetSectionIndex(1, 2, 1));
+    const uint32_t pos_z = static_cast<uint32_t>(system.GetSectionIndex(1, 1, 2));
+
+    auto total = [&system]() {
+        uint32_t sum = 0;
+        for (uint32_t i = 0; i < system.GetSectionCount(); ++i) {
+            sum += system.GetSectionMeshRevision(i);
+        }
+        return sum;
+    };
+
+    // Interior block only dirties its own section
+    system.SetBlock(24, 24, 24, blec::world::Block{1});
+    ASSERT_EQ(system.GetSectionMeshRevision(center), 1u);
+    ASSERT_EQ(total(), 1u);
+
+    // Face block also dirties the neighbor across that face
+    system.SetBlock(16, 24, 24, blec::world::Block{1});
+    ASSERT_EQ(system.GetSectionMeshRevision(center), 2u);
+    ASSERT_EQ(system.GetSectionMeshRevision(neg_x), 1u);
+    ASSERT_EQ(system.GetSectionMeshRevision(pos_x), 0u);
+    ASSERT_EQ(total(), 3u);
+
+    // Corner block dirties every section whose border holds it: the owner,
+    // three face, three edge and one corner neighbor
+    system.SetBlock(31, 31, 31, blec::world::Block{1});
+    ASSERT_EQ(system.GetSectionMeshRevision(pos_x), 1u);
+    ASSERT_EQ(system.GetSectionMeshRevision(pos_y), 1u);
+    ASSERT_EQ(system.GetSectionMeshRevision(pos_z), 1u);
+    ASSERT_EQ(system.GetSectionMeshRevision(
+                  static_cast<uint32_t>(system.GetSectionIndex(2, 2, 1))), 1u);
+    ASSERT_EQ(system.GetSectionMeshRevision(
+                  static_cast<uint32_t>(system.GetSectionIndex(2, 2, 2))), 1u);
+    ASSERT_EQ(total(), 11u);
+
+    // No change, no mark; grid edges have no neighbor to mark
+    system.SetBlock(31, 31, 31, blec::world::Block{1});
+    system.SetBlock(0, 24, 24, blec::world::Block{1});
+    ASSERT_EQ(total(), 12u);
+
+    // The edit revision still only counts the owning section
+    ASSERT_EQ(system.GetSectionRevision(neg_x), 1u);
+    ASSERT_EQ(system.GetSectionRevision(center), 3u);
+}
+
+TEST_CASE(TestGatherPaddedSection) {
+    using blec::world::kPaddedSectionSize;
+    blec::world::BlockSystem system;
+    system.Initialize(32, 20, 16, 1.0f);
+    system.SetBlock(16, 0, 0, blec::world::Block{3});   // First block of section (1,0,0)
+    system.SetBlock(15, 5, 7, blec::world::Block{2});   // Border cell in section (0,0,0)
+    system.SetBlock(20, 16, 4, blec::world::Block{4});  // Border cell in section (1,1,0)
+
+    std::vector<uint8_t> types(blec::world::kPaddedSectionVolume, 0xFF);
+    const uint32_t section = static_cast<uint32_t>(system.GetSectionIndex(1, 0, 0));
+    system.GatherPaddedSection(section, types.data());
+
+    auto at = [&](int px, int py, int pz) {
+        return types[px + (py + pz * kPaddedSectionSize) * kPaddedSectionSize];
+    };
+    ASSERT_EQ(at(1, 1, 1), 3);
+    ASSERT_EQ(at(0, 6, 8), 2);
+    ASSERT_EQ(at(5, 17, 5), 4);
+
+    // Cells beyond the grid (x >= 32, y < 0, z >= 16) read as air
+    ASSERT_EQ(at(17, 1, 1), 0);
+    ASSERT_EQ(at(1, 0, 1), 0);
+    ASSERT_EQ(at(1, 1, 17), 0);
+
+    uint32_t solid = 0;
+    for (uint8_t type : types) {
+        solid += (type != 0) ? 1u : 0u;
+    }
+    ASSERT_EQ(solid, 3u);
+}
+
+TEST_CASE(TestVisibleSections) {
+    blec::world::BlockSystem system;
+    system.Initialize(32, 32, 32, 1.0f);
+    system.SetBlock(20, 20, 20, blec::world::Block{1});
+
+    // Look at the block from outside the grid
+    glm::mat4 view = glm::lookAt(glm::vec3(20.5f, 20.5f, 40.0f),
+                                 glm::vec3(20.5f, 20.5f, 20.5f),
+                                 glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 projection = glm::perspective(glm::radians(45.0f), 1.0f, 0.1f, 100.0f);
+    system.ExtractFrustum(view, projection);
+    system.UpdateVisibility();
+
+    // Only the single non-empty section is reported
+    ASSERT_EQ(system.GetVisibleSections().size(), 1u);
+    ASSERT_EQ(static_cast<int32_t>(system.GetVisibleSections()[0]),
+              system.GetSectionIndex(1, 1, 1));
+    ASSERT_EQ(system.GetVisibleBlockCount(), 1u);
+}
+
+TEST_CASE(TestVisibilityEnterLeaveDiff) {
+    blec::world::BlockSystem system;
+    system.Initialize(48, 16, 16, 1.0f);
+    system.SetBlock(8, 8, 8, blec::world::Block{1});
+    system.SetBlock(40, 8, 8, blec::world::Block{1});
+    glm::mat4 projection = glm::perspective(glm::radians(45.0f), 1.0f, 0.1f, 100.0f);
+
+    // First update: everything visible has entered
+    system.ExtractFrustum(glm::lookAt(glm::vec3(8.5f, 8.5f, 30.0f), glm::vec3(8.5f, 8.5f, 8.5f),
+                                      glm::vec3(0.0f, 1.0f, 0.0f)), projection);
+    system.UpdateVisibility();
+    ASSERT_EQ(system.GetEnteredSections().size(), 1u);
+    ASSERT_EQ(system.GetEnteredSections()[0], 0u);
+    ASSERT_TRUE(system.GetLeftSections().empty());
+
+    // Unchanged view produces no events
+    system.UpdateVisibility();
+    ASSERT_TRUE(system.GetEnteredSections().empty());
+    ASSERT_TRUE(system.GetLeftSections().empty());
+
+    // Turning to the other block swaps the sections
+    system.ExtractFrustum(glm::lookAt(glm::vec3(40.5f, 8.5f, 30.0f), glm::vec3(40.5f, 8.5f, 8.5f),
+                                      glm::vec3(0.0f, 1.0f, 0.0f)), projection);
+    system.UpdateVisibility();
+    ASSERT_EQ(system.GetEnteredSections().size(), 1u);
+    ASSERT_EQ(system.GetEnteredSections()[0], 2u);
+    ASSERT_EQ(system.GetLeftSections().size(), 1u);
+    ASSERT_EQ(system.GetLeftSections()[0], 0u);
+}
+
+TEST_CASE(TestDiffSections) {
+    std::vector<uint32_t> previous = {1, 3, 5, 7};
+    std::vector<uint32_t> current = {0, 3, 4, 7, 9};
+    std::vector<uint32_t> entered;
+    std::vector<uint32_t> left;
+    blec::world::BlockSystem::DiffSections(previous, current, &entered, &left);
+
+    ASSERT_EQ(entered.size(), 3u);
+    ASSERT_EQ(entered[0], 0u);
+    ASSERT_EQ(entered[1], 4u);
+    ASSERT_EQ(entered[2], 9u);
+    ASSERT_EQ(left.size(), 2u);
+    ASSERT_EQ(left[0], 1u);
+    ASSERT_EQ(left[1], 5u);
+}
+
 TEST_MAIN()
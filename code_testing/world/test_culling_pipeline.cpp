@@ -0,0 +1,200 @@
+// code_testing/world/test_culling_pipeline.cpp
+// Unit tests for pipelined (worker thread) visibility culling
+
+#include "../test_framework.h"
+#include "world/block_system.h"
+#include "world/culling_pipeline.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using blec::world::AABB;
+using blec::world::Block;
+using blec::world::BlockSystem;
+using blec::world::CullingPipeline;
+using blec::world::CullingResult;
+using blec::world::CullingView;
+using blec::world::ViewFrustum;
+
+namespace {
+
+// Camera at a position looking down -Z with a 45 degree vertical fov
+CullingView MakeView(const glm::vec3& position, const glm::vec3& forward) {
+    return CullingView{position, glm::normalize(forward), glm::vec3(0.0f, 1.0f, 0.0f),
+                       glm::radians(45.0f), 1.0f, 0.1f, 100.0f, 0.0f, 0.0f};
+}
+
+// Grid with one block in each of two sections along X
+void SetupTwoBlocks(BlockSystem* system) {
+    system->Initialize(48, 16, 16, 1.0f);
+    system->SetBlock(8, 8, 8, Block{1});
+    system->SetBlock(40, 8, 8, Block{1});
+}
+
+} // namespace
+
+// ============================================================================
+// TEST SUITE: Prediction
+// ============================================================================
+
+TEST_CASE(TestPredictViewExtrapolatesMotion) {
+    CullingView previous = MakeView(glm::vec3(0.0f, 0.0f, 10.0f), glm::vec3(0.0f, 0.0f, -1.0f));
+    CullingView current = MakeView(glm::vec3(1.0f, 0.0f, 10.0f), glm::vec3(0.0f, 0.0f, -1.0f));
+
+    CullingView predicted = CullingPipeline::PredictView(previous, current, 0.5f);
+    ASSERT_LT(glm::length(predicted.position - glm::vec3(2.0f, 0.0f, 10.0f)), 0.001f);
+    ASSERT_GE(predicted.position_padding, 1.5f);  // Minimum plus one frame of motion
+    ASSERT_LT(predicted.angle_padding, 0.001f);   // No rotation
+}
+
+TEST_CASE(TestCoversAcceptsCameraInsidePadding) {
+    CullingView previous = MakeView(glm::vec3(0.0f, 0.0f, 10.0f), glm::vec3(0.0f, 0.0f, -1.0f));
+    CullingView current = MakeView(glm::vec3(1.0f, 0.0f, 10.0f), glm::vec3(0.1f, 0.0f, -1.0f));
+    CullingView predicted = CullingPipeline::PredictView(previous, current, 0.5f);
+
+    // Camera stopped instead of continuing: still within the padding
+    ASSERT_TRUE(CullingPipeline::Covers(predicted, current));
+
+    // Camera teleported far away: prediction must be rejected
+    CullingView teleported = MakeView(glm::vec3(30.0f, 0.0f, 10.0f), current.forward);
+    ASSERT_FALSE(CullingPipeline::Covers(predicted, teleported));
+
+    // Camera turned around: prediction must be rejected
+    CullingView turned = MakeView(current.position, glm::vec3(0.0f, 0.0f, 1.0f));
+    ASSERT_FALSE(CullingPipeline::Covers(predicted, turned));
+}
+
+TEST_CASE(TestPaddedFrustumContainsUnpadded) {
+    CullingView view = MakeView(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f));
+    CullingView padded = view;
+    padded.position_padding = 1.0f;
+    padded.angle_padding = 0.2f;
+
+    ViewFrustum tight = CullingPipeline::BuildFrustum(view);
+    ViewFrustum loose = CullingPipeline::BuildFrustum(padded);
+
+    // Just outside the tight frustum's right edge, inside the padded one
+    AABB box{glm::vec3(9.0f, -0.5f, -20.0f), glm::vec3(10.0f, 0.5f, -19.0f)};
+    ASSERT_FALSE(tight.IntersectsAABB(box));
+    ASSERT_TRUE(loose.IntersectsAABB(box));
+
+    // Box slightly behind the camera is kept by the position padding
+    AABB behind{glm::vec3(-0.2f, -0.2f, 0.2f), glm::vec3(0.2f, 0.2f, 0.6f)};
+    ASSERT_FALSE(tight.IntersectsAABB(behind));
+    ASSERT_TRUE(loose.IntersectsAABB(behind));
+}
+
+// ============================================================================
+// TEST SUITE: Culling passes
+// ============================================================================
+
+TEST_CASE(TestCullNowMatchesBlockSystem) {
+    BlockSystem system;
+    SetupTwoBlocks(&system);
+
+    // Looking at the first block only
+    CullingPipeline pipeline(system);
+    pipeline.CullNow(MakeView(glm::vec3(8.5f, 8.5f, 30.0f), glm::vec3(0.0f, 0.0f, -1.0f)));
+
+    ASSERT_TRUE(pipeline.HasResult());
+    const CullingResult& result = pipeline.GetResult();
+    ASSERT_EQ(result.visible_sections.size(), 1u);
+    ASSERT_EQ(static_cast<int32_t>(result.visible_sections[0]), system.GetSectionIndex(0, 0, 0));
+    ASSERT_EQ(result.visible_block_count, 1u);
+}
+
+TEST_CASE(TestWorkerProducesSubmittedResult) {
+    BlockSystem system;
+    SetupTwoBlocks(&system);
+
+    CullingPipeline pipeline(system);
+    ASSERT_TRUE(pipeline.Start());
+    ASSERT_TRUE(pipeline.IsRunning());
+
+    CullingView view = MakeView(glm::vec3(40.5f, 8.5f, 30.0f), glm::vec3(0.0f, 0.0f, -1.0f));
+    pipeline.Submit(view);
+    ASSERT_TRUE(pipeline.WaitForResult());
+    ASSERT_EQ(pipeline.GetResult().visible_sections.size(), 1u);
+    ASSERT_EQ(static_cast<int32_t>(pipeline.GetResult().visible_sections[0]),
+              system.GetSectionIndex(2, 0, 0));
+
+    pipeline.Stop();
+    ASSERT_FALSE(pipeline.IsRunning());
+}
+
+TEST_CASE(TestAcquireRecullsOnMisprediction) {
+    BlockSystem system;
+    SetupTwoBlocks(&system);
+
+    CullingPipeline pipeline(system);
+    pipeline.Start();
+
+    // Predicted looking at the first block, but the camera jumped to the second
+    pipeline.Submit(MakeView(glm::vec3(8.5f, 8.5f, 30.0f), glm::vec3(0.0f, 0.0f, -1.0f)));
+    const CullingResult& result =
+        pipeline.Acquire(MakeView(glm::vec3(40.5f, 8.5f, 30.0f), glm::vec3(0.0f, 0.0f, -1.0f)));
+
+    ASSERT_EQ(pipeline.GetMispredictionCount(), 1u);
+    ASSERT_EQ(result.visible_sections.size(), 1u);
+    ASSERT_EQ(static_cast<int32_t>(result.visible_sections[0]), system.GetSectionIndex(2, 0, 0));
+}
+
+TEST_CASE(TestAcquireReportsEnteredAndLeft) {
+    BlockSystem system;
+    SetupTwoBlocks(&system);
+    CullingPipeline pipeline(system);
+
+    CullingView first = MakeView(glm::vec3(8.5f, 8.5f, 30.0f), glm::vec3(0.0f, 0.0f, -1.0f));
+    ASSERT_EQ(pipeline.Acquire(first).entered_sections.size(), 1u);
+
+    CullingView second = MakeView(glm::vec3(40.5f, 8.5f, 30.0f), glm::vec3(0.0f, 0.0f, -1.0f));
+    const CullingResult& result = pipeline.Acquire(second);
+    ASSERT_EQ(result.entered_sections.size(), 1u);
+    ASSERT_EQ(static_cast<int32_t>(result.entered_sections[0]), system.GetSectionIndex(2, 0, 0));
+    ASSERT_EQ(result.left_sections.size(), 1u);
+    ASSERT_EQ(static_cast<int32_t>(result.left_sections[0]), system.GetSectionIndex(0, 0, 0));
+}
+
+TEST_CASE(TestOcclusionKeepsSectionsInsideAnglePadding) {
+    // A solid section 14 blocks ahead fills the unpadded view; a block behind
+    // it and to the side is hidden on the unpadded screen but exposed past
+    // the wall's silhouette, which lies inside the padded field of view
+    BlockSystem system;
+    system.Initialize(48, 16, 64, 1.0f);
+    for (int32_t z = 16; z < 32; ++z) {
+        for (int32_t y = 0; y < 16; ++y) {
+            for (int32_t x = 16; x < 32; ++x) {
+                system.SetBlock(x, y, z, Block{1});
+            }
+        }
+    }
+    system.SetBlock(46, 8, 33, Block{1});
+    const int32_t target = system.GetSectionIndex(2, 0, 2);
+
+    const glm::vec3 eye(24.0f, 8.0f, 2.0f);
+    CullingView predicted = MakeView(eye, glm::vec3(0.0f, 0.0f, 1.0f));
+    predicted.angle_padding = 0.2f;
+
+    CullingPipeline pipeline(system);
+    pipeline.CullNow(predicted);
+
+    // Turning toward the block within the padding reuses the predicted pass,
+    // which must already contain the section the turned camera sees
+    const float turn = 0.15f;
+    const CullingView turned = MakeView(eye, glm::vec3(std::sin(turn), 0.0f, std::cos(turn)));
+    const CullingResult& result = pipeline.Acquire(turned);
+    ASSERT_EQ(pipeline.GetMispredictionCount(), 0u);
+    const std::vector<uint32_t>& visible = result.visible_sections;
+    ASSERT_TRUE(std::find(visible.begin(), visible.end(), static_cast<uint32_t>(target)) !=
+                visible.end());
+
+    // The turned camera's own pass agrees
+    CullingPipeline reference(system);
+    reference.CullNow(turned);
+    const std::vector<uint32_t>& expected = reference.GetResult().visible_sections;
+    ASSERT_TRUE(std::find(expected.begin(), expected.end(), static_cast<uint32_t>(target)) !=
+                expected.end());
+}
+
+TEST_MAIN()
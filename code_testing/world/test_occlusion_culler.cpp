@@ -0,0 +1,184 @@
+// code_testing/world/test_occlusion_culler.cpp
+// Unit tests for software occlusion culling
+
+#include "../test_framework.h"
+#include "world/block_system.h"
+#include "world/occlusion_culler.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <vector>
+
+namespace {
+
+// Camera at (0, 0, 10) looking down -Z
+glm::mat4 MakeViewProjection(const glm::vec3& eye, const glm::vec3& target) {
+    glm::mat4 view = glm::lookAt(eye, target, glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 projection = glm::perspective(glm::radians(60.0f), 2.0f, 0.1f, 100.0f);
+    return projection * view;
+}
+
+} // namespace
+
+// ============================================================================
+// TEST SUITE: Depth Buffer and Hi-Z
+// ============================================================================
+
+TEST_CASE(TestOcclusionEmptyBufferOccludesNothing) {
+    blec::world::OcclusionCuller culler;
+    const glm::vec3 eye(0.0f, 0.0f, 10.0f);
+    culler.BeginFrame(MakeViewProjection(eye, glm::vec3(0.0f)), eye);
+    culler.BuildHierarchy();
+
+    blec::world::AABB box{{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}};
+    ASSERT_FALSE(culler.IsOccluded(box));
+    ASSERT_EQ(culler.GetDepth(0, 0), 1.0f);
+}
+
+TEST_CASE(TestOcclusionWallHidesBoxBehind) {
+    blec::world::OcclusionCuller culler;
+    const glm::vec3 eye(0.0f, 0.0f, 10.0f);
+    culler.BeginFrame(MakeViewProjection(eye, glm::vec3(0.0f)), eye);
+    culler.RasterizeOccluder(blec::world::AABB{{-20.0f, -20.0f, 0.0f}, {20.0f, 20.0f, 1.0f}});
+    culler.BuildHierarchy();
+
+    // Wall covers the whole screen, so its depth is written everywhere
+    ASSERT_LT(culler.GetDepth(128, 64), 1.0f);
+
+    blec::world::AABB behind{{-1.0f, -1.0f, -5.0f}, {1.0f, 1.0f, -4.0f}};
+    blec::world::AABB in_front{{-1.0f, -1.0f, 3.0f}, {1.0f, 1.0f, 4.0f}};
+    ASSERT_TRUE(culler.IsOccluded(behind));
+    ASSERT_FALSE(culler.IsOccluded(in_front));
+}
+
+TEST_CASE(TestOcclusionPartialCoverNotOccluded) {
+    blec::world::OcclusionCuller culler;
+    const glm::vec3 eye(0.0f, 0.0f, 10.0f);
+    culler.BeginFrame(MakeViewProjection(eye, glm::vec3(0.0f)), eye);
+    // Small pillar only hides part of the box behind it
+    culler.RasterizeOccluder(blec::world::AABB{{-0.5f, -0.5f, 0.0f}, {0.5f, 0.5f, 1.0f}});
+    culler.BuildHierarchy();
+
+    blec::world::AABB behind{{-3.0f, -3.0f, -5.0f}, {3.0f, 3.0f, -4.0f}};
+    ASSERT_FALSE(culler.IsOccluded(behind));
+}
+
+TEST_CASE(TestOcclusionBoxBehindCameraSkipped) {
+    blec::world::OcclusionCuller culler;
+    const glm::vec3 eye(0.0f, 0.0f, 10.0f);
+    culler.BeginFrame(MakeViewProjection(eye, glm::vec3(0.0f)), eye);
+    // Occluder straddling the camera plane must not be rasterized
+    culler.RasterizeOccluder(blec::world::AABB{{-20.0f, -20.0f, 5.0f}, {20.0f, 20.0f, 15.0f}});
+    culler.BuildHierarchy();
+
+    ASSERT_EQ(culler.GetDepth(128, 64), 1.0f);
+}
+
+TEST_CASE(TestOcclusionPaddingScalesWithDepth) {
+    // Wall 2 units in front of the camera ending at x = 1, a box 40 units
+    // away just inside its silhouette and a box a few units behind it
+    const blec::world::AABB wall{{-20.0f, -20.0f, 7.0f}, {1.0f, 20.0f, 8.0f}};
+    const blec::world::AABB far_box{{10.0f, -0.5f, -31.0f}, {16.0f, 0.5f, -30.0f}};
+    const blec::world::AABB near_box{{-3.0f, -0.1f, 3.0f}, {-2.8f, 0.1f, 4.0f}};
+
+    blec::world::OcclusionCuller culler;
+    const glm::vec3 eye(0.0f, 0.0f, 10.0f);
+    culler.BeginFrame(MakeViewProjection(eye, glm::vec3(0.0f)), eye);
+    culler.RasterizeOccluder(wall);
+    culler.BuildHierarchy();
+    ASSERT_TRUE(culler.IsOccluded(far_box));
+
+    // Half a unit to the side the far box comes into view
+    const glm::vec3 moved(0.5f, 0.0f, 10.0f);
+    culler.BeginFrame(MakeViewProjection(moved, glm::vec3(0.5f, 0.0f, 0.0f)), moved);
+    culler.RasterizeOccluder(wall);
+    culler.BuildHierarchy();
+    ASSERT_FALSE(culler.IsOccluded(far_box));
+
+    // A padding covering that move must keep the far box, yet still hide the
+    // box right behind the wall
+    culler.SetTestPadding(0.5f);
+    culler.BeginFrame(MakeViewProjection(eye, glm::vec3(0.0f)), eye);
+    culler.RasterizeOccluder(wall);
+    culler.BuildHierarchy();
+    ASSERT_FALSE(culler.IsOccluded(far_box));
+    ASSERT_TRUE(culler.IsOccluded(near_box));
+
+    // Once the camera could reach the wall nothing is occluded
+    culler.SetTestPadding(2.5f);
+    ASSERT_FALSE(culler.IsOccluded(near_box));
+}
+
+// ============================================================================
+// TEST SUITE: Section Culling
+// ============================================================================
+
+TEST_CASE(TestOcclusionCullSections) {
+    blec::world::BlockSystem system;
+    system.Initialize(16, 16, 48, 1.0f);
+
+    // Section z=1 is completely solid, section z=2 holds a few blocks behind it
+    for (int32_t z = 16; z < 32; ++z) {
+        for (int32_t y = 0; y < 16; ++y) {
+            for (int32_t x = 0; x < 16; ++x) {
+                system.SetBlock(x, y, z, blec::world::Block{1});
+            }
+        }
+    }
+    system.SetBlock(8, 8, 40, blec::world::Block{1});
+
+    const glm::vec3 eye(8.0f, 8.0f, -2.0f);
+    const glm::mat4 view = glm::lookAt(eye, glm::vec3(8.0f, 8.0f, 24.0f),
+                                       glm::vec3(0.0f, 1.0f, 0.0f));
+    const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 2.0f, 0.1f, 100.0f);
+    system.ExtractFrustum(view, projection);
+    system.UpdateVisibility();
+    ASSERT_EQ(system.GetVisibleSections().size(), 2u);
+
+    blec::world::OcclusionCuller culler;
+    std::vector<uint32_t> visible;
+    culler.Cull(system, projection * view, eye, system.GetVisibleSections(), &visible);
+
+    ASSERT_EQ(culler.GetTestedSectionCount(), 2u);
+    ASSERT_EQ(culler.GetOccluderCount(), 1u);
+    ASSERT_EQ(culler.GetOccludedSectionCount(), 1u);
+    ASSERT_EQ(visible.size(), 1u);
+    ASSERT_EQ(static_cast<int32_t>(visible[0]), system.GetSectionIndex(0, 0, 1));
+
+    // Punch a hole through the wall: the occluder cache must notice the edit
+    for (int32_t z = 16; z < 32; ++z) {
+        system.SetBlock(8, 8, z, blec::world::Block{0});
+    }
+    culler.Cull(system, projection * view, eye, system.GetVisibleSections(), &visible);
+    ASSERT_EQ(culler.GetOccludedSectionCount(), 0u);
+    ASSERT_EQ(visible.size(), 2u);
+}
+
+TEST_CASE(TestOcclusionMaxOccluders) {
+    blec::world::BlockSystem system;
+    system.Initialize(16, 16, 48, 1.0f);
+    for (int32_t z = 16; z < 32; ++z) {
+        for (int32_t y = 0; y < 16; ++y) {
+            for (int32_t x = 0; x < 16; ++x) {
+                system.SetBlock(x, y, z, blec::world::Block{1});
+            }
+        }
+    }
+    system.SetBlock(8, 8, 40, blec::world::Block{1});
+
+    const glm::vec3 eye(8.0f, 8.0f, -2.0f);
+    const glm::mat4 view = glm::lookAt(eye, glm::vec3(8.0f, 8.0f, 24.0f),
+                                       glm::vec3(0.0f, 1.0f, 0.0f));
+    const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 2.0f, 0.1f, 100.0f);
+    system.ExtractFrustum(view, projection);
+    system.UpdateVisibility();
+
+    // With occluders disabled nothing can be rejected
+    blec::world::OcclusionCuller culler;
+    culler.SetMaxOccluders(0);
+    std::vector<uint32_t> visible;
+    culler.Cull(system, projection * view, eye, system.GetVisibleSections(), &visible);
+    ASSERT_EQ(culler.GetOccluderCount(), 0u);
+    ASSERT_EQ(visible.size(), 2u);
+}
+
+TEST_MAIN()
@@ -0,0 +1,124 @@
+// code_testing/world/test_section_connectivity.cpp
+// Unit tests for section face connectivity and cave culling traversal
+
+#include "../test_framework.h"
+#include "world/block_system.h"
+#include "world/section_connectivity.h"
+#include <glm/glm.hpp>
+#include <vector>
+
+using blec::world::Block;
+using blec::world::BlockSystem;
+using blec::world::SectionConnectivity;
+using blec::world::SectionFace;
+
+namespace {
+
+// Fill a box of blocks (inclusive min, exclusive max)
+void FillBox(BlockSystem* system, int x0, int y0, int z0, int x1, int y1, int z1, uint8_t type) {
+    for (int z = z0; z < z1; ++z) {
+        for (int y = y0; y < y1; ++y) {
+            for (int x = x0; x < x1; ++x) {
+                system->SetBlock(x, y, z, Block{type});
+            }
+        }
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// TEST SUITE: Face Connectivity
+// ============================================================================
+
+TEST_CASE(TestConnectivityEmptySection) {
+    BlockSystem system;
+    system.Initialize(16, 16, 16, 1.0f);
+
+    uint64_t links = SectionConnectivity::ComputeFaceConnections(system, 0);
+    ASSERT_TRUE(SectionConnectivity::AreFacesConnected(links, SectionFace::NegX, SectionFace::PosX));
+    ASSERT_TRUE(SectionConnectivity::AreFacesConnected(links, SectionFace::NegY, SectionFace::PosZ));
+}
+
+TEST_CASE(TestConnectivityFullSection) {
+    BlockSystem system;
+    system.Initialize(16, 16, 16, 1.0f);
+    FillBox(&system, 0, 0, 0, 16, 16, 16, 1);
+
+    ASSERT_EQ(SectionConnectivity::ComputeFaceConnections(system, 0), 0u);
+}
+
+TEST_CASE(TestConnectivityWallSplitsSection) {
+    BlockSystem system;
+    system.Initialize(16, 16, 16, 1.0f);
+    FillBox(&system, 8, 0, 0, 9, 16, 16, 1);  // Solid YZ wall at x = 8
+
+    uint64_t links = SectionConnectivity::ComputeFaceConnections(system, 0);
+    ASSERT_FALSE(SectionConnectivity::AreFacesConnected(links, SectionFace::NegX, SectionFace::PosX));
+    ASSERT_TRUE(SectionConnectivity::AreFacesConnected(links, SectionFace::NegY, SectionFace::PosY));
+    ASSERT_TRUE(SectionConnectivity::AreFacesConnected(links, SectionFace::NegX, SectionFace::NegZ));
+    ASSERT_TRUE(SectionConnectivity::AreFacesConnected(links, SectionFace::PosX, SectionFace::PosY));
+}
+
+TEST_CASE(TestConnectivityTunnel) {
+    BlockSystem system;
+    system.Initialize(16, 16, 16, 1.0f);
+    FillBox(&system, 0, 0, 0, 16, 16, 16, 1);
+    FillBox(&system, 7, 7, 0, 8, 8, 16, 0);  // Straight tunnel along Z
+
+    uint64_t links = SectionConnectivity::ComputeFaceConnections(system, 0);
+    ASSERT_TRUE(SectionConnectivity::AreFacesConnected(links, SectionFace::NegZ, SectionFace::PosZ));
+    ASSERT_FALSE(SectionConnectivity::AreFacesConnected(links, SectionFace::NegZ, SectionFace::PosY));
+    ASSERT_FALSE(SectionConnectivity::AreFacesConnected(links, SectionFace::NegX, SectionFace::PosX));
+}
+
+// ============================================================================
+// TEST SUITE: Traversal
+// ============================================================================
+
+TEST_CASE(TestTraversalBlockedBySolidSection) {
+    BlockSystem system;
+    system.Initialize(16, 16, 48, 1.0f);
+    FillBox(&system, 0, 0, 16, 16, 16, 32, 1);  // Section z=1 fully solid
+    system.SetBlock(8, 8, 40, Block{1});         // Something in section z=2
+
+    SectionConnectivity connectivity;
+    connectivity.Traverse(system, glm::vec3(8.0f, 8.0f, 4.0f));
+
+    ASSERT_TRUE(connectivity.IsReachable(0));
+    ASSERT_TRUE(connectivity.IsReachable(1));   // Neighbor surface is visible
+    ASSERT_FALSE(connectivity.IsReachable(2));  // Nothing passes through the solid section
+    ASSERT_EQ(connectivity.GetReachableSectionCount(), 2u);
+
+    std::vector<uint32_t> candidates = {1, 2};
+    std::vector<uint32_t> reachable;
+    connectivity.FilterSections(candidates, &reachable);
+    ASSERT_EQ(reachable.size(), 1u);
+
+    // Carving a tunnel is picked up through the section revision
+    FillBox(&system, 7, 7, 16, 8, 8, 32, 0);
+    connectivity.Traverse(system, glm::vec3(8.0f, 8.0f, 4.0f));
+    ASSERT_TRUE(connectivity.IsReachable(2));
+}
+
+TEST_CASE(TestTraversalEmptyWorld) {
+    BlockSystem system;
+    system.Initialize(48, 16, 16, 1.0f);
+    SectionConnectivity connectivity;
+
+    // Camera in the middle section reaches both neighbors
+    connectivity.Traverse(system, glm::vec3(24.0f, 8.0f, 8.0f));
+    ASSERT_EQ(connectivity.GetReachableSectionCount(), 3u);
+}
+
+TEST_CASE(TestTraversalCameraOutsideGrid) {
+    BlockSystem system;
+    system.Initialize(32, 32, 32, 1.0f);
+    FillBox(&system, 0, 0, 0, 32, 32, 32, 1);
+
+    SectionConnectivity connectivity;
+    connectivity.Traverse(system, glm::vec3(-10.0f, 5.0f, 5.0f));
+    ASSERT_EQ(connectivity.GetReachableSectionCount(), system.GetSectionCount());
+}
+
+TEST_MAIN()
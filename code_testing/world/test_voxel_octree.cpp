@@ -0,0 +1,151 @@
+// code_testing/world/test_voxel_octree.cpp
+// Unit tests for the sparse voxel octree spatial index
+
+#include "../test_framework.h"
+#include "world/block_system.h"
+#include "world/voxel_octree.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <vector>
+
+using blec::world::AABB;
+using blec::world::Block;
+using blec::world::BlockSystem;
+using blec::world::RayHit;
+using blec::world::VoxelOctree;
+
+// ============================================================================
+// TEST SUITE: Construction and Updates
+// ============================================================================
+
+TEST_CASE(TestOctreeEmpty) {
+    VoxelOctree octree;
+    ASSERT_EQ(octree.GetSolidCount(), 0u);
+    ASSERT_FALSE(octree.IsSolid(0, 0, 0));
+    ASSERT_FALSE(octree.OverlapsSolid(AABB{glm::vec3(0.0f), glm::vec3(8.0f)}));
+}
+
+TEST_CASE(TestOctreeBuildFromBlocks) {
+    BlockSystem system;
+    system.Initialize(40, 20, 10, 1.0f);
+    system.SetBlock(0, 0, 0, Block{1});
+    system.SetBlock(39, 19, 9, Block{2});
+    system.SetBlock(17, 3, 5, Block{1});
+
+    VoxelOctree octree;
+    octree.Build(system);
+    ASSERT_EQ(octree.GetRootSize(), 64);
+    ASSERT_EQ(octree.GetSolidCount(), 3u);
+    ASSERT_TRUE(octree.IsSolid(39, 19, 9));
+    ASSERT_TRUE(octree.IsSolid(17, 3, 5));
+    ASSERT_FALSE(octree.IsSolid(17, 3, 6));
+}
+
+TEST_CASE(TestOctreeReleasesEmptySubtrees) {
+    VoxelOctree octree;
+    octree.SetSolid(5, 6, 7, true);
+    ASSERT_GT(octree.GetNodeCount(), 1u);
+
+    octree.SetSolid(5, 6, 7, false);
+    ASSERT_EQ(octree.GetSolidCount(), 0u);
+    ASSERT_EQ(octree.GetNodeCount(), 1u);  // Only the root remains
+}
+
+TEST_CASE(TestOctreeTracksBlockSystemEdits) {
+    BlockSystem system;
+    system.Initialize(32, 32, 32, 1.0f);
+    system.EnableSpatialIndex();
+    ASSERT_NOT_NULL(system.GetSpatialIndex());
+
+    system.SetBlock(3, 4, 5, Block{1});
+    system.SetBlock(3, 4, 5, Block{2});  // Type change keeps it solid
+    ASSERT_EQ(system.GetSpatialIndex()->GetSolidCount(), 1u);
+
+    system.SetBlock(3, 4, 5, Block{0});
+    ASSERT_FALSE(system.GetSpatialIndex()->IsSolid(3, 4, 5));
+
+    system.DisableSpatialIndex();
+    ASSERT_NULL(system.GetSpatialIndex());
+}
+
+// ============================================================================
+// TEST SUITE: Queries
+// ============================================================================
+
+TEST_CASE(TestOctreeFrustumCountMatchesScan) {
+    // Scattered blocks; the indexed count must equal the per-block scan
+    BlockSystem scanned;
+    BlockSystem indexed;
+    scanned.Initialize(48, 32, 48, 1.0f);
+    indexed.Initialize(48, 32, 48, 1.0f);
+    indexed.EnableSpatialIndex();
+    for (int z = 0; z < 48; z += 3) {
+        for (int y = 0; y < 32; y += 5) {
+            for (int x = (z + y) % 4; x < 48; x += 4) {
+                scanned.SetBlock(x, y, z, Block{1});
+                indexed.SetBlock(x, y, z, Block{1});
+            }
+        }
+    }
+
+    glm::mat4 view = glm::lookAt(glm::vec3(10.0f, 16.0f, 60.0f),
+                                 glm::vec3(30.0f, 10.0f, 10.0f),
+                                 glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 projection = glm::perspective(glm::radians(60.0f), 1.5f, 0.1f, 70.0f);
+    scanned.ExtractFrustum(view, projection);
+    indexed.ExtractFrustum(view, projection);
+    scanned.UpdateVisibility();
+    indexed.UpdateVisibility();
+
+    ASSERT_GT(scanned.GetVisibleBlockCount(), 0u);
+    ASSERT_LT(scanned.GetVisibleBlockCount(), scanned.GetTotalBlockCount());
+    ASSERT_EQ(indexed.GetVisibleBlockCount(), scanned.GetVisibleBlockCount());
+
+    std::vector<glm::ivec3> blocks;
+    indexed.GetSpatialIndex()->QueryFrustum(indexed.GetFrustum(), &blocks);
+    ASSERT_EQ(static_cast<uint32_t>(blocks.size()), scanned.GetVisibleBlockCount());
+}
+
+TEST_CASE(TestOctreeQueryAABB) {
+    VoxelOctree octree;
+    octree.SetSolid(2, 2, 2, true);
+    octree.SetSolid(6, 2, 2, true);
+
+    std::vector<glm::ivec3> blocks;
+    octree.QueryAABB(AABB{glm::vec3(1.5f), glm::vec3(4.0f)}, &blocks);
+    ASSERT_EQ(blocks.size(), 1u);
+    ASSERT_EQ(blocks[0].x, 2);
+
+    ASSERT_TRUE(octree.OverlapsSolid(AABB{glm::vec3(6.2f, 2.2f, 2.2f), glm::vec3(6.8f)}));
+    ASSERT_FALSE(octree.OverlapsSolid(AABB{glm::vec3(4.2f), glm::vec3(5.8f)}));
+}
+
+TEST_CASE(TestOctreeRaycast) {
+    VoxelOctree octree;
+    octree.SetSolid(5, 1, 1, true);
+    octree.SetSolid(7, 1, 1, true);
+
+    RayHit hit;
+    ASSERT_TRUE(octree.Raycast(glm::vec3(0.5f, 1.5f, 1.5f), glm::vec3(1.0f, 0.0f, 0.0f),
+                               100.0f, &hit));
+    ASSERT_EQ(hit.block.x, 5);
+    ASSERT_EQ(hit.normal.x, -1);
+    ASSERT_LT(std::abs(hit.distance - 4.5f), 0.001f);
+
+    // Range shorter than the first hit
+    ASSERT_FALSE(octree.Raycast(glm::vec3(0.5f, 1.5f, 1.5f), glm::vec3(1.0f, 0.0f, 0.0f),
+                                4.0f, &hit));
+
+    // Origin inside a solid block reports a zero normal
+    ASSERT_TRUE(octree.Raycast(glm::vec3(7.5f, 1.5f, 1.5f), glm::vec3(-1.0f, 0.0f, 0.0f),
+                               100.0f, &hit));
+    ASSERT_EQ(hit.block.x, 7);
+    ASSERT_EQ(hit.normal.x, 0);
+
+    // Ray passing beside the blocks
+    ASSERT_FALSE(octree.Raycast(glm::vec3(0.5f, 3.5f, 1.5f), glm::vec3(1.0f, 0.0f, 0.0f),
+                                100.0f, &hit));
+}
+
+TEST_MAIN()
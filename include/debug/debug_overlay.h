@@ -15,6 +15,7 @@ namespace input {
 }
 namespace render {
     class BitmapFont;
+    class UiCommandList;
 }
 
 namespace debug {
@@ -41,6 +42,10 @@ public:
     // Render the overlay to screen
     void Render(int screenWidth, int screenHeight, const render::BitmapFont& font, const input::InputHandler& input) const;
 
+    // Record the overlay for replay on the render thread (nothing when hidden)
+    // The commands expect a Begin2D projection, like Render
+    void Record(render::UiCommandList* commands, const input::InputHandler& input) const;
+
     // Record an error
     void RecordError(const std::string& error);
 
@@ -57,6 +62,49 @@ public:
     // Set block system information
     void SetBlockCounts(uint32_t total_blocks, uint32_t visible_blocks);
 
+    // Set section culling information
+    // visible_sections: sections that passed all culling stages
+    // occluded_sections: frustum-visible sections rejected by occlusion culling
+    void SetSectionCounts(uint32_t visible_sections, uint32_t occluded_sections);
+
+    // Set chunk mesh information
+    // rendered_faces: block faces drawn this frame
+    // faces_per_block: average emitted faces per solid block (hidden faces culled)
+    void SetMeshStats(uint32_t rendered_faces, float faces_per_block);
+
+    // Set meshing benchmark information
+    // mode: meshing algorithm name
+    // meshed_triangles: triangles across all cached section meshes
+    // build_time_ms: time spent rebuilding meshes this frame
+    void SetMeshingInfo(const std::string& mode, uint32_t meshed_triangles, double build_time_ms);
+
+    // Set GPU mesh memory information
+    // gpu_bytes: mesh data held in GPU buffers
+    // upload_bytes: mesh data uploaded this frame
+    void SetMeshMemory(size_t gpu_bytes, size_t upload_bytes);
+
+    // Set chunk arena occupancy
+    // utilization: share of the arena holding mesh data (0..1)
+    // fragmentation: share of free space outside the largest free block (0..1)
+    void SetMeshArena(float utilization, float fragmentation);
+
+    // Set draw submission statistics
+    // commands: draws executed from the render queue
+    // state_calls: GL state calls issued last frame
+    // skipped_calls: redundant GL state calls the state cache skipped
+    void SetRenderQueue(uint32_t commands, uint32_t state_calls, uint32_t skipped_calls);
+
+    // Set 2D overlay batching statistics
+    // draw_calls: draw calls the 2D batch issued last frame
+    // primitives: quads and lines they drew
+    void SetOverlayBatch(uint32_t draw_calls, uint32_t primitives);
+
+    // Set per-thread frame times
+    // simulation_ms: simulation thread time to build a frame packet
+    // render_ms: render thread time to draw the last finished packet
+    // wait_ms: time the simulation thread waited to hand its packet over
+    void SetFrameTimes(double simulation_ms, double render_ms, double wait_ms);
+
 private:
     // Build text lines for display
     std::vector<std::string> BuildDebugLines(const input::InputHandler& input) const;
@@ -75,6 +123,29 @@ private:
     uint32_t total_blocks_;
     uint32_t visible_blocks_;
 
+    // Section culling information
+    uint32_t visible_sections_;
+    uint32_t occluded_sections_;
+
+    // Chunk mesh information
+    uint32_t rendered_faces_;
+    float faces_per_block_;
+    std::string meshing_mode_;
+    uint32_t meshed_triangles_;
+    double mesh_build_time_ms_;
+    size_t mesh_gpu_bytes_;
+    size_t mesh_upload_bytes_;
+    float arena_utilization_;
+    float arena_fragmentation_;
+    uint32_t queued_commands_;
+    uint32_t state_calls_;
+    uint32_t skipped_state_calls_;
+    uint32_t overlay_draw_calls_;
+    uint32_t overlay_primitives_;
+    double simulation_time_ms_;
+    double render_time_ms_;
+    double submit_wait_ms_;
+
     // Error and warning tracking
     int error_count_;
     std::string last_error_;
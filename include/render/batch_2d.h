@@ -0,0 +1,153 @@
+// render/batch_2d.h
+// Batched drawing of 2D overlay primitives
+// Renderer's 2D functions append colored quads and lines to one vertex array
+// instead of issuing a glBegin/glEnd pair each; the array is drawn with a
+// single glDrawArrays when Renderer::End2D closes the batch or when the next
+// primitive needs different state (quads after lines, blending toggled)
+// Vertices are uploaded through the batch's own StreamBuffer, which falls
+// back to client memory without buffer objects
+// Once Initialize has built the glyph atlas, every primitive is textured
+// from it: text samples its glyph and rectangles and lines the atlas' opaque
+// cell, so text and boxes share one draw call
+
+#ifndef BLEC_RENDER_BATCH_2D_H
+#define BLEC_RENDER_BATCH_2D_H
+
+#include "render/glyph_atlas.h"
+#include "render/stream_buffer.h"
+
+#include <vector>
+#include <cstdint>
+
+namespace blec {
+namespace render {
+
+// Batched vertex: screen position, atlas coordinate and RGBA8 color (20 bytes)
+struct Batch2DVertex {
+    float x;
+    float y;
+    float u;
+    float v;
+    uint8_t color[4];
+};
+
+static_assert(sizeof(Batch2DVertex) == 20, "Batch2DVertex must stay 20 bytes");
+
+// Primitive the pending vertices form
+enum class Batch2DPrimitive {
+    Triangles,  // Quads (rectangles and glyphs), two triangles each
+    Lines
+};
+
+// Batch2D accumulates the 2D draws of one Begin2D/End2D pair
+// Outside a pair every draw is flushed immediately, as before batching
+// The application draws 2D on one thread with one context, so a single batch
+// (ForCurrentContext) serves it, like the GlStateCache
+class Batch2D {
+public:
+    Batch2D();
+    ~Batch2D() = default;
+
+    // Get the batch of the application's context
+    static Batch2D& ForCurrentContext();
+
+    // Build the glyph atlas texture (context must be current)
+    // Without it glyphs cannot be batched and primitives are untextured
+    bool Initialize();
+
+    // Check whether the glyph atlas is available
+    bool HasAtlas() const { return atlas_.IsReady(); }
+
+    // Start deferring draws until End (Renderer::Begin2D)
+    void Begin();
+
+    // Draw what is pending and stop deferring (Renderer::End2D)
+    void End();
+
+    // Check whether draws are currently deferred
+    bool IsActive() const { return active_; }
+
+    // Set the color of following primitives (RGBA, 0-1 range)
+    void SetColor(float r, float g, float b, float a);
+
+    // Append a filled rectangle at (x, y) with size (w, h)
+    void AddRect(float x, float y, float w, float h);
+
+    // Append a line from (x1, y1) to (x2, y2)
+    void AddLine(float x1, float y1, float x2, float y2);
+
+    // Append a character's glyph as one quad with its top-left at (x, y),
+    // each glyph pixel scale units wide
+    // Ignored without the atlas and for characters outside ASCII 32-126
+    void AddGlyph(float x, float y, float scale, char c);
+
+    // Draw pending vertices with one draw call and clear them
+    // Call before changing GL state the pending vertices depend on
+    void Flush();
+
+    // Delete the atlas and the upload ring (requires the context that
+    // created them)
+    void Release();
+
+    // Get vertices waiting for the next Flush
+    const std::vector<Batch2DVertex>& GetPendingVertices() const { return vertices_; }
+
+    // Get the primitive of the pending vertices
+    Batch2DPrimitive GetPrimitive() const { return primitive_; }
+
+    // Get draw calls / primitives (rectangles, glyphs and lines) since the
+    // last EndFrame
+    uint32_t GetDrawCallCount() const { return draw_calls_; }
+    uint32_t GetPrimitiveCount() const { return primitives_; }
+
+    // Get draw calls / primitives of the last finished frame
+    uint32_t GetLastFrameDrawCallCount() const { return last_draw_calls_; }
+    uint32_t GetLastFramePrimitiveCount() const { return last_primitives_; }
+
+    // Close the frame: fence the ring's spans and move the counters
+    void EndFrame();
+
+private:
+    // Switch to a primitive, flushing vertices of the other one
+    void SetPrimitive(Batch2DPrimitive primitive);
+
+    // Append one vertex in the current color
+    void Push(float x, float y, float u, float v);
+
+    // Append a quad as two triangles
+    void PushQuad(float x, float y, float w, float h, const GlyphRect& uv);
+
+    // Enable or disable the atlas texture and alpha test around a draw
+    void SetTexturing(bool enabled);
+
+    // Flush unless draws are deferred
+    void FlushIfImmediate();
+
+    // Pending geometry
+    std::vector<Batch2DVertex> vertices_;
+    Batch2DPrimitive primitive_;
+    uint8_t color_[4];
+    bool active_;
+
+    // Glyph atlas and the coordinate untextured primitives sample
+    GlyphAtlas atlas_;
+    GlyphRect solid_uv_;
+
+    // Upload ring for flushed vertices
+    StreamBuffer stream_;
+
+    // Counters
+    uint32_t draw_calls_;
+    uint32_t primitives_;
+    uint32_t last_draw_calls_;
+    uint32_t last_primitives_;
+
+    // Non-copyable
+    Batch2D(const Batch2D&) = delete;
+    Batch2D& operator=(const Batch2D&) = delete;
+};
+
+} // namespace render
+} // namespace blec
+
+#endif // BLEC_RENDER_BATCH_2D_H
@@ -0,0 +1,163 @@
+// render/block_instancer.h
+// Draws small dynamic sets of loose cubes (falling blocks, placement
+// previews, debug voxels) in one draw call
+// One unit cube is instanced with a per-instance position and type when the
+// context supports instanced arrays; otherwise the instances are expanded
+// into a single batch on the CPU, and without shaders drawn in immediate mode
+// Instance and batch vertices are rewritten every frame through the
+// renderer's StreamBuffer
+
+#ifndef BLEC_RENDER_BLOCK_INSTANCER_H
+#define BLEC_RENDER_BLOCK_INSTANCER_H
+
+#include "render/shader_manager.h"
+#include "render/stream_buffer.h"
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+
+namespace blec {
+namespace render {
+
+// Per-instance attributes (16 bytes)
+//   a_instance = (x, y, z), a_type = palette index
+struct BlockInstance {
+    float x;              // Cube center in world space
+    float y;
+    float z;
+    uint8_t palette;      // Palette index (see ChunkMesher::GetPaletteIndex)
+    uint8_t reserved[3];  // Zero; keeps instances 4-byte aligned
+};
+
+static_assert(sizeof(BlockInstance) == 16, "BlockInstance must stay 16 bytes");
+
+// Unit cube vertex: corner in [0, 1] and face index in world::SectionFace order
+struct CubeVertex {
+    float corner[3];
+    float face;
+};
+
+// Vertex of the batched fallback: a cube vertex with its instance copied in
+struct BatchVertex {
+    CubeVertex cube;
+    BlockInstance instance;
+};
+
+static_assert(sizeof(BatchVertex) == 32, "BatchVertex must stay 32 bytes");
+
+// Vertices and indices of the unit cube
+constexpr int kCubeVertexCount = 24;
+constexpr int kCubeIndexCount = 36;
+
+// How BlockInstancer draws
+enum class InstancingPath {
+    Instanced,  // One instanced draw of the shared cube (ARB_instanced_arrays)
+    Batched,    // Instances expanded into one vertex batch, one draw
+    Immediate   // No shaders or buffer objects
+};
+
+// BlockInstancer collects cubes each frame and draws them together
+// Usage per frame: Clear(), Add() each cube, Render()
+class BlockInstancer {
+public:
+    BlockInstancer();
+    ~BlockInstancer() = default;
+
+    // Remove all instances (keeps allocated storage)
+    void Clear();
+
+    // Add a cube centered at a world position
+    // type: Block type, colored like section meshes
+    void Add(const glm::vec3& center, uint8_t type);
+
+    // Replace all instances with a prepared set (e.g. from a frame packet)
+    void Assign(const std::vector<BlockInstance>& instances);
+
+    // Get number of queued instances
+    size_t GetInstanceCount() const { return instances_.size(); }
+
+    // Get queued instances
+    const std::vector<BlockInstance>& GetInstances() const { return instances_; }
+
+    // Set the edge length of every cube in world units (default 1)
+    void SetScale(float scale) { scale_ = scale; }
+
+    // Get the cube edge length
+    float GetScale() const { return scale_; }
+
+    // Draw all instances with the shared camera matrices, uploading them
+    // through stream
+    // The first call picks the path and registers the program with shaders
+    void Render(ShaderManager* shaders, StreamBuffer* stream);
+
+    // Delete GPU buffers (requires the context that created them)
+    // The program stays registered with the ShaderManager
+    void ReleaseGpuResources();
+
+    // Get the path chosen by the first Render
+    InstancingPath GetPath() const { return path_; }
+
+    // Get a display name for a path
+    static const char* GetPathName(InstancingPath path);
+
+    // Get number of draw calls issued by the last Render
+    uint32_t GetLastDrawCallCount() const { return draw_calls_; }
+
+    // Get one unit cube vertex (counter-clockwise from outside per face)
+    static const CubeVertex& GetCubeVertex(int index);
+
+    // Get one unit cube index (faces as triangles 0-1-2, 0-2-3)
+    static uint16_t GetCubeIndex(int index);
+
+    // Build the instance Add() queues for a cube centered at a world position
+    static BlockInstance MakeInstance(const glm::vec3& center, uint8_t type);
+
+    // Expand instances into cube vertices for the batched path
+    static void BuildBatchVertices(const std::vector<BlockInstance>& instances,
+                                   std::vector<BatchVertex>* vertices);
+
+private:
+    // Pick the path, build the program and create the static buffers
+    void InitializeGpu(ShaderManager* shaders);
+
+    // Draw paths
+    void RenderInstanced(StreamBuffer* stream);
+    void RenderBatched(StreamBuffer* stream);
+    void RenderImmediate() const;
+
+    // Grow the batch index buffer to hold at least cube_count cubes
+    void ReserveBatchIndices(size_t cube_count);
+
+    // Queued cubes
+    std::vector<BlockInstance> instances_;
+    float scale_;
+
+    // Chosen path and program
+    bool gpu_checked_;
+    InstancingPath path_;
+    ShaderId program_;
+    int32_t scale_location_;
+
+    // Static GL buffers (0 until created)
+    uint32_t cube_vertex_buffer_;
+    uint32_t cube_index_buffer_;
+    uint32_t batch_index_buffer_;
+    size_t batch_index_cubes_;  // Cubes the batch index buffer covers
+
+    // Staging for the batched path
+    std::vector<BatchVertex> batch_vertices_;
+    std::vector<uint32_t> batch_indices_;
+
+    // Draw calls of the last Render
+    uint32_t draw_calls_;
+
+    // Non-copyable
+    BlockInstancer(const BlockInstancer&) = delete;
+    BlockInstancer& operator=(const BlockInstancer&) = delete;
+};
+
+} // namespace render
+} // namespace blec
+
+#endif // BLEC_RENDER_BLOCK_INSTANCER_H
@@ -0,0 +1,133 @@
+// render/buffer_allocator.h
+// Sub-allocation bookkeeping for large GL buffers
+// Requests are rounded up to size classes (four per power of two) so
+// allocations that grow a little stay in place; free blocks are kept in
+// per-class lists for quick fits and coalesced by address, and compaction
+// plans moves that slide allocations toward the start of the buffer
+// Sizes and offsets are in caller-defined units (e.g. vertices); no GL calls
+
+#ifndef BLEC_RENDER_BUFFER_ALLOCATOR_H
+#define BLEC_RENDER_BUFFER_ALLOCATOR_H
+
+#include <map>
+#include <set>
+#include <vector>
+#include <cstdint>
+
+namespace blec {
+namespace render {
+
+// Offset returned when no free block fits
+constexpr uint32_t kInvalidAllocation = UINT32_MAX;
+
+// Smallest size class; smaller requests are rounded up to it
+constexpr uint32_t kMinAllocationClass = 16;
+
+// Occupancy of a BufferAllocator
+struct BufferAllocatorStats {
+    uint32_t capacity;        // Total units
+    uint32_t allocated;       // Units in allocations (class-rounded)
+    uint32_t requested;       // Units callers asked for
+    uint32_t free;            // Units in free blocks
+    uint32_t largest_free;    // Largest free block
+    uint32_t free_blocks;     // Number of free blocks
+    uint32_t allocations;     // Number of live allocations
+
+    // Share of the capacity holding requested data (0..1)
+    float GetUtilization() const;
+
+    // Share of the free space outside the largest free block (0 = one block)
+    float GetFragmentation() const;
+};
+
+// One allocation to relocate during compaction
+struct BufferMove {
+    uint32_t key;   // Owner passed to Allocate
+    uint32_t from;  // Current offset
+    uint32_t to;    // Offset of the free block it moves into
+    uint32_t size;  // Allocated units to copy
+};
+
+// BufferAllocator tracks allocations inside one linear range
+class BufferAllocator {
+public:
+    explicit BufferAllocator(uint32_t capacity = 0);
+    ~BufferAllocator() = default;
+
+    // Round a request up to its size class
+    static uint32_t GetClassSize(uint32_t size);
+
+    // Allocate at least size units for an owner key
+    // Returns the offset, or kInvalidAllocation if no free block fits (grow
+    // and retry)
+    uint32_t Allocate(uint32_t key, uint32_t size);
+
+    // Free the allocation starting at offset
+    void Free(uint32_t offset);
+
+    // Change an allocation's size without moving it
+    // Shrinking below half the class returns the tail to the free list;
+    // growing uses slack in the class or a free block right after it
+    // Returns false if the allocation must move instead
+    bool Resize(uint32_t offset, uint32_t size);
+
+    // Get the class-rounded size of the allocation at offset (0 if none)
+    uint32_t GetAllocationSize(uint32_t offset) const;
+
+    // Extend the range; the new space joins the free list
+    void Grow(uint32_t capacity);
+
+    // Free all allocations (keeps the capacity)
+    void Reset();
+
+    // Plan the next compaction step: a high allocation that fits into a
+    // free block below it
+    // Returns false if no allocation can move down
+    bool PlanCompaction(BufferMove* move) const;
+
+    // Record that a planned move was carried out
+    void ApplyMove(const BufferMove& move);
+
+    // Get occupancy statistics
+    BufferAllocatorStats GetStats() const;
+
+    // Get total units
+    uint32_t GetCapacity() const { return capacity_; }
+
+private:
+    // A live allocation
+    struct Allocation {
+        uint32_t key;
+        uint32_t size;       // Class-rounded
+        uint32_t requested;
+    };
+
+    // Get the free list index for a block or class size (-1 below the
+    // smallest class)
+    static int GetClassIndex(uint32_t size);
+
+    // Add a free block, merging it with free neighbors
+    void InsertFree(uint32_t offset, uint32_t size);
+
+    // Add a free block whose neighbors are known to be allocated
+    void AddFreeBlock(uint32_t offset, uint32_t size);
+
+    // Remove a free block from the free lists
+    void RemoveFreeBlock(std::map<uint32_t, uint32_t>::iterator block);
+
+    // Free blocks by offset, and their offsets per class
+    std::map<uint32_t, uint32_t> free_blocks_;
+    std::vector<std::set<uint32_t>> free_lists_;
+
+    // Live allocations by offset
+    std::map<uint32_t, Allocation> allocations_;
+
+    uint32_t capacity_;
+    uint32_t allocated_;
+    uint32_t requested_;
+};
+
+} // namespace render
+} // namespace blec
+
+#endif // BLEC_RENDER_BUFFER_ALLOCATOR_H
@@ -0,0 +1,144 @@
+// render/chunk_arena.h
+// Shared GPU storage for all packed section meshes
+// Each section's vertices occupy a sub-allocated range of one large vertex
+// buffer, so every visible section can be drawn with a single
+// glMultiDrawElementsBaseVertex through the shared QuadIndexBuffer
+// Vertices are stamped with their section's grid coordinates, which lets the
+// voxel shader place them without a per-section uniform
+// Ranges come from a size-class BufferAllocator; Compact() slides them
+// toward the start a few at a time with GPU-side buffer copies
+
+#ifndef BLEC_RENDER_CHUNK_ARENA_H
+#define BLEC_RENDER_CHUNK_ARENA_H
+
+#include "render/buffer_allocator.h"
+#include "render/voxel_mesh.h"
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace blec {
+namespace render {
+
+// Initial arena size in vertices (8 MiB of VoxelVertex)
+constexpr uint32_t kDefaultArenaVertices = 1u << 20;
+
+// Fragmentation (see BufferAllocatorStats) above which Compact moves ranges
+constexpr float kArenaCompactionThreshold = 0.25f;
+
+// Vertex range of one section inside the arena (count 0 = none)
+struct ArenaRange {
+    uint32_t first;  // First vertex, used as the draw's base vertex
+    uint32_t count;  // Number of vertices (four per quad)
+};
+
+// ChunkArena sub-allocates section meshes from one vertex buffer
+// A CPU copy of the whole buffer is kept so the arena can grow without
+// reading back from the GPU
+class ChunkArena {
+public:
+    explicit ChunkArena(uint32_t capacity = kDefaultArenaVertices);
+    ~ChunkArena();
+
+    // Copy a section's vertices into the arena, replacing its previous range
+    // Meshes that still fit their size class (or a free block right after
+    // it) stay in place; others move to the best-fitting free range, growing
+    // the arena if none fits
+    // key: Section index
+    // section_coord: Section grid coordinates (0..255), written to every vertex
+    // Returns bytes sent to the GPU (0 before EnableGpu)
+    size_t Store(uint32_t key, const std::vector<VoxelVertex>& vertices,
+                 const glm::ivec3& section_coord);
+
+    // Free a section's range
+    void Remove(uint32_t key);
+
+    // Free all ranges (keeps the capacity and GPU buffer)
+    void Clear();
+
+    // Get a section's range
+    ArenaRange GetRange(uint32_t key) const;
+
+    // Get the CPU copy of the whole arena
+    const std::vector<VoxelVertex>& GetVertices() const { return vertices_; }
+
+    // Get arena size in vertices
+    uint32_t GetCapacity() const { return static_cast<uint32_t>(vertices_.size()); }
+
+    // Get number of vertices in stored ranges
+    uint32_t GetUsedVertexCount() const { return allocator_.GetStats().requested; }
+
+    // Get number of disjoint free ranges
+    size_t GetFreeRangeCount() const { return allocator_.GetStats().free_blocks; }
+
+    // Get occupancy statistics in vertices
+    BufferAllocatorStats GetStats() const { return allocator_.GetStats(); }
+
+    // Move ranges toward the start while fragmentation is above
+    // kArenaCompactionThreshold, copying at most max_vertices
+    // Moves are GPU-side copies when gl::HasCopyBuffer(), otherwise uploads
+    // from the CPU copy
+    // Returns number of vertices moved
+    uint32_t Compact(uint32_t max_vertices);
+
+    // Get number of ranges moved by compaction so far
+    uint32_t GetCompactionMoveCount() const { return compaction_moves_; }
+
+    // Get number of times the arena had to grow
+    uint32_t GetGrowthCount() const { return growth_count_; }
+
+    // Create the GPU buffer from the CPU copy; later Stores update it in place
+    // Requires gl::HasBufferObjects()
+    void EnableGpu();
+
+    // Delete the GPU buffer (requires the context that created it)
+    // Ranges and the CPU copy are kept, so EnableGpu restores the contents
+    void Release();
+
+    // Check if the GPU buffer exists
+    bool IsGpuEnabled() const { return buffer_ != 0; }
+
+    // Get bytes of the GPU buffer
+    size_t GetGpuBytes() const { return gpu_bytes_; }
+
+    // Bind as the array buffer for the voxel attributes
+    void Bind() const;
+
+private:
+    // Allocate count vertices for a key, doubling the arena until they fit
+    // Returns the first vertex
+    uint32_t Allocate(uint32_t key, uint32_t count);
+
+    // Upload a span of the CPU copy unless the buffer is respecified anyway
+    // Returns bytes sent
+    size_t UploadSpan(uint32_t first, uint32_t count);
+
+    // CPU copy of the arena
+    std::vector<VoxelVertex> vertices_;
+
+    // Range bookkeeping in vertices
+    BufferAllocator allocator_;
+
+    // Ranges indexed by key
+    std::vector<ArenaRange> ranges_;
+
+    // Statistics
+    uint32_t growth_count_;
+    uint32_t compaction_moves_;
+
+    // OpenGL buffer handle (0 until EnableGpu)
+    uint32_t buffer_;
+    size_t gpu_bytes_;
+    bool grown_;  // Capacity changed since the GPU buffer was sized
+
+    // Non-copyable
+    ChunkArena(const ChunkArena&) = delete;
+    ChunkArena& operator=(const ChunkArena&) = delete;
+};
+
+} // namespace render
+} // namespace blec
+
+#endif // BLEC_RENDER_CHUNK_ARENA_H
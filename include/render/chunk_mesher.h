@@ -0,0 +1,144 @@
+// render/chunk_mesher.h
+// Builds renderable meshes from block system sections
+// Emits only faces between solid blocks and air (hidden-face culling),
+// optionally merging coplanar faces into larger quads (greedy meshing)
+
+#ifndef BLEC_RENDER_CHUNK_MESHER_H
+#define BLEC_RENDER_CHUNK_MESHER_H
+
+#include "render/face_buffer.h"
+#include "render/voxel_mesh.h"
+#include "world/block_system.h"
+
+#include <glm/glm.hpp>
+#include <cstdint>
+
+namespace blec {
+namespace render {
+
+// Meshing algorithm
+enum class MeshingMode {
+    Culled,  // One quad per visible block face
+    Greedy,  // Coplanar same-type faces merged into maximal rectangles
+    Binary   // Same quads as Greedy, built from bit-packed occupancy columns
+};
+
+// Mode used unless changed at runtime; configure with the CMake option
+// BLEC_GREEDY_MESHING
+#if defined(BLEC_GREEDY_MESHING)
+constexpr MeshingMode kDefaultMeshingMode = MeshingMode::Binary;
+#else
+constexpr MeshingMode kDefaultMeshingMode = MeshingMode::Culled;
+#endif
+
+// Statistics for one meshed section
+struct ChunkMeshStats {
+    uint32_t solid_blocks;  // Non-air blocks in the section
+    uint32_t faces;         // Quads emitted
+    double build_time_ms;   // Time spent building the mesh
+};
+
+// Copy of one section plus a one-block border (see
+// world::BlockSystem::GatherPaddedSection), enough to mesh the section
+// without touching the block system, e.g. on a worker thread
+struct SectionSnapshot {
+    uint8_t types[world::kPaddedSectionVolume];  // Padded cells, X fastest
+    uint32_t solid_blocks;                       // Non-air blocks in the section
+};
+
+// ChunkMesher turns the blocks of one section into a packed mesh in
+// section-local coordinates (the renderer adds the section origin)
+// A face is emitted only when the neighboring cell (possibly in another
+// section, or outside the grid) is air, so buried faces never reach the GPU
+// Each face corner gets an ambient occlusion level from the blocks around it
+// in front of the face; occluded faces are never merged, so their corner
+// levels interpolate over a single block
+class ChunkMesher {
+public:
+    // Build the mesh for one section, replacing the mesh contents
+    // Returns the face and block counts for statistics
+    static ChunkMeshStats BuildSectionMesh(const world::BlockSystem& blocks,
+                                           uint32_t section_index, VoxelMesh* mesh,
+                                           MeshingMode mode = kDefaultMeshingMode);
+
+    // Build one face record per emitted quad for vertex-pulling rendering
+    // Produces the same faces as BuildSectionMesh with the same mode
+    static ChunkMeshStats BuildSectionMesh(const world::BlockSystem& blocks,
+                                           uint32_t section_index, FaceBuffer* faces,
+                                           MeshingMode mode = kDefaultMeshingMode);
+
+    // Copy a section and its border cells for meshing later
+    // types is left untouched when the section is empty
+    static void CaptureSection(const world::BlockSystem& blocks, uint32_t section_index,
+                               SectionSnapshot* snapshot);
+
+    // Build from a snapshot (thread-safe; touches no shared state)
+    static ChunkMeshStats BuildSectionMesh(const SectionSnapshot& snapshot, VoxelMesh* mesh,
+                                           MeshingMode mode = kDefaultMeshingMode);
+    static ChunkMeshStats BuildSectionMesh(const SectionSnapshot& snapshot, FaceBuffer* faces,
+                                           MeshingMode mode = kDefaultMeshingMode);
+
+    // Get a display name for a meshing mode
+    static const char* GetModeName(MeshingMode mode);
+
+    // Get the mode that follows a mode, for cycling through all of them
+    static MeshingMode GetNextMode(MeshingMode mode);
+
+    // Get the base color for a block type
+    static glm::vec3 GetBlockColor(uint8_t type);
+
+    // Get the palette index stored in vertices for a block type
+    static uint8_t GetPaletteIndex(uint8_t type);
+
+    // Get number of palette entries
+    static int GetPaletteSize();
+
+    // Get the color of a palette entry
+    static glm::vec3 GetPaletteColor(int index);
+
+    // Get the brightness factor for an ambient occlusion level
+    static float GetAmbientOcclusionShade(int level);
+
+    // Get the brightness factor for a face direction (indexed like
+    // world::SectionFace), giving blocks readable shading without lighting
+    static float GetFaceShade(int face);
+
+private:
+    // Shared driver for both output formats (Output is VoxelMesh or FaceBuffer)
+    // All algorithms read the padded cells of a snapshot; cells outside the
+    // grid are air, so sections clamped by the grid need no special casing
+    template <typename Output>
+    static ChunkMeshStats Build(const SectionSnapshot& snapshot, Output* output,
+                                MeshingMode mode);
+
+    // Emit one quad per visible face
+    template <typename Output>
+    static void BuildCulled(const uint8_t* types, Output* output, ChunkMeshStats* stats);
+
+    // Sweep each face direction slice by slice and merge visible faces of
+    // the same block type into rectangles
+    template <typename Output>
+    static void BuildGreedy(const uint8_t* types, Output* output, ChunkMeshStats* stats);
+
+    // Greedy meshing on bit masks: occupancy columns along each axis give
+    // face masks with one shift and AND-NOT, and rectangles are grown with
+    // count-trailing-zeros over 16-bit face rows
+    template <typename Output>
+    static void BuildBinary(const uint8_t* types, Output* output, ChunkMeshStats* stats);
+
+    // Append a rectangle of faces (1x1 for unmerged faces)
+    // Slice, row and column are section-local along the face axis a and the
+    // in-plane axes u = (a + 1) % 3 and v = (a + 2) % 3
+    // ao: Occlusion level of each corner (nullptr = unoccluded)
+    static void EmitRectangle(int face, int32_t slice, int32_t i, int32_t j, int32_t width,
+                              int32_t height, uint8_t type, VoxelMesh* mesh,
+                              const uint8_t* ao = nullptr);
+    static void EmitRectangle(int face, int32_t slice, int32_t i, int32_t j, int32_t width,
+                              int32_t height, uint8_t type, FaceBuffer* faces,
+                              const uint8_t* ao = nullptr);
+};
+
+} // namespace render
+} // namespace blec
+
+#endif // BLEC_RENDER_CHUNK_MESHER_H
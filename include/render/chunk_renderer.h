@@ -0,0 +1,296 @@
+// render/chunk_renderer.h
+// Per-section mesh cache and drawing for the block world
+// Meshes are rebuilt only when a block inside their section or on a
+// neighboring section's border changes,
+// optionally on worker threads, and drawn from GPU buffers through the voxel
+// shaders when available; packed meshes share one ChunkArena buffer and are
+// drawn with one multi-draw call
+
+#ifndef BLEC_RENDER_CHUNK_RENDERER_H
+#define BLEC_RENDER_CHUNK_RENDERER_H
+
+#include "render/chunk_arena.h"
+#include "render/chunk_mesher.h"
+#include "render/face_buffer.h"
+#include "render/mesh_worker_pool.h"
+#include "render/quad_index_buffer.h"
+#include "render/shader_program.h"
+#include "render/voxel_mesh.h"
+#include "world/block_system.h"
+
+#include <glm/glm.hpp>
+#include <chrono>
+#include <vector>
+#include <cstdint>
+
+namespace blec {
+namespace render {
+
+// GPU upload time allowed per Render() by default, in milliseconds
+constexpr double kDefaultUploadBudgetMs = 2.0;
+
+// How section geometry is stored and drawn
+enum class ChunkRenderPath {
+    PackedVertices,  // 8-byte vertices drawn through the shared quad indices
+    VertexPulling    // One 8-byte record per face, expanded from gl_VertexID
+};
+
+// ChunkRenderer owns one mesh per section and draws the visible ones
+// Usage per frame: Update() with the visible sections, then Render() them
+class ChunkRenderer {
+public:
+    ChunkRenderer();
+    ~ChunkRenderer() = default;
+
+    // Rebuild stale meshes among the given sections
+    // A mesh is stale when its section's mesh revision moved, i.e. a block
+    // inside it or on the touching face of a neighbor was edited; several
+    // edits between two Updates cost one rebuild
+    // With workers running, stale sections are snapshotted and queued instead,
+    // and meshes finished since the last Update are adopted; a section keeps
+    // its previous mesh until the new one arrives
+    void Update(const world::BlockSystem& blocks, const std::vector<uint32_t>& sections);
+
+    // Mesh on background threads from now on
+    // thread_count: 0 = one less than the hardware threads (at least one)
+    // Returns true if the workers are running
+    bool StartWorkers(uint32_t thread_count = 0);
+
+    // Stop the workers; queued sections are rebuilt synchronously by the
+    // next Update
+    void StopWorkers();
+
+    // Check if meshing runs on worker threads
+    bool IsMeshingAsync() const { return workers_.IsRunning(); }
+
+    // Wait for all queued sections and adopt their meshes
+    void FlushWorkers();
+
+    // Get number of sections queued or being meshed on the workers
+    uint32_t GetPendingMeshCount() const { return workers_.GetPendingJobCount(); }
+
+    // Limit GPU uploads per Render to roughly this many milliseconds
+    // Sections over budget keep drawing their previous GPU copy and are
+    // uploaded in later frames; at least one upload runs per frame
+    void SetUploadBudgetMs(double budget_ms) { upload_budget_ms_ = budget_ms; }
+
+    // Get the per-frame upload budget
+    double GetUploadBudgetMs() const { return upload_budget_ms_; }
+
+    // Select the meshing algorithm; all cached meshes are rebuilt on their
+    // next Update so the two modes can be compared at runtime
+    // Sections keep drawing their old mesh until the rebuilt one is adopted
+    void SetMeshingMode(MeshingMode mode);
+
+    // Get the active meshing algorithm
+    MeshingMode GetMeshingMode() const { return mode_; }
+
+    // Select how geometry is stored and drawn; cached meshes are dropped
+    // and rebuilt in the new format on the next Update
+    // Vertex pulling needs OpenGL 3.1; without it Render switches back to
+    // packed vertices
+    void SetRenderPath(ChunkRenderPath path);
+
+    // Select a render path only when it differs from the last one asked for
+    // Callers passing the wanted path every frame keep a fallback Render
+    // chose instead of rebuilding into the unsupported path again
+    void RequestRenderPath(ChunkRenderPath path);
+
+    // Switch to packed vertices but remember the requested path
+    // Render calls this when vertex pulling is unavailable
+    void FallBackToPackedVertices();
+
+    // Get the active render path
+    ChunkRenderPath GetRenderPath() const { return render_path_; }
+
+    // Get the path last selected with SetRenderPath or RequestRenderPath
+    ChunkRenderPath GetRequestedRenderPath() const { return requested_render_path_; }
+
+    // Get a display name for a render path
+    static const char* GetRenderPathName(ChunkRenderPath path);
+
+    // Draw the meshes of the given sections
+    // view_projection: Camera matrices concatenated on the CPU (see
+    // Renderer::GetViewProjection)
+    // Packed meshes are drawn from the arena with one
+    // glMultiDrawElementsBaseVertex; without it, one glDrawElements per section
+    // re-points the attributes into the same buffer
+    // Stale GPU copies are uploaded first; without buffer object and shader
+    // support the geometry is decoded on the CPU in immediate mode with the
+    // fixed-function matrices the renderer loads in that case
+    void Render(const std::vector<uint32_t>& sections, const glm::mat4& view_projection);
+
+    // Delete the shaders and all GPU mesh buffers
+    // Call before the GL context is destroyed
+    void ReleaseGpuResources();
+
+    // Check if the last Render used the GPU buffer path
+    bool IsUsingGpuPath() const { return gpu_path_; }
+
+    // Get number of draw calls issued by the last Render
+    uint32_t GetLastDrawCallCount() const { return draw_calls_; }
+
+    // Get the shared storage of packed section meshes
+    const ChunkArena& GetArena() const { return arena_; }
+
+    // Get number of meshes rebuilt (or adopted from the workers) by the last
+    // Update
+    uint32_t GetRebuiltSectionCount() const { return rebuilt_sections_; }
+
+    // Get total mesh build time of the last Update in milliseconds (worker
+    // time for adopted meshes)
+    double GetLastBuildTimeMs() const { return build_time_ms_; }
+
+    // Get number of faces drawn by the last Render
+    uint32_t GetRenderedFaceCount() const { return rendered_faces_; }
+
+    // Get total faces across all meshed sections
+    uint32_t GetMeshedFaceCount() const { return meshed_faces_; }
+
+    // Get bytes of mesh data currently held in GPU buffers (including the
+    // arena's free space and the shared quad index buffer)
+    size_t GetGpuMeshBytes() const {
+        return gpu_bytes_ + arena_.GetGpuBytes() + quad_indices_.GetGpuBytes();
+    }
+
+    // Get bytes uploaded to GPU buffers by the last Render
+    size_t GetLastUploadBytes() const { return upload_bytes_; }
+
+    // Get total triangles across all meshed sections
+    uint32_t GetMeshedTriangleCount() const { return meshed_faces_ * 2; }
+
+    // Get average emitted faces per solid block across all meshed sections
+    // (6 for isolated blocks, far lower for solid terrain)
+    float GetFacesPerBlock() const;
+
+    // Get cached mesh of a section (empty if never meshed or when vertex
+    // pulling is active)
+    const VoxelMesh& GetSectionMesh(uint32_t section_index) const {
+        return entries_[section_index].mesh;
+    }
+
+    // Get cached face records of a section (empty unless vertex pulling is
+    // active)
+    const FaceBuffer& GetSectionFaces(uint32_t section_index) const {
+        return entries_[section_index].faces;
+    }
+
+private:
+    // Cached mesh for one section
+    struct SectionEntry {
+        VoxelMesh mesh;                      // Geometry for PackedVertices
+        FaceBuffer faces;                    // Geometry for VertexPulling
+        glm::vec3 origin;                    // World position of the section's min corner
+        glm::ivec3 coord;                    // Section grid coordinates
+        bool valid;                          // Whether the mesh was built
+        bool arena_stale;                    // Mesh changed since it was stored in the arena
+        uint32_t revision;                   // Mesh revision the mesh was built from
+        uint32_t mode_generation;            // Meshing mode generation it was built with
+        ChunkMeshStats stats;                // Stats of the cached mesh
+        uint64_t pending_version;            // Version of the queued build (0 = none)
+        uint32_t pending_revision;           // Mesh revision it was queued with
+    };
+
+    // Shader program with its per-draw uniform locations
+    struct VoxelProgram {
+        ShaderProgram program;
+        int32_t origin_location;
+        int32_t block_size_location;
+        int32_t view_projection_location;
+    };
+
+    // Adopt a finished worker mesh unless its section was queued again since
+    // (or the mode or render path changed), in which case it is stale
+    void ApplyResult(MeshResult* result);
+
+    // Forget all queued builds so their results are discarded
+    void DiscardPendingBuilds();
+
+    // Switch the active render path, dropping geometry of the old format
+    void ApplyRenderPath(ChunkRenderPath path);
+
+    // Compile the voxel shaders once buffer and shader support is known
+    void InitializeGpu();
+
+    // Build a voxel program and upload its constant uniforms
+    static bool BuildProgram(const char* vertex_source, const char* fragment_source,
+                             VoxelProgram* program);
+
+    // Upload a stale face buffer within the frame's budget, keeping the
+    // memory statistics current (packed meshes go through StoreIfStale)
+    void UploadIfStale(FaceBuffer* faces);
+
+    // Copy a changed packed mesh into the arena within the frame's budget
+    void StoreIfStale(uint32_t section, SectionEntry* entry);
+
+    // Check if the current Render may upload more
+    bool HasUploadBudget() const;
+
+    // Draw the visible packed meshes from the arena
+    void RenderArena(const std::vector<uint32_t>& sections);
+
+    // Draw one section by decoding its geometry in immediate mode
+    void RenderImmediate(const SectionEntry& entry) const;
+
+    // Per-section cache (indexed by section index)
+    std::vector<SectionEntry> entries_;
+
+    // Block edge length in world units (from the last Update)
+    float block_size_;
+
+    // World position of section (0, 0, 0)'s min corner (from the last Update)
+    glm::vec3 world_origin_;
+
+    // GPU path state
+    VoxelProgram packed_program_;
+    VoxelProgram pulling_program_;
+    QuadIndexBuffer quad_indices_;  // Shared by all packed meshes
+    ChunkArena arena_;              // Vertices of all packed meshes
+    bool gpu_checked_;     // Whether InitializeGpu ran
+    bool gpu_path_;        // Whether meshes are drawn from GPU buffers
+    bool multi_draw_;      // Whether glMultiDrawElementsBaseVertex is available
+
+    // Multi-draw arguments, rebuilt every Render
+    std::vector<int32_t> draw_counts_;
+    std::vector<const void*> draw_offsets_;
+    std::vector<int32_t> draw_base_vertices_;
+
+    // Active render path, and the one last asked for (differs after a
+    // fallback)
+    ChunkRenderPath render_path_;
+    ChunkRenderPath requested_render_path_;
+
+    // Active meshing algorithm, and a counter bumped on every switch so
+    // meshes of the previous mode are rebuilt while staying drawable
+    MeshingMode mode_;
+    uint32_t mode_generation_;
+
+    // Background meshing
+    MeshWorkerPool workers_;
+    std::vector<MeshResult> results_;  // Reused between Updates
+    uint64_t last_version_;            // Version of the last queued build
+
+    // Upload budget of the current Render
+    double upload_budget_ms_;
+    std::chrono::steady_clock::time_point upload_deadline_;
+    uint32_t frame_uploads_;
+
+    // Statistics
+    uint32_t draw_calls_;
+    uint32_t rebuilt_sections_;
+    double build_time_ms_;
+    uint32_t rendered_faces_;
+    uint32_t meshed_faces_;
+    uint32_t meshed_blocks_;
+    size_t gpu_bytes_;
+    size_t upload_bytes_;
+
+    // Non-copyable
+    ChunkRenderer(const ChunkRenderer&) = delete;
+    ChunkRenderer& operator=(const ChunkRenderer&) = delete;
+};
+
+} // namespace render
+} // namespace blec
+
+#endif // BLEC_RENDER_CHUNK_RENDERER_H
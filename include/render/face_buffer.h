@@ -0,0 +1,115 @@
+// render/face_buffer.h
+// One packed record per visible face for vertex-pulling rendering
+// The vertex shader fetches a record per gl_VertexID / 6 from a buffer
+// texture and expands it into the quad's corners, so no vertex or index
+// buffers are needed
+
+#ifndef BLEC_RENDER_FACE_BUFFER_H
+#define BLEC_RENDER_FACE_BUFFER_H
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+
+namespace blec {
+namespace render {
+
+// Packed face (8 bytes, fetched as one RG32UI texel)
+// geometry: bits 0-3 x, 4-7 y, 8-11 z (section-local cell of the face's
+//           minimum corner), 12-14 face index (world::SectionFace order),
+//           15-18 width - 1 along u, 19-22 height - 1 along v, where
+//           u = (face / 2 + 1) % 3 and v = (face / 2 + 2) % 3
+// material: bits 0-7 palette index, bits 8-15 ambient occlusion level of
+//           each corner (2 bits per corner, corner 0 lowest)
+struct FaceRecord {
+    uint32_t geometry;
+    uint32_t material;
+};
+
+static_assert(sizeof(FaceRecord) == 8, "FaceRecord must stay 8 bytes");
+
+// Vertices generated per face (two triangles, no index buffer)
+constexpr int kVerticesPerFace = 6;
+
+// FaceBuffer holds the face records of one section and their GPU copy
+class FaceBuffer {
+public:
+    FaceBuffer();
+    ~FaceBuffer();
+
+    // Move support for storing buffers in containers
+    FaceBuffer(FaceBuffer&& other) noexcept;
+    FaceBuffer& operator=(FaceBuffer&& other) noexcept;
+
+    // Remove all faces (keeps allocated storage and GPU objects)
+    void Clear();
+
+    // Replace the records with those of another buffer, leaving it empty
+    // Keeps this buffer's GPU objects, which draw their old contents until
+    // the next Upload
+    void TakeGeometry(FaceBuffer* source);
+
+    // Append a face
+    // cell: Section-local cell at the face's minimum corner (0..15 per axis)
+    // face: Index in world::SectionFace order
+    // width, height: Extent along the in-plane axes u and v (1..16)
+    // color: Palette index
+    // ao: Ambient occlusion level of each corner (nullptr = unoccluded)
+    void AddFace(const glm::ivec3& cell, int face, int32_t width, int32_t height,
+                 uint8_t color, const uint8_t* ao = nullptr);
+
+    // Get face records
+    const std::vector<FaceRecord>& GetFaces() const { return faces_; }
+
+    // Get number of faces
+    size_t GetFaceCount() const { return faces_.size(); }
+
+    // Copy the records into a buffer texture, creating it on first use
+    // Requires gl::HasTextureBuffers()
+    void Upload();
+
+    // Delete the GPU objects (requires the context that created them)
+    void Release();
+
+    // Check if the GPU copy matches the CPU records
+    bool IsUploaded() const { return uploaded_; }
+
+    // Get bytes of the GPU copy
+    size_t GetGpuBytes() const { return gpu_bytes_; }
+
+    // Draw the uploaded faces with the vertex-pulling shader bound
+    // Binds the buffer texture to texture unit 0
+    void Draw() const;
+
+    // Expand one generated vertex the way the vertex shader does
+    // vertex: Index in [0, kVerticesPerFace)
+    // Returns the section-local corner position
+    static glm::ivec3 ExpandCorner(const FaceRecord& record, int vertex);
+
+    // Decode the fields of a record
+    static int DecodeFace(const FaceRecord& record);
+    static uint8_t DecodeColor(const FaceRecord& record);
+    static int DecodeAmbientOcclusion(const FaceRecord& record, int vertex);
+
+private:
+    // Face data
+    std::vector<FaceRecord> faces_;
+
+    // OpenGL handles (0 until uploaded)
+    uint32_t buffer_;
+    uint32_t texture_;
+
+    // Upload state
+    bool uploaded_;
+    size_t gpu_bytes_;
+    size_t gpu_face_count_;
+
+    // Non-copyable
+    FaceBuffer(const FaceBuffer&) = delete;
+    FaceBuffer& operator=(const FaceBuffer&) = delete;
+};
+
+} // namespace render
+} // namespace blec
+
+#endif // BLEC_RENDER_FACE_BUFFER_H
@@ -1,6 +1,8 @@
 // font.h
 // Bitmap font rendering for debug text display
 // Uses 5x7 pixel font for ASCII characters 32-126
+// Characters are drawn as one quad from the glyph atlas when the 2D batch
+// has one, otherwise pixel by pixel
 
 #ifndef BLEC_FONT_H
 #define BLEC_FONT_H
@@ -19,6 +21,7 @@ public:
 
     // Draw a single character at screen position (x, y) with given scale
     // Characters outside ASCII 32-126 are ignored
+    // Batched like Renderer::DrawFilledRect
     void DrawChar(float x, float y, float scale, char c) const;
 
     // Draw a text string at screen position (x, y) with given scale
@@ -31,6 +34,10 @@ public:
     // Get the height of a single character in pixels
     static constexpr float GetCharHeight(float scale) { return 8.0f * scale; }
 
+    // Get the 5 column bytes of a character's glyph (bit 0 is the top row)
+    // Returns nullptr for characters outside ASCII 32-126
+    static const unsigned char* GetGlyph(char c);
+
 private:
     // 5x7 bitmap font data for ASCII 32-126 (95 characters)
     // Each character is 5 bytes, each byte is a column of 7 pixels
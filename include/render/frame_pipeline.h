@@ -0,0 +1,133 @@
+// render/frame_pipeline.h
+// Double-buffered hand-off of frames from the simulation thread to the
+// render thread
+// The simulation thread fills a FramePacket (camera matrices, visible
+// sections, loose cubes and recorded 2D commands) and submits it; the render
+// thread, which owns the GL context, draws it while the simulation thread
+// already fills the other packet for the next frame
+// A submitted packet is never written again until the render thread has
+// released it, so the render thread reads it without locking
+
+#ifndef BLEC_RENDER_FRAME_PIPELINE_H
+#define BLEC_RENDER_FRAME_PIPELINE_H
+
+#include "render/block_instancer.h"
+#include "render/chunk_mesher.h"
+#include "render/chunk_renderer.h"
+#include "render/ui_command_list.h"
+
+#include <glm/glm.hpp>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace blec {
+namespace render {
+
+// Everything the render thread needs to draw one frame
+struct FramePacket {
+    uint64_t frame_index;                   // Set by Submit
+    int framebuffer_width;
+    int framebuffer_height;
+    glm::mat4 view;
+    glm::mat4 projection;
+    float fov_y_degrees;                    // Vertical field of view of projection
+    std::vector<uint32_t> visible_sections; // Culled section list, sorted by index
+    std::vector<BlockInstance> cubes;       // Loose cubes for the BlockInstancer
+    float cube_scale;                       // Edge length of every loose cube
+    MeshingMode meshing_mode;               // Applied to the ChunkRenderer before drawing
+    ChunkRenderPath render_path;
+    UiCommandList ui;                       // 2D overlay, replayed after the 3D scene
+};
+
+// Render thread statistics of a finished frame, read back for the overlay
+struct FrameStats {
+    uint64_t frame_index;
+    uint32_t rendered_faces;
+    float faces_per_block;
+    std::string meshing_name;
+    ChunkRenderPath render_path;            // Path actually drawn with (after any fallback)
+    uint32_t meshed_triangles;
+    double mesh_build_time_ms;
+    size_t mesh_gpu_bytes;
+    size_t mesh_upload_bytes;
+    float arena_utilization;
+    float arena_fragmentation;
+    uint32_t flushed_commands;
+    uint32_t state_calls;
+    uint32_t skipped_state_calls;
+    uint32_t overlay_draw_calls;            // Batch2D draw calls of the 2D overlay
+    uint32_t overlay_primitives;            // Quads and lines in them
+    double render_time_ms;                  // Render thread time from acquire to release
+};
+
+// FramePipeline hands packets between exactly one producer (simulation)
+// thread and one consumer (render) thread
+// Producer per frame: fill GetWritePacket(), then Submit()
+// Consumer loop: AcquirePacket() until it returns nullptr, draw, ReleasePacket()
+class FramePipeline {
+public:
+    FramePipeline();
+    ~FramePipeline() = default;
+
+    // Get the packet the simulation thread fills for the next frame
+    // Valid until the next Submit
+    FramePacket& GetWritePacket() { return packets_[write_index_]; }
+
+    // Hand the write packet to the render thread
+    // Blocks while the render thread still draws the other packet, so the
+    // simulation runs at most one frame ahead
+    void Submit();
+
+    // Block until a submitted packet is available (render thread)
+    // Returns nullptr once Stop() was called and every packet is drawn
+    const FramePacket* AcquirePacket();
+
+    // Finish the acquired packet and publish its statistics (render thread)
+    void ReleasePacket(const FrameStats& stats);
+
+    // Block until every submitted packet has been drawn
+    // Call before modifying data the render thread reads (block edits)
+    void WaitForIdle();
+
+    // Let AcquirePacket return nullptr after the remaining packets
+    void Stop();
+
+    // Get statistics of the most recently released frame
+    FrameStats GetStats() const;
+
+    // Get number of packets submitted so far
+    uint64_t GetSubmittedCount() const { return submitted_; }
+
+    // Get time the last Submit spent waiting for the render thread
+    double GetLastSubmitWaitMs() const { return submit_wait_ms_; }
+
+private:
+    // Both packets: the simulation writes one while the render thread reads
+    // the other
+    FramePacket packets_[2];
+    int write_index_;
+    uint64_t submitted_;
+    double submit_wait_ms_;
+
+    // Hand-off state (guarded by mutex_)
+    mutable std::mutex mutex_;
+    std::condition_variable packet_ready_;
+    std::condition_variable packet_done_;
+    int ready_index_;   // Submitted packet waiting for the render thread, or -1
+    bool rendering_;    // The render thread holds a packet
+    bool stop_;
+    FrameStats stats_;
+
+    // Non-copyable
+    FramePipeline(const FramePipeline&) = delete;
+    FramePipeline& operator=(const FramePipeline&) = delete;
+};
+
+} // namespace render
+} // namespace blec
+
+#endif // BLEC_RENDER_FRAME_PIPELINE_H
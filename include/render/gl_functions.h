@@ -0,0 +1,284 @@
+// render/gl_functions.h
+// OpenGL entry points beyond version 1.1, loaded at runtime
+// The system GL headers only guarantee 1.1 on every platform, so buffer and
+// shader functions are resolved through GLFW once a context exists
+
+#ifndef BLEC_RENDER_GL_FUNCTIONS_H
+#define BLEC_RENDER_GL_FUNCTIONS_H
+
+#include <GLFW/glfw3.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_WIN32)
+#define BLEC_GLAPIENTRY __stdcall
+#else
+#define BLEC_GLAPIENTRY
+#endif
+
+// Constants from OpenGL 1.3 through 3.1 missing from 1.1 headers
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER 0x8892
+#endif
+#ifndef GL_ELEMENT_ARRAY_BUFFER
+#define GL_ELEMENT_ARRAY_BUFFER 0x8893
+#endif
+#ifndef GL_STATIC_DRAW
+#define GL_STATIC_DRAW 0x88E4
+#endif
+#ifndef GL_DYNAMIC_DRAW
+#define GL_DYNAMIC_DRAW 0x88E8
+#endif
+#ifndef GL_FRAGMENT_SHADER
+#define GL_FRAGMENT_SHADER 0x8B30
+#endif
+#ifndef GL_VERTEX_SHADER
+#define GL_VERTEX_SHADER 0x8B31
+#endif
+#ifndef GL_COMPILE_STATUS
+#define GL_COMPILE_STATUS 0x8B81
+#endif
+#ifndef GL_LINK_STATUS
+#define GL_LINK_STATUS 0x8B82
+#endif
+#ifndef GL_INFO_LOG_LENGTH
+#define GL_INFO_LOG_LENGTH 0x8B84
+#endif
+#ifndef GL_TEXTURE0
+#define GL_TEXTURE0 0x84C0
+#endif
+#ifndef GL_TEXTURE_BUFFER
+#define GL_TEXTURE_BUFFER 0x8C2A
+#endif
+#ifndef GL_RG32UI
+#define GL_RG32UI 0x823C
+#endif
+#ifndef GL_STREAM_DRAW
+#define GL_STREAM_DRAW 0x88E0
+#endif
+#ifndef GL_COPY_READ_BUFFER
+#define GL_COPY_READ_BUFFER 0x8F36
+#endif
+#ifndef GL_COPY_WRITE_BUFFER
+#define GL_COPY_WRITE_BUFFER 0x8F37
+#endif
+
+// Constants for mapped buffer ranges (3.0), sync objects (3.2) and immutable
+// buffer storage (4.4)
+#ifndef GL_MAP_WRITE_BIT
+#define GL_MAP_WRITE_BIT 0x0002
+#endif
+#ifndef GL_MAP_INVALIDATE_RANGE_BIT
+#define GL_MAP_INVALIDATE_RANGE_BIT 0x0004
+#endif
+#ifndef GL_MAP_UNSYNCHRONIZED_BIT
+#define GL_MAP_UNSYNCHRONIZED_BIT 0x0020
+#endif
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+#ifndef GL_MAP_COHERENT_BIT
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#endif
+#ifndef GL_ALREADY_SIGNALED
+#define GL_ALREADY_SIGNALED 0x911A
+#endif
+#ifndef GL_CONDITION_SATISFIED
+#define GL_CONDITION_SATISFIED 0x911C
+#endif
+#ifndef GL_WAIT_FAILED
+#define GL_WAIT_FAILED 0x911D
+#endif
+
+namespace blec {
+namespace render {
+namespace gl {
+
+// Opaque fence handle (GLsync in the specification)
+struct SyncObject;
+using Sync = SyncObject*;
+
+// Function pointer types (signatures as in the OpenGL specification)
+using GenBuffersProc = void (BLEC_GLAPIENTRY*)(GLsizei n, GLuint* buffers);
+using DeleteBuffersProc = void (BLEC_GLAPIENTRY*)(GLsizei n, const GLuint* buffers);
+using BindBufferProc = void (BLEC_GLAPIENTRY*)(GLenum target, GLuint buffer);
+using BufferDataProc = void (BLEC_GLAPIENTRY*)(GLenum target, std::ptrdiff_t size,
+                                               const void* data, GLenum usage);
+using BufferSubDataProc = void (BLEC_GLAPIENTRY*)(GLenum target, std::ptrdiff_t offset,
+                                                  std::ptrdiff_t size, const void* data);
+using CreateShaderProc = GLuint (BLEC_GLAPIENTRY*)(GLenum type);
+using DeleteShaderProc = void (BLEC_GLAPIENTRY*)(GLuint shader);
+using ShaderSourceProc = void (BLEC_GLAPIENTRY*)(GLuint shader, GLsizei count,
+                                                 const char* const* strings,
+                                                 const GLint* lengths);
+using CompileShaderProc = void (BLEC_GLAPIENTRY*)(GLuint shader);
+using GetShaderivProc = void (BLEC_GLAPIENTRY*)(GLuint shader, GLenum pname, GLint* params);
+using GetShaderInfoLogProc = void (BLEC_GLAPIENTRY*)(GLuint shader, GLsizei max_length,
+                                                     GLsizei* length, char* log);
+using CreateProgramProc = GLuint (BLEC_GLAPIENTRY*)();
+using DeleteProgramProc = void (BLEC_GLAPIENTRY*)(GLuint program);
+using AttachShaderProc = void (BLEC_GLAPIENTRY*)(GLuint program, GLuint shader);
+using BindAttribLocationProc = void (BLEC_GLAPIENTRY*)(GLuint program, GLuint index,
+                                                       const char* name);
+using LinkProgramProc = void (BLEC_GLAPIENTRY*)(GLuint program);
+using GetProgramivProc = void (BLEC_GLAPIENTRY*)(GLuint program, GLenum pname, GLint* params);
+using GetProgramInfoLogProc = void (BLEC_GLAPIENTRY*)(GLuint program, GLsizei max_length,
+                                                      GLsizei* length, char* log);
+using UseProgramProc = void (BLEC_GLAPIENTRY*)(GLuint program);
+using GetUniformLocationProc = GLint (BLEC_GLAPIENTRY*)(GLuint program, const char* name);
+using Uniform1iProc = void (BLEC_GLAPIENTRY*)(GLint location, GLint v0);
+using Uniform1fProc = void (BLEC_GLAPIENTRY*)(GLint location, GLfloat v0);
+using Uniform3fProc = void (BLEC_GLAPIENTRY*)(GLint location, GLfloat v0, GLfloat v1,
+                                              GLfloat v2);
+using Uniform1fvProc = void (BLEC_GLAPIENTRY*)(GLint location, GLsizei count,
+                                               const GLfloat* values);
+using Uniform3fvProc = void (BLEC_GLAPIENTRY*)(GLint location, GLsizei count,
+                                               const GLfloat* values);
+using UniformMatrix4fvProc = void (BLEC_GLAPIENTRY*)(GLint location, GLsizei count,
+                                                     GLboolean transpose, const GLfloat* values);
+using EnableVertexAttribArrayProc = void (BLEC_GLAPIENTRY*)(GLuint index);
+using DisableVertexAttribArrayProc = void (BLEC_GLAPIENTRY*)(GLuint index);
+using VertexAttribPointerProc = void (BLEC_GLAPIENTRY*)(GLuint index, GLint size, GLenum type,
+                                                        GLboolean normalized, GLsizei stride,
+                                                        const void* pointer);
+using ActiveTextureProc = void (BLEC_GLAPIENTRY*)(GLenum texture);
+using TexBufferProc = void (BLEC_GLAPIENTRY*)(GLenum target, GLenum internal_format,
+                                              GLuint buffer);
+using VertexAttribDivisorProc = void (BLEC_GLAPIENTRY*)(GLuint index, GLuint divisor);
+using DrawElementsInstancedProc = void (BLEC_GLAPIENTRY*)(GLenum mode, GLsizei count,
+                                                          GLenum type, const void* indices,
+                                                          GLsizei instance_count);
+using MultiDrawElementsBaseVertexProc = void (BLEC_GLAPIENTRY*)(GLenum mode,
+                                                                const GLsizei* counts,
+                                                                GLenum type,
+                                                                const void* const* indices,
+                                                                GLsizei draw_count,
+                                                                const GLint* base_vertices);
+using CopyBufferSubDataProc = void (BLEC_GLAPIENTRY*)(GLenum read_target, GLenum write_target,
+                                                      std::ptrdiff_t read_offset,
+                                                      std::ptrdiff_t write_offset,
+                                                      std::ptrdiff_t size);
+using MapBufferRangeProc = void* (BLEC_GLAPIENTRY*)(GLenum target, std::ptrdiff_t offset,
+                                                    std::ptrdiff_t length, GLbitfield access);
+using UnmapBufferProc = GLboolean (BLEC_GLAPIENTRY*)(GLenum target);
+using BufferStorageProc = void (BLEC_GLAPIENTRY*)(GLenum target, std::ptrdiff_t size,
+                                                  const void* data, GLbitfield flags);
+using FenceSyncProc = Sync (BLEC_GLAPIENTRY*)(GLenum condition, GLbitfield flags);
+using ClientWaitSyncProc = GLenum (BLEC_GLAPIENTRY*)(Sync sync, GLbitfield flags,
+                                                     uint64_t timeout);
+using DeleteSyncProc = void (BLEC_GLAPIENTRY*)(Sync sync);
+
+// Buffer objects (OpenGL 1.5)
+extern GenBuffersProc GenBuffers;
+extern DeleteBuffersProc DeleteBuffers;
+extern BindBufferProc BindBuffer;
+extern BufferDataProc BufferData;
+extern BufferSubDataProc BufferSubData;
+
+// Shaders and programs (OpenGL 2.0)
+extern CreateShaderProc CreateShader;
+extern DeleteShaderProc DeleteShader;
+extern ShaderSourceProc ShaderSource;
+extern CompileShaderProc CompileShader;
+extern GetShaderivProc GetShaderiv;
+extern GetShaderInfoLogProc GetShaderInfoLog;
+extern CreateProgramProc CreateProgram;
+extern DeleteProgramProc DeleteProgram;
+extern AttachShaderProc AttachShader;
+extern BindAttribLocationProc BindAttribLocation;
+extern LinkProgramProc LinkProgram;
+extern GetProgramivProc GetProgramiv;
+extern GetProgramInfoLogProc GetProgramInfoLog;
+extern UseProgramProc UseProgram;
+extern GetUniformLocationProc GetUniformLocation;
+extern Uniform1iProc Uniform1i;
+extern Uniform1fProc Uniform1f;
+extern Uniform3fProc Uniform3f;
+extern Uniform1fvProc Uniform1fv;
+extern Uniform3fvProc Uniform3fv;
+extern UniformMatrix4fvProc UniformMatrix4fv;
+
+// Generic vertex attributes (OpenGL 2.0)
+extern EnableVertexAttribArrayProc EnableVertexAttribArray;
+extern DisableVertexAttribArrayProc DisableVertexAttribArray;
+extern VertexAttribPointerProc VertexAttribPointer;
+
+// Texture buffers (OpenGL 1.3 multitexture, OpenGL 3.1 buffer textures)
+extern ActiveTextureProc ActiveTexture;
+extern TexBufferProc TexBuffer;
+
+// Instanced drawing (OpenGL 3.3 core, or ARB_instanced_arrays on 2.1)
+extern VertexAttribDivisorProc VertexAttribDivisor;
+extern DrawElementsInstancedProc DrawElementsInstanced;
+
+// Multi-draw with per-draw base vertices (OpenGL 3.2 core, or
+// ARB_draw_elements_base_vertex on 2.1)
+extern MultiDrawElementsBaseVertexProc MultiDrawElementsBaseVertex;
+
+// Buffer-to-buffer copies (OpenGL 3.1 core, or ARB_copy_buffer on 2.1)
+extern CopyBufferSubDataProc CopyBufferSubData;
+
+// Mapping buffer ranges (OpenGL 3.0 core, or ARB_map_buffer_range on 2.1)
+extern MapBufferRangeProc MapBufferRange;
+extern UnmapBufferProc UnmapBuffer;
+
+// Fences (OpenGL 3.2 core, or ARB_sync on 2.1)
+extern FenceSyncProc FenceSync;
+extern ClientWaitSyncProc ClientWaitSync;
+extern DeleteSyncProc DeleteSync;
+
+// Immutable storage that can stay mapped (OpenGL 4.4 core, or
+// ARB_buffer_storage)
+extern BufferStorageProc BufferStorage;
+
+// Resolve all entry points from the current context
+// Returns true if both buffer objects and shaders are available
+bool LoadFunctions();
+
+// Check whether buffer object functions were loaded
+bool HasBufferObjects();
+
+// Check whether shader and vertex attribute functions were loaded
+bool HasShaders();
+
+// Check whether buffer textures, integer texel fetches and gl_VertexID are
+// available (OpenGL 3.1 / GLSL 1.40, compatibility contexts included)
+bool HasTextureBuffers();
+
+// Check whether per-instance vertex attributes and instanced draws are
+// available (core in OpenGL 3.3, otherwise through ARB_instanced_arrays)
+bool HasInstancing();
+
+// Check whether many indexed draws with their own base vertex can be issued
+// in one call (core in OpenGL 3.2, otherwise through
+// ARB_draw_elements_base_vertex)
+bool HasMultiDrawBaseVertex();
+
+// Check whether buffer contents can be copied on the GPU (core in OpenGL
+// 3.1, otherwise through ARB_copy_buffer)
+bool HasCopyBuffer();
+
+// Check whether parts of a buffer can be mapped without waiting for the GPU
+// (core in OpenGL 3.0, otherwise through ARB_map_buffer_range)
+bool HasMapBufferRange();
+
+// Check whether fences can be placed in the command stream and polled (core
+// in OpenGL 3.2, otherwise through ARB_sync)
+bool HasSync();
+
+// Check whether buffers can be created with storage that stays mapped while
+// the GPU reads it (core in OpenGL 4.4, otherwise through ARB_buffer_storage)
+bool HasBufferStorage();
+
+// Get the context version parsed by LoadFunctions (0.0 before loading)
+void GetVersion(int* major, int* minor);
+
+} // namespace gl
+} // namespace render
+} // namespace blec
+
+#endif // BLEC_RENDER_GL_FUNCTIONS_H
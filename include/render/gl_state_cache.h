@@ -0,0 +1,127 @@
+// render/gl_state_cache.h
+// Shadow copy of the fixed-function GL state the renderer toggles
+// Every change goes through the cache, which only calls into GL when the
+// requested value differs from the last one set, and counts both outcomes
+// The application draws with one context on one thread, so a single cache
+// (ForCurrentContext) shadows it; call Invalidate after anything else may
+// have changed GL state behind its back
+
+#ifndef BLEC_RENDER_GL_STATE_CACHE_H
+#define BLEC_RENDER_GL_STATE_CACHE_H
+
+#include <GLFW/glfw3.h>
+
+#include <cstdint>
+
+namespace blec {
+namespace render {
+
+// Render state bits: which pipeline features a draw needs
+using RenderState = uint8_t;
+constexpr RenderState kStateDepthTest = 1u << 0;   // glDepthFunc(GL_LESS)
+constexpr RenderState kStateDepthWrite = 1u << 1;  // glDepthMask(GL_TRUE)
+constexpr RenderState kStateCullFace = 1u << 2;    // Back faces, CCW front
+constexpr RenderState kStateBlend = 1u << 3;       // SRC_ALPHA, ONE_MINUS_SRC_ALPHA
+
+// Common combinations
+constexpr RenderState kStateOpaque = kStateDepthTest | kStateDepthWrite | kStateCullFace;
+constexpr RenderState kStateTranslucent = kStateDepthTest | kStateBlend;
+constexpr RenderState kStateOverlay = kStateBlend;
+
+// GlStateCache skips GL calls that would not change anything
+class GlStateCache {
+public:
+    GlStateCache();
+    ~GlStateCache() = default;
+
+    // Get the cache shadowing the application's context
+    static GlStateCache& ForCurrentContext();
+
+    // Forget all shadowed values so the next change of each is issued
+    // Required after creating a context or after code outside the cache
+    // changed state
+    void Invalidate();
+
+    // Set every feature in a RenderState at once
+    void Apply(RenderState state);
+
+    // Enable or disable depth testing (GL_LESS when enabled)
+    void SetDepthTest(bool enabled);
+
+    // Enable or disable depth buffer writes
+    void SetDepthWrite(bool enabled);
+
+    // Enable or disable back-face culling (back faces, counter-clockwise front)
+    void SetCullFace(bool enabled);
+
+    // Enable or disable alpha blending (SRC_ALPHA, ONE_MINUS_SRC_ALPHA)
+    void SetBlend(bool enabled);
+
+    // Select the matrix stack later matrix calls affect
+    void SetMatrixMode(GLenum mode);
+
+    // Enable or disable fixed-function 2D texturing
+    void SetTexture2D(bool enabled);
+
+    // Bind a texture to GL_TEXTURE_2D (0 unbinds)
+    void BindTexture2D(GLuint texture);
+
+    // Enable or disable alpha testing (GL_GREATER 0 when enabled: fully
+    // transparent fragments are discarded)
+    void SetAlphaTest(bool enabled);
+
+    // Get GL calls issued / skipped since the last EndFrame
+    uint32_t GetIssuedCount() const { return issued_; }
+    uint32_t GetSkippedCount() const { return skipped_; }
+
+    // Get GL calls issued / skipped during the last finished frame
+    uint32_t GetLastFrameIssuedCount() const { return last_issued_; }
+    uint32_t GetLastFrameSkippedCount() const { return last_skipped_; }
+
+    // Move the current counts into the last-frame counts
+    void EndFrame();
+
+private:
+    // Shadowed values
+    enum Slot {
+        kSlotDepthTest,
+        kSlotDepthFunc,
+        kSlotDepthWrite,
+        kSlotCullFace,
+        kSlotCullMode,
+        kSlotFrontFace,
+        kSlotBlend,
+        kSlotBlendFunc,
+        kSlotMatrixMode,
+        kSlotTexture2D,
+        kSlotTextureBinding,
+        kSlotAlphaTest,
+        kSlotAlphaFunc,
+        kSlotCount
+    };
+
+    // Record a value for a slot
+    // Returns true if it differs from the shadowed one and must be issued
+    bool Change(Slot slot, int64_t value);
+
+    // Enable or disable a capability through its slot
+    void SetCapability(Slot slot, GLenum capability, bool enabled);
+
+    // Last value set per slot (kUnknown after Invalidate)
+    int64_t values_[kSlotCount];
+
+    // Call counters
+    uint32_t issued_;
+    uint32_t skipped_;
+    uint32_t last_issued_;
+    uint32_t last_skipped_;
+
+    // Non-copyable
+    GlStateCache(const GlStateCache&) = delete;
+    GlStateCache& operator=(const GlStateCache&) = delete;
+};
+
+} // namespace render
+} // namespace blec
+
+#endif // BLEC_RENDER_GL_STATE_CACHE_H
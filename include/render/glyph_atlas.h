@@ -0,0 +1,80 @@
+// render/glyph_atlas.h
+// Texture holding every BitmapFont glyph, so a character is one textured
+// quad instead of one rectangle per lit pixel
+// The 5x7 glyphs are rasterized at startup into 8x8 cells, 16 per row, as
+// white texels whose alpha is the glyph coverage; one extra cell is fully
+// opaque so untextured rectangles and lines can sample it and share the
+// glyphs' draw call
+
+#ifndef BLEC_RENDER_GLYPH_ATLAS_H
+#define BLEC_RENDER_GLYPH_ATLAS_H
+
+#include <vector>
+#include <cstdint>
+
+namespace blec {
+namespace render {
+
+// Atlas layout (texels)
+constexpr int kGlyphAtlasWidth = 128;
+constexpr int kGlyphAtlasHeight = 64;
+constexpr int kGlyphCellSize = 8;
+constexpr int kGlyphAtlasColumns = kGlyphAtlasWidth / kGlyphCellSize;
+
+// Glyph size inside its cell (texels, top-left aligned)
+constexpr int kGlyphWidth = 5;
+constexpr int kGlyphHeight = 7;
+
+// Cell index of the fully opaque cell (first cell after the 95 glyphs' rows)
+constexpr int kSolidCell = 6 * kGlyphAtlasColumns;
+
+// Texture coordinates of a rectangle in the atlas
+struct GlyphRect {
+    float u0;
+    float v0;
+    float u1;
+    float v1;
+};
+
+// GlyphAtlas owns the atlas texture
+class GlyphAtlas {
+public:
+    GlyphAtlas();
+    ~GlyphAtlas() = default;
+
+    // Rasterize the font and upload the texture (context must be current)
+    // Returns false if the texture could not be created
+    bool Initialize();
+
+    // Delete the texture (requires the context that created it)
+    void Release();
+
+    // Check whether the texture exists
+    bool IsReady() const { return texture_ != 0; }
+
+    // Get the GL texture name (0 before Initialize)
+    uint32_t GetTexture() const { return texture_; }
+
+    // Rasterize every glyph into RGBA8 texels (kGlyphAtlasWidth x
+    // kGlyphAtlasHeight, rows top to bottom)
+    static void Rasterize(std::vector<uint8_t>* texels);
+
+    // Get the texture rectangle of a character's 5x7 glyph
+    // Returns false for characters outside ASCII 32-126
+    static bool GetGlyphRect(char c, GlyphRect* rect);
+
+    // Get a texture coordinate inside the opaque cell
+    static void GetSolidTexel(float* u, float* v);
+
+private:
+    uint32_t texture_;
+
+    // Non-copyable
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+};
+
+} // namespace render
+} // namespace blec
+
+#endif // BLEC_RENDER_GLYPH_ATLAS_H
@@ -1,6 +1,7 @@
 // render/mesh.h
 // 3D mesh management and rendering
-// Supports vertex arrays and colored geometry
+// Supports vertex arrays and colored geometry, drawn from GPU buffers when
+// buffer objects are available and in immediate mode otherwise
 
 #ifndef BLEC_RENDER_MESH_H
 #define BLEC_RENDER_MESH_H
@@ -34,13 +35,62 @@ public:
     Mesh();
     ~Mesh();
 
+    // Move support for efficient transfer (e.g. storing meshes in containers)
+    // The moved-from mesh owns no buffers; move-assignment releases the
+    // target's own buffers first, so it needs their context like Release()
+    Mesh(Mesh&& other) noexcept;
+    Mesh& operator=(Mesh&& other) noexcept;
+
     // Create a simple colored cube mesh
     // Each face has a different color for visualization
     static Mesh CreateCube();
 
     // Render the mesh to the screen
     // Requires appropriate projection and view matrices to be set in renderer
-    void Render() const;
+    // With buffer objects, geometry changed since the last call is uploaded
+    // first and the mesh is drawn with one glDrawElements; otherwise every
+    // vertex is submitted in immediate mode
+    void Render();
+
+    // Draw through the active shader program instead of fixed function
+    // Reads generic attributes kPositionAttribute, kColorAttribute and
+    // kNormalAttribute (see ShaderManager); uploads first if stale
+    // Requires gl::HasBufferObjects() and gl::HasShaders()
+    void Draw();
+
+    // Copy vertices and indices into GPU buffers, creating them on first use
+    // Requires gl::HasBufferObjects()
+    void Upload();
+
+    // Delete the GPU buffers (requires the context that created them)
+    void Release();
+
+    // Check if the GPU copy matches the CPU geometry
+    bool IsUploaded() const { return uploaded_; }
+
+    // Get bytes of the GPU copy
+    size_t GetGpuBytes() const { return gpu_vertex_bytes_ + gpu_index_bytes_; }
+
+    // Remove all vertices and indices (keeps allocated storage)
+    void Clear();
+
+    // Reserve storage for a known amount of geometry
+    void Reserve(size_t vertex_count, size_t index_count);
+
+    // Append a vertex and return its index
+    uint32_t AddVertex(const Vertex& vertex);
+
+    // Append a triangle from three vertex indices (counter-clockwise = front)
+    void AddTriangle(uint32_t a, uint32_t b, uint32_t c);
+
+    // Exchange geometry storage with the given vectors (see MeshBuilder)
+    void SwapGeometry(std::vector<Vertex>* vertices, std::vector<uint32_t>* indices);
+
+    // Get vertex data
+    const std::vector<Vertex>& GetVertices() const { return vertices_; }
+
+    // Get index data
+    const std::vector<uint32_t>& GetIndices() const { return indices_; }
 
     // Get number of vertices
     size_t GetVertexCount() const { return vertices_.size(); }
@@ -50,6 +100,8 @@ public:
 
     // Enable/disable back-face culling for this mesh
     // When enabled, faces not facing camera won't be rendered
+    // Render() and Draw() set GL_CULL_FACE to match through the GlStateCache
+    // and leave it that way
     // Default is disabled for predictable behavior
     void SetBackfaceCulling(bool enabled) { culling_enabled_ = enabled; }
 
@@ -58,6 +110,8 @@ public:
 
     // Transform mesh vertices by a transformation matrix
     // Typically used with model matrix for rotation/scale/translation
+    // Runs in SIMD batches; for very large vertex sets prefer VertexStreams,
+    // which skips the interleave/deinterleave step
     void ApplyTransform(const glm::mat4& transform);
 
 private:
@@ -70,18 +124,25 @@ private:
     // Whether back-face culling is enabled
     bool culling_enabled_;
 
-    // OpenGL handles (for immediate mode rendering)
-    // Will be 0 for immediate mode (glBegin/glEnd)
+    // OpenGL buffer handles (0 until uploaded, and in immediate mode)
+    uint32_t vertex_buffer_;
+    uint32_t index_buffer_;
+
+    // Upload state
+    bool uploaded_;
+    size_t gpu_vertex_bytes_;
+    size_t gpu_index_bytes_;
+    size_t gpu_index_count_;
 
     // Non-copyable
     Mesh(const Mesh&) = delete;
     Mesh& operator=(const Mesh&) = delete;
 
-    // Move support for efficient transfer
-    Mesh(Mesh&&) = default;
-    Mesh& operator=(Mesh&&) = default;
+    // Draw the uploaded buffers through fixed-function client arrays, or
+    // through generic vertex attributes for shader programs
+    void RenderBuffers(bool generic_attributes) const;
 
-    // Render vertices with color and normal information
+    // Render vertices with color and normal information in immediate mode
     void RenderVertices() const;
 };
 
@@ -0,0 +1,119 @@
+// render/mesh_builder.h
+// Geometry builder for render::Mesh
+// Builders stage vertices and indices in buffers borrowed from a per-thread
+// pool and swap them into the target mesh, so rebuilding meshes of a stable
+// size performs no heap allocations
+
+#ifndef BLEC_RENDER_MESH_BUILDER_H
+#define BLEC_RENDER_MESH_BUILDER_H
+
+#include "render/mesh.h"
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace blec {
+namespace render {
+
+// Most free staging buffer pairs a pool keeps; extra ones are freed
+constexpr size_t kMaxPooledStagingBuffers = 8;
+
+// MeshStagingPool recycles vertex and index storage between builders
+// Not thread-safe; each thread uses its own pool through ForCurrentThread()
+class MeshStagingPool {
+public:
+    MeshStagingPool() = default;
+
+    // Get the pool of the calling thread
+    static MeshStagingPool& ForCurrentThread();
+
+    // Move a free buffer pair (empty, capacity kept) into the outputs
+    // Outputs are left untouched when the pool is empty
+    void Acquire(std::vector<Vertex>* vertices, std::vector<uint32_t>* indices);
+
+    // Clear a buffer pair and keep its storage for later builders
+    void Release(std::vector<Vertex>* vertices, std::vector<uint32_t>* indices);
+
+    // Get number of free buffer pairs
+    size_t GetFreeCount() const { return free_vertices_.size(); }
+
+    // Get number of times a builder had to grow a staging buffer
+    // Stays constant once the pool is warm for the workload
+    uint64_t GetGrowthCount() const { return growth_count_; }
+
+    // Record that a staging buffer is about to grow (called by MeshBuilder)
+    void RecordGrowth() { growth_count_ += 1; }
+
+private:
+    std::vector<std::vector<Vertex>> free_vertices_;
+    std::vector<std::vector<uint32_t>> free_indices_;
+    uint64_t growth_count_ = 0;
+
+    // Non-copyable
+    MeshStagingPool(const MeshStagingPool&) = delete;
+    MeshStagingPool& operator=(const MeshStagingPool&) = delete;
+};
+
+// MeshBuilder accumulates triangles and quads and moves them into a Mesh
+// Usage: Reserve(), emit geometry, Build(&mesh); the builder can then be
+// reused and returns its staging storage to the pool when destroyed
+class MeshBuilder {
+public:
+    // Borrow staging storage from the calling thread's pool
+    MeshBuilder();
+
+    // Borrow staging storage from a specific pool (must outlive the builder)
+    explicit MeshBuilder(MeshStagingPool* pool);
+
+    ~MeshBuilder();
+
+    // Reserve room for a known amount of geometry
+    void Reserve(size_t vertex_count, size_t index_count);
+
+    // Reserve room for a number of quads (4 vertices, 6 indices each)
+    void ReserveQuads(size_t quad_count);
+
+    // Append a vertex and return its index
+    uint32_t AddVertex(const Vertex& vertex);
+
+    // Append a triangle from three vertex indices (counter-clockwise = front)
+    void AddTriangle(uint32_t a, uint32_t b, uint32_t c);
+
+    // Append a quad from four corners in counter-clockwise order, drawn as
+    // triangles 0-1-2 and 0-2-3
+    void AddQuad(const glm::vec3* corners, const glm::vec3& color, const glm::vec3& normal);
+
+    // Append quad_count quads whose corners are consecutive in vertices
+    // (4 per quad, counter-clockwise)
+    void AddQuads(const Vertex* vertices, size_t quad_count);
+
+    // Get number of staged vertices
+    size_t GetVertexCount() const { return vertices_.size(); }
+
+    // Get number of staged indices
+    size_t GetIndexCount() const { return indices_.size(); }
+
+    // Swap the staged geometry into a mesh, replacing its contents
+    // The mesh's previous storage becomes the builder's (emptied) staging
+    // buffers, so a mesh rebuilt every frame recycles the same two blocks
+    void Build(Mesh* mesh);
+
+private:
+    // Record a growth if appending would exceed the current capacity
+    void NoteAppend(size_t vertex_count, size_t index_count);
+
+    MeshStagingPool* pool_;
+    std::vector<Vertex> vertices_;
+    std::vector<uint32_t> indices_;
+
+    // Non-copyable
+    MeshBuilder(const MeshBuilder&) = delete;
+    MeshBuilder& operator=(const MeshBuilder&) = delete;
+};
+
+} // namespace render
+} // namespace blec
+
+#endif // BLEC_RENDER_MESH_BUILDER_H
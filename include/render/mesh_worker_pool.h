@@ -0,0 +1,121 @@
+// render/mesh_worker_pool.h
+// Background section meshing on worker threads
+// Jobs carry a snapshot of the section, so workers never read the block
+// system and the world can be edited while meshes are being built
+
+#ifndef BLEC_RENDER_MESH_WORKER_POOL_H
+#define BLEC_RENDER_MESH_WORKER_POOL_H
+
+#include "render/chunk_mesher.h"
+#include "render/face_buffer.h"
+#include "render/voxel_mesh.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace blec {
+namespace render {
+
+// Most consumed results a pool keeps for reuse; extra ones are freed
+constexpr size_t kMaxRecycledResults = 64;
+
+// One section to mesh
+struct MeshJob {
+    uint32_t section_index;
+    uint64_t version;           // Caller's build version, returned with the result
+    MeshingMode mode;
+    bool build_faces;           // Build a FaceBuffer instead of a VoxelMesh
+    SectionSnapshot snapshot;   // Blocks the mesh is built from
+};
+
+// Finished CPU-side geometry of one job (no GL objects)
+struct MeshResult {
+    uint32_t section_index;
+    uint64_t version;
+    bool build_faces;
+    ChunkMeshStats stats;
+    VoxelMesh mesh;             // Filled unless build_faces
+    FaceBuffer faces;           // Filled if build_faces
+};
+
+// MeshWorkerPool runs MeshJobs on a fixed set of threads
+// Submit and CollectResults are called from the main thread; results come
+// back in completion order
+class MeshWorkerPool {
+public:
+    MeshWorkerPool();
+
+    // Stops the workers
+    ~MeshWorkerPool();
+
+    // Start the worker threads
+    // thread_count: 0 = one less than the hardware threads (at least one)
+    // Returns true if the workers are running
+    bool Start(uint32_t thread_count = 0);
+
+    // Drop queued jobs, finish the ones in flight and join the workers
+    // Unclaimed results are discarded
+    void Stop();
+
+    // Check whether the workers are running
+    bool IsRunning() const { return !workers_.empty(); }
+
+    // Get number of worker threads
+    uint32_t GetThreadCount() const { return static_cast<uint32_t>(workers_.size()); }
+
+    // Queue a job (requires IsRunning())
+    void Submit(const MeshJob& job);
+
+    // Move all finished results into results (appended)
+    // Workers are only blocked for the swap of the result list
+    void CollectResults(std::vector<MeshResult>* results);
+
+    // Hand consumed results back so workers build into their storage
+    // After TakeGeometry a result holds the replaced mesh's vectors, so a
+    // section rebuilt at a stable size swaps the same blocks back and forth
+    // instead of allocating; results is left empty
+    void RecycleResults(std::vector<MeshResult>* results);
+
+    // Get number of recycled results waiting for a job
+    size_t GetRecycledCount() const;
+
+    // Block until every submitted job has finished
+    void WaitForIdle();
+
+    // Get number of jobs queued or in flight
+    uint32_t GetPendingJobCount() const;
+
+private:
+    // Worker thread entry point
+    void WorkerLoop();
+
+    std::vector<std::thread> workers_;
+
+    // Job queue
+    mutable std::mutex mutex_;
+    std::condition_variable job_ready_;
+    std::condition_variable idle_;
+    std::deque<MeshJob> jobs_;
+    uint32_t active_jobs_;  // Taken from the queue but not finished
+    bool stop_;
+
+    // Finished and recycled results (separate lock so collecting never waits
+    // on the queue)
+    mutable std::mutex results_mutex_;
+    std::vector<MeshResult> results_;
+    std::vector<MeshResult> free_results_;
+
+    // Non-copyable
+    MeshWorkerPool(const MeshWorkerPool&) = delete;
+    MeshWorkerPool& operator=(const MeshWorkerPool&) = delete;
+};
+
+} // namespace render
+} // namespace blec
+
+#endif // BLEC_RENDER_MESH_WORKER_POOL_H
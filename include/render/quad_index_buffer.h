@@ -0,0 +1,64 @@
+// render/quad_index_buffer.h
+// Index buffer shared by all section meshes
+// Every voxel quad is drawn as triangles 0-1-2 and 0-2-3 of its four
+// vertices, so one 16-bit buffer sized for the densest section serves every
+// mesh and meshes only store and upload vertices
+
+#ifndef BLEC_RENDER_QUAD_INDEX_BUFFER_H
+#define BLEC_RENDER_QUAD_INDEX_BUFFER_H
+
+#include "world/block_system.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace blec {
+namespace render {
+
+// Vertices and indices per quad
+constexpr int kVerticesPerQuad = 4;
+constexpr int kIndicesPerQuad = 6;
+
+// Most quads a section mesh can hold: a 3D checkerboard exposes all six
+// faces of half the blocks, which no other arrangement exceeds
+constexpr uint32_t kMaxQuadsPerSection = world::kSectionVolume / 2 * 6;
+
+// QuadIndexBuffer owns the shared GL index buffer
+class QuadIndexBuffer {
+public:
+    QuadIndexBuffer();
+    ~QuadIndexBuffer();
+
+    // Create the GPU buffer for kMaxQuadsPerSection quads (no-op once created)
+    // Requires gl::HasBufferObjects()
+    void Upload();
+
+    // Delete the GPU buffer (requires the context that created it)
+    void Release();
+
+    // Check if the GPU buffer exists
+    bool IsUploaded() const { return buffer_ != 0; }
+
+    // Get bytes of the GPU buffer
+    size_t GetGpuBytes() const;
+
+    // Bind as the element array buffer for the arena's packed meshes
+    void Bind() const;
+
+    // Get the vertex referenced by an index position (the CPU equivalent of
+    // reading the buffer)
+    static uint32_t GetIndex(size_t position);
+
+private:
+    // OpenGL buffer handle (0 until uploaded)
+    uint32_t buffer_;
+
+    // Non-copyable
+    QuadIndexBuffer(const QuadIndexBuffer&) = delete;
+    QuadIndexBuffer& operator=(const QuadIndexBuffer&) = delete;
+};
+
+} // namespace render
+} // namespace blec
+
+#endif // BLEC_RENDER_QUAD_INDEX_BUFFER_H
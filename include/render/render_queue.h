@@ -0,0 +1,130 @@
+// render/render_queue.h
+// Draw submissions recorded as commands and executed in sort-key order
+// Each command gets a 64-bit key (pass, shader, state, depth, index) so one
+// radix sort groups draws by pass, then by program, then by render state,
+// and orders them by depth within a group: front to back for opaque draws,
+// back to front for translucent ones
+//   bits 63-60  RenderPass
+//   bits 59-48  ShaderId (kInvalidShader sorts last)
+//   bits 47-40  RenderState
+//   bits 39-16  quantized view depth
+//   bits 15-0   submission index, which also keeps equal keys in order
+
+#ifndef BLEC_RENDER_RENDER_QUEUE_H
+#define BLEC_RENDER_RENDER_QUEUE_H
+
+#include "render/gl_state_cache.h"
+#include "render/shader_manager.h"
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace blec {
+namespace render {
+
+class BlockInstancer;
+class ChunkRenderer;
+class Mesh;
+
+// Commands one queue holds (the submission index has 16 bits)
+constexpr size_t kMaxRenderCommands = 1u << 16;
+
+// View depth mapped onto the 24-bit depth field; farther draws share the
+// last value
+constexpr float kSortDepthRange = 1024.0f;
+
+// Groups of draws executed in order
+enum class RenderPass : uint8_t {
+    Opaque = 0,       // Front to back
+    Translucent = 1,  // Back to front, after every opaque draw
+    Overlay = 2       // Last
+};
+
+// What a command draws
+enum class RenderCommandType : uint8_t {
+    Mesh,       // mesh with model
+    Chunks,     // chunks->Render(*sections)
+    Instances   // instancer->Render()
+};
+
+// One recorded draw
+// Pointers must stay valid until the queue is flushed
+struct RenderCommand {
+    RenderCommandType type;
+    RenderPass pass;
+    RenderState state;  // Applied through the GlStateCache before drawing
+    ShaderId shader;    // Program the draw uses, kInvalidShader if it binds its own
+    float depth;        // Distance from the camera
+
+    Mesh* mesh;
+    glm::mat4 model;
+    ChunkRenderer* chunks;
+    const std::vector<uint32_t>* sections;
+    BlockInstancer* instancer;
+};
+
+// RenderQueue records commands and sorts them by key
+// Usage per frame: Submit() each draw, Sort(), execute GetSortedCommand(i)
+// for every command, Clear()
+class RenderQueue {
+public:
+    RenderQueue() = default;
+    ~RenderQueue() = default;
+
+    // Record a command
+    // Returns false once kMaxRenderCommands are queued
+    bool Submit(const RenderCommand& command);
+
+    // Remove all commands (keeps allocated storage)
+    void Clear();
+
+    // Sort commands by key
+    void Sort();
+
+    // Get number of queued commands
+    size_t GetCommandCount() const { return commands_.size(); }
+
+    // Get the i-th command in key order (submission order before Sort)
+    const RenderCommand& GetSortedCommand(size_t i) const;
+
+    // Get the keys in their current order
+    const std::vector<uint64_t>& GetKeys() const { return keys_; }
+
+    // Get number of digit passes the last Sort needed (0 to 8)
+    uint32_t GetLastSortPassCount() const { return sort_passes_; }
+
+    // Build the sort key of a command
+    static uint64_t MakeSortKey(RenderPass pass, ShaderId shader, RenderState state,
+                                float depth, uint32_t index);
+
+    // Map a view depth onto 24 bits (0 at the camera, saturating at
+    // kSortDepthRange)
+    static uint32_t QuantizeDepth(float depth);
+
+    // Stable LSD radix sort on 8-bit digits; digits every key shares are
+    // skipped
+    // scratch: Reused temporary storage
+    // Returns number of digit passes performed
+    static uint32_t RadixSort(std::vector<uint64_t>* keys, std::vector<uint64_t>* scratch);
+
+private:
+    // Commands in submission order
+    std::vector<RenderCommand> commands_;
+
+    // Keys, sorted by Sort
+    std::vector<uint64_t> keys_;
+    std::vector<uint64_t> scratch_;
+
+    uint32_t sort_passes_ = 0;
+
+    // Non-copyable
+    RenderQueue(const RenderQueue&) = delete;
+    RenderQueue& operator=(const RenderQueue&) = delete;
+};
+
+} // namespace render
+} // namespace blec
+
+#endif // BLEC_RENDER_RENDER_QUEUE_H
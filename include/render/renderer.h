@@ -1,10 +1,21 @@
 // renderer.h
 // Core rendering functionality using OpenGL
 // Provides basic drawing primitives, 2D overlay support, and 3D rendering
+// 3D matrices feed GLSL programs through a ShaderManager; the fixed-function
+// matrix stack is only loaded when shaders or buffer objects are missing
+// 3D draws are submitted to a RenderQueue and executed in sort-key order by
+// Flush; all state changes go through the GlStateCache
+// 2D rectangles and lines are collected by the Batch2D and drawn together
+// at End2D
 
 #ifndef BLEC_RENDERER_H
 #define BLEC_RENDERER_H
 
+#include "render/gl_state_cache.h"
+#include "render/render_queue.h"
+#include "render/shader_manager.h"
+#include "render/stream_buffer.h"
+
 #include <glm/glm.hpp>
 
 namespace blec {
@@ -12,14 +23,38 @@ namespace render {
 
 // Renderer provides basic OpenGL rendering operations
 // Manages matrix stacks, rendering state, and drawing primitives
+
 class Renderer {
 public:
-    Renderer() = default;
+    Renderer();
     ~Renderer() = default;
 
     // Initialize renderer and set up OpenGL state
+    // Loads OpenGL entry points and builds the built-in shaders, so the
+    // context must be current
     void Initialize();
 
+    // Delete shader programs and the upload ring (requires the context
+    // Initialize used)
+    void ReleaseGpuResources();
+
+    // Close the frame after its last draw, fencing this frame's stream
+    // uploads and closing the state cache's frame counters
+    void EndFrame();
+
+    // Check if 3D drawing goes through shaders instead of the fixed-function
+    // matrix stack
+    bool UsesShaderPipeline() const { return shader_pipeline_; }
+
+    // Get the shader registry holding the frame's matrices
+    ShaderManager& GetShaders() { return shaders_; }
+
+    // Get the ring that per-frame vertex and instance data is uploaded through
+    StreamBuffer& GetStream() { return stream_; }
+
+    // Get projection * view, concatenated once after either changed
+    const glm::mat4& GetViewProjection() { return shaders_.GetViewProjection(); }
+
     // Set the OpenGL viewport to match framebuffer size
     static void SetViewport(int width, int height);
 
@@ -28,43 +63,79 @@ public:
     static void Clear(float r, float g, float b, float a);
 
     // Set projection matrix (for perspective or orthographic projection)
-    static void SetProjection(const glm::mat4& projection);
+    void SetProjection(const glm::mat4& projection);
 
     // Set view matrix (camera transformation)
-    static void SetView(const glm::mat4& view);
+    void SetView(const glm::mat4& view);
+
+    // Set model matrix (object transformation) for following draws
+    // The fixed-function fallback multiplies it onto the modelview matrix
+    void SetModel(const glm::mat4& model);
+
+    // Draw a mesh with the current model matrix
+    // Uses the built-in color shader on the shader pipeline, Mesh::Render()
+    // otherwise
+    void DrawMesh(Mesh* mesh);
 
-    // Set model matrix (object transformation)
-    static void SetModel(const glm::mat4& model);
+    // Record a draw for the next Flush
+    // Returns false if the queue is full
+    bool Submit(const RenderCommand& command);
+
+    // Record a mesh drawn with the built-in color shader
+    // depth: Distance from the camera (opaque meshes draw front to back)
+    bool SubmitMesh(Mesh* mesh, const glm::mat4& model, float depth,
+                    RenderPass pass = RenderPass::Opaque);
+
+    // Record the visible chunk sections (drawn with back-face culling)
+    // sections must stay unchanged until Flush
+    bool SubmitChunks(ChunkRenderer* chunks, const std::vector<uint32_t>* sections);
+
+    // Record a BlockInstancer's cubes
+    bool SubmitInstances(BlockInstancer* instancer);
+
+    // Sort the recorded draws and execute them, applying each command's
+    // RenderState through the state cache, then clear the queue
+    // Call between Begin3D/End3D after SetView
+    void Flush();
+
+    // Get the recorded draws
+    const RenderQueue& GetQueue() const { return queue_; }
+
+    // Get number of commands executed by the last Flush
+    size_t GetLastFlushCommandCount() const { return flushed_commands_; }
 
     // Begin drawing in 2D screen space (for overlays, UI)
     // Origin is top-left, Y axis points down
+    // Following 2D draws are batched until End2D
     static void Begin2D(int screenWidth, int screenHeight);
 
-    // End 2D drawing and restore previous state
+    // Draw the batched 2D primitives, end 2D drawing and restore previous state
     static void End2D();
 
     // Begin drawing in 3D world space
-    // Sets up perspective projection and enables depth testing
-    static void Begin3D(int screenWidth, int screenHeight, float fovDegrees = 45.0f);
+    // Sets up perspective projection, resets the model matrix and enables
+    // depth testing
+    void Begin3D(int screenWidth, int screenHeight, float fovDegrees = 45.0f);
 
     // End 3D drawing and restore state
     static void End3D();
 
     // Draw a filled rectangle at (x, y) with size (w, h)
-    // Used for 2D UI and overlays
+    // Used for 2D UI and overlays; batched between Begin2D/End2D
     static void DrawFilledRect(float x, float y, float w, float h);
 
     // Draw a line from (x1, y1) to (x2, y2)
-    // Color is set via SetColor() before calling
+    // Color is set via SetColor() before calling; batched like rectangles
     static void DrawLine(float x1, float y1, float x2, float y2);
 
-    // Set the current drawing color (RGBA, 0-1 range)
+    // Set the color of following 2D rectangles and lines (RGBA, 0-1 range)
     static void SetColor(float r, float g, float b, float a);
 
     // Enable alpha blending for transparency
+    // Flushes the 2D batch first
     static void EnableBlending();
 
-    // Disable alpha blending
+    // Disable alpha blending (flushes the 2D batch first)
     static void DisableBlending();
 
     // Enable depth testing for 3D rendering
@@ -82,6 +153,19 @@ public:
     static void DisableBackfaceCulling();
 
 private:
+    // Programs and the matrices they read
+    ShaderManager shaders_;
+
+    // Per-frame upload ring shared by dynamic geometry
+    StreamBuffer stream_;
+
+    // Whether 3D drawing uses shaders (set by Initialize)
+    bool shader_pipeline_;
+
+    // Draws recorded since the last Flush
+    RenderQueue queue_;
+    size_t flushed_commands_;
+
     // Non-copyable
     Renderer(const Renderer&) = delete;
     Renderer& operator=(const Renderer&) = delete;
@@ -0,0 +1,125 @@
+// render/shader_manager.h
+// Registry of GLSL programs sharing the frame's camera matrices
+// Programs are written against GLSL 1.20 so OpenGL 2.1 contexts work; instead
+// of the fixed-function matrix stack they read u_view_projection and u_model,
+// which are concatenated on the CPU and uploaded only when they changed
+
+#ifndef BLEC_RENDER_SHADER_MANAGER_H
+#define BLEC_RENDER_SHADER_MANAGER_H
+
+#include "render/shader_program.h"
+
+#include <glm/glm.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace blec {
+namespace render {
+
+// Identifies a program registered with a ShaderManager
+using ShaderId = int32_t;
+constexpr ShaderId kInvalidShader = -1;
+
+// Attribute locations used by the built-in programs (see Mesh::Draw)
+constexpr uint32_t kPositionAttribute = 0;
+constexpr uint32_t kColorAttribute = 1;
+constexpr uint32_t kNormalAttribute = 2;
+
+// ShaderManager owns named programs and feeds them the camera matrices
+class ShaderManager {
+public:
+    ShaderManager();
+    ~ShaderManager() = default;
+
+    // Compile and link a program under a name
+    // attributes[i] is bound to generic attribute location i
+    // Returns the program's id, or kInvalidShader if it failed to build
+    ShaderId Add(const char* name, const char* vertex_source, const char* fragment_source,
+                 const char* const* attributes, int attribute_count);
+
+    // Build the built-in programs; requires gl::HasShaders()
+    // Returns true if all of them linked
+    bool InitializeBuiltins();
+
+    // Get the built-in program for render::Vertex meshes
+    // (position, color and normal at kPositionAttribute..kNormalAttribute)
+    ShaderId GetColorShader() const { return color_shader_; }
+
+    // Find a program by name (kInvalidShader if unknown)
+    ShaderId Find(const char* name) const;
+
+    // Get a registered program (nullptr for invalid ids)
+    const ShaderProgram* Get(ShaderId id) const;
+
+    // Get number of registered programs
+    size_t GetProgramCount() const { return entries_.size(); }
+
+    // Set the camera matrices; the view-projection product is recomputed at
+    // most once after either changes, when it is next needed
+    void SetProjection(const glm::mat4& projection);
+    void SetView(const glm::mat4& view);
+
+    // Set the model matrix for following draws (uploaded to the active
+    // program right away)
+    void SetModel(const glm::mat4& model);
+
+    // Get projection * view
+    const glm::mat4& GetViewProjection();
+
+    // Get number of view-projection products computed so far
+    uint32_t GetConcatenationCount() const { return concatenations_; }
+
+    // Make a program current and upload the matrices it has not seen yet
+    void Use(ShaderId id);
+
+    // Return to the fixed-function pipeline
+    void Unuse();
+
+    // Get the program made current by Use (kInvalidShader if none)
+    ShaderId GetActive() const { return active_; }
+
+    // Delete all programs (requires the context that built them)
+    void Release();
+
+private:
+    // One registered program with its matrix uniform state
+    struct Entry {
+        std::string name;
+        std::unique_ptr<ShaderProgram> program;
+        int32_t view_projection_location;
+        int32_t model_location;
+        uint64_t view_projection_serial;  // Serial of the last uploaded values
+        uint64_t model_serial;
+    };
+
+    // Upload matrices the active program has not seen yet
+    void UploadMatrices(Entry* entry);
+
+    std::vector<Entry> entries_;
+
+    // Camera and model matrices
+    glm::mat4 projection_;
+    glm::mat4 view_;
+    glm::mat4 view_projection_;
+    glm::mat4 model_;
+    bool view_projection_dirty_;
+
+    // Change counters compared against each program's upload serials
+    uint64_t view_projection_serial_;
+    uint64_t model_serial_;
+    uint32_t concatenations_;
+
+    ShaderId active_;
+    ShaderId color_shader_;
+
+    // Non-copyable
+    ShaderManager(const ShaderManager&) = delete;
+    ShaderManager& operator=(const ShaderManager&) = delete;
+};
+
+} // namespace render
+} // namespace blec
+
+#endif // BLEC_RENDER_SHADER_MANAGER_H
@@ -0,0 +1,71 @@
+// render/shader_program.h
+// GLSL program compiled from vertex and fragment shader sources
+// Requires gl::LoadFunctions() to have succeeded
+
+#ifndef BLEC_RENDER_SHADER_PROGRAM_H
+#define BLEC_RENDER_SHADER_PROGRAM_H
+
+#include <glm/glm.hpp>
+#include <string>
+#include <cstdint>
+
+namespace blec {
+namespace render {
+
+// ShaderProgram owns a linked GL program object
+class ShaderProgram {
+public:
+    ShaderProgram();
+    ~ShaderProgram();
+
+    // Compile both stages and link them
+    // attributes[i] is bound to generic attribute location i before linking
+    // Returns false and keeps the compiler output in GetLog() on failure
+    bool Build(const char* vertex_source, const char* fragment_source,
+               const char* const* attributes, int attribute_count);
+
+    // Delete the GL program (requires the context that built it)
+    void Release();
+
+    // Check if the program linked successfully
+    bool IsValid() const { return program_ != 0; }
+
+    // Make this the active program
+    void Use() const;
+
+    // Stop using any program (back to fixed function)
+    static void Unuse();
+
+    // Look up a uniform location (-1 if unused by the shaders)
+    int32_t GetUniformLocation(const char* name) const;
+
+    // Set uniforms on the active program (ignored for location -1)
+    static void SetUniform(int32_t location, int value);
+    static void SetUniform(int32_t location, float value);
+    static void SetUniform(int32_t location, const glm::vec3& value);
+    static void SetUniform(int32_t location, const glm::mat4& value);
+    static void SetUniformArray(int32_t location, const float* values, int count);
+    static void SetUniformArray(int32_t location, const glm::vec3* values, int count);
+
+    // Get compiler and linker messages of the last Build
+    const std::string& GetLog() const { return log_; }
+
+private:
+    // Compile one stage, returning the shader object or 0 on failure
+    uint32_t CompileStage(uint32_t type, const char* source);
+
+    // GL program object (0 if not built)
+    uint32_t program_;
+
+    // Compiler and linker output
+    std::string log_;
+
+    // Non-copyable
+    ShaderProgram(const ShaderProgram&) = delete;
+    ShaderProgram& operator=(const ShaderProgram&) = delete;
+};
+
+} // namespace render
+} // namespace blec
+
+#endif // BLEC_RENDER_SHADER_PROGRAM_H
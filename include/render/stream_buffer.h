@@ -0,0 +1,165 @@
+// render/stream_buffer.h
+// Ring buffer for vertex data rewritten every frame (UI vertices, debug
+// lines, instance attributes)
+// Each upload takes the next span of one large buffer instead of
+// respecifying or overwriting a buffer the GPU may still read, so writing
+// never waits on earlier draws:
+//   - With ARB_buffer_storage the buffer is mapped once and stays mapped;
+//     a fence placed at the end of each frame marks when the GPU is done
+//     with that frame's spans, and spans are only reused after it signals
+//   - With ARB_map_buffer_range spans are mapped unsynchronized, and the
+//     buffer is orphaned each time the ring wraps
+//   - On plain OpenGL 1.5 the buffer is also orphaned on wrap, and spans are
+//     uploaded with glBufferSubData into storage no draw has used yet
+//   - Without buffer objects spans live in client memory
+// If the GPU still holds every span when a new one is needed, the ring grows
+// instead of waiting
+
+#ifndef BLEC_RENDER_STREAM_BUFFER_H
+#define BLEC_RENDER_STREAM_BUFFER_H
+
+#include "render/gl_functions.h"
+
+#include <deque>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace blec {
+namespace render {
+
+// Initial ring size in bytes
+constexpr size_t kDefaultStreamBytes = 1u << 20;
+
+// Default span alignment (covers float and 16-byte vertex layouts)
+constexpr size_t kStreamAlignment = 16;
+
+// How StreamBuffer gets bytes to the GPU
+enum class StreamMode {
+    Persistent,  // Mapped once (ARB_buffer_storage), fenced per frame
+    MapRange,    // Unsynchronized glMapBufferRange, orphaned on wrap
+    Orphan,      // glBufferSubData into fresh space, orphaned on wrap
+    Client       // No buffer objects: client memory
+};
+
+// Space reserved in the ring for one upload
+struct StreamSpan {
+    void* data;     // Write pointer, valid until Commit
+    size_t offset;  // Byte offset of the span in the buffer
+    size_t size;    // Bytes reserved
+};
+
+// StreamBuffer hands out spans of a ring buffer bound as GL_ARRAY_BUFFER
+// Usage per upload: Allocate(), write the span, Commit(), set attribute
+// pointers with GetPointer(span.offset) and draw; call EndFrame() once per
+// frame after the last draw
+// A span stays valid until the next Allocate, so draw from it first
+class StreamBuffer {
+public:
+    explicit StreamBuffer(size_t capacity = kDefaultStreamBytes);
+    ~StreamBuffer();
+
+    // Reserve bytes for one upload
+    // The first call picks the mode, so the context must be current
+    // Returns an empty span when bytes is 0
+    StreamSpan Allocate(size_t bytes, size_t alignment = kStreamAlignment);
+
+    // Make a written span visible to the GPU
+    // Leaves the buffer bound as the array buffer (0 in client mode)
+    void Commit(const StreamSpan& span);
+
+    // Bind as the array buffer (0 in client mode)
+    void Bind() const;
+
+    // Get the attribute pointer argument for a byte offset into the buffer
+    const void* GetPointer(size_t offset) const;
+
+    // Close the frame: fence its spans and retire frames the GPU finished
+    void EndFrame();
+
+    // Delete the buffer and fences (requires the context that created them)
+    void Release();
+
+    // Get the mode chosen by the first Allocate
+    StreamMode GetMode() const { return mode_; }
+
+    // Get a display name for a mode
+    static const char* GetModeName(StreamMode mode);
+
+    // Get ring size in bytes
+    size_t GetCapacity() const { return capacity_; }
+
+    // Get bytes allocated during the last finished frame
+    size_t GetLastFrameBytes() const { return last_frame_bytes_; }
+
+    // Get number of frames whose fences have not signaled yet
+    size_t GetFramesInFlight() const { return frames_.size(); }
+
+    // Get number of times the buffer was orphaned on wrap
+    uint32_t GetOrphanCount() const { return orphan_count_; }
+
+    // Get number of times the ring had to grow
+    uint32_t GetGrowthCount() const { return growth_count_; }
+
+private:
+    // A finished frame whose spans the GPU may still read
+    struct Frame {
+        gl::Sync fence;
+        uint64_t end;  // Ring position after the frame's last span
+    };
+
+    // Pick the mode from the loaded entry points and create the storage
+    void InitializeGpu();
+
+    // Create (or recreate) the buffer at the current capacity
+    void CreateStorage();
+
+    // Drop in-flight frames and double the ring until bytes fit
+    // The old storage is released once the GPU is done with it
+    void Grow(size_t bytes);
+
+    // Retire frames from the oldest whose fences have signaled
+    void RetireFinishedFrames();
+
+    // Delete all fences without waiting
+    void DropFrames();
+
+    // Ring size and positions; positions only increase, the buffer offset
+    // is the position modulo capacity
+    size_t capacity_;
+    uint64_t head_;  // Next free byte
+    uint64_t tail_;  // Oldest byte the GPU may still read
+
+    // Frames in flight, oldest first (persistent mode only)
+    std::deque<Frame> frames_;
+
+    // Bytes allocated in the current and last frame
+    size_t frame_bytes_;
+    size_t last_frame_bytes_;
+
+    // Statistics
+    uint32_t orphan_count_;
+    uint32_t growth_count_;
+
+    // Chosen mode
+    bool gpu_checked_;
+    StreamMode mode_;
+
+    // OpenGL buffer (0 in client mode) and its persistent mapping
+    uint32_t buffer_;
+    uint8_t* mapped_;
+    bool span_mapped_;  // The last span was mapped with glMapBufferRange
+
+    // Client memory, or staging for spans uploaded with glBufferSubData
+    std::vector<uint8_t> client_;
+    std::vector<uint8_t> staging_;
+
+    // Non-copyable
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+};
+
+} // namespace render
+} // namespace blec
+
+#endif // BLEC_RENDER_STREAM_BUFFER_H
@@ -0,0 +1,77 @@
+// render/ui_command_list.h
+// Recorded 2D overlay drawing
+// UI code records colors, rectangles, lines and text into a list on the
+// simulation thread; the render thread replays it between Begin2D/End2D
+// Text is copied into the list, so recorded commands reference nothing else
+
+#ifndef BLEC_RENDER_UI_COMMAND_LIST_H
+#define BLEC_RENDER_UI_COMMAND_LIST_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace blec {
+namespace render {
+
+class BitmapFont;
+
+// Kind of recorded 2D call (arguments in UiCommand::values)
+enum class UiCommandType : uint8_t {
+    SetColor,         // r, g, b, a
+    FilledRect,       // x, y, w, h
+    Line,             // x1, y1, x2, y2
+    Text,             // x, y, scale; characters in the list's text storage
+    EnableBlending,
+    DisableBlending
+};
+
+// One recorded call
+struct UiCommand {
+    UiCommandType type;
+    float values[4];
+    uint32_t text_offset;  // Text commands: first character in the text storage
+    uint32_t text_length;
+};
+
+// UiCommandList mirrors Renderer's 2D functions as a replayable recording
+class UiCommandList {
+public:
+    UiCommandList() = default;
+    ~UiCommandList() = default;
+
+    // Record calls (see the Renderer and BitmapFont functions of the same name)
+    void SetColor(float r, float g, float b, float a);
+    void DrawFilledRect(float x, float y, float w, float h);
+    void DrawLine(float x1, float y1, float x2, float y2);
+    void DrawText(float x, float y, float scale, const std::string& text);
+    void EnableBlending();
+    void DisableBlending();
+
+    // Remove all commands (keeps allocated storage)
+    void Clear();
+
+    // Get recorded commands in order
+    const std::vector<UiCommand>& GetCommands() const { return commands_; }
+
+    // Get the characters of a Text command
+    std::string GetText(const UiCommand& command) const;
+
+    // Replay every command through Renderer's 2D functions and the font
+    // Call between Renderer::Begin2D and End2D with the context current
+    void Execute(const BitmapFont& font) const;
+
+private:
+    // Append a command with up to four arguments
+    void Push(UiCommandType type, float a = 0.0f, float b = 0.0f, float c = 0.0f,
+              float d = 0.0f);
+
+    std::vector<UiCommand> commands_;
+    std::string text_;  // Characters of all Text commands
+};
+
+} // namespace render
+} // namespace blec
+
+#endif // BLEC_RENDER_UI_COMMAND_LIST_H
@@ -0,0 +1,73 @@
+// render/vertex_streams.h
+// Structure-of-arrays vertex storage and batch transforms
+// Each vertex component lives in its own float array so transforms load four
+// vertices per SIMD register; suited to bulk work such as stamping prefabs
+// with millions of vertices
+
+#ifndef BLEC_RENDER_VERTEX_STREAMS_H
+#define BLEC_RENDER_VERTEX_STREAMS_H
+
+#include "render/mesh.h"
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstddef>
+
+namespace blec {
+namespace render {
+
+// Transform points by a matrix, dividing by w when it is not affine
+// x, y, z: Component arrays of count entries, transformed in place
+void TransformPositions(const glm::mat4& transform, float* x, float* y, float* z,
+                        size_t count);
+
+// Transform directions by a normal matrix and renormalize them
+// x, y, z: Component arrays of count entries, transformed in place
+void TransformNormals(const glm::mat3& normal_matrix, float* x, float* y, float* z,
+                      size_t count);
+
+// Get the matrix that transforms normals for a model transform
+// (inverse transpose of its upper 3x3)
+glm::mat3 ComputeNormalMatrix(const glm::mat4& transform);
+
+// VertexStreams holds render::Vertex data as one array per component
+struct VertexStreams {
+    std::vector<float> position_x;
+    std::vector<float> position_y;
+    std::vector<float> position_z;
+    std::vector<float> color_r;
+    std::vector<float> color_g;
+    std::vector<float> color_b;
+    std::vector<float> normal_x;
+    std::vector<float> normal_y;
+    std::vector<float> normal_z;
+
+    // Get number of vertices
+    size_t GetCount() const { return position_x.size(); }
+
+    // Resize every stream (new vertices are zeroed)
+    void Resize(size_t count);
+
+    // Remove all vertices (keeps allocated storage)
+    void Clear() { Resize(0); }
+
+    // Replace the contents with interleaved vertices
+    void CopyFrom(const std::vector<Vertex>& vertices);
+
+    // Write the contents as interleaved vertices, replacing the output
+    void CopyTo(std::vector<Vertex>* vertices) const;
+
+    // Get one vertex in interleaved form
+    Vertex GetVertex(size_t index) const;
+
+    // Overwrite one vertex
+    void SetVertex(size_t index, const Vertex& vertex);
+
+    // Transform positions and normals; the normal matrix is computed once
+    void ApplyTransform(const glm::mat4& transform);
+};
+
+} // namespace render
+} // namespace blec
+
+#endif // BLEC_RENDER_VERTEX_STREAMS_H
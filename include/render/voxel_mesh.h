@@ -0,0 +1,98 @@
+// render/voxel_mesh.h
+// Compact mesh format for block sections
+// Each vertex packs a section-local position, face normal, palette color and
+// ambient occlusion level into 8 bytes; the voxel shader decodes them
+// Meshes hold vertices only; ChunkRenderer copies them into its ChunkArena
+// and draws them through the shared QuadIndexBuffer
+
+#ifndef BLEC_RENDER_VOXEL_MESH_H
+#define BLEC_RENDER_VOXEL_MESH_H
+
+#include "render/quad_index_buffer.h"
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+
+namespace blec {
+namespace render {
+
+// Packed voxel vertex (8 bytes instead of the 36 of render::Vertex)
+// Bound as two unsigned byte vec4 attributes:
+//   a_position = (x, y, z, normal | ao << 3), a_material = (color, sx, sy, sz)
+struct VoxelVertex {
+    uint8_t x;            // Section-local corner position (0..kSectionSize)
+    uint8_t y;
+    uint8_t z;
+    uint8_t normal_ao;    // Face index (world::SectionFace order) in bits 0-2,
+                          // ambient occlusion level in bits 3-4
+    uint8_t color;        // Palette index (see ChunkMesher::GetPaletteIndex)
+    uint8_t section[3];   // Section grid coordinates, stamped by ChunkArena
+                          // (zero in meshes); keeps vertices 4-byte aligned
+};
+
+static_assert(sizeof(VoxelVertex) == 8, "VoxelVertex must stay 8 bytes");
+
+// Number of ambient occlusion levels (0 = unoccluded)
+constexpr int kAmbientOcclusionLevels = 4;
+
+// VoxelMesh holds packed geometry for one section on the CPU
+class VoxelMesh {
+public:
+    VoxelMesh() = default;
+    ~VoxelMesh() = default;
+
+    // Move support for storing meshes in containers
+    VoxelMesh(VoxelMesh&& other) noexcept = default;
+    VoxelMesh& operator=(VoxelMesh&& other) noexcept = default;
+
+    // Remove all vertices (keeps allocated storage)
+    void Clear();
+
+    // Replace the vertices with those of another mesh, leaving it empty
+    void TakeGeometry(VoxelMesh* source);
+
+    // Append a quad from four section-local corners in counter-clockwise order
+    // face: Index in world::SectionFace order
+    // color: Palette index
+    // ao: Ambient occlusion level of each corner (nullptr = unoccluded)
+    void AddQuad(const glm::ivec3* corners, int face, uint8_t color,
+                 const uint8_t* ao = nullptr);
+
+    // Get vertex data
+    const std::vector<VoxelVertex>& GetVertices() const { return vertices_; }
+
+    // Get number of vertices
+    size_t GetVertexCount() const { return vertices_.size(); }
+
+    // Get number of quads
+    size_t GetQuadCount() const { return vertices_.size() / kVerticesPerQuad; }
+
+    // Get number of indices drawn from the shared index buffer (triangles * 3)
+    size_t GetIndexCount() const { return GetQuadCount() * kIndicesPerQuad; }
+
+    // Decode the section-local position of a vertex
+    static glm::vec3 DecodePosition(const VoxelVertex& vertex);
+
+    // Decode the face index of a vertex
+    static int DecodeFace(const VoxelVertex& vertex);
+
+    // Decode the ambient occlusion level of a vertex
+    static int DecodeAmbientOcclusion(const VoxelVertex& vertex);
+
+    // Get the outward normal of a face index
+    static glm::vec3 GetFaceNormal(int face);
+
+private:
+    // Vertex data
+    std::vector<VoxelVertex> vertices_;
+
+    // Non-copyable
+    VoxelMesh(const VoxelMesh&) = delete;
+    VoxelMesh& operator=(const VoxelMesh&) = delete;
+};
+
+} // namespace render
+} // namespace blec
+
+#endif // BLEC_RENDER_VOXEL_MESH_H
@@ -7,6 +7,7 @@ namespace blec {
 namespace render {
     class Renderer;
     class BitmapFont;
+    class UiCommandList;
 } // namespace render
 
 namespace ui {
@@ -80,6 +81,15 @@ public:
     /// Uses renderer's 2D drawing functions
     /// Should be called during 2D rendering phase after other UI
     void RenderPauseMenu(render::Renderer& renderer, render::BitmapFont& font) const;
+
+    /// Record the crosshair for replay on the render thread
+    /// @param commands List the drawing calls are appended to
+    void RecordCrosshair(render::UiCommandList* commands) const;
+
+    /// Record the pause menu (nothing when not paused) for replay on the
+    /// render thread
+    /// @param commands List the drawing calls are appended to
+    void RecordPauseMenu(render::UiCommandList* commands) const;
     
     /// Update screen dimensions (call if window resizes)
     /// @param screen_width New viewport width in pixels
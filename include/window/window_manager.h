@@ -29,6 +29,10 @@ public:
     // Make the window's OpenGL context current
     void MakeContextCurrent();
 
+    // Detach the OpenGL context from the calling thread so another thread
+    // can make it current
+    void ReleaseContext();
+
     // Enable or disable VSync (1 = enabled, 0 = disabled)
     void SetVSync(int interval);
 
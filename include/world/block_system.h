@@ -6,12 +6,30 @@
 #define BLEC_WORLD_BLOCK_SYSTEM_H
 
 #include <glm/glm.hpp>
+#include <memory>
 #include <vector>
 #include <cstdint>
 
 namespace blec {
 namespace world {
 
+class VoxelOctree;
+
+/// Edge length of a section (cubic sub-region of the grid) in blocks
+/// Sections are the unit of visibility and occlusion culling
+constexpr int32_t kSectionSize = 16;
+
+/// Number of blocks in a full section
+constexpr uint32_t kSectionVolume = kSectionSize * kSectionSize * kSectionSize;
+
+/// Edge length of a section plus a one-block border on every side
+/// Border cells let per-section passes see their neighbors without lookups
+constexpr int32_t kPaddedSectionSize = kSectionSize + 2;
+
+/// Number of cells in a padded section
+constexpr uint32_t kPaddedSectionVolume =
+    kPaddedSectionSize * kPaddedSectionSize * kPaddedSectionSize;
+
 /// Represents a single block in the voxel grid
 /// Air blocks (value 0) are invisible, non-air blocks (value > 0) are visible
 struct Block {
@@ -40,6 +58,14 @@ struct ViewFrustum {
     /// Check if AABB intersects this frustum
     /// Efficiently tests AABB against frustum planes
     bool IntersectsAABB(const AABB& aabb) const;
+
+    /// Check if AABB lies completely inside this frustum
+    /// Lets hierarchical queries accept whole subtrees without further tests
+    bool ContainsAABB(const AABB& aabb) const;
+
+    /// Push every plane outward by a distance in world units
+    /// Used to make a frustum conservative for a camera that may still move
+    void Expand(float padding);
 };
 
 /// Block system managing voxel grid and visibility queries
@@ -50,7 +76,7 @@ public:
     BlockSystem();
 
     /// Destructor
-    ~BlockSystem() = default;
+    ~BlockSystem();
 
     /// Initialize block system with grid dimensions
     /// @param grid_width: Width of grid in blocks (X axis)
@@ -71,20 +97,69 @@ public:
     /// @param projection_matrix: Perspective projection matrix
     void ExtractFrustum(const glm::mat4& view_matrix, const glm::mat4& projection_matrix);
 
+    /// Compute normalized frustum planes without touching the stored frustum
+    /// @param view_matrix: Camera view matrix
+    /// @param projection_matrix: Perspective projection matrix
+    /// @return Frustum planes in world space
+    static ViewFrustum ComputeFrustum(const glm::mat4& view_matrix,
+                                      const glm::mat4& projection_matrix);
+
     /// Update visibility counts based on extracted frustum
-    /// Counts how many non-air blocks are visible in camera view
+    /// Counts how many non-air blocks are visible in camera view and collects
+    /// the non-empty sections intersecting the frustum
     /// Should be called each frame after ExtractFrustum
     void UpdateVisibility();
 
+    /// Collect the non-empty sections intersecting an arbitrary frustum
+    /// Read-only, so it may run on a worker thread as long as no blocks are
+    /// modified at the same time
+    /// @param frustum: Frustum to test against
+    /// @param sections: Output section indices, cleared first
+    /// @return Number of non-air blocks intersecting the frustum
+    uint32_t CollectVisibleSections(const ViewFrustum& frustum,
+                                    std::vector<uint32_t>* sections) const;
+
     /// Get current view frustum (for testing)
     const ViewFrustum& GetFrustum() const { return frustum_; }
 
+    /// Build a sparse voxel octree over the solid blocks and keep it in sync
+    /// with SetBlock; UpdateVisibility then counts visible blocks through it
+    void EnableSpatialIndex();
+
+    /// Drop the spatial index (visibility falls back to per-section scans)
+    void DisableSpatialIndex();
+
+    /// Get the spatial index for ray, box and frustum queries
+    /// @return Octree, or nullptr if EnableSpatialIndex was not called
+    const VoxelOctree* GetSpatialIndex() const { return spatial_index_.get(); }
+
     /// Get number of total non-air blocks in world
     uint32_t GetTotalBlockCount() const { return total_blocks_; }
 
     /// Get number of non-air blocks visible in frustum
     uint32_t GetVisibleBlockCount() const { return visible_blocks_; }
 
+    /// Get indices of non-empty sections intersecting the frustum
+    /// Filled by UpdateVisibility, ordered by section index
+    const std::vector<uint32_t>& GetVisibleSections() const { return visible_sections_; }
+
+    /// Get sections that became visible in the last UpdateVisibility
+    /// Sorted by section index
+    const std::vector<uint32_t>& GetEnteredSections() const { return entered_sections_; }
+
+    /// Get sections that stopped being visible in the last UpdateVisibility
+    /// Sorted by section index
+    const std::vector<uint32_t>& GetLeftSections() const { return left_sections_; }
+
+    /// Compute the difference between two visible sets
+    /// @param previous: Section indices visible before, sorted ascending
+    /// @param current: Section indices visible now, sorted ascending
+    /// @param entered: Output sections only in current, cleared first
+    /// @param left: Output sections only in previous, cleared first
+    static void DiffSections(const std::vector<uint32_t>& previous,
+                             const std::vector<uint32_t>& current,
+                             std::vector<uint32_t>* entered, std::vector<uint32_t>* left);
+
     /// Get block at grid position
     /// @param x, y, z: Grid coordinates
     /// @return Block at position, or Block{0} (air) if out of bounds
@@ -114,6 +189,58 @@ public:
     /// @return Axis-aligned bounding box for the block
     AABB GetBlockAABB(int32_t grid_x, int32_t grid_y, int32_t grid_z) const;
 
+    /// Get section grid dimensions (grid size divided by kSectionSize, rounded up)
+    uint32_t GetSectionCountX() const { return section_count_x_; }
+    uint32_t GetSectionCountY() const { return section_count_y_; }
+    uint32_t GetSectionCountZ() const { return section_count_z_; }
+
+    /// Get total number of sections
+    uint32_t GetSectionCount() const {
+        return section_count_x_ * section_count_y_ * section_count_z_;
+    }
+
+    /// Convert section coordinates to a section index
+    /// @param sx, sy, sz: Section coordinates
+    /// @return Section index, or -1 if out of bounds
+    int32_t GetSectionIndex(int32_t sx, int32_t sy, int32_t sz) const;
+
+    /// Convert a section index back to section coordinates
+    /// @param section_index: Index in [0, GetSectionCount())
+    /// @param sx, sy, sz: Output section coordinates
+    void GetSectionCoordinates(uint32_t section_index,
+                               int32_t* sx, int32_t* sy, int32_t* sz) const;
+
+    /// Get world-space bounds of a section, clamped to the grid extents
+    /// @param section_index: Index in [0, GetSectionCount())
+    AABB GetSectionAABB(uint32_t section_index) const;
+
+    /// Get number of non-air blocks inside a section
+    uint32_t GetSectionBlockCount(uint32_t section_index) const {
+        return section_block_counts_[section_index];
+    }
+
+    /// Copy the block types of a section and its one-block border
+    /// Cells outside the grid read as air
+    /// @param section_index: Index in [0, GetSectionCount())
+    /// @param types: Output array of kPaddedSectionVolume entries, X fastest,
+    ///               where padded cell (1, 1, 1) is the section's first block
+    void GatherPaddedSection(uint32_t section_index, uint8_t* types) const;
+
+    /// Get edit revision of a section
+    /// Incremented every time a block inside the section changes, so derived
+    /// per-section data (occluders, meshes) can detect when it is stale
+    uint32_t GetSectionRevision(uint32_t section_index) const {
+        return section_revisions_[section_index];
+    }
+
+    /// Get mesh revision of a section
+    /// Incremented when a block inside the section or in its one-block border
+    /// changes, since boundary faces and ambient occlusion read those cells;
+    /// a single edit marks at most eight sections (a corner block)
+    uint32_t GetSectionMeshRevision(uint32_t section_index) const {
+        return section_mesh_revisions_[section_index];
+    }
+
 private:
     // Grid parameters
     uint32_t grid_width_;   // Width in blocks (X axis)
@@ -124,10 +251,25 @@ private:
     // Block storage (linear array indexed as [x + y*width + z*width*height])
     std::vector<Block> blocks_;
 
+    // Section grid (kSectionSize^3 blocks per section)
+    uint32_t section_count_x_;
+    uint32_t section_count_y_;
+    uint32_t section_count_z_;
+    std::vector<uint32_t> section_block_counts_;  // Non-air blocks per section
+    std::vector<uint32_t> section_revisions_;     // Edit counter per section
+    std::vector<uint32_t> section_mesh_revisions_;  // Edit counter incl. neighbor borders
+
     // Visibility state
     ViewFrustum frustum_;
     uint32_t total_blocks_;    // Count of non-air blocks in world
     uint32_t visible_blocks_;  // Count of visible non-air blocks
+    std::vector<uint32_t> visible_sections_;  // Non-empty sections in frustum
+    std::vector<uint32_t> previous_visible_sections_;  // Visible set of the previous update
+    std::vector<uint32_t> entered_sections_;  // In visible_sections_ but not the previous set
+    std::vector<uint32_t> left_sections_;     // In the previous set but not visible_sections_
+
+    // Optional octree over solid blocks (null when disabled)
+    std::unique_ptr<VoxelOctree> spatial_index_;
 
     /// Convert 3D grid coordinates to linear array index
     /// @param x, y, z: Grid coordinates
@@ -141,6 +283,13 @@ private:
 
     /// Update total block count (non-air blocks)
     void RecalculateTotalBlockCount();
+
+    /// Get index of the section containing a valid grid coordinate
+    uint32_t SectionIndexForBlock(int32_t x, int32_t y, int32_t z) const;
+
+    /// Bump the mesh revision of the section owning a valid grid coordinate,
+    /// and of each face-adjacent section whose padded border contains it
+    void MarkSectionMeshesDirty(int32_t x, int32_t y, int32_t z);
 };
 
 } // namespace world
@@ -0,0 +1,172 @@
+// include/world/culling_pipeline.h
+// Pipelined visibility culling on a worker thread
+// Culls frame N+1 from a predicted camera while the main thread renders frame N
+
+#ifndef BLEC_WORLD_CULLING_PIPELINE_H
+#define BLEC_WORLD_CULLING_PIPELINE_H
+
+#include "world/block_system.h"
+#include "world/occlusion_culler.h"
+#include "world/section_connectivity.h"
+
+#include <glm/glm.hpp>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+namespace blec {
+namespace world {
+
+/// Camera parameters a culling pass is computed for
+/// The paddings widen the culled volume so the result stays valid for any
+/// camera within position_padding and angle_padding of this one
+struct CullingView {
+    glm::vec3 position;      // Camera position in world space
+    glm::vec3 forward;       // Normalized view direction
+    glm::vec3 up;            // Camera up vector
+    float fov_y;             // Vertical field of view in radians
+    float aspect;            // Viewport width / height
+    float near_plane;        // Near clip distance
+    float far_plane;         // Far clip distance
+    float position_padding;  // World units the frustum planes are pushed out
+    float angle_padding;     // Radians added to each side of the field of view
+};
+
+/// Output of one culling pass
+struct CullingResult {
+    CullingView view;                         // View the pass was computed for
+    std::vector<uint32_t> visible_sections;   // Surviving sections, sorted by index
+    std::vector<uint32_t> entered_sections;   // Visible now but not in the previous Acquire
+    std::vector<uint32_t> left_sections;      // Visible in the previous Acquire but not now
+    uint32_t frustum_section_count;           // Sections inside the padded frustum
+    uint32_t reachable_section_count;         // Sections left after cave culling
+    uint32_t occluded_section_count;          // Sections rejected by occlusion culling
+    uint32_t visible_block_count;             // Non-air blocks inside the padded frustum
+    double cull_time_ms;                      // Time spent in the pass
+};
+
+/// Runs frustum, cave and occlusion culling on a dedicated worker thread
+/// Usage per frame:
+///   1. Acquire() with the real camera - collects the pass submitted last
+///      frame, or culls synchronously if the prediction missed
+///   2. Submit() the predicted view for the next frame, then render
+/// Blocks must not be modified while a pass is in flight; call
+/// WaitForResult() before editing the block system
+class CullingPipeline {
+public:
+    /// Minimum frustum padding applied to predictions (world units)
+    static constexpr float kDefaultMinPadding = 0.5f;
+
+    /// Constructor
+    /// @param blocks: Block system to cull (must outlive the pipeline)
+    explicit CullingPipeline(const BlockSystem& blocks);
+
+    /// Destructor - stops the worker thread
+    ~CullingPipeline();
+
+    /// Start the worker thread
+    /// @return true if the worker is running
+    bool Start();
+
+    /// Finish any pending pass and join the worker thread
+    void Stop();
+
+    /// Check whether the worker thread is running
+    bool IsRunning() const { return worker_.joinable(); }
+
+    /// Queue a culling pass on the worker thread
+    /// Falls back to running it immediately when the worker is not running
+    /// @param view: Camera view to cull for (typically from PredictView)
+    void Submit(const CullingView& view);
+
+    /// Block until the submitted pass has finished
+    /// @return true if a result is available
+    bool WaitForResult();
+
+    /// Run a culling pass synchronously on the calling thread
+    /// Used for the first frame and when a prediction misses the real camera
+    void CullNow(const CullingView& view);
+
+    /// Get a result valid for the real camera this frame
+    /// Uses the pass submitted last frame if Covers() accepts it, otherwise
+    /// culls the real view synchronously and counts a misprediction
+    /// Fills the entered/left lists relative to the previous Acquire
+    /// @param actual: Real camera view (paddings normally zero)
+    const CullingResult& Acquire(const CullingView& actual);
+
+    /// Get the latest completed result (valid after WaitForResult or CullNow)
+    /// Stays unchanged while the next pass runs, until the next WaitForResult
+    const CullingResult& GetResult() const { return result_; }
+
+    /// Check whether a result has been produced yet
+    bool HasResult() const { return has_result_; }
+
+    /// Get number of predicted passes rejected by Acquire() and recomputed
+    uint32_t GetMispredictionCount() const { return mispredictions_; }
+
+    /// Extrapolate the camera one frame ahead from its last two states
+    /// Padding grows with the per-frame motion so that a camera which keeps
+    /// accelerating or turning moderately still lies inside the result
+    /// @param previous: Camera view one frame ago
+    /// @param current: Camera view this frame
+    /// @param min_padding: Lower bound for the position padding
+    static CullingView PredictView(const CullingView& previous, const CullingView& current,
+                                   float min_padding = kDefaultMinPadding);
+
+    /// Check whether a result computed for one view is valid for another
+    /// @param culled: View the result was computed for (with paddings)
+    /// @param actual: Real camera view this frame
+    static bool Covers(const CullingView& culled, const CullingView& actual);
+
+    /// Build the padded frustum for a view
+    static ViewFrustum BuildFrustum(const CullingView& view);
+
+    /// Build the projection of the padded frustum: both half-angles widened
+    /// by angle_padding, so occlusion sees everything the frustum stage kept
+    static glm::mat4 BuildPaddedProjection(const CullingView& view);
+
+private:
+    /// Worker thread entry point
+    void WorkerLoop();
+
+    /// Run all culling stages for a view
+    void RunPass(const CullingView& view, CullingResult* result);
+
+    // Source data (read-only while a pass runs)
+    const BlockSystem& blocks_;
+
+    // Culling stages (owned by whichever thread runs the pass)
+    SectionConnectivity connectivity_;
+    OcclusionCuller occlusion_culler_;
+    std::vector<uint32_t> frustum_sections_;
+    std::vector<uint32_t> reachable_sections_;
+
+    // Results: result_ is read by the caller, pending_result_ written by the
+    // worker and swapped in by WaitForResult
+    CullingResult result_;
+    CullingResult pending_result_;
+    bool has_result_;
+    bool result_ready_;  // pending_result_ holds a finished pass
+    std::vector<uint32_t> acquired_sections_;  // Visible set of the previous Acquire
+    uint32_t mispredictions_;
+
+    // Worker synchronization
+    std::thread worker_;
+    std::mutex mutex_;
+    std::condition_variable job_ready_;
+    std::condition_variable job_done_;
+    CullingView pending_view_;
+    bool job_pending_;   // Submitted but not finished
+    bool stop_;          // Worker should exit
+
+    // Non-copyable
+    CullingPipeline(const CullingPipeline&) = delete;
+    CullingPipeline& operator=(const CullingPipeline&) = delete;
+};
+
+} // namespace world
+} // namespace blec
+
+#endif // BLEC_WORLD_CULLING_PIPELINE_H
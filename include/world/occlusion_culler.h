@@ -0,0 +1,149 @@
+// include/world/occlusion_culler.h
+// CPU software occlusion culling for block sections
+// Rasterizes nearby occluders into a low-resolution depth buffer, builds a
+// hierarchical (hi-Z) depth pyramid and rejects sections hidden behind them
+
+#ifndef BLEC_WORLD_OCCLUSION_CULLER_H
+#define BLEC_WORLD_OCCLUSION_CULLER_H
+
+#include "world/block_system.h"
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+namespace blec {
+namespace world {
+
+/// Software occlusion culler running entirely on the CPU
+/// Usage per frame: Cull() with the frustum-visible sections, then read stats
+class OcclusionCuller {
+public:
+    /// Depth buffer resolution (kept low so rasterization stays cheap)
+    static constexpr int kDepthWidth = 256;
+    static constexpr int kDepthHeight = 128;
+
+    /// Default number of nearest sections rasterized as occluders per frame
+    static constexpr uint32_t kDefaultMaxOccluders = 64;
+
+    /// Constructor - allocates depth buffer and hi-Z pyramid
+    OcclusionCuller();
+
+    /// Destructor
+    ~OcclusionCuller() = default;
+
+    /// Set how many of the nearest sections may be rasterized as occluders
+    void SetMaxOccluders(uint32_t max_occluders) { max_occluders_ = max_occluders; }
+
+    /// Get maximum number of occluder sections per frame
+    uint32_t GetMaxOccluders() const { return max_occluders_; }
+
+    /// Keep results valid for a camera up to padding world units away
+    /// Moving the camera by p shifts an occluder's silhouette by
+    /// p * (d / d_occluder - 1) at distance d, so tested boxes are inflated
+    /// by p times their distance over the nearest occluder's, and nothing is
+    /// occluded once the camera could reach that occluder
+    void SetTestPadding(float padding) { test_padding_ = padding; }
+
+    /// Full culling pass for one frame
+    /// Rasterizes the nearest occluders among candidate_sections, builds the
+    /// hi-Z pyramid and writes the sections that survive to visible_sections
+    /// @param blocks: Block system owning the sections
+    /// @param view_projection: Combined projection * view matrix
+    /// @param camera_position: Camera position in world space
+    /// @param candidate_sections: Frustum-visible section indices
+    /// @param visible_sections: Output list, cleared first (must not alias the input)
+    void Cull(const BlockSystem& blocks, const glm::mat4& view_projection,
+              const glm::vec3& camera_position,
+              const std::vector<uint32_t>& candidate_sections,
+              std::vector<uint32_t>* visible_sections);
+
+    /// Reset the depth buffer to the far plane and set the camera transform
+    /// used by RasterizeOccluder and IsOccluded
+    void BeginFrame(const glm::mat4& view_projection, const glm::vec3& camera_position);
+
+    /// Rasterize the camera-facing sides of an occluder box into the depth buffer
+    /// Boxes crossing the near plane are skipped (never occluding is always safe)
+    void RasterizeOccluder(const AABB& box);
+
+    /// Build the hi-Z pyramid from the depth buffer
+    /// Must be called after the last RasterizeOccluder of the frame
+    void BuildHierarchy();
+
+    /// Test a box against the hi-Z pyramid, inflated by the test padding
+    /// @return true if the box is completely hidden behind rasterized occluders
+    bool IsOccluded(const AABB& box) const;
+
+    /// Get depth buffer value at a pixel (NDC depth, 1.0 = far plane)
+    float GetDepth(int x, int y) const { return depth_levels_[0][y * kDepthWidth + x]; }
+
+    /// Get number of sections tested in the last Cull
+    uint32_t GetTestedSectionCount() const { return tested_sections_; }
+
+    /// Get number of sections rejected as occluded in the last Cull
+    uint32_t GetOccludedSectionCount() const { return occluded_sections_; }
+
+    /// Get number of occluder boxes rasterized in the last Cull
+    uint32_t GetOccluderCount() const { return occluder_count_; }
+
+private:
+    /// Cached occluder box for one section, rebuilt when the section revision changes
+    struct SectionOccluder {
+        uint32_t revision;  // Section revision the box was computed from
+        bool valid;         // Whether revision/box hold computed data
+        bool has_box;       // Whether the section contains a usable occluder
+        AABB box;           // World-space occluder box
+    };
+
+    /// Screen-space vertex produced by projecting a world-space point
+    struct ScreenVertex {
+        float x;  // Pixel X
+        float y;  // Pixel Y
+        float z;  // NDC depth
+    };
+
+    /// Find the largest solid box made of full layers inside a section
+    /// @return true if the section has at least one fully solid layer
+    static bool ComputeSectionOccluder(const BlockSystem& blocks, uint32_t section, AABB* box);
+
+    /// Project a world-space point; returns false if it is behind the near plane
+    bool ProjectPoint(const glm::vec3& point, ScreenVertex* out) const;
+
+    /// Rasterize one screen-space triangle with min depth writes
+    void RasterizeTriangle(const ScreenVertex& v0, const ScreenVertex& v1,
+                           const ScreenVertex& v2);
+
+    // Transform state for the current frame
+    glm::mat4 view_projection_;
+    glm::vec3 camera_position_;
+    float nearest_occluder_;  // Distance to the nearest rasterized occluder
+
+    // Hi-Z pyramid: level 0 is the full-resolution depth buffer, each further
+    // level stores the farthest depth of its 2x2 children
+    std::vector<std::vector<float>> depth_levels_;
+    std::vector<int> level_widths_;
+    std::vector<int> level_heights_;
+
+    // Per-section occluder cache
+    std::vector<SectionOccluder> occluders_;
+
+    // Candidates sorted nearest-first (kept as a member to reuse its storage)
+    std::vector<std::pair<float, uint32_t>> sorted_candidates_;
+
+    // Settings and statistics
+    uint32_t max_occluders_;
+    float test_padding_;
+    uint32_t tested_sections_;
+    uint32_t occluded_sections_;
+    uint32_t occluder_count_;
+
+    // Non-copyable
+    OcclusionCuller(const OcclusionCuller&) = delete;
+    OcclusionCuller& operator=(const OcclusionCuller&) = delete;
+};
+
+} // namespace world
+} // namespace blec
+
+#endif // BLEC_WORLD_OCCLUSION_CULLER_H
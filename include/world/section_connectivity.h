@@ -0,0 +1,107 @@
+// include/world/section_connectivity.h
+// Section connectivity graph for cave culling
+// Records which faces of each section are linked through non-opaque blocks
+// and walks the section grid from the camera to find potentially visible sections
+
+#ifndef BLEC_WORLD_SECTION_CONNECTIVITY_H
+#define BLEC_WORLD_SECTION_CONNECTIVITY_H
+
+#include "world/block_system.h"
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+
+namespace blec {
+namespace world {
+
+/// Faces of a section, ordered so that the opposite face is (face ^ 1)
+enum class SectionFace : uint8_t {
+    NegX = 0,
+    PosX = 1,
+    NegY = 2,
+    PosY = 3,
+    NegZ = 4,
+    PosZ = 5
+};
+
+/// Number of faces on a section
+constexpr int kSectionFaceCount = 6;
+
+/// Cave culling based on per-section face connectivity
+/// Usage per frame: Traverse() from the camera, then FilterSections()
+class SectionConnectivity {
+public:
+    /// Constructor
+    SectionConnectivity();
+
+    /// Destructor
+    ~SectionConnectivity() = default;
+
+    /// Compute which face pairs of a section are linked through air
+    /// @param blocks: Block system owning the section
+    /// @param section_index: Section to analyze
+    /// @return Bit mask with bit (a * 6 + b) set when faces a and b are connected
+    static uint64_t ComputeFaceConnections(const BlockSystem& blocks, uint32_t section_index);
+
+    /// Check whether two faces are connected in a face connection mask
+    static bool AreFacesConnected(uint64_t connections, SectionFace a, SectionFace b) {
+        return (connections >> (static_cast<int>(a) * kSectionFaceCount +
+                                static_cast<int>(b))) & 1u;
+    }
+
+    /// Get cached face connections of a section, recomputing if it was edited
+    uint64_t GetFaceConnections(const BlockSystem& blocks, uint32_t section_index);
+
+    /// Breadth-first walk from the camera's section
+    /// A section is only left through faces connected to the face it was
+    /// entered through, and never back toward the camera
+    /// If the camera is outside the grid, every section is marked reachable
+    /// @param blocks: Block system to traverse
+    /// @param camera_position: Camera position in world space
+    void Traverse(const BlockSystem& blocks, const glm::vec3& camera_position);
+
+    /// Check whether the last Traverse reached a section
+    bool IsReachable(uint32_t section_index) const { return reachable_[section_index] != 0; }
+
+    /// Keep only reachable sections
+    /// @param sections: Input section indices (e.g. frustum-visible sections)
+    /// @param reachable_sections: Output list, cleared first (must not alias the input)
+    void FilterSections(const std::vector<uint32_t>& sections,
+                        std::vector<uint32_t>* reachable_sections) const;
+
+    /// Get number of sections reached by the last Traverse
+    uint32_t GetReachableSectionCount() const { return reachable_count_; }
+
+private:
+    /// Cached face connections for one section
+    struct SectionLinks {
+        uint32_t revision;     // Section revision the mask was computed from
+        bool valid;            // Whether revision/connections hold computed data
+        uint64_t connections;  // Face connection mask
+    };
+
+    /// Pending section in the breadth-first walk
+    struct QueueEntry {
+        uint32_t section;    // Section index
+        int8_t entry_face;   // Face the walk entered through, -1 for the start
+        uint8_t directions;  // Bit per SectionFace stepped through so far
+    };
+
+    // Per-section connectivity cache
+    std::vector<SectionLinks> links_;
+
+    // Traversal state (members so storage is reused between frames)
+    std::vector<uint8_t> reachable_;
+    std::vector<QueueEntry> queue_;
+    uint32_t reachable_count_;
+
+    // Non-copyable
+    SectionConnectivity(const SectionConnectivity&) = delete;
+    SectionConnectivity& operator=(const SectionConnectivity&) = delete;
+};
+
+} // namespace world
+} // namespace blec
+
+#endif // BLEC_WORLD_SECTION_CONNECTIVITY_H
@@ -0,0 +1,133 @@
+// include/world/voxel_octree.h
+// Sparse voxel octree over solid blocks
+// Shared spatial index for frustum, ray and AABB queries on the block grid
+
+#ifndef BLEC_WORLD_VOXEL_OCTREE_H
+#define BLEC_WORLD_VOXEL_OCTREE_H
+
+#include "world/block_system.h"
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+
+namespace blec {
+namespace world {
+
+/// Result of a ray query against the octree
+struct RayHit {
+    glm::ivec3 block;   // Grid coordinates of the first solid block hit
+    glm::ivec3 normal;  // Face normal of the entry face (zero if the ray starts inside)
+    float distance;     // Distance along the ray in world units
+};
+
+/// Sparse octree storing only occupied space
+/// Interior nodes keep the solid count of their subtree, so empty subtrees are
+/// never allocated and fully visible subtrees are counted in one step
+/// Leaves are 4x4x4 bricks stored as 64-bit occupancy masks
+class VoxelOctree {
+public:
+    /// Edge length of a leaf brick in blocks
+    static constexpr int32_t kLeafSize = 4;
+
+    /// Constructor - creates an empty tree spanning the minimum root size
+    VoxelOctree();
+
+    /// Destructor
+    ~VoxelOctree() = default;
+
+    /// Rebuild the tree from the current contents of a block system
+    /// @param blocks: Source grid (tree covers its dimensions and block size)
+    void Build(const BlockSystem& blocks);
+
+    /// Update a single cell incrementally
+    /// Nodes are allocated on demand and released when their subtree empties
+    /// @param x, y, z: Grid coordinates (ignored if outside the tree)
+    /// @param solid: Whether the cell holds a non-air block
+    void SetSolid(int32_t x, int32_t y, int32_t z, bool solid);
+
+    /// Check whether a cell is solid
+    bool IsSolid(int32_t x, int32_t y, int32_t z) const;
+
+    /// Get number of solid cells in the tree
+    uint32_t GetSolidCount() const { return nodes_[kRootNode].solid_count; }
+
+    /// Get number of allocated interior nodes and leaf bricks
+    uint32_t GetNodeCount() const;
+
+    /// Get edge length of the (cubic) root node in blocks
+    int32_t GetRootSize() const { return root_size_; }
+
+    /// Count solid blocks whose bounds intersect a frustum
+    /// Subtrees fully inside the frustum contribute their count without descending
+    uint32_t CountInFrustum(const ViewFrustum& frustum) const;
+
+    /// Collect grid coordinates of solid blocks intersecting a frustum
+    /// @param blocks: Output list (appended to)
+    void QueryFrustum(const ViewFrustum& frustum, std::vector<glm::ivec3>* blocks) const;
+
+    /// Collect grid coordinates of solid blocks overlapping a world-space box
+    /// @param blocks: Output list (appended to)
+    void QueryAABB(const AABB& box, std::vector<glm::ivec3>* blocks) const;
+
+    /// Check whether any solid block overlaps a world-space box
+    /// Stops at the first hit, suitable for collision tests
+    bool OverlapsSolid(const AABB& box) const;
+
+    /// Find the first solid block along a ray
+    /// @param origin: Ray origin in world space
+    /// @param direction: Ray direction (need not be normalized; distance is in its units)
+    /// @param max_distance: Maximum ray parameter to search
+    /// @param hit: Output hit information
+    /// @return true if a solid block was hit within max_distance
+    bool Raycast(const glm::vec3& origin, const glm::vec3& direction, float max_distance,
+                 RayHit* hit) const;
+
+private:
+    /// Index of the root node (always allocated)
+    static constexpr uint32_t kRootNode = 0;
+
+    /// Marker for an empty child subtree
+    static constexpr uint32_t kEmptyChild = 0xFFFFFFFFu;
+
+    /// Interior node: children are nodes, or leaf bricks when the child size
+    /// equals kLeafSize
+    struct Node {
+        uint32_t children[8];  // Child index or kEmptyChild
+        uint32_t solid_count;  // Solid cells in this subtree
+    };
+
+    /// Allocate an interior node or leaf, reusing freed slots
+    uint32_t AllocateNode();
+    uint32_t AllocateLeaf();
+
+    /// Convert a node box in grid units to a world-space AABB
+    AABB NodeBounds(const glm::ivec3& origin, int32_t size) const;
+
+    // Recursive query helpers (size is the node edge length in blocks)
+    uint32_t CountInFrustumNode(uint32_t node, const glm::ivec3& origin, int32_t size,
+                                const ViewFrustum& frustum) const;
+    void QueryFrustumNode(uint32_t node, const glm::ivec3& origin, int32_t size,
+                          const ViewFrustum& frustum, bool fully_inside,
+                          std::vector<glm::ivec3>* blocks) const;
+    bool QueryAABBNode(uint32_t node, const glm::ivec3& origin, int32_t size,
+                       const AABB& box, std::vector<glm::ivec3>* blocks) const;
+    void RaycastNode(uint32_t node, const glm::ivec3& origin, int32_t size,
+                     const glm::vec3& ray_origin, const glm::vec3& ray_direction,
+                     RayHit* best, bool* found) const;
+
+    // Node storage; freed slots are recycled through the free lists
+    std::vector<Node> nodes_;
+    std::vector<uint64_t> leaves_;
+    std::vector<uint32_t> free_nodes_;
+    std::vector<uint32_t> free_leaves_;
+
+    // Tree dimensions
+    int32_t root_size_;   // Power of two >= largest grid dimension
+    float block_size_;    // World units per block
+};
+
+} // namespace world
+} // namespace blec
+
+#endif // BLEC_WORLD_VOXEL_OCTREE_H
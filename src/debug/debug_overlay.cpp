@@ -5,6 +5,7 @@
 #include "input/input_handler.h"
 #include "render/font.h"
 #include "render/renderer.h"
+#include "render/ui_command_list.h"
 
 #include <cstdio>
 
@@ -23,6 +24,25 @@ DebugOverlay::DebugOverlay()
     , camera_pitch_(0.0f)
     , total_blocks_(0)
     , visible_blocks_(0)
+    , visible_sections_(0)
+    , occluded_sections_(0)
+    , rendered_faces_(0)
+    , faces_per_block_(0.0f)
+    , meshing_mode_()
+    , meshed_triangles_(0)
+    , mesh_build_time_ms_(0.0)
+    , mesh_gpu_bytes_(0)
+    , mesh_upload_bytes_(0)
+    , arena_utilization_(0.0f)
+    , arena_fragmentation_(0.0f)
+    , queued_commands_(0)
+    , state_calls_(0)
+    , skipped_state_calls_(0)
+    , overlay_draw_calls_(0)
+    , overlay_primitives_(0)
+    , simulation_time_ms_(0.0)
+    , render_time_ms_(0.0)
+    , submit_wait_ms_(0.0)
     , error_count_(0)
     , last_error_()
     , warning_count_(0)
@@ -53,17 +73,30 @@ void DebugOverlay::Render(int screenWidth, int screenHeight, const render::Bitma
         return;
     }
 
+    render::UiCommandList commands;
+    Record(&commands, input);
+
+    render::Renderer::Begin2D(screenWidth, screenHeight);
+    commands.Execute(font);
+    render::Renderer::End2D();
+}
+
+void DebugOverlay::Record(render::UiCommandList* commands, const input::InputHandler& input) const {
+    if (!visible_) {
+        return;
+    }
+
     // Build debug information lines
     std::vector<std::string> lines = BuildDebugLines(input);
 
     // Calculate overlay dimensions
     const float scale = 2.0f;
     const float padding = 10.0f;
-    const float lineHeight = font.GetCharHeight(scale);
+    const float lineHeight = render::BitmapFont::GetCharHeight(scale);
 
     float maxWidth = 0.0f;
     for (const auto& line : lines) {
-        float width = static_cast<float>(line.size()) * font.GetCharWidth(scale);
+        float width = static_cast<float>(line.size()) * render::BitmapFont::GetCharWidth(scale);
         if (width > maxWidth) {
             maxWidth = width;
         }
@@ -72,24 +105,21 @@ void DebugOverlay::Render(int screenWidth, int screenHeight, const render::Bitma
     float boxWidth = maxWidth + padding * 2.0f;
     float boxHeight = lineHeight * static_cast<float>(lines.size()) + padding * 2.0f;
 
-    // Begin 2D rendering
-    render::Renderer::Begin2D(screenWidth, screenHeight);
-    render::Renderer::EnableBlending();
+    commands->EnableBlending();
 
     // Draw semi-transparent background box
-    render::Renderer::SetColor(0.0f, 0.0f, 0.0f, 0.6f);
-    render::Renderer::DrawFilledRect(padding, padding, boxWidth, boxHeight);
+    commands->SetColor(0.0f, 0.0f, 0.0f, 0.6f);
+    commands->DrawFilledRect(padding, padding, boxWidth, boxHeight);
 
     // Draw debug text
-    render::Renderer::SetColor(0.9f, 0.95f, 1.0f, 1.0f);
+    commands->SetColor(0.9f, 0.95f, 1.0f, 1.0f);
     float textY = padding * 2.0f;
     for (const auto& line : lines) {
-        font.DrawText(padding * 2.0f, textY, scale, line);
+        commands->DrawText(padding * 2.0f, textY, scale, line);
         textY += lineHeight;
     }
 
-    render::Renderer::DisableBlending();
-    render::Renderer::End2D();
+    commands->DisableBlending();
 }
 
 void DebugOverlay::RecordError(const std::string& error) {
@@ -118,6 +148,51 @@ void DebugOverlay::SetBlockCounts(uint32_t total_blocks, uint32_t visible_blocks
     visible_blocks_ = visible_blocks;
 }
 
+void DebugOverlay::SetSectionCounts(uint32_t visible_sections, uint32_t occluded_sections) {
+    visible_sections_ = visible_sections;
+    occluded_sections_ = occluded_sections;
+}
+
+void DebugOverlay::SetMeshStats(uint32_t rendered_faces, float faces_per_block) {
+    rendered_faces_ = rendered_faces;
+    faces_per_block_ = faces_per_block;
+}
+
+void DebugOverlay::SetMeshingInfo(const std::string& mode, uint32_t meshed_triangles,
+                                  double build_time_ms) {
+    meshing_mode_ = mode;
+    meshed_triangles_ = meshed_triangles;
+    mesh_build_time_ms_ = build_time_ms;
+}
+
+void DebugOverlay::SetMeshMemory(size_t gpu_bytes, size_t upload_bytes) {
+    mesh_gpu_bytes_ = gpu_bytes;
+    mesh_upload_bytes_ = upload_bytes;
+}
+
+void DebugOverlay::SetMeshArena(float utilization, float fragmentation) {
+    arena_utilization_ = utilization;
+    arena_fragmentation_ = fragmentation;
+}
+
+void DebugOverlay::SetRenderQueue(uint32_t commands, uint32_t state_calls,
+                                  uint32_t skipped_calls) {
+    queued_commands_ = commands;
+    state_calls_ = state_calls;
+    skipped_state_calls_ = skipped_calls;
+}
+
+void DebugOverlay::SetOverlayBatch(uint32_t draw_calls, uint32_t primitives) {
+    overlay_draw_calls_ = draw_calls;
+    overlay_primitives_ = primitives;
+}
+
+void DebugOverlay::SetFrameTimes(double simulation_ms, double render_ms, double wait_ms) {
+    simulation_time_ms_ = simulation_ms;
+    render_time_ms_ = render_ms;
+    submit_wait_ms_ = wait_ms;
+}
+
 std::vector<std::string> DebugOverlay::BuildDebugLines(const input::InputHandler& input) const {
     char buffer[256];
     std::vector<std::string> lines;
@@ -129,6 +204,10 @@ std::vector<std::string> DebugOverlay::BuildDebugLines(const input::InputHandler
     std::snprintf(buffer, sizeof(buffer), "FPS: %.1f", fps_);
     lines.emplace_back(buffer);
 
+    std::snprintf(buffer, sizeof(buffer), "Sim: %.2f ms  Render: %.2f ms  Wait: %.2f ms",
+                  simulation_time_ms_, render_time_ms_, submit_wait_ms_);
+    lines.emplace_back(buffer);
+
     // ======== Camera Section ========
     lines.emplace_back("=== CAMERA ===");
 
@@ -152,6 +231,41 @@ std::vector<std::string> DebugOverlay::BuildDebugLines(const input::InputHandler
     std::snprintf(buffer, sizeof(buffer), "Visible Blocks: %u", visible_blocks_);
     lines.emplace_back(buffer);
 
+    // Section culling counts
+    std::snprintf(buffer, sizeof(buffer), "Visible Sections: %u", visible_sections_);
+    lines.emplace_back(buffer);
+
+    std::snprintf(buffer, sizeof(buffer), "Occluded Sections: %u", occluded_sections_);
+    lines.emplace_back(buffer);
+
+    // Chunk mesh counts
+    std::snprintf(buffer, sizeof(buffer), "Rendered Faces: %u", rendered_faces_);
+    lines.emplace_back(buffer);
+
+    std::snprintf(buffer, sizeof(buffer), "Faces/Block: %.2f", faces_per_block_);
+    lines.emplace_back(buffer);
+
+    std::snprintf(buffer, sizeof(buffer), "Meshing: %s  Triangles: %u  Build: %.2f ms",
+                  meshing_mode_.c_str(), meshed_triangles_, mesh_build_time_ms_);
+    lines.emplace_back(buffer);
+
+    std::snprintf(buffer, sizeof(buffer), "Mesh Memory: %.1f KB  Upload: %.1f KB",
+                  static_cast<double>(mesh_gpu_bytes_) / 1024.0,
+                  static_cast<double>(mesh_upload_bytes_) / 1024.0);
+    lines.emplace_back(buffer);
+
+    std::snprintf(buffer, sizeof(buffer), "Mesh Arena: %.0f%% used  %.0f%% fragmented",
+                  arena_utilization_ * 100.0f, arena_fragmentation_ * 100.0f);
+    lines.emplace_back(buffer);
+
+    std::snprintf(buffer, sizeof(buffer), "Draw Queue: %u  GL State: %u set  %u skipped",
+                  queued_commands_, state_calls_, skipped_state_calls_);
+    lines.emplace_back(buffer);
+
+    std::snprintf(buffer, sizeof(buffer), "2D Batch: %u draws  %u primitives",
+                  overlay_draw_calls_, overlay_primitives_);
+    lines.emplace_back(buffer);
+
     // ======== Input Section ========
     lines.emplace_back("=== INPUT ===");
 
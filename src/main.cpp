@@ -1,15 +1,22 @@
 // main.cpp
 // Entry point for B-Lec game prototype
 // Integrates window management, input handling, 3D rendering, block system, debug overlay, and UI
+// The main thread polls input and simulates; a render thread owning the GL
+// context draws the previous frame's packet at the same time
 
 #include "window/window_manager.h"
 #include "input/input_handler.h"
 #include "render/renderer.h"
 #include "render/font.h"
 #include "render/camera.h"
-#include "render/mesh.h"
+#include "render/chunk_renderer.h"
+#include "render/block_instancer.h"
+#include "render/frame_pipeline.h"
+#include "render/batch_2d.h"
 #include "debug/debug_overlay.h"
 #include "world/block_system.h"
+#include "world/culling_pipeline.h"
+#include "world/voxel_octree.h"
 #include "ui/ui_manager.h"
 
 #include <GLFW/glfw3.h>
@@ -17,6 +24,8 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <chrono>
 #include <cstdio>
+#include <string>
+#include <thread>
 
 namespace {
 
@@ -25,6 +34,15 @@ constexpr int kWindowWidth = 1280;
 constexpr int kWindowHeight = 720;
 constexpr const char* kWindowTitle = "B-Lec Prototype";
 
+// Maximum distance for breaking and placing blocks, in world units
+constexpr float kBlockReach = 8.0f;
+
+// Edge length of the placement preview cube, in world units
+constexpr float kPreviewBlockScale = 0.35f;
+
+// Vertical field of view, in degrees
+constexpr float kFieldOfView = 45.0f;
+
 // GLFW error callback
 void GLFWErrorCallback(int error, const char* description) {
     std::fprintf(stderr, "GLFW Error %d: %s\n", error, description);
@@ -54,28 +72,137 @@ int main() {
         return 1;
     }
 
-    window_manager.MakeContextCurrent();
-    window_manager.SetVSync(1); // Enable VSync
-
-    // Initialize renderer
-    renderer.Initialize();
-
     // Initialize UI manager with window dimensions
     ui_manager.Initialize(kWindowWidth, kWindowHeight);
 
-    // Initialize camera
-    camera.Initialize(glm::vec3(0.0f, 0.0f, 2.0f), glm::vec3(0.0f, 0.0f, 0.0f));
+    // Initialize camera in front of the test blocks at the grid center
+    camera.Initialize(glm::vec3(16.5f, 18.5f, 26.0f), glm::vec3(16.5f, 16.5f, 16.5f));
     camera.SetMovementSpeed(5.0f);  // 5 units per second
     camera.SetRotationSpeed(0.005f); // radians per pixel
 
-    // Create cube mesh
-    blec::render::Mesh cube = blec::render::Mesh::CreateCube();
-    cube.SetBackfaceCulling(true);  // Only render front-facing faces
-
     // Initialize block system
     blec::world::BlockSystem block_system;
     block_system.Initialize(32, 32, 32, 1.0f);  // 32x32x32 grid with 1 unit blocks
     block_system.CreateTestBlocks();  // Create initial test block cube at center
+    block_system.EnableSpatialIndex();  // Octree for visibility counts and queries
+
+    // Frustum, cave and occlusion culling run on a worker thread one frame
+    // ahead, using a predicted camera
+    blec::world::CullingPipeline culling_pipeline(block_system);
+    culling_pipeline.Start();
+    blec::world::CullingView previous_view{};
+    bool has_previous_view = false;
+
+    // Per-section meshes of the block world (only faces touching air), built
+    // on worker threads and uploaded under a per-frame budget
+    // Owned by the render thread after it starts
+    blec::render::ChunkRenderer chunk_renderer;
+    chunk_renderer.StartWorkers();
+
+    // Loose cubes drawn on top of the sections (the placement preview),
+    // instanced in one draw call; filled from each packet on the render thread
+    blec::render::BlockInstancer block_instancer;
+
+    // Frame packets travel from this thread to the render thread, which draws
+    // frame N while this thread simulates frame N+1
+    // The meshing mode and render path live in the packet; the render thread
+    // applies them to the ChunkRenderer
+    blec::render::FramePipeline frame_pipeline;
+    blec::render::MeshingMode meshing_mode = chunk_renderer.GetMeshingMode();
+    blec::render::ChunkRenderPath render_path = chunk_renderer.GetRenderPath();
+
+    std::thread render_thread([&]() {
+        using render_clock = std::chrono::steady_clock;
+        window_manager.MakeContextCurrent();
+        window_manager.SetVSync(1); // Enable VSync
+        renderer.Initialize();
+
+        while (const blec::render::FramePacket* packet = frame_pipeline.AcquirePacket()) {
+            const auto render_start = render_clock::now();
+            blec::render::FrameStats stats = frame_pipeline.GetStats();
+            stats.frame_index = packet->frame_index;
+
+            // Minimized: nothing to draw, keep presenting for VSync pacing
+            if (packet->framebuffer_width <= 0 || packet->framebuffer_height <= 0) {
+                window_manager.SwapBuffers();
+                frame_pipeline.ReleasePacket(stats);
+                continue;
+            }
+
+            if (chunk_renderer.GetMeshingMode() != packet->meshing_mode) {
+                chunk_renderer.SetMeshingMode(packet->meshing_mode);
+            }
+            // Applied only when the request changes, so a fallback to packed
+            // vertices sticks until F8 asks for another path
+            chunk_renderer.RequestRenderPath(packet->render_path);
+
+            // Set viewport and clear screen
+            renderer.SetViewport(packet->framebuffer_width, packet->framebuffer_height);
+            renderer.Clear(0.1f, 0.15f, 0.2f, 1.0f); // Dark blue background
+
+            // ===== RENDER 3D SCENE =====
+            renderer.Begin3D(packet->framebuffer_width, packet->framebuffer_height,
+                             packet->fov_y_degrees);
+            renderer.SetProjection(packet->projection);
+            renderer.SetView(packet->view);
+
+            // Render the visible sections of the block world; the renderer
+            // places each section mesh at its origin, so no model transform is needed
+            chunk_renderer.Update(block_system, packet->visible_sections);
+
+            // Record the frame's 3D draws, then execute them sorted by pass,
+            // program, state and depth; each carries its own culling and depth state
+            block_instancer.Assign(packet->cubes);
+            block_instancer.SetScale(packet->cube_scale);
+            renderer.SubmitChunks(&chunk_renderer, &packet->visible_sections);
+            renderer.SubmitInstances(&block_instancer);
+            renderer.Flush();
+            renderer.End3D();
+
+            // ===== RENDER 2D OVERLAY =====
+            renderer.Begin2D(packet->framebuffer_width, packet->framebuffer_height);
+            packet->ui.Execute(font);
+            renderer.End2D();
+            renderer.EndFrame();
+
+            // Swap buffers to display rendered frame
+            window_manager.SwapBuffers();
+
+            // Statistics for the overlay of a later frame
+            stats.rendered_faces = chunk_renderer.GetRenderedFaceCount();
+            stats.faces_per_block = chunk_renderer.GetFacesPerBlock();
+            stats.meshing_name =
+                std::string(blec::render::ChunkMesher::GetModeName(chunk_renderer.GetMeshingMode())) +
+                " / " + blec::render::ChunkRenderer::GetRenderPathName(chunk_renderer.GetRenderPath());
+            stats.render_path = chunk_renderer.GetRenderPath();
+            stats.meshed_triangles = chunk_renderer.GetMeshedTriangleCount();
+            stats.mesh_build_time_ms = chunk_renderer.GetLastBuildTimeMs();
+            stats.mesh_gpu_bytes = chunk_renderer.GetGpuMeshBytes();
+            stats.mesh_upload_bytes = chunk_renderer.GetLastUploadBytes();
+            const blec::render::BufferAllocatorStats arena_stats =
+                chunk_renderer.GetArena().GetStats();
+            stats.arena_utilization = arena_stats.GetUtilization();
+            stats.arena_fragmentation = arena_stats.GetFragmentation();
+            const blec::render::GlStateCache& gl_state =
+                blec::render::GlStateCache::ForCurrentContext();
+            stats.flushed_commands = static_cast<uint32_t>(renderer.GetLastFlushCommandCount());
+            stats.state_calls = gl_state.GetLastFrameIssuedCount();
+            stats.skipped_state_calls = gl_state.GetLastFrameSkippedCount();
+            const blec::render::Batch2D& batch_2d = blec::render::Batch2D::ForCurrentContext();
+            stats.overlay_draw_calls = batch_2d.GetLastFrameDrawCallCount();
+            stats.overlay_primitives = batch_2d.GetLastFramePrimitiveCount();
+            stats.render_time_ms = std::chrono::duration<double, std::milli>(
+                render_clock::now() - render_start).count();
+            frame_pipeline.ReleasePacket(stats);
+        }
+
+        // GL resources belong to this thread's context
+        chunk_renderer.StopWorkers();
+        chunk_renderer.ReleaseGpuResources();
+        block_instancer.ReleaseGpuResources();
+        renderer.ReleaseGpuResources();
+        window_manager.ReleaseContext();
+    });
 
     // Register input callbacks
     input_handler.RegisterCallbacks(window_manager.GetHandle());
@@ -87,6 +214,10 @@ int main() {
     // Static for toggle states
     static bool f12_was_down = false;
     static bool esc_was_down = false;
+    static bool f9_was_down = false;
+    static bool f8_was_down = false;
+    static bool break_was_down = false;
+    static bool place_was_down = false;
 
     // Main game loop
     while (!window_manager.ShouldClose()) {
@@ -99,6 +230,11 @@ int main() {
         // Poll for events
         window_manager.PollEvents();
 
+        // The packet this frame fills; the render thread draws the other one
+        blec::render::FramePacket& packet = frame_pipeline.GetWritePacket();
+        packet.cubes.clear();
+        packet.ui.Clear();
+
         // Handle ESC key to toggle pause (press detection)
         if (input_handler.IsKeyDown(GLFW_KEY_ESCAPE)) {
             if (!esc_was_down) {
@@ -149,6 +285,31 @@ int main() {
             f12_was_down = false;
         }
 
+        // Cycle meshing modes with F9 for A/B comparison (press detection)
+        if (input_handler.IsKeyDown(GLFW_KEY_F9)) {
+            if (!f9_was_down) {
+                meshing_mode = blec::render::ChunkMesher::GetNextMode(meshing_mode);
+                f9_was_down = true;
+            }
+        } else {
+            f9_was_down = false;
+        }
+
+        // Toggle packed vertices / vertex pulling with F8 (press detection)
+        if (input_handler.IsKeyDown(GLFW_KEY_F8)) {
+            if (!f8_was_down) {
+                // Toggle from the path in use, which differs from the
+                // requested one after a fallback
+                render_path = frame_pipeline.GetStats().render_path ==
+                                      blec::render::ChunkRenderPath::PackedVertices
+                                  ? blec::render::ChunkRenderPath::VertexPulling
+                                  : blec::render::ChunkRenderPath::PackedVertices;
+                f8_was_down = true;
+            }
+        } else {
+            f8_was_down = false;
+        }
+
         // Handle camera and gameplay only when not paused
         if (!ui_manager.IsPaused()) {
             // Handle camera movement (WASD keys)
@@ -179,6 +340,44 @@ int main() {
             // Some mice might be inverted, standard is positive Y = look up
             camera.Yaw(static_cast<float>(mouse_dx));
             camera.Pitch(static_cast<float>(-mouse_dy));  // Inverted for natural look
+
+            // Break (left click) or place (right click) the targeted block
+            // Only the touched sections are marked dirty; they are remeshed
+            // once by the chunk renderer's Update when this frame is drawn
+            const bool break_down = input_handler.IsMouseButtonDown(GLFW_MOUSE_BUTTON_LEFT);
+            const bool place_down = input_handler.IsMouseButtonDown(GLFW_MOUSE_BUTTON_RIGHT);
+            const blec::world::VoxelOctree* spatial_index = block_system.GetSpatialIndex();
+            blec::world::RayHit hit{};
+            const bool has_hit =
+                spatial_index != nullptr &&
+                spatial_index->Raycast(camera.GetPosition(), camera.GetForward(),
+                                       kBlockReach, &hit);
+
+            // Preview where a right click would place a block
+            if (has_hit && hit.normal != glm::ivec3(0)) {
+                packet.cubes.push_back(blec::render::BlockInstancer::MakeInstance(
+                    glm::vec3(hit.block + hit.normal) + glm::vec3(0.5f), 1));
+            }
+
+            if (((break_down && !break_was_down) || (place_down && !place_was_down)) &&
+                has_hit) {
+                // The culling pass in flight and the frame being drawn read
+                // the blocks
+                culling_pipeline.WaitForResult();
+                frame_pipeline.WaitForIdle();
+                if (break_down && !break_was_down) {
+                    block_system.SetBlock(hit.block.x, hit.block.y, hit.block.z,
+                                          blec::world::Block{0});
+                } else if (hit.normal != glm::ivec3(0)) {
+                    const glm::ivec3 target = hit.block + hit.normal;
+                    if (block_system.GetBlock(target.x, target.y, target.z).type == 0) {
+                        block_system.SetBlock(target.x, target.y, target.z,
+                                              blec::world::Block{1});
+                    }
+                }
+            }
+            break_was_down = break_down;
+            place_was_down = place_down;
         }
 
         // Update camera and debug overlay
@@ -190,81 +389,92 @@ int main() {
         int fb_height = 0;
         window_manager.GetFramebufferSize(&fb_width, &fb_height);
 
+        packet.framebuffer_width = fb_width;
+        packet.framebuffer_height = fb_height;
         if (fb_width <= 0 || fb_height <= 0) {
-            window_manager.SwapBuffers();
+            frame_pipeline.Submit();
             input_handler.ResetMouseDelta();
             continue;
         }
 
-        // Set viewport and clear screen
-        renderer.SetViewport(fb_width, fb_height);
-        renderer.Clear(0.1f, 0.15f, 0.2f, 1.0f); // Dark blue background
-
         // ===== UPDATE BLOCK SYSTEM =====
         // Create projection matrix for frustum extraction
-        glm::mat4 projection = glm::perspective(glm::radians(45.0f),
-                                                static_cast<float>(fb_width) / fb_height,
-                                                0.1f, 100.0f);
+        const float aspect = static_cast<float>(fb_width) / fb_height;
+        glm::mat4 projection = glm::perspective(glm::radians(kFieldOfView), aspect, 0.1f, 100.0f);
         glm::mat4 view = camera.GetViewMatrix();
+        glm::vec3 cam_pos = camera.GetPosition();
 
-        // Extract camera frustum and update block visibility
+        // Keep the main-thread frustum current for other queries
         block_system.ExtractFrustum(view, projection);
-        block_system.UpdateVisibility();
+
+        // Collect the culling pass computed while the last frame rendered
+        // (recomputed here if the camera left its padded prediction), then
+        // start the pass for the next frame
+        blec::world::CullingView current_view{cam_pos, camera.GetForward(), camera.GetUp(),
+                                              glm::radians(kFieldOfView), aspect, 0.1f, 100.0f,
+                                              0.0f, 0.0f};
+        const blec::world::CullingResult& culling = culling_pipeline.Acquire(current_view);
+        packet.visible_sections = culling.visible_sections;
+        culling_pipeline.Submit(blec::world::CullingPipeline::PredictView(
+            has_previous_view ? previous_view : current_view, current_view));
+        previous_view = current_view;
+        has_previous_view = true;
+
+        // ===== FILL FRAME PACKET =====
+        packet.view = view;
+        packet.projection = projection;
+        packet.fov_y_degrees = kFieldOfView;
+        packet.cube_scale = kPreviewBlockScale;
+        packet.meshing_mode = meshing_mode;
+        packet.render_path = render_path;
 
         // Update debug overlay with camera and block information
-        glm::vec3 cam_pos = camera.GetPosition();
         debug_overlay.SetCameraPosition(cam_pos.x, cam_pos.y, cam_pos.z);
         debug_overlay.SetCameraOrientation(camera.GetYaw(), camera.GetPitch());
         
         // Set block counts
         debug_overlay.SetBlockCounts(block_system.GetTotalBlockCount(),
-                                     block_system.GetVisibleBlockCount());
-
-        // ===== RENDER 3D SCENE =====
-        renderer.Begin3D(fb_width, fb_height, 45.0f);
-
-        // Set view matrix from camera
-        renderer.SetView(view);
-
-        // Render cube at origin
-        glm::mat4 model = glm::mat4(1.0f);  // Identity matrix (cube at origin)
-        renderer.SetModel(model);
-
-        // Enable back-face culling
-        renderer.EnableBackfaceCulling();
-
-        // Render the cube
-        cube.Render();
-
-        // Disable back-face culling before 2D
-        renderer.DisableBackfaceCulling();
-
-        renderer.End3D();
-
-        // ===== RENDER 2D OVERLAY =====
-        renderer.Begin2D(fb_width, fb_height);
-
-        // Render crosshair (always visible)
-        ui_manager.RenderCrosshair(renderer);
-
-        // Render pause menu (only when paused)
-        ui_manager.RenderPauseMenu(renderer, font);
-
-        // Render debug overlay if visible
-        if (debug_overlay.IsVisible()) {
-            debug_overlay.Render(fb_width, fb_height, font, input_handler);
-        }
-
-        renderer.End2D();
-
-        // Swap buffers to display rendered frame
-        window_manager.SwapBuffers();
+                                     culling.visible_block_count);
+        debug_overlay.SetSectionCounts(static_cast<uint32_t>(packet.visible_sections.size()),
+                                       culling.occluded_section_count);
+
+        // Render statistics lag by the frames still in flight
+        const blec::render::FrameStats stats = frame_pipeline.GetStats();
+        debug_overlay.SetMeshStats(stats.rendered_faces, stats.faces_per_block);
+        debug_overlay.SetMeshingInfo(stats.meshing_name, stats.meshed_triangles,
+                                     stats.mesh_build_time_ms);
+        debug_overlay.SetMeshMemory(stats.mesh_gpu_bytes, stats.mesh_upload_bytes);
+        debug_overlay.SetMeshArena(stats.arena_utilization, stats.arena_fragmentation);
+        debug_overlay.SetRenderQueue(stats.flushed_commands, stats.state_calls,
+                                     stats.skipped_state_calls);
+        debug_overlay.SetOverlayBatch(stats.overlay_draw_calls, stats.overlay_primitives);
+
+        // ===== RECORD 2D OVERLAY =====
+        // Crosshair (always visible)
+        ui_manager.RecordCrosshair(&packet.ui);
+
+        // Pause menu (only when paused)
+        ui_manager.RecordPauseMenu(&packet.ui);
+
+        // Debug overlay (only when visible)
+        debug_overlay.SetFrameTimes(
+            std::chrono::duration<double, std::milli>(clock::now() - current_time).count(),
+            stats.render_time_ms, frame_pipeline.GetLastSubmitWaitMs());
+        debug_overlay.Record(&packet.ui, input_handler);
+
+        // Hand the frame to the render thread; waits while it still draws
+        // the previous one
+        frame_pipeline.Submit();
 
         // Reset per-frame input state
         input_handler.ResetMouseDelta();
     }
 
-    // Shutdown
+    // Shutdown: the render thread draws what was submitted, then releases
+    // its GL resources and the context
+    frame_pipeline.Stop();
+    render_thread.join();
+    culling_pipeline.Stop();
     window_manager.Shutdown();
     return 0;
 }
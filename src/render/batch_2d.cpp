@@ -0,0 +1,198 @@
+// render/batch_2d.cpp
+// Implementation of batched 2D overlay drawing
+
+#include "render/batch_2d.h"
+#include "render/gl_functions.h"
+#include "render/gl_state_cache.h"
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+
+namespace blec {
+namespace render {
+
+namespace {
+
+// Vertices per batched primitive
+constexpr size_t kQuadVertices = 6;
+constexpr size_t kLineVertices = 2;
+
+// Convert a 0-1 color channel to a byte
+uint8_t ToByte(float value) {
+    return static_cast<uint8_t>(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+}
+
+} // anonymous namespace
+
+Batch2D::Batch2D()
+    : vertices_(), primitive_(Batch2DPrimitive::Triangles), color_{255, 255, 255, 255},
+      active_(false), atlas_(), solid_uv_(), stream_(), draw_calls_(0), primitives_(0), last_draw_calls_(0),
+      last_primitives_(0) {
+}
+
+Batch2D& Batch2D::ForCurrentContext() {
+    static Batch2D batch;
+    return batch;
+}
+
+bool Batch2D::Initialize() {
+    if (!atlas_.Initialize()) {
+        std::fprintf(stderr, "Failed to create the glyph atlas; text is drawn per pixel\n");
+        return false;
+    }
+    GlyphAtlas::GetSolidTexel(&solid_uv_.u0, &solid_uv_.v0);
+    solid_uv_.u1 = solid_uv_.u0;
+    solid_uv_.v1 = solid_uv_.v0;
+    return true;
+}
+
+void Batch2D::Begin() {
+    Flush();
+    active_ = true;
+}
+
+void Batch2D::End() {
+    Flush();
+    active_ = false;
+    SetTexturing(false);
+}
+
+void Batch2D::SetColor(float r, float g, float b, float a) {
+    // Color is per vertex, so changing it never breaks the batch
+    color_[0] = ToByte(r);
+    color_[1] = ToByte(g);
+    color_[2] = ToByte(b);
+    color_[3] = ToByte(a);
+}
+
+void Batch2D::AddRect(float x, float y, float w, float h) {
+    SetPrimitive(Batch2DPrimitive::Triangles);
+    PushQuad(x, y, w, h, solid_uv_);
+    FlushIfImmediate();
+}
+
+void Batch2D::AddLine(float x1, float y1, float x2, float y2) {
+    SetPrimitive(Batch2DPrimitive::Lines);
+    Push(x1, y1, solid_uv_.u0, solid_uv_.v0);
+    Push(x2, y2, solid_uv_.u0, solid_uv_.v0);
+    FlushIfImmediate();
+}
+
+void Batch2D::AddGlyph(float x, float y, float scale, char c) {
+    GlyphRect uv{};
+    if (!HasAtlas() || !GlyphAtlas::GetGlyphRect(c, &uv)) {
+        return;
+    }
+    SetPrimitive(Batch2DPrimitive::Triangles);
+    PushQuad(x, y, kGlyphWidth * scale, kGlyphHeight * scale, uv);
+    FlushIfImmediate();
+}
+
+void Batch2D::Flush() {
+    if (vertices_.empty()) {
+        return;
+    }
+
+    const size_t bytes = vertices_.size() * sizeof(Batch2DVertex);
+    const StreamSpan span = stream_.Allocate(bytes);
+    std::memcpy(span.data, vertices_.data(), bytes);
+    stream_.Commit(span);
+
+    // Fixed-function arrays: Begin2D loads the orthographic projection into
+    // the matrix stack and no program is bound outside Renderer::Flush
+    // The atlas texels are white, so the default GL_MODULATE leaves the
+    // vertex color and multiplies alpha by glyph coverage; the alpha test
+    // drops uncovered texels even while blending is off
+    const char* base = static_cast<const char*>(stream_.GetPointer(span.offset));
+    SetTexturing(HasAtlas());
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, sizeof(Batch2DVertex), base + offsetof(Batch2DVertex, x));
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Batch2DVertex),
+                   base + offsetof(Batch2DVertex, color));
+    if (HasAtlas()) {
+        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+        glTexCoordPointer(2, GL_FLOAT, sizeof(Batch2DVertex), base + offsetof(Batch2DVertex, u));
+    }
+    const bool lines = primitive_ == Batch2DPrimitive::Lines;
+    glDrawArrays(lines ? GL_LINES : GL_TRIANGLES, 0, static_cast<GLsizei>(vertices_.size()));
+    if (HasAtlas()) {
+        glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    }
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    if (!active_) {
+        // Leave no texturing behind for fixed-function 3D fallbacks
+        SetTexturing(false);
+    }
+    if (gl::HasBufferObjects()) {
+        gl::BindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    draw_calls_ += 1;
+    primitives_ += static_cast<uint32_t>(vertices_.size() / (lines ? kLineVertices
+                                                                    : kQuadVertices));
+    vertices_.clear();
+}
+
+void Batch2D::Release() {
+    vertices_.clear();
+    SetTexturing(false);
+    atlas_.Release();
+    solid_uv_ = GlyphRect{};
+    stream_.Release();
+}
+
+void Batch2D::EndFrame() {
+    stream_.EndFrame();
+    last_draw_calls_ = draw_calls_;
+    last_primitives_ = primitives_;
+    draw_calls_ = 0;
+    primitives_ = 0;
+}
+
+void Batch2D::SetPrimitive(Batch2DPrimitive primitive) {
+    if (primitive != primitive_) {
+        Flush();
+        primitive_ = primitive;
+    }
+}
+
+void Batch2D::Push(float x, float y, float u, float v) {
+    Batch2DVertex vertex;
+    vertex.x = x;
+    vertex.y = y;
+    vertex.u = u;
+    vertex.v = v;
+    std::memcpy(vertex.color, color_, sizeof(color_));
+    vertices_.push_back(vertex);
+}
+
+void Batch2D::PushQuad(float x, float y, float w, float h, const GlyphRect& uv) {
+    Push(x, y, uv.u0, uv.v0);
+    Push(x + w, y, uv.u1, uv.v0);
+    Push(x + w, y + h, uv.u1, uv.v1);
+    Push(x, y, uv.u0, uv.v0);
+    Push(x + w, y + h, uv.u1, uv.v1);
+    Push(x, y + h, uv.u0, uv.v1);
+}
+
+void Batch2D::SetTexturing(bool enabled) {
+    GlStateCache& state = GlStateCache::ForCurrentContext();
+    if (enabled) {
+        state.BindTexture2D(atlas_.GetTexture());
+    }
+    state.SetTexture2D(enabled);
+    state.SetAlphaTest(enabled);
+}
+
+void Batch2D::FlushIfImmediate() {
+    if (!active_) {
+        Flush();
+    }
+}
+
+} // namespace render
+} // namespace blec
@@ -0,0 +1,326 @@
+// render/block_instancer.cpp
+// Implementation of instanced and batched cube drawing
+
+#include "render/block_instancer.h"
+#include "render/chunk_mesher.h"
+#include "render/gl_functions.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+namespace blec {
+namespace render {
+
+namespace {
+
+// Attribute locations; the per-vertex corner stays at 0 since some drivers
+// require attribute 0 to advance per vertex
+constexpr uint32_t kCornerAttribute = 0;
+constexpr uint32_t kInstanceAttribute = 1;
+constexpr uint32_t kTypeAttribute = 2;
+
+const char* const kInstanceAttributes[] = {"a_corner", "a_instance", "a_type"};
+
+// Palette entries the shader can hold (matches the voxel shaders)
+constexpr int kShaderPaletteSize = 8;
+
+// Unit cube in world::SectionFace order (NegX, PosX, NegY, PosY, NegZ, PosZ),
+// four corners per face counter-clockwise when viewed from outside
+const CubeVertex kCubeVertices[kCubeVertexCount] = {
+    {{0, 0, 0}, 0}, {{0, 0, 1}, 0}, {{0, 1, 1}, 0}, {{0, 1, 0}, 0},
+    {{1, 0, 1}, 1}, {{1, 0, 0}, 1}, {{1, 1, 0}, 1}, {{1, 1, 1}, 1},
+    {{0, 0, 0}, 2}, {{1, 0, 0}, 2}, {{1, 0, 1}, 2}, {{0, 0, 1}, 2},
+    {{0, 1, 1}, 3}, {{1, 1, 1}, 3}, {{1, 1, 0}, 3}, {{0, 1, 0}, 3},
+    {{1, 0, 0}, 4}, {{0, 0, 0}, 4}, {{0, 1, 0}, 4}, {{1, 1, 0}, 4},
+    {{0, 0, 1}, 5}, {{1, 0, 1}, 5}, {{1, 1, 1}, 5}, {{0, 1, 1}, 5},
+};
+
+// Triangle corners of a face, relative to its first vertex
+constexpr uint16_t kFaceIndexPattern[6] = {0, 1, 2, 0, 2, 3};
+
+// Same vertex shader for both GPU paths: the instanced path advances
+// a_instance and a_type once per instance, the batched path once per vertex
+const char* const kInstanceVertexShader = R"(#version 120
+attribute vec4 a_corner;    // unit cube corner, face index
+attribute vec3 a_instance;  // cube center
+attribute float a_type;     // palette index
+uniform mat4 u_view_projection;
+uniform float u_scale;
+uniform vec3 u_palette[8];
+uniform float u_face_shade[6];
+varying vec3 v_color;
+void main() {
+    v_color = u_palette[int(a_type)] * u_face_shade[int(a_corner.w)];
+    gl_Position = u_view_projection * vec4(a_instance + (a_corner.xyz - 0.5) * u_scale, 1.0);
+}
+)";
+
+const char* const kInstanceFragmentShader = R"(#version 120
+varying vec3 v_color;
+void main() {
+    gl_FragColor = vec4(v_color, 1.0);
+}
+)";
+
+// Point the instance attributes at a buffer laid out as BlockInstance
+void SetInstancePointers(size_t stride, size_t offset) {
+    gl::VertexAttribPointer(kInstanceAttribute, 3, GL_FLOAT, GL_FALSE,
+                            static_cast<GLsizei>(stride),
+                            reinterpret_cast<const void*>(offset + offsetof(BlockInstance, x)));
+    gl::VertexAttribPointer(kTypeAttribute, 1, GL_UNSIGNED_BYTE, GL_FALSE,
+                            static_cast<GLsizei>(stride),
+                            reinterpret_cast<const void*>(offset +
+                                                          offsetof(BlockInstance, palette)));
+}
+
+} // anonymous namespace
+
+BlockInstancer::BlockInstancer()
+    : scale_(1.0f), gpu_checked_(false), path_(InstancingPath::Immediate),
+      program_(kInvalidShader), scale_location_(-1), cube_vertex_buffer_(0),
+      cube_index_buffer_(0), batch_index_buffer_(0), batch_index_cubes_(0), draw_calls_(0) {
+}
+
+void BlockInstancer::Clear() {
+    instances_.clear();
+}
+
+void BlockInstancer::Add(const glm::vec3& center, uint8_t type) {
+    instances_.push_back(MakeInstance(center, type));
+}
+
+void BlockInstancer::Assign(const std::vector<BlockInstance>& instances) {
+    instances_.assign(instances.begin(), instances.end());
+}
+
+BlockInstance BlockInstancer::MakeInstance(const glm::vec3& center, uint8_t type) {
+    BlockInstance instance{};
+    instance.x = center.x;
+    instance.y = center.y;
+    instance.z = center.z;
+    instance.palette = ChunkMesher::GetPaletteIndex(type);
+    return instance;
+}
+
+const char* BlockInstancer::GetPathName(InstancingPath path) {
+    switch (path) {
+        case InstancingPath::Instanced:
+            return "Instanced";
+        case InstancingPath::Batched:
+            return "Batched";
+        case InstancingPath::Immediate:
+            break;
+    }
+    return "Immediate";
+}
+
+const CubeVertex& BlockInstancer::GetCubeVertex(int index) {
+    return kCubeVertices[index];
+}
+
+uint16_t BlockInstancer::GetCubeIndex(int index) {
+    return static_cast<uint16_t>((index / 6) * 4 + kFaceIndexPattern[index % 6]);
+}
+
+void BlockInstancer::BuildBatchVertices(const std::vector<BlockInstance>& instances,
+                                        std::vector<BatchVertex>* vertices) {
+    vertices->resize(instances.size() * kCubeVertexCount);
+    BatchVertex* out = vertices->data();
+    for (const BlockInstance& instance : instances) {
+        for (const CubeVertex& corner : kCubeVertices) {
+            out->cube = corner;
+            out->instance = instance;
+            ++out;
+        }
+    }
+}
+
+void BlockInstancer::InitializeGpu(ShaderManager* shaders) {
+    gpu_checked_ = true;
+    path_ = InstancingPath::Immediate;
+    if (!gl::HasBufferObjects() || !gl::HasShaders()) {
+        return;
+    }
+
+    program_ = shaders->Find("block_instanced");
+    if (program_ == kInvalidShader) {
+        program_ = shaders->Add("block_instanced", kInstanceVertexShader,
+                                kInstanceFragmentShader, kInstanceAttributes, 3);
+    }
+    if (program_ == kInvalidShader) {
+        return;
+    }
+
+    // Constant uniforms, shared with the section meshes' look
+    const ShaderProgram* program = shaders->Get(program_);
+    glm::vec3 palette[kShaderPaletteSize];
+    const int palette_size = std::min(ChunkMesher::GetPaletteSize(), kShaderPaletteSize);
+    for (int i = 0; i < palette_size; ++i) {
+        palette[i] = ChunkMesher::GetPaletteColor(i);
+    }
+    float face_shades[6];
+    for (int face = 0; face < 6; ++face) {
+        face_shades[face] = ChunkMesher::GetFaceShade(face);
+    }
+    shaders->Use(program_);
+    ShaderProgram::SetUniformArray(program->GetUniformLocation("u_palette"), palette,
+                                   palette_size);
+    ShaderProgram::SetUniformArray(program->GetUniformLocation("u_face_shade"), face_shades, 6);
+    shaders->Unuse();
+    scale_location_ = program->GetUniformLocation("u_scale");
+
+    if (!gl::HasInstancing()) {
+        path_ = InstancingPath::Batched;
+        return;
+    }
+
+    // The shared cube and its 16-bit indices never change
+    uint16_t indices[kCubeIndexCount];
+    for (int i = 0; i < kCubeIndexCount; ++i) {
+        indices[i] = GetCubeIndex(i);
+    }
+    gl::GenBuffers(1, &cube_vertex_buffer_);
+    gl::BindBuffer(GL_ARRAY_BUFFER, cube_vertex_buffer_);
+    gl::BufferData(GL_ARRAY_BUFFER, sizeof(kCubeVertices), kCubeVertices, GL_STATIC_DRAW);
+    gl::GenBuffers(1, &cube_index_buffer_);
+    gl::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, cube_index_buffer_);
+    gl::BufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+    gl::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    gl::BindBuffer(GL_ARRAY_BUFFER, 0);
+    path_ = InstancingPath::Instanced;
+}
+
+void BlockInstancer::Render(ShaderManager* shaders, StreamBuffer* stream) {
+    if (!gpu_checked_) {
+        InitializeGpu(shaders);
+    }
+    draw_calls_ = 0;
+    if (instances_.empty()) {
+        return;
+    }
+
+    if (path_ == InstancingPath::Immediate) {
+        RenderImmediate();
+        draw_calls_ = 1;
+        return;
+    }
+
+    shaders->Use(program_);
+    ShaderProgram::SetUniform(scale_location_, scale_);
+    gl::EnableVertexAttribArray(kCornerAttribute);
+    gl::EnableVertexAttribArray(kInstanceAttribute);
+    gl::EnableVertexAttribArray(kTypeAttribute);
+    if (path_ == InstancingPath::Instanced) {
+        RenderInstanced(stream);
+    } else {
+        RenderBatched(stream);
+    }
+    gl::DisableVertexAttribArray(kTypeAttribute);
+    gl::DisableVertexAttribArray(kInstanceAttribute);
+    gl::DisableVertexAttribArray(kCornerAttribute);
+    gl::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    gl::BindBuffer(GL_ARRAY_BUFFER, 0);
+    shaders->Unuse();
+    draw_calls_ = 1;
+}
+
+void BlockInstancer::RenderInstanced(StreamBuffer* stream) {
+    gl::BindBuffer(GL_ARRAY_BUFFER, cube_vertex_buffer_);
+    gl::VertexAttribPointer(kCornerAttribute, 4, GL_FLOAT, GL_FALSE, sizeof(CubeVertex),
+                            reinterpret_cast<const void*>(0));
+
+    // Instances are rewritten every frame, so they go through the ring
+    // rather than a buffer the previous frame's draw may still read
+    const size_t bytes = instances_.size() * sizeof(BlockInstance);
+    const StreamSpan span = stream->Allocate(bytes);
+    std::memcpy(span.data, instances_.data(), bytes);
+    stream->Commit(span);
+    SetInstancePointers(sizeof(BlockInstance), span.offset);
+    gl::VertexAttribDivisor(kInstanceAttribute, 1);
+    gl::VertexAttribDivisor(kTypeAttribute, 1);
+
+    gl::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, cube_index_buffer_);
+    gl::DrawElementsInstanced(GL_TRIANGLES, kCubeIndexCount, GL_UNSIGNED_SHORT, nullptr,
+                              static_cast<GLsizei>(instances_.size()));
+
+    // Other programs read these locations per vertex
+    gl::VertexAttribDivisor(kInstanceAttribute, 0);
+    gl::VertexAttribDivisor(kTypeAttribute, 0);
+}
+
+void BlockInstancer::ReserveBatchIndices(size_t cube_count) {
+    if (batch_index_buffer_ != 0 && cube_count <= batch_index_cubes_) {
+        return;
+    }
+    size_t capacity = std::max<size_t>(batch_index_cubes_, 64);
+    while (capacity < cube_count) {
+        capacity *= 2;
+    }
+
+    batch_indices_.resize(capacity * kCubeIndexCount);
+    for (size_t cube = 0; cube < capacity; ++cube) {
+        const uint32_t base = static_cast<uint32_t>(cube * kCubeVertexCount);
+        for (int i = 0; i < kCubeIndexCount; ++i) {
+            batch_indices_[cube * kCubeIndexCount + i] = base + GetCubeIndex(i);
+        }
+    }
+    if (batch_index_buffer_ == 0) {
+        gl::GenBuffers(1, &batch_index_buffer_);
+    }
+    gl::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch_index_buffer_);
+    gl::BufferData(GL_ELEMENT_ARRAY_BUFFER,
+                   static_cast<std::ptrdiff_t>(batch_indices_.size() * sizeof(uint32_t)),
+                   batch_indices_.data(), GL_STATIC_DRAW);
+    batch_index_cubes_ = capacity;
+}
+
+void BlockInstancer::RenderBatched(StreamBuffer* stream) {
+    ReserveBatchIndices(instances_.size());
+
+    BuildBatchVertices(instances_, &batch_vertices_);
+    const size_t bytes = batch_vertices_.size() * sizeof(BatchVertex);
+    const StreamSpan span = stream->Allocate(bytes);
+    std::memcpy(span.data, batch_vertices_.data(), bytes);
+    stream->Commit(span);
+    gl::VertexAttribPointer(kCornerAttribute, 4, GL_FLOAT, GL_FALSE, sizeof(BatchVertex),
+                            reinterpret_cast<const void*>(span.offset +
+                                                          offsetof(BatchVertex, cube)));
+    SetInstancePointers(sizeof(BatchVertex), span.offset + offsetof(BatchVertex, instance));
+
+    gl::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch_index_buffer_);
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(instances_.size() * kCubeIndexCount),
+                   GL_UNSIGNED_INT, nullptr);
+}
+
+void BlockInstancer::RenderImmediate() const {
+    glBegin(GL_TRIANGLES);
+    for (const BlockInstance& instance : instances_) {
+        const glm::vec3 center(instance.x, instance.y, instance.z);
+        const glm::vec3 color = ChunkMesher::GetPaletteColor(instance.palette);
+        for (int i = 0; i < kCubeIndexCount; ++i) {
+            const CubeVertex& vertex = kCubeVertices[GetCubeIndex(i)];
+            const glm::vec3 shaded =
+                color * ChunkMesher::GetFaceShade(static_cast<int>(vertex.face));
+            const glm::vec3 position = center + (glm::vec3(vertex.corner[0], vertex.corner[1],
+                                                           vertex.corner[2]) - 0.5f) * scale_;
+            glColor3f(shaded.x, shaded.y, shaded.z);
+            glVertex3f(position.x, position.y, position.z);
+        }
+    }
+    glEnd();
+}
+
+void BlockInstancer::ReleaseGpuResources() {
+    uint32_t* buffers[] = {&cube_vertex_buffer_, &cube_index_buffer_, &batch_index_buffer_};
+    for (uint32_t* buffer : buffers) {
+        if (*buffer != 0) {
+            gl::DeleteBuffers(1, buffer);
+            *buffer = 0;
+        }
+    }
+    batch_index_cubes_ = 0;
+    gpu_checked_ = false;
+}
+
+} // namespace render
+} // namespace blec
@@ -0,0 +1,267 @@
+// render/buffer_allocator.cpp
+// Implementation of size-class sub-allocation and compaction planning
+
+#include "render/buffer_allocator.h"
+#include <algorithm>
+#include <iterator>
+
+namespace blec {
+namespace render {
+
+namespace {
+
+// Sub-classes per power of two (as a shift); rounding wastes at most 25%
+constexpr int kClassSubdivisionBits = 2;
+
+// log2 of kMinAllocationClass
+constexpr int kMinClassLog2 = 4;
+
+// Free lists for classes up to 2^31
+constexpr int kClassCount = (32 - kMinClassLog2) << kClassSubdivisionBits;
+
+// Allocations examined per compaction plan, highest offsets first
+constexpr int kCompactionCandidates = 32;
+
+int FloorLog2(uint32_t value) {
+    int log2 = 0;
+    while (value >>= 1) {
+        ++log2;
+    }
+    return log2;
+}
+
+} // anonymous namespace
+
+float BufferAllocatorStats::GetUtilization() const {
+    if (capacity == 0) {
+        return 0.0f;
+    }
+    return static_cast<float>(requested) / static_cast<float>(capacity);
+}
+
+float BufferAllocatorStats::GetFragmentation() const {
+    if (free == 0) {
+        return 0.0f;
+    }
+    return 1.0f - static_cast<float>(largest_free) / static_cast<float>(free);
+}
+
+BufferAllocator::BufferAllocator(uint32_t capacity)
+    : free_lists_(kClassCount), capacity_(capacity), allocated_(0), requested_(0) {
+    if (capacity > 0) {
+        AddFreeBlock(0, capacity);
+    }
+}
+
+uint32_t BufferAllocator::GetClassSize(uint32_t size) {
+    if (size <= kMinAllocationClass) {
+        return kMinAllocationClass;
+    }
+    const uint32_t step = 1u << (FloorLog2(size) - kClassSubdivisionBits);
+    return (size + step - 1) & ~(step - 1);
+}
+
+int BufferAllocator::GetClassIndex(uint32_t size) {
+    if (size < kMinAllocationClass) {
+        return -1;
+    }
+    const int log2 = FloorLog2(size);
+    const uint32_t sub = (size >> (log2 - kClassSubdivisionBits)) &
+                         ((1u << kClassSubdivisionBits) - 1);
+    return ((log2 - kMinClassLog2) << kClassSubdivisionBits) + static_cast<int>(sub);
+}
+
+uint32_t BufferAllocator::Allocate(uint32_t key, uint32_t size) {
+    const uint32_t class_size = GetClassSize(size);
+
+    // Every block listed at or above the request's class fits it; within a
+    // class the lowest address wins to keep data packed
+    for (int index = GetClassIndex(class_size); index < kClassCount; ++index) {
+        if (free_lists_[index].empty()) {
+            continue;
+        }
+        auto block = free_blocks_.find(*free_lists_[index].begin());
+        const uint32_t offset = block->first;
+        const uint32_t block_size = block->second;
+        RemoveFreeBlock(block);
+        if (block_size > class_size) {
+            AddFreeBlock(offset + class_size, block_size - class_size);
+        }
+
+        allocations_[offset] = Allocation{key, class_size, size};
+        allocated_ += class_size;
+        requested_ += size;
+        return offset;
+    }
+    return kInvalidAllocation;
+}
+
+void BufferAllocator::Free(uint32_t offset) {
+    auto allocation = allocations_.find(offset);
+    if (allocation == allocations_.end()) {
+        return;
+    }
+    allocated_ -= allocation->second.size;
+    requested_ -= allocation->second.requested;
+    const uint32_t size = allocation->second.size;
+    allocations_.erase(allocation);
+    InsertFree(offset, size);
+}
+
+bool BufferAllocator::Resize(uint32_t offset, uint32_t size) {
+    auto found = allocations_.find(offset);
+    if (found == allocations_.end()) {
+        return false;
+    }
+    Allocation& allocation = found->second;
+    const uint32_t class_size = GetClassSize(size);
+
+    if (class_size <= allocation.size) {
+        if (class_size < allocation.size / 2) {
+            InsertFree(offset + class_size, allocation.size - class_size);
+            allocated_ -= allocation.size - class_size;
+            allocation.size = class_size;
+        }
+    } else {
+        // Grow into a free block that starts right after the allocation
+        auto next = free_blocks_.find(offset + allocation.size);
+        if (next == free_blocks_.end() || allocation.size + next->second < class_size) {
+            return false;
+        }
+        const uint32_t extra = class_size - allocation.size;
+        const uint32_t next_size = next->second;
+        RemoveFreeBlock(next);
+        if (next_size > extra) {
+            AddFreeBlock(offset + class_size, next_size - extra);
+        }
+        allocated_ += extra;
+        allocation.size = class_size;
+    }
+
+    requested_ = requested_ - allocation.requested + size;
+    allocation.requested = size;
+    return true;
+}
+
+uint32_t BufferAllocator::GetAllocationSize(uint32_t offset) const {
+    auto allocation = allocations_.find(offset);
+    return (allocation != allocations_.end()) ? allocation->second.size : 0;
+}
+
+void BufferAllocator::Grow(uint32_t capacity) {
+    if (capacity <= capacity_) {
+        return;
+    }
+    const uint32_t old_capacity = capacity_;
+    capacity_ = capacity;
+    InsertFree(old_capacity, capacity - old_capacity);
+}
+
+void BufferAllocator::Reset() {
+    free_blocks_.clear();
+    for (std::set<uint32_t>& list : free_lists_) {
+        list.clear();
+    }
+    allocations_.clear();
+    allocated_ = 0;
+    requested_ = 0;
+    if (capacity_ > 0) {
+        AddFreeBlock(0, capacity_);
+    }
+}
+
+bool BufferAllocator::PlanCompaction(BufferMove* move) const {
+    int candidates = 0;
+    for (auto allocation = allocations_.rbegin();
+         allocation != allocations_.rend() && candidates < kCompactionCandidates;
+         ++allocation, ++candidates) {
+        const uint32_t offset = allocation->first;
+        const uint32_t size = allocation->second.size;
+
+        // Lowest free block below the allocation that holds it; it cannot
+        // overlap the allocation since it ends at or before its start
+        for (const auto& block : free_blocks_) {
+            if (block.first >= offset) {
+                break;
+            }
+            if (block.second >= size) {
+                *move = BufferMove{allocation->second.key, offset, block.first, size};
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void BufferAllocator::ApplyMove(const BufferMove& move) {
+    auto allocation = allocations_.find(move.from);
+    auto block = free_blocks_.find(move.to);
+    if (allocation == allocations_.end() || block == free_blocks_.end() ||
+        block->second < allocation->second.size) {
+        return;
+    }
+
+    const Allocation moved = allocation->second;
+    const uint32_t block_size = block->second;
+    RemoveFreeBlock(block);
+    if (block_size > moved.size) {
+        AddFreeBlock(move.to + moved.size, block_size - moved.size);
+    }
+    allocations_.erase(allocation);
+    allocations_[move.to] = moved;
+    InsertFree(move.from, moved.size);
+}
+
+BufferAllocatorStats BufferAllocator::GetStats() const {
+    BufferAllocatorStats stats{};
+    stats.capacity = capacity_;
+    stats.allocated = allocated_;
+    stats.requested = requested_;
+    stats.free_blocks = static_cast<uint32_t>(free_blocks_.size());
+    stats.allocations = static_cast<uint32_t>(allocations_.size());
+    for (const auto& block : free_blocks_) {
+        stats.free += block.second;
+        stats.largest_free = std::max(stats.largest_free, block.second);
+    }
+    return stats;
+}
+
+void BufferAllocator::InsertFree(uint32_t offset, uint32_t size) {
+    if (size == 0) {
+        return;
+    }
+
+    auto next = free_blocks_.lower_bound(offset);
+    if (next != free_blocks_.begin()) {
+        auto previous = std::prev(next);
+        if (previous->first + previous->second == offset) {
+            offset = previous->first;
+            size += previous->second;
+            RemoveFreeBlock(previous);
+        }
+    }
+    if (next != free_blocks_.end() && offset + size == next->first) {
+        size += next->second;
+        RemoveFreeBlock(next);
+    }
+    AddFreeBlock(offset, size);
+}
+
+void BufferAllocator::AddFreeBlock(uint32_t offset, uint32_t size) {
+    free_blocks_[offset] = size;
+    const int index = GetClassIndex(size);
+    if (index >= 0) {
+        free_lists_[index].insert(offset);
+    }
+}
+
+void BufferAllocator::RemoveFreeBlock(std::map<uint32_t, uint32_t>::iterator block) {
+    const int index = GetClassIndex(block->second);
+    if (index >= 0) {
+        free_lists_[index].erase(block->first);
+    }
+    free_blocks_.erase(block);
+}
+
+} // namespace render
+} // namespace blec
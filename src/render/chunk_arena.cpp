@@ -0,0 +1,172 @@
+// render/chunk_arena.cpp
+// Implementation of the shared section vertex buffer
+
+#include "render/chunk_arena.h"
+#include "render/gl_functions.h"
+#include <algorithm>
+
+namespace blec {
+namespace render {
+
+ChunkArena::ChunkArena(uint32_t capacity)
+    : vertices_(capacity), allocator_(capacity), growth_count_(0), compaction_moves_(0),
+      buffer_(0), gpu_bytes_(0), grown_(false) {
+}
+
+ChunkArena::~ChunkArena() {
+    // GL buffers must be released explicitly while the context is current
+}
+
+size_t ChunkArena::Store(uint32_t key, const std::vector<VoxelVertex>& vertices,
+                         const glm::ivec3& section_coord) {
+    const uint32_t count = static_cast<uint32_t>(vertices.size());
+    if (count == 0) {
+        Remove(key);
+        return 0;
+    }
+    if (key >= ranges_.size()) {
+        ranges_.resize(key + 1, ArenaRange{0, 0});
+    }
+
+    uint32_t first = ranges_[key].first;
+    if (ranges_[key].count == 0 || !allocator_.Resize(first, count)) {
+        if (ranges_[key].count != 0) {
+            allocator_.Free(first);
+        }
+        first = Allocate(key, count);
+    }
+    ranges_[key] = ArenaRange{first, count};
+
+    const uint8_t sx = static_cast<uint8_t>(section_coord.x);
+    const uint8_t sy = static_cast<uint8_t>(section_coord.y);
+    const uint8_t sz = static_cast<uint8_t>(section_coord.z);
+    VoxelVertex* out = vertices_.data() + first;
+    for (uint32_t i = 0; i < count; ++i) {
+        out[i] = vertices[i];
+        out[i].section[0] = sx;
+        out[i].section[1] = sy;
+        out[i].section[2] = sz;
+    }
+    return UploadSpan(first, count);
+}
+
+void ChunkArena::Remove(uint32_t key) {
+    if (key >= ranges_.size() || ranges_[key].count == 0) {
+        return;
+    }
+    allocator_.Free(ranges_[key].first);
+    ranges_[key] = ArenaRange{0, 0};
+}
+
+void ChunkArena::Clear() {
+    ranges_.clear();
+    allocator_.Reset();
+}
+
+ArenaRange ChunkArena::GetRange(uint32_t key) const {
+    if (key >= ranges_.size()) {
+        return ArenaRange{0, 0};
+    }
+    return ranges_[key];
+}
+
+uint32_t ChunkArena::Compact(uint32_t max_vertices) {
+    uint32_t moved = 0;
+    BufferMove move{};
+    while (moved < max_vertices &&
+           allocator_.GetStats().GetFragmentation() > kArenaCompactionThreshold &&
+           allocator_.PlanCompaction(&move)) {
+        // Source and destination never overlap (see PlanCompaction)
+        std::copy(vertices_.begin() + move.from, vertices_.begin() + move.from + move.size,
+                  vertices_.begin() + move.to);
+        if (buffer_ != 0) {
+            if (gl::HasCopyBuffer()) {
+                gl::BindBuffer(GL_COPY_READ_BUFFER, buffer_);
+                gl::BindBuffer(GL_COPY_WRITE_BUFFER, buffer_);
+                gl::CopyBufferSubData(
+                    GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+                    static_cast<std::ptrdiff_t>(move.from * sizeof(VoxelVertex)),
+                    static_cast<std::ptrdiff_t>(move.to * sizeof(VoxelVertex)),
+                    static_cast<std::ptrdiff_t>(move.size * sizeof(VoxelVertex)));
+                gl::BindBuffer(GL_COPY_READ_BUFFER, 0);
+                gl::BindBuffer(GL_COPY_WRITE_BUFFER, 0);
+            } else {
+                UploadSpan(move.to, move.size);
+            }
+        }
+
+        allocator_.ApplyMove(move);
+        ranges_[move.key].first = move.to;
+        moved += move.size;
+        compaction_moves_ += 1;
+    }
+    return moved;
+}
+
+uint32_t ChunkArena::Allocate(uint32_t key, uint32_t count) {
+    uint32_t first = allocator_.Allocate(key, count);
+    if (first != kInvalidAllocation) {
+        return first;
+    }
+
+    uint32_t capacity = std::max(GetCapacity(), BufferAllocator::GetClassSize(count));
+    do {
+        capacity *= 2;
+        allocator_.Grow(capacity);
+        first = allocator_.Allocate(key, count);
+    } while (first == kInvalidAllocation);
+    vertices_.resize(capacity);
+    growth_count_ += 1;
+    grown_ = true;
+    return first;
+}
+
+size_t ChunkArena::UploadSpan(uint32_t first, uint32_t count) {
+    if (buffer_ == 0) {
+        return 0;
+    }
+    gl::BindBuffer(GL_ARRAY_BUFFER, buffer_);
+    size_t bytes = 0;
+    if (grown_) {
+        // A larger buffer is respecified from the CPU copy
+        gpu_bytes_ = vertices_.size() * sizeof(VoxelVertex);
+        gl::BufferData(GL_ARRAY_BUFFER, static_cast<std::ptrdiff_t>(gpu_bytes_),
+                       vertices_.data(), GL_DYNAMIC_DRAW);
+        grown_ = false;
+        bytes = gpu_bytes_;
+    } else {
+        bytes = count * sizeof(VoxelVertex);
+        gl::BufferSubData(GL_ARRAY_BUFFER,
+                          static_cast<std::ptrdiff_t>(first * sizeof(VoxelVertex)),
+                          static_cast<std::ptrdiff_t>(bytes), vertices_.data() + first);
+    }
+    gl::BindBuffer(GL_ARRAY_BUFFER, 0);
+    return bytes;
+}
+
+void ChunkArena::EnableGpu() {
+    if (buffer_ == 0) {
+        gl::GenBuffers(1, &buffer_);
+    }
+    gpu_bytes_ = vertices_.size() * sizeof(VoxelVertex);
+    gl::BindBuffer(GL_ARRAY_BUFFER, buffer_);
+    gl::BufferData(GL_ARRAY_BUFFER, static_cast<std::ptrdiff_t>(gpu_bytes_), vertices_.data(),
+                   GL_DYNAMIC_DRAW);
+    gl::BindBuffer(GL_ARRAY_BUFFER, 0);
+    grown_ = false;
+}
+
+void ChunkArena::Release() {
+    if (buffer_ != 0) {
+        gl::DeleteBuffers(1, &buffer_);
+        buffer_ = 0;
+    }
+    gpu_bytes_ = 0;
+}
+
+void ChunkArena::Bind() const {
+    gl::BindBuffer(GL_ARRAY_BUFFER, buffer_);
+}
+
+} // namespace render
+} // namespace blec
@@ -0,0 +1,509 @@
+// render/chunk_mesher.cpp
+// Implementation of hidden-face-culled and greedy section meshing
+
+#include "render/chunk_mesher.h"
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace blec {
+namespace render {
+
+namespace {
+
+// Step between neighboring padded cells along each face normal
+// (NegX, PosX, NegY, PosY, NegZ, PosZ)
+constexpr int32_t kPaddedStrides[6] = {
+    -1, 1,
+    -world::kPaddedSectionSize, world::kPaddedSectionSize,
+    -world::kPaddedSectionSize * world::kPaddedSectionSize,
+    world::kPaddedSectionSize * world::kPaddedSectionSize
+};
+
+// Step between neighboring padded cells along each axis (X, Y, Z)
+constexpr int32_t kAxisStrides[3] = {
+    1, world::kPaddedSectionSize, world::kPaddedSectionSize * world::kPaddedSectionSize
+};
+
+// Offsets along (u, v) of a face's corners in EmitRectangle order, for faces
+// pointing along -a and +a
+constexpr int kCornerOffsets[2][4][2] = {
+    {{0, 0}, {0, 1}, {1, 1}, {1, 0}},
+    {{0, 0}, {1, 0}, {1, 1}, {0, 1}}
+};
+
+// Compute the ambient occlusion level of each corner of a visible face from
+// the three cells touching the corner in front of the face (two sides and
+// the diagonal); two solid sides occlude the corner fully
+// index: Padded cell of the block; ao receives the levels in EmitRectangle order
+// Returns true if any corner is occluded
+bool ComputeFaceOcclusion(const uint8_t* types, int32_t index, int face, uint8_t* ao) {
+    const int a = face / 2;
+    const int32_t stride_u = kAxisStrides[(a + 1) % 3];
+    const int32_t stride_v = kAxisStrides[(a + 2) % 3];
+    const int32_t front = index + kPaddedStrides[face];
+    const int (*offsets)[2] = kCornerOffsets[face & 1];
+
+    bool occluded = false;
+    for (int corner = 0; corner < 4; ++corner) {
+        const int32_t du = offsets[corner][0] != 0 ? stride_u : -stride_u;
+        const int32_t dv = offsets[corner][1] != 0 ? stride_v : -stride_v;
+        const int side_u = types[front + du] != 0 ? 1 : 0;
+        const int side_v = types[front + dv] != 0 ? 1 : 0;
+        const int diagonal = types[front + du + dv] != 0 ? 1 : 0;
+        ao[corner] = static_cast<uint8_t>((side_u != 0 && side_v != 0) ? 3
+                                                                        : side_u + side_v + diagonal);
+        occluded = occluded || ao[corner] != 0;
+    }
+    return occluded;
+}
+
+// Index of the padded cell holding section-local block (x, y, z)
+inline int32_t PaddedIndex(int32_t x, int32_t y, int32_t z) {
+    return (x + 1) + ((y + 1) + (z + 1) * world::kPaddedSectionSize) * world::kPaddedSectionSize;
+}
+
+// Base colors for the first block types; others cycle through the table
+constexpr float kBlockColors[][3] = {
+    {0.45f, 0.75f, 0.35f},  // 1: grass
+    {0.55f, 0.40f, 0.25f},  // 2: dirt
+    {0.55f, 0.55f, 0.58f},  // 3: stone
+    {0.85f, 0.80f, 0.55f},  // 4: sand
+    {0.60f, 0.45f, 0.30f}   // 5: wood
+};
+constexpr int kBlockColorCount = sizeof(kBlockColors) / sizeof(kBlockColors[0]);
+
+// Brightness per ambient occlusion level (0 = unoccluded)
+constexpr float kAmbientOcclusionShades[kAmbientOcclusionLevels] = {1.0f, 0.8f, 0.65f, 0.5f};
+
+// Index of the lowest set bit (mask must be non-zero)
+inline int CountTrailingZeros(uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(mask);
+#else
+    int count = 0;
+    for (; (mask & 1u) == 0; mask >>= 1) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+// Bits covering one section row (padding excluded)
+constexpr uint32_t kRowMask = (1u << world::kSectionSize) - 1u;
+
+// Face rows of one block type for every face direction and slice
+// rows[face][slice][j] has bit i set when the face at (slice, i, j) is visible
+struct FacePlanes {
+    uint16_t rows[6][world::kSectionSize][world::kSectionSize];
+};
+
+// Plane index meaning "no plane yet"; 16 bits hold one per block type
+constexpr uint16_t kNoPlane = 0xFFFF;
+constexpr int kBlockTypeCount = 256;
+
+// BuildBinary working set, kept per thread so repeated builds reuse the
+// planes (3 KB per block type) instead of allocating them every section
+struct BinaryScratch {
+    std::vector<FacePlanes> planes;       // Grown to the most types seen in one section
+    uint8_t plane_types[kBlockTypeCount]; // Block type of each used plane
+    uint16_t plane_of_type[kBlockTypeCount];
+};
+
+BinaryScratch& GetBinaryScratch() {
+    thread_local BinaryScratch scratch;
+    return scratch;
+}
+
+} // anonymous namespace
+
+glm::vec3 ChunkMesher::GetBlockColor(uint8_t type) {
+    return GetPaletteColor(GetPaletteIndex(type));
+}
+
+uint8_t ChunkMesher::GetPaletteIndex(uint8_t type) {
+    return static_cast<uint8_t>((std::max<int>(type, 1) - 1) % kBlockColorCount);
+}
+
+int ChunkMesher::GetPaletteSize() {
+    return kBlockColorCount;
+}
+
+glm::vec3 ChunkMesher::GetPaletteColor(int index) {
+    const float* color = kBlockColors[index];
+    return glm::vec3(color[0], color[1], color[2]);
+}
+
+float ChunkMesher::GetAmbientOcclusionShade(int level) {
+    return kAmbientOcclusionShades[level];
+}
+
+float ChunkMesher::GetFaceShade(int face) {
+    // Top brightest, bottom darkest, X and Z sides in between
+    static const float kShades[6] = {0.75f, 0.75f, 0.5f, 1.0f, 0.85f, 0.85f};
+    return kShades[face];
+}
+
+const char* ChunkMesher::GetModeName(MeshingMode mode) {
+    switch (mode) {
+        case MeshingMode::Greedy:
+            return "Greedy";
+        case MeshingMode::Binary:
+            return "Binary";
+        default:
+            return "Culled";
+    }
+}
+
+MeshingMode ChunkMesher::GetNextMode(MeshingMode mode) {
+    switch (mode) {
+        case MeshingMode::Culled:
+            return MeshingMode::Greedy;
+        case MeshingMode::Greedy:
+            return MeshingMode::Binary;
+        default:
+            return MeshingMode::Culled;
+    }
+}
+
+ChunkMeshStats ChunkMesher::BuildSectionMesh(const world::BlockSystem& blocks,
+                                             uint32_t section_index, VoxelMesh* mesh,
+                                             MeshingMode mode) {
+    SectionSnapshot snapshot;
+    CaptureSection(blocks, section_index, &snapshot);
+    return Build(snapshot, mesh, mode);
+}
+
+ChunkMeshStats ChunkMesher::BuildSectionMesh(const world::BlockSystem& blocks,
+                                             uint32_t section_index, FaceBuffer* faces,
+                                             MeshingMode mode) {
+    SectionSnapshot snapshot;
+    CaptureSection(blocks, section_index, &snapshot);
+    return Build(snapshot, faces, mode);
+}
+
+ChunkMeshStats ChunkMesher::BuildSectionMesh(const SectionSnapshot& snapshot, VoxelMesh* mesh,
+                                             MeshingMode mode) {
+    return Build(snapshot, mesh, mode);
+}
+
+ChunkMeshStats ChunkMesher::BuildSectionMesh(const SectionSnapshot& snapshot, FaceBuffer* faces,
+                                             MeshingMode mode) {
+    return Build(snapshot, faces, mode);
+}
+
+void ChunkMesher::CaptureSection(const world::BlockSystem& blocks, uint32_t section_index,
+                                 SectionSnapshot* snapshot) {
+    snapshot->solid_blocks = blocks.GetSectionBlockCount(section_index);
+    if (snapshot->solid_blocks != 0) {
+        blocks.GatherPaddedSection(section_index, snapshot->types);
+    }
+}
+
+template <typename Output>
+ChunkMeshStats ChunkMesher::Build(const SectionSnapshot& snapshot, Output* output,
+                                  MeshingMode mode) {
+    using clock = std::chrono::steady_clock;
+    const auto start_time = clock::now();
+
+    ChunkMeshStats stats{0, 0, 0.0};
+    output->Clear();
+
+    if (snapshot.solid_blocks == 0) {
+        return stats;
+    }
+
+    stats.solid_blocks = snapshot.solid_blocks;
+    if (mode == MeshingMode::Binary) {
+        BuildBinary(snapshot.types, output, &stats);
+    } else if (mode == MeshingMode::Greedy) {
+        BuildGreedy(snapshot.types, output, &stats);
+    } else {
+        BuildCulled(snapshot.types, output, &stats);
+    }
+
+    const std::chrono::duration<double, std::milli> elapsed = clock::now() - start_time;
+    stats.build_time_ms = elapsed.count();
+    return stats;
+}
+
+template <typename Output>
+void ChunkMesher::BuildCulled(const uint8_t* types, Output* output, ChunkMeshStats* stats) {
+    for (int32_t z = 0; z < world::kSectionSize; ++z) {
+        for (int32_t y = 0; y < world::kSectionSize; ++y) {
+            for (int32_t x = 0; x < world::kSectionSize; ++x) {
+                const int32_t index = PaddedIndex(x, y, z);
+                const uint8_t type = types[index];
+                if (type == 0) {
+                    continue;
+                }
+
+                const glm::ivec3 local(x, y, z);
+                for (int face = 0; face < 6; ++face) {
+                    // Out-of-grid neighbors read as air, so the world boundary is closed
+                    if (types[index + kPaddedStrides[face]] != 0) {
+                        continue;
+                    }
+
+                    const int a = face / 2;
+                    uint8_t ao[4];
+                    ComputeFaceOcclusion(types, index, face, ao);
+                    EmitRectangle(face, local[a], local[(a + 1) % 3], local[(a + 2) % 3], 1, 1,
+                                  type, output, ao);
+                    stats->faces += 1;
+                }
+            }
+        }
+    }
+}
+
+template <typename Output>
+void ChunkMesher::BuildGreedy(const uint8_t* types, Output* output, ChunkMeshStats* stats) {
+    constexpr int32_t kSize = world::kSectionSize;
+
+    // Block type of each visible face in the current slice (0 = no face)
+    uint8_t mask[kSize * kSize];
+
+    for (int face = 0; face < 6; ++face) {
+        // Slice axis a and in-plane axes u, v chosen cyclically so that
+        // u x v points along +a
+        const int a = face / 2;
+        const int u = (a + 1) % 3;
+        const int v = (a + 2) % 3;
+        const int32_t stride = kPaddedStrides[face];
+
+        for (int32_t slice = 0; slice < kSize; ++slice) {
+            // Build the face mask for this slice
+            for (int32_t j = 0; j < kSize; ++j) {
+                for (int32_t i = 0; i < kSize; ++i) {
+                    glm::ivec3 cell;
+                    cell[a] = slice;
+                    cell[u] = i;
+                    cell[v] = j;
+
+                    const int32_t index = PaddedIndex(cell.x, cell.y, cell.z);
+                    const uint8_t type = types[index];
+                    const bool exposed = type != 0 && types[index + stride] == 0;
+                    mask[i + j * kSize] = exposed ? type : 0;
+
+                    // Occluded faces are emitted alone so their corner
+                    // levels stay on their own block
+                    uint8_t ao[4];
+                    if (exposed && ComputeFaceOcclusion(types, index, face, ao)) {
+                        EmitRectangle(face, slice, i, j, 1, 1, type, output, ao);
+                        stats->faces += 1;
+                        mask[i + j * kSize] = 0;
+                    }
+                }
+            }
+
+            // Greedily cover the mask with maximal same-type rectangles
+            for (int32_t j = 0; j < kSize; ++j) {
+                for (int32_t i = 0; i < kSize;) {
+                    const uint8_t type = mask[i + j * world::kSectionSize];
+                    if (type == 0) {
+                        ++i;
+                        continue;
+                    }
+
+                    // Grow along u, then along v while whole rows match
+                    int32_t width = 1;
+                    while (i + width < kSize && mask[i + width + j * kSize] == type) {
+                        ++width;
+                    }
+                    int32_t height = 1;
+                    for (; j + height < kSize; ++height) {
+                        bool row_matches = true;
+                        for (int32_t k = 0; k < width; ++k) {
+                            if (mask[i + k + (j + height) * kSize] != type) {
+                                row_matches = false;
+                                break;
+                            }
+                        }
+                        if (!row_matches) {
+                            break;
+                        }
+                    }
+
+                    // Clear the covered cells
+                    for (int32_t h = 0; h < height; ++h) {
+                        for (int32_t k = 0; k < width; ++k) {
+                            mask[i + k + (j + h) * kSize] = 0;
+                        }
+                    }
+
+                    EmitRectangle(face, slice, i, j, width, height, type, output);
+                    stats->faces += 1;
+
+                    i += width;
+                }
+            }
+        }
+    }
+}
+
+template <typename Output>
+void ChunkMesher::BuildBinary(const uint8_t* types, Output* output, ChunkMeshStats* stats) {
+    constexpr int32_t kSize = world::kSectionSize;
+    constexpr int32_t kPadded = world::kPaddedSectionSize;
+
+    // Occupancy columns: columns[a][pv][pu] has bit p set when the padded cell
+    // at position p along axis a is solid (u and v as in EmitRectangle)
+    uint32_t columns[3][kPadded][kPadded] = {};
+    for (int32_t z = 0; z < kPadded; ++z) {
+        for (int32_t y = 0; y < kPadded; ++y) {
+            const uint8_t* row = types + (y + z * kPadded) * kPadded;
+            for (int32_t x = 0; x < kPadded; ++x) {
+                const uint32_t solid = row[x] != 0 ? 1u : 0u;
+                columns[0][z][y] |= solid << x;  // Along X: u = Y, v = Z
+                columns[1][x][z] |= solid << y;  // Along Y: u = Z, v = X
+                columns[2][y][x] |= solid << z;  // Along Z: u = X, v = Y
+            }
+        }
+    }
+
+    // One set of face planes per block type present in the section
+    BinaryScratch& scratch = GetBinaryScratch();
+    std::fill(scratch.plane_of_type, scratch.plane_of_type + kBlockTypeCount, kNoPlane);
+    std::vector<FacePlanes>& planes = scratch.planes;
+    size_t plane_count = 0;
+
+    for (int face = 0; face < 6; ++face) {
+        const int a = face / 2;
+        const int u = (a + 1) % 3;
+        const int v = (a + 2) % 3;
+        const bool positive = (face & 1) != 0;
+
+        for (int32_t j = 0; j < kSize; ++j) {
+            for (int32_t i = 0; i < kSize; ++i) {
+                const uint32_t column = columns[a][j + 1][i + 1];
+
+                // Solid cells whose neighbor along the face normal is air,
+                // shifted back so bit k is section-local slice k
+                const uint32_t exposed = positive ? (column & ~(column >> 1))
+                                                  : (column & ~(column << 1));
+                uint32_t faces = (exposed >> 1) & kRowMask;
+
+                // Sort the visible faces into the plane of their block type
+                while (faces != 0) {
+                    const int32_t slice = CountTrailingZeros(faces);
+                    faces &= faces - 1;
+
+                    int32_t cell[3];
+                    cell[a] = slice + 1;
+                    cell[u] = i + 1;
+                    cell[v] = j + 1;
+                    const int32_t index = cell[0] + (cell[1] + cell[2] * kPadded) * kPadded;
+                    const uint8_t type = types[index];
+
+                    // Occluded faces are emitted alone, as in BuildGreedy
+                    uint8_t ao[4];
+                    if (ComputeFaceOcclusion(types, index, face, ao)) {
+                        EmitRectangle(face, slice, i, j, 1, 1, type, output, ao);
+                        stats->faces += 1;
+                        continue;
+                    }
+
+                    uint16_t plane = scratch.plane_of_type[type];
+                    if (plane == kNoPlane) {
+                        plane = static_cast<uint16_t>(plane_count++);
+                        scratch.plane_of_type[type] = plane;
+                        scratch.plane_types[plane] = type;
+                        if (plane < planes.size()) {
+                            planes[plane] = FacePlanes{};  // Reused, clear all rows
+                        } else {
+                            planes.emplace_back();  // Value-initialized, all rows empty
+                        }
+                    }
+                    planes[plane].rows[face][slice][j] |= static_cast<uint16_t>(1u << i);
+                }
+            }
+        }
+    }
+
+    // Cover each plane with rectangles: take the run of set bits starting at
+    // the lowest one, then extend it over following rows that contain it
+    // (yields the same rectangles as BuildGreedy)
+    for (int face = 0; face < 6; ++face) {
+        for (int32_t slice = 0; slice < kSize; ++slice) {
+            for (size_t plane = 0; plane < plane_count; ++plane) {
+                uint16_t* rows = planes[plane].rows[face][slice];
+                for (int32_t j = 0; j < kSize; ++j) {
+                    uint32_t row = rows[j];
+                    while (row != 0) {
+                        const int32_t i = CountTrailingZeros(row);
+                        const int32_t width = CountTrailingZeros(~(row >> i));
+                        const uint32_t run = ((1u << width) - 1u) << i;
+
+                        int32_t height = 1;
+                        while (j + height < kSize && (rows[j + height] & run) == run) {
+                            rows[j + height] = static_cast<uint16_t>(rows[j + height] & ~run);
+                            ++height;
+                        }
+                        row &= ~run;
+
+                        EmitRectangle(face, slice, i, j, width, height,
+                                      scratch.plane_types[plane], output);
+                        stats->faces += 1;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void ChunkMesher::EmitRectangle(int face, int32_t slice, int32_t i, int32_t j, int32_t width,
+                                int32_t height, uint8_t type, VoxelMesh* mesh,
+                                const uint8_t* ao) {
+    const int a = face / 2;
+    const int u = (a + 1) % 3;
+    const int v = (a + 2) % 3;
+    const bool positive = (face & 1) != 0;
+
+    // Rectangle corners in section-local block units, on the face plane
+    glm::ivec3 base(0);
+    base[a] = slice + (positive ? 1 : 0);
+    base[u] = i;
+    base[v] = j;
+    glm::ivec3 du(0);
+    glm::ivec3 dv(0);
+    du[u] = width;
+    dv[v] = height;
+
+    glm::ivec3 corners[4];
+    if (positive) {
+        corners[0] = base;
+        corners[1] = base + du;
+        corners[2] = base + du + dv;
+        corners[3] = base + dv;
+    } else {
+        // Reverse winding for faces pointing along -a
+        corners[0] = base;
+        corners[1] = base + dv;
+        corners[2] = base + du + dv;
+        corners[3] = base + du;
+    }
+    mesh->AddQuad(corners, face, GetPaletteIndex(type), ao);
+}
+
+void ChunkMesher::EmitRectangle(int face, int32_t slice, int32_t i, int32_t j, int32_t width,
+                                int32_t height, uint8_t type, FaceBuffer* faces,
+                                const uint8_t* ao) {
+    const int a = face / 2;
+    glm::ivec3 cell(0);
+    cell[a] = slice;
+    cell[(a + 1) % 3] = i;
+    cell[(a + 2) % 3] = j;
+    faces->AddFace(cell, face, width, height, GetPaletteIndex(type), ao);
+}
+
+} // namespace render
+} // namespace blec
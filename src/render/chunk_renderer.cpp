@@ -0,0 +1,575 @@
+// render/chunk_renderer.cpp
+// Implementation of the per-section mesh cache
+
+#include "render/chunk_renderer.h"
+#include "render/gl_functions.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace blec {
+namespace render {
+
+namespace {
+
+// Palette entries the voxel shaders can hold
+constexpr int kShaderPaletteSize = 8;
+
+// Arena vertices compaction may move per Render (512 KiB)
+constexpr uint32_t kCompactionVerticesPerFrame = 1u << 16;
+
+// Attribute names bound to locations 0 and 1 (see VoxelVertex)
+const char* const kVoxelAttributes[] = {"a_position", "a_material"};
+
+// GLsizei and GLint arguments are passed from int32_t arrays
+static_assert(sizeof(GLsizei) == sizeof(int32_t) && sizeof(GLint) == sizeof(int32_t),
+              "multi-draw arguments must be 32-bit");
+
+// Decodes packed voxel vertices; positions are section-local block units in
+// the section whose grid coordinates the arena stamped into a_material.yzw
+// (16 = world::kSectionSize), and u_origin is the world's min corner
+const char* const kVoxelVertexShader = R"(#version 120
+attribute vec4 a_position;  // x, y, z, face | ao << 3
+attribute vec4 a_material;  // palette index, section x, y, z
+uniform mat4 u_view_projection;
+uniform vec3 u_origin;
+uniform float u_block_size;
+uniform vec3 u_palette[8];
+uniform float u_face_shade[6];
+uniform float u_ao_shade[4];
+varying vec3 v_color;
+void main() {
+    float face = mod(a_position.w, 8.0);
+    float ao = floor(a_position.w / 8.0);
+    v_color = u_palette[int(a_material.x)] * u_face_shade[int(face)] * u_ao_shade[int(ao)];
+    vec3 world = u_origin + (a_material.yzw * 16.0 + a_position.xyz) * u_block_size;
+    gl_Position = u_view_projection * vec4(world, 1.0);
+}
+)";
+
+const char* const kVoxelFragmentShader = R"(#version 120
+varying vec3 v_color;
+void main() {
+    gl_FragColor = vec4(v_color, 1.0);
+}
+)";
+
+// Expands face records fetched from a buffer texture, six vertices per face
+// Mirrors FaceBuffer::ExpandCorner; no vertex attributes are read
+const char* const kPullingVertexShader = R"(#version 140
+uniform usamplerBuffer u_faces;
+uniform mat4 u_view_projection;
+uniform vec3 u_origin;
+uniform float u_block_size;
+uniform vec3 u_palette[8];
+uniform float u_face_shade[6];
+uniform float u_ao_shade[4];
+out vec3 v_color;
+const int kVertexCorners[6] = int[6](0, 1, 2, 0, 2, 3);
+void main() {
+    uvec2 record = texelFetch(u_faces, gl_VertexID / 6).xy;
+    int corner = kVertexCorners[gl_VertexID % 6];
+    int face = int((record.x >> 12u) & 7u);
+    int a = face / 2;
+    bool positive = (face & 1) != 0;
+
+    // Faces along -a walk the corners in the opposite direction
+    int k = positive ? corner : (4 - corner) % 4;
+    vec3 position = vec3(uvec3(record.x, record.x >> 4u, record.x >> 8u) & 15u);
+    position[a] += positive ? 1.0 : 0.0;
+    position[(a + 1) % 3] += (k == 1 || k == 2) ? float((record.x >> 15u) & 15u) + 1.0 : 0.0;
+    position[(a + 2) % 3] += (k >= 2) ? float((record.x >> 19u) & 15u) + 1.0 : 0.0;
+
+    int ao = int((record.y >> uint(8 + corner * 2)) & 3u);
+    v_color = u_palette[int(record.y & 255u)] * u_face_shade[face] * u_ao_shade[ao];
+    gl_Position = u_view_projection * vec4(u_origin + position * u_block_size, 1.0);
+}
+)";
+
+const char* const kPullingFragmentShader = R"(#version 140
+in vec3 v_color;
+out vec4 frag_color;
+void main() {
+    frag_color = vec4(v_color, 1.0);
+}
+)";
+
+// Point the voxel attributes at a vertex of the bound array buffer
+void SetVoxelPointers(uint32_t first_vertex) {
+    const size_t offset = first_vertex * sizeof(VoxelVertex);
+    gl::VertexAttribPointer(0, 4, GL_UNSIGNED_BYTE, GL_FALSE, sizeof(VoxelVertex),
+                            reinterpret_cast<const void*>(offset));
+    gl::VertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_FALSE, sizeof(VoxelVertex),
+                            reinterpret_cast<const void*>(offset + 4));
+}
+
+// Reset the uniform locations of a program that is not built
+void ResetLocations(int32_t* origin, int32_t* block_size, int32_t* view_projection) {
+    *origin = -1;
+    *block_size = -1;
+    *view_projection = -1;
+}
+
+} // anonymous namespace
+
+ChunkRenderer::ChunkRenderer()
+    : block_size_(1.0f), world_origin_(0.0f), gpu_checked_(false), gpu_path_(false),
+      multi_draw_(false), render_path_(ChunkRenderPath::PackedVertices),
+      requested_render_path_(ChunkRenderPath::PackedVertices),
+      mode_(kDefaultMeshingMode), mode_generation_(0), last_version_(0),
+      upload_budget_ms_(kDefaultUploadBudgetMs),
+      frame_uploads_(0), draw_calls_(0), rebuilt_sections_(0), build_time_ms_(0.0), rendered_faces_(0), meshed_faces_(0),
+      meshed_blocks_(0), gpu_bytes_(0), upload_bytes_(0) {
+    ResetLocations(&packed_program_.origin_location, &packed_program_.block_size_location,
+                   &packed_program_.view_projection_location);
+    ResetLocations(&pulling_program_.origin_location, &pulling_program_.block_size_location,
+                   &pulling_program_.view_projection_location);
+}
+
+void ChunkRenderer::SetMeshingMode(MeshingMode mode) {
+    if (mode == mode_) {
+        return;
+    }
+    mode_ = mode;
+    mode_generation_ += 1;
+    DiscardPendingBuilds();
+}
+
+void ChunkRenderer::SetRenderPath(ChunkRenderPath path) {
+    requested_render_path_ = path;
+    ApplyRenderPath(path);
+}
+
+void ChunkRenderer::RequestRenderPath(ChunkRenderPath path) {
+    if (path == requested_render_path_) {
+        return;
+    }
+    SetRenderPath(path);
+}
+
+void ChunkRenderer::FallBackToPackedVertices() {
+    ApplyRenderPath(ChunkRenderPath::PackedVertices);
+}
+
+void ChunkRenderer::ApplyRenderPath(ChunkRenderPath path) {
+    if (path == render_path_) {
+        return;
+    }
+    render_path_ = path;
+
+    // Drop the previous format's geometry, GPU copies included
+    for (SectionEntry& entry : entries_) {
+        entry.valid = false;
+        entry.mesh.Clear();
+        entry.faces.Release();
+        entry.faces.Clear();
+    }
+    arena_.Clear();
+    DiscardPendingBuilds();
+    gpu_bytes_ = 0;
+}
+
+const char* ChunkRenderer::GetRenderPathName(ChunkRenderPath path) {
+    return (path == ChunkRenderPath::VertexPulling) ? "Pulling" : "Packed";
+}
+
+void ChunkRenderer::Update(const world::BlockSystem& blocks,
+                           const std::vector<uint32_t>& sections) {
+    block_size_ = blocks.GetBlockSize();
+    world_origin_ = blocks.GetBlockWorldPosition(0, 0, 0);
+    if (entries_.size() != blocks.GetSectionCount()) {
+        for (SectionEntry& entry : entries_) {
+            entry.faces.Release();
+        }
+        arena_.Clear();
+        gpu_bytes_ = 0;
+        entries_.clear();
+        entries_.resize(blocks.GetSectionCount());
+        for (uint32_t section = 0; section < entries_.size(); ++section) {
+            SectionEntry& entry = entries_[section];
+            blocks.GetSectionCoordinates(section, &entry.coord.x, &entry.coord.y,
+                                         &entry.coord.z);
+            entry.valid = false;
+            entry.mode_generation = 0;
+            entry.arena_stale = false;
+            entry.stats = ChunkMeshStats{0, 0, 0.0};
+            entry.pending_version = 0;
+        }
+        meshed_faces_ = 0;
+        meshed_blocks_ = 0;
+    }
+
+    rebuilt_sections_ = 0;
+    build_time_ms_ = 0.0;
+    const bool async = workers_.IsRunning();
+    if (async) {
+        workers_.CollectResults(&results_);
+        for (MeshResult& result : results_) {
+            ApplyResult(&result);
+        }
+        workers_.RecycleResults(&results_);
+    }
+
+    for (uint32_t section : sections) {
+        SectionEntry& entry = entries_[section];
+        const uint32_t revision = blocks.GetSectionMeshRevision(section);
+        if (entry.valid && entry.revision == revision &&
+            entry.mode_generation == mode_generation_) {
+            continue;
+        }
+
+        if (async) {
+            // Already queued with this revision
+            if (entry.pending_version != 0 && entry.pending_revision == revision) {
+                continue;
+            }
+
+            // A newer version supersedes any build still in flight
+            MeshJob job;
+            job.section_index = section;
+            job.version = ++last_version_;
+            job.mode = mode_;
+            job.build_faces = (render_path_ == ChunkRenderPath::VertexPulling);
+            ChunkMesher::CaptureSection(blocks, section, &job.snapshot);
+            workers_.Submit(job);
+
+            entry.pending_version = job.version;
+            entry.pending_revision = revision;
+            entry.origin = blocks.GetSectionAABB(section).min;
+            continue;
+        }
+
+        // Swap the old mesh's contribution out of the totals
+        meshed_faces_ -= entry.stats.faces;
+        meshed_blocks_ -= entry.stats.solid_blocks;
+
+        if (render_path_ == ChunkRenderPath::VertexPulling) {
+            entry.stats = ChunkMesher::BuildSectionMesh(blocks, section, &entry.faces, mode_);
+        } else {
+            entry.stats = ChunkMesher::BuildSectionMesh(blocks, section, &entry.mesh, mode_);
+        }
+        entry.origin = blocks.GetSectionAABB(section).min;
+        entry.revision = revision;
+        entry.mode_generation = mode_generation_;
+        entry.valid = true;
+        entry.arena_stale = true;
+
+        meshed_faces_ += entry.stats.faces;
+        meshed_blocks_ += entry.stats.solid_blocks;
+        rebuilt_sections_ += 1;
+        build_time_ms_ += entry.stats.build_time_ms;
+    }
+}
+
+bool ChunkRenderer::StartWorkers(uint32_t thread_count) {
+    return workers_.Start(thread_count);
+}
+
+void ChunkRenderer::StopWorkers() {
+    workers_.Stop();
+    DiscardPendingBuilds();
+}
+
+void ChunkRenderer::FlushWorkers() {
+    if (!workers_.IsRunning()) {
+        return;
+    }
+    workers_.WaitForIdle();
+    workers_.CollectResults(&results_);
+    for (MeshResult& result : results_) {
+        ApplyResult(&result);
+    }
+    workers_.RecycleResults(&results_);
+}
+
+void ChunkRenderer::ApplyResult(MeshResult* result) {
+    if (result->section_index >= entries_.size()) {
+        return;
+    }
+    SectionEntry& entry = entries_[result->section_index];
+    if (result->version != entry.pending_version) {
+        return;
+    }
+
+    meshed_faces_ -= entry.stats.faces;
+    meshed_blocks_ -= entry.stats.solid_blocks;
+
+    if (result->build_faces) {
+        entry.faces.TakeGeometry(&result->faces);
+    } else {
+        entry.mesh.TakeGeometry(&result->mesh);
+    }
+    entry.stats = result->stats;
+    // Builds queued before a mode switch were discarded, so this one used
+    // the current mode
+    entry.revision = entry.pending_revision;
+    entry.mode_generation = mode_generation_;
+    entry.valid = true;
+    entry.arena_stale = true;
+    entry.pending_version = 0;
+
+    meshed_faces_ += entry.stats.faces;
+    meshed_blocks_ += entry.stats.solid_blocks;
+    rebuilt_sections_ += 1;
+    build_time_ms_ += entry.stats.build_time_ms;
+}
+
+void ChunkRenderer::DiscardPendingBuilds() {
+    for (SectionEntry& entry : entries_) {
+        entry.pending_version = 0;
+    }
+}
+
+bool ChunkRenderer::BuildProgram(const char* vertex_source, const char* fragment_source,
+                                 VoxelProgram* program) {
+    ShaderProgram& shader = program->program;
+    if (!shader.Build(vertex_source, fragment_source, kVoxelAttributes, 2)) {
+        return false;
+    }
+
+    // Constant uniforms
+    glm::vec3 palette[kShaderPaletteSize];
+    const int palette_size = std::min(ChunkMesher::GetPaletteSize(), kShaderPaletteSize);
+    for (int i = 0; i < palette_size; ++i) {
+        palette[i] = ChunkMesher::GetPaletteColor(i);
+    }
+    float face_shades[6];
+    for (int face = 0; face < 6; ++face) {
+        face_shades[face] = ChunkMesher::GetFaceShade(face);
+    }
+    float ao_shades[kAmbientOcclusionLevels];
+    for (int level = 0; level < kAmbientOcclusionLevels; ++level) {
+        ao_shades[level] = ChunkMesher::GetAmbientOcclusionShade(level);
+    }
+
+    shader.Use();
+    ShaderProgram::SetUniformArray(shader.GetUniformLocation("u_palette"), palette, palette_size);
+    ShaderProgram::SetUniformArray(shader.GetUniformLocation("u_face_shade"), face_shades, 6);
+    ShaderProgram::SetUniformArray(shader.GetUniformLocation("u_ao_shade"), ao_shades,
+                                   kAmbientOcclusionLevels);
+    ShaderProgram::SetUniform(shader.GetUniformLocation("u_faces"), 0);  // Texture unit 0
+    ShaderProgram::Unuse();
+
+    program->origin_location = shader.GetUniformLocation("u_origin");
+    program->block_size_location = shader.GetUniformLocation("u_block_size");
+    program->view_projection_location = shader.GetUniformLocation("u_view_projection");
+    return true;
+}
+
+void ChunkRenderer::InitializeGpu() {
+    gpu_checked_ = true;
+    gpu_path_ = false;
+    if (!gl::HasBufferObjects() || !gl::HasShaders()) {
+        return;
+    }
+    if (!BuildProgram(kVoxelVertexShader, kVoxelFragmentShader, &packed_program_)) {
+        return;
+    }
+    quad_indices_.Upload();
+    arena_.EnableGpu();
+    multi_draw_ = gl::HasMultiDrawBaseVertex();
+    gpu_path_ = true;
+
+    // Vertex pulling is optional on top of the packed path
+    if (gl::HasTextureBuffers()) {
+        BuildProgram(kPullingVertexShader, kPullingFragmentShader, &pulling_program_);
+    }
+}
+
+bool ChunkRenderer::HasUploadBudget() const {
+    return frame_uploads_ == 0 || std::chrono::steady_clock::now() < upload_deadline_;
+}
+
+void ChunkRenderer::UploadIfStale(FaceBuffer* faces) {
+    if (faces->IsUploaded()) {
+        return;
+    }
+    if (!HasUploadBudget()) {
+        return;  // Keep drawing the previous GPU copy
+    }
+    gpu_bytes_ -= faces->GetGpuBytes();
+    faces->Upload();
+    gpu_bytes_ += faces->GetGpuBytes();
+    upload_bytes_ += faces->GetGpuBytes();
+    frame_uploads_ += 1;
+}
+
+void ChunkRenderer::Render(const std::vector<uint32_t>& sections,
+                           const glm::mat4& view_projection) {
+    if (!gpu_checked_) {
+        InitializeGpu();
+    }
+    if (gpu_path_ && render_path_ == ChunkRenderPath::VertexPulling &&
+        !pulling_program_.program.IsValid()) {
+        // Meshes switch format on the next Update; the request is kept so
+        // re-requesting it every frame does not undo the fallback
+        std::fprintf(stderr, "Vertex pulling requires OpenGL 3.1, using packed vertices\n");
+        FallBackToPackedVertices();
+    }
+
+    rendered_faces_ = 0;
+    upload_bytes_ = 0;
+    frame_uploads_ = 0;
+    draw_calls_ = 0;
+    upload_deadline_ = std::chrono::steady_clock::now() +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double, std::milli>(upload_budget_ms_));
+    const bool pulling = (render_path_ == ChunkRenderPath::VertexPulling);
+    const VoxelProgram& program = pulling ? pulling_program_ : packed_program_;
+    if (gpu_path_) {
+        program.program.Use();
+        ShaderProgram::SetUniform(program.block_size_location, block_size_);
+        ShaderProgram::SetUniform(program.view_projection_location, view_projection);
+        if (!pulling) {
+            ShaderProgram::SetUniform(program.origin_location, world_origin_);
+            RenderArena(sections);
+            ShaderProgram::Unuse();
+            return;
+        }
+    }
+
+    for (uint32_t section : sections) {
+        if (section >= entries_.size()) {
+            continue;
+        }
+        SectionEntry& entry = entries_[section];
+        if (!entry.valid || entry.stats.faces == 0) {
+            continue;
+        }
+
+        if (!gpu_path_) {
+            RenderImmediate(entry);
+        } else {
+            UploadIfStale(&entry.faces);
+            ShaderProgram::SetUniform(program.origin_location, entry.origin);
+            entry.faces.Draw();
+        }
+        rendered_faces_ += entry.stats.faces;
+        draw_calls_ += 1;
+    }
+
+    if (gpu_path_) {
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+        ShaderProgram::Unuse();
+    }
+}
+
+void ChunkRenderer::StoreIfStale(uint32_t section, SectionEntry* entry) {
+    if (!entry->arena_stale || !HasUploadBudget()) {
+        return;  // Keep drawing the previous range
+    }
+    upload_bytes_ += arena_.Store(section, entry->mesh.GetVertices(), entry->coord);
+    entry->arena_stale = false;
+    frame_uploads_ += 1;
+}
+
+void ChunkRenderer::RenderArena(const std::vector<uint32_t>& sections) {
+    draw_counts_.clear();
+    draw_offsets_.clear();
+    draw_base_vertices_.clear();
+    for (uint32_t section : sections) {
+        if (section >= entries_.size()) {
+            continue;
+        }
+        SectionEntry& entry = entries_[section];
+        if (!entry.valid) {
+            continue;
+        }
+
+        // Emptied meshes are stored too so their range is freed
+        StoreIfStale(section, &entry);
+        const ArenaRange range = arena_.GetRange(section);
+        if (range.count == 0) {
+            continue;
+        }
+        const uint32_t quads = range.count / kVerticesPerQuad;
+        draw_counts_.push_back(static_cast<int32_t>(quads * kIndicesPerQuad));
+        draw_offsets_.push_back(nullptr);  // Every section starts at index 0
+        draw_base_vertices_.push_back(static_cast<int32_t>(range.first));
+        rendered_faces_ += quads;
+    }
+    if (draw_counts_.empty()) {
+        return;
+    }
+
+    gl::EnableVertexAttribArray(0);
+    gl::EnableVertexAttribArray(1);
+    quad_indices_.Bind();
+    arena_.Bind();
+    if (multi_draw_) {
+        SetVoxelPointers(0);
+        gl::MultiDrawElementsBaseVertex(
+            GL_TRIANGLES, reinterpret_cast<const GLsizei*>(draw_counts_.data()),
+            GL_UNSIGNED_SHORT, draw_offsets_.data(), static_cast<GLsizei>(draw_counts_.size()),
+            reinterpret_cast<const GLint*>(draw_base_vertices_.data()));
+        draw_calls_ = 1;
+    } else {
+        for (size_t i = 0; i < draw_counts_.size(); ++i) {
+            SetVoxelPointers(static_cast<uint32_t>(draw_base_vertices_[i]));
+            glDrawElements(GL_TRIANGLES, draw_counts_[i], GL_UNSIGNED_SHORT, nullptr);
+        }
+        draw_calls_ = static_cast<uint32_t>(draw_counts_.size());
+    }
+    gl::DisableVertexAttribArray(0);
+    gl::DisableVertexAttribArray(1);
+    gl::BindBuffer(GL_ARRAY_BUFFER, 0);
+    gl::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    // Queued after this frame's draw, so the next frame sees the new ranges
+    arena_.Compact(kCompactionVerticesPerFrame);
+}
+
+void ChunkRenderer::RenderImmediate(const SectionEntry& entry) const {
+    glBegin(GL_TRIANGLES);
+    if (render_path_ == ChunkRenderPath::VertexPulling) {
+        for (const FaceRecord& record : entry.faces.GetFaces()) {
+            const glm::vec3 face_color =
+                ChunkMesher::GetPaletteColor(FaceBuffer::DecodeColor(record)) *
+                ChunkMesher::GetFaceShade(FaceBuffer::DecodeFace(record));
+            for (int vertex = 0; vertex < kVerticesPerFace; ++vertex) {
+                const glm::vec3 color = face_color * ChunkMesher::GetAmbientOcclusionShade(
+                    FaceBuffer::DecodeAmbientOcclusion(record, vertex));
+                const glm::vec3 position = entry.origin +
+                    glm::vec3(FaceBuffer::ExpandCorner(record, vertex)) * block_size_;
+                glColor3f(color.x, color.y, color.z);
+                glVertex3f(position.x, position.y, position.z);
+            }
+        }
+    } else {
+        const std::vector<VoxelVertex>& vertices = entry.mesh.GetVertices();
+        for (size_t i = 0; i < entry.mesh.GetIndexCount(); ++i) {
+            const VoxelVertex& vertex = vertices[QuadIndexBuffer::GetIndex(i)];
+            const int face = VoxelMesh::DecodeFace(vertex);
+            const glm::vec3 color = ChunkMesher::GetPaletteColor(vertex.color) *
+                ChunkMesher::GetFaceShade(face) *
+                ChunkMesher::GetAmbientOcclusionShade(VoxelMesh::DecodeAmbientOcclusion(vertex));
+            const glm::vec3 position = entry.origin + VoxelMesh::DecodePosition(vertex) * block_size_;
+            glColor3f(color.x, color.y, color.z);
+            glVertex3f(position.x, position.y, position.z);
+        }
+    }
+    glEnd();
+}
+
+void ChunkRenderer::ReleaseGpuResources() {
+    for (SectionEntry& entry : entries_) {
+        entry.faces.Release();
+    }
+    arena_.Release();
+    packed_program_.program.Release();
+    pulling_program_.program.Release();
+    quad_indices_.Release();
+    gpu_bytes_ = 0;
+    gpu_checked_ = false;
+    gpu_path_ = false;
+    multi_draw_ = false;
+}
+
+float ChunkRenderer::GetFacesPerBlock() const {
+    if (meshed_blocks_ == 0) {
+        return 0.0f;
+    }
+    return static_cast<float>(meshed_faces_) / static_cast<float>(meshed_blocks_);
+}
+
+} // namespace render
+} // namespace blec
@@ -0,0 +1,176 @@
+// render/face_buffer.cpp
+// Implementation of per-face records for vertex pulling
+
+#include "render/face_buffer.h"
+#include "render/gl_functions.h"
+#include <utility>
+
+namespace blec {
+namespace render {
+
+namespace {
+
+// Bit layout of FaceRecord::geometry
+constexpr int kFaceShift = 12;
+constexpr int kWidthShift = 15;
+constexpr int kHeightShift = 19;
+constexpr uint32_t kNibbleMask = 0x0F;
+constexpr uint32_t kFaceMask = 0x07;
+
+// Bit layout of FaceRecord::material
+constexpr int kAmbientOcclusionShift = 8;
+
+// Quad corner used by each generated vertex (triangles 0-1-2 and 0-2-3)
+constexpr int kVertexCorners[kVerticesPerFace] = {0, 1, 2, 0, 2, 3};
+
+// Corner offsets along (u, v), counter-clockwise seen from outside
+// Faces along -a walk the corners in the opposite direction
+constexpr int kPositiveCorners[4][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+constexpr int kNegativeCorners[4][2] = {{0, 0}, {0, 1}, {1, 1}, {1, 0}};
+
+} // anonymous namespace
+
+FaceBuffer::FaceBuffer()
+    : buffer_(0), texture_(0), uploaded_(false), gpu_bytes_(0), gpu_face_count_(0) {
+}
+
+FaceBuffer::~FaceBuffer() {
+    // GL objects must be released explicitly while the context is current
+}
+
+FaceBuffer::FaceBuffer(FaceBuffer&& other) noexcept
+    : faces_(std::move(other.faces_)), buffer_(other.buffer_), texture_(other.texture_),
+      uploaded_(other.uploaded_), gpu_bytes_(other.gpu_bytes_),
+      gpu_face_count_(other.gpu_face_count_) {
+    other.buffer_ = 0;
+    other.texture_ = 0;
+    other.uploaded_ = false;
+    other.gpu_bytes_ = 0;
+    other.gpu_face_count_ = 0;
+}
+
+FaceBuffer& FaceBuffer::operator=(FaceBuffer&& other) noexcept {
+    if (this != &other) {
+        faces_ = std::move(other.faces_);
+        std::swap(buffer_, other.buffer_);
+        std::swap(texture_, other.texture_);
+        std::swap(uploaded_, other.uploaded_);
+        std::swap(gpu_bytes_, other.gpu_bytes_);
+        std::swap(gpu_face_count_, other.gpu_face_count_);
+    }
+    return *this;
+}
+
+void FaceBuffer::Clear() {
+    faces_.clear();
+    uploaded_ = false;
+}
+
+void FaceBuffer::TakeGeometry(FaceBuffer* source) {
+    faces_.swap(source->faces_);
+    source->faces_.clear();
+    source->uploaded_ = false;
+    uploaded_ = false;
+}
+
+void FaceBuffer::AddFace(const glm::ivec3& cell, int face, int32_t width, int32_t height,
+                         uint8_t color, const uint8_t* ao) {
+    FaceRecord record;
+    record.geometry = (static_cast<uint32_t>(cell.x) & kNibbleMask) |
+                      ((static_cast<uint32_t>(cell.y) & kNibbleMask) << 4) |
+                      ((static_cast<uint32_t>(cell.z) & kNibbleMask) << 8) |
+                      ((static_cast<uint32_t>(face) & kFaceMask) << kFaceShift) |
+                      ((static_cast<uint32_t>(width - 1) & kNibbleMask) << kWidthShift) |
+                      ((static_cast<uint32_t>(height - 1) & kNibbleMask) << kHeightShift);
+
+    uint32_t occlusion = 0;
+    if (ao != nullptr) {
+        for (int corner = 0; corner < 4; ++corner) {
+            occlusion |= (static_cast<uint32_t>(ao[corner]) & 0x03u) << (corner * 2);
+        }
+    }
+    record.material = color | (occlusion << kAmbientOcclusionShift);
+
+    faces_.push_back(record);
+    uploaded_ = false;
+}
+
+void FaceBuffer::Upload() {
+    if (buffer_ == 0) {
+        gl::GenBuffers(1, &buffer_);
+        glGenTextures(1, &texture_);
+    }
+
+    const std::ptrdiff_t bytes = static_cast<std::ptrdiff_t>(faces_.size() * sizeof(FaceRecord));
+    gl::BindBuffer(GL_TEXTURE_BUFFER, buffer_);
+    gl::BufferData(GL_TEXTURE_BUFFER, bytes, faces_.data(), GL_STATIC_DRAW);
+    gl::BindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    // Re-attach after every allocation so the texture sees the new storage
+    glBindTexture(GL_TEXTURE_BUFFER, texture_);
+    gl::TexBuffer(GL_TEXTURE_BUFFER, GL_RG32UI, buffer_);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+
+    uploaded_ = true;
+    gpu_bytes_ = static_cast<size_t>(bytes);
+    gpu_face_count_ = faces_.size();
+}
+
+void FaceBuffer::Release() {
+    if (buffer_ != 0) {
+        glDeleteTextures(1, &texture_);
+        gl::DeleteBuffers(1, &buffer_);
+        buffer_ = 0;
+        texture_ = 0;
+    }
+    uploaded_ = false;
+    gpu_bytes_ = 0;
+    gpu_face_count_ = 0;
+}
+
+void FaceBuffer::Draw() const {
+    if (texture_ == 0 || gpu_face_count_ == 0) {
+        return;
+    }
+
+    gl::ActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_BUFFER, texture_);
+    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(gpu_face_count_ * kVerticesPerFace));
+}
+
+glm::ivec3 FaceBuffer::ExpandCorner(const FaceRecord& record, int vertex) {
+    const int face = DecodeFace(record);
+    const int a = face / 2;
+    const int u = (a + 1) % 3;
+    const int v = (a + 2) % 3;
+    const bool positive = (face & 1) != 0;
+
+    glm::ivec3 position(static_cast<int32_t>(record.geometry & kNibbleMask),
+                        static_cast<int32_t>((record.geometry >> 4) & kNibbleMask),
+                        static_cast<int32_t>((record.geometry >> 8) & kNibbleMask));
+    const int32_t width = static_cast<int32_t>((record.geometry >> kWidthShift) & kNibbleMask) + 1;
+    const int32_t height = static_cast<int32_t>((record.geometry >> kHeightShift) & kNibbleMask) + 1;
+
+    const int corner = kVertexCorners[vertex];
+    const int* offset = positive ? kPositiveCorners[corner] : kNegativeCorners[corner];
+    position[a] += positive ? 1 : 0;
+    position[u] += offset[0] * width;
+    position[v] += offset[1] * height;
+    return position;
+}
+
+int FaceBuffer::DecodeFace(const FaceRecord& record) {
+    return static_cast<int>((record.geometry >> kFaceShift) & kFaceMask);
+}
+
+uint8_t FaceBuffer::DecodeColor(const FaceRecord& record) {
+    return static_cast<uint8_t>(record.material & 0xFFu);
+}
+
+int FaceBuffer::DecodeAmbientOcclusion(const FaceRecord& record, int vertex) {
+    const int corner = kVertexCorners[vertex];
+    return static_cast<int>((record.material >> (kAmbientOcclusionShift + corner * 2)) & 0x03u);
+}
+
+} // namespace render
+} // namespace blec
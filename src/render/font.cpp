@@ -2,6 +2,7 @@
 // Implementation of bitmap font rendering
 
 #include "render/font.h"
+#include "render/batch_2d.h"
 #include "render/renderer.h"
 
 namespace blec {
@@ -106,13 +107,28 @@ const unsigned char BitmapFont::kFont5x7[96][5] = {
     {0x02, 0x01, 0x02, 0x04, 0x02}  // 126 '~'
 };
 
-void BitmapFont::DrawChar(float x, float y, float scale, char c) const {
+const unsigned char* BitmapFont::GetGlyph(char c) {
     // Only support ASCII printable characters
     if (c < 32 || c > 126) {
+        return nullptr;
+    }
+    return kFont5x7[c - 32];
+}
+
+void BitmapFont::DrawChar(float x, float y, float scale, char c) const {
+    const unsigned char* glyph = GetGlyph(c);
+    if (glyph == nullptr) {
         return;
     }
 
-    const unsigned char* glyph = kFont5x7[c - 32];
+    // One textured quad when the atlas is available
+    Batch2D& batch = Batch2D::ForCurrentContext();
+    if (batch.HasAtlas()) {
+        if (c != ' ') {
+            batch.AddGlyph(x, y, scale, c);
+        }
+        return;
+    }
 
     // Draw each pixel of the character
     for (int col = 0; col < 5; ++col) {
@@ -0,0 +1,81 @@
+// render/frame_pipeline.cpp
+// Implementation of the simulation to render thread packet hand-off
+
+#include "render/frame_pipeline.h"
+#include <chrono>
+
+namespace blec {
+namespace render {
+
+FramePipeline::FramePipeline()
+    : packets_(), write_index_(0), submitted_(0), submit_wait_ms_(0.0), ready_index_(-1),
+      rendering_(false), stop_(false), stats_() {
+}
+
+void FramePipeline::Submit() {
+    using clock = std::chrono::steady_clock;
+    const auto start_time = clock::now();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    // The render thread may still draw the other packet, and the packet
+    // submitted last frame may not have been picked up yet; both must finish
+    // before the write slot can change hands
+    packet_done_.wait(lock, [this] { return (ready_index_ < 0 && !rendering_) || stop_; });
+    if (stop_) {
+        return;  // Nobody will draw it
+    }
+
+    packets_[write_index_].frame_index = submitted_;
+    submitted_ += 1;
+    ready_index_ = write_index_;
+    write_index_ = 1 - write_index_;
+    lock.unlock();
+    packet_ready_.notify_one();
+
+    submit_wait_ms_ =
+        std::chrono::duration<double, std::milli>(clock::now() - start_time).count();
+}
+
+const FramePacket* FramePipeline::AcquirePacket() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    packet_ready_.wait(lock, [this] { return ready_index_ >= 0 || stop_; });
+    if (ready_index_ < 0) {
+        return nullptr;  // Stopped with nothing left to draw
+    }
+
+    const FramePacket* packet = &packets_[ready_index_];
+    ready_index_ = -1;
+    rendering_ = true;
+    return packet;
+}
+
+void FramePipeline::ReleasePacket(const FrameStats& stats) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_ = stats;
+        rendering_ = false;
+    }
+    packet_done_.notify_all();
+}
+
+void FramePipeline::WaitForIdle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    packet_done_.wait(lock, [this] { return (ready_index_ < 0 && !rendering_) || stop_; });
+}
+
+void FramePipeline::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    packet_ready_.notify_all();
+    packet_done_.notify_all();
+}
+
+FrameStats FramePipeline::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+} // namespace render
+} // namespace blec
@@ -0,0 +1,251 @@
+// render/gl_functions.cpp
+// Runtime loading of OpenGL entry points through GLFW
+
+#include "render/gl_functions.h"
+#include <cstdio>
+#include <cstring>
+
+namespace blec {
+namespace render {
+namespace gl {
+
+GenBuffersProc GenBuffers = nullptr;
+DeleteBuffersProc DeleteBuffers = nullptr;
+BindBufferProc BindBuffer = nullptr;
+BufferDataProc BufferData = nullptr;
+BufferSubDataProc BufferSubData = nullptr;
+
+CreateShaderProc CreateShader = nullptr;
+DeleteShaderProc DeleteShader = nullptr;
+ShaderSourceProc ShaderSource = nullptr;
+CompileShaderProc CompileShader = nullptr;
+GetShaderivProc GetShaderiv = nullptr;
+GetShaderInfoLogProc GetShaderInfoLog = nullptr;
+CreateProgramProc CreateProgram = nullptr;
+DeleteProgramProc DeleteProgram = nullptr;
+AttachShaderProc AttachShader = nullptr;
+BindAttribLocationProc BindAttribLocation = nullptr;
+LinkProgramProc LinkProgram = nullptr;
+GetProgramivProc GetProgramiv = nullptr;
+GetProgramInfoLogProc GetProgramInfoLog = nullptr;
+UseProgramProc UseProgram = nullptr;
+GetUniformLocationProc GetUniformLocation = nullptr;
+Uniform1iProc Uniform1i = nullptr;
+Uniform1fProc Uniform1f = nullptr;
+Uniform3fProc Uniform3f = nullptr;
+Uniform1fvProc Uniform1fv = nullptr;
+Uniform3fvProc Uniform3fv = nullptr;
+UniformMatrix4fvProc UniformMatrix4fv = nullptr;
+
+EnableVertexAttribArrayProc EnableVertexAttribArray = nullptr;
+DisableVertexAttribArrayProc DisableVertexAttribArray = nullptr;
+VertexAttribPointerProc VertexAttribPointer = nullptr;
+
+ActiveTextureProc ActiveTexture = nullptr;
+TexBufferProc TexBuffer = nullptr;
+
+VertexAttribDivisorProc VertexAttribDivisor = nullptr;
+DrawElementsInstancedProc DrawElementsInstanced = nullptr;
+
+MultiDrawElementsBaseVertexProc MultiDrawElementsBaseVertex = nullptr;
+
+CopyBufferSubDataProc CopyBufferSubData = nullptr;
+
+MapBufferRangeProc MapBufferRange = nullptr;
+UnmapBufferProc UnmapBuffer = nullptr;
+
+FenceSyncProc FenceSync = nullptr;
+ClientWaitSyncProc ClientWaitSync = nullptr;
+DeleteSyncProc DeleteSync = nullptr;
+
+BufferStorageProc BufferStorage = nullptr;
+
+namespace {
+
+// Whether each group resolved completely
+bool buffers_loaded = false;
+bool shaders_loaded = false;
+bool texture_buffers_loaded = false;
+bool instancing_loaded = false;
+bool multi_draw_loaded = false;
+bool copy_buffer_loaded = false;
+bool map_range_loaded = false;
+bool sync_loaded = false;
+bool buffer_storage_loaded = false;
+
+// Context version
+int version_major = 0;
+int version_minor = 0;
+
+// Look up one entry point, returning true if it exists
+template <typename Proc>
+bool Load(Proc* proc, const char* name) {
+    *proc = reinterpret_cast<Proc>(glfwGetProcAddress(name));
+    return *proc != nullptr;
+}
+
+// Check the extension string of a compatibility context for a name
+bool HasExtension(const char* name) {
+    const GLubyte* extensions = glGetString(GL_EXTENSIONS);
+    if (extensions == nullptr) {
+        return false;
+    }
+    const char* list = reinterpret_cast<const char*>(extensions);
+    const size_t length = std::strlen(name);
+    for (const char* match = std::strstr(list, name); match != nullptr;
+         match = std::strstr(match + length, name)) {
+        // Reject prefixes of longer names
+        const bool starts = (match == list) || (match[-1] == ' ');
+        const bool ends = (match[length] == ' ') || (match[length] == '\0');
+        if (starts && ends) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // anonymous namespace
+
+bool LoadFunctions() {
+    // Entry points may resolve even when the context lacks them, so newer
+    // features are also gated on the reported version
+    version_major = 0;
+    version_minor = 0;
+    const GLubyte* version = glGetString(GL_VERSION);
+    if (version != nullptr) {
+        std::sscanf(reinterpret_cast<const char*>(version), "%d.%d", &version_major,
+                    &version_minor);
+    }
+
+    bool buffers = true;
+    buffers &= Load(&GenBuffers, "glGenBuffers");
+    buffers &= Load(&DeleteBuffers, "glDeleteBuffers");
+    buffers &= Load(&BindBuffer, "glBindBuffer");
+    buffers &= Load(&BufferData, "glBufferData");
+    buffers &= Load(&BufferSubData, "glBufferSubData");
+    buffers_loaded = buffers;
+
+    bool shaders = true;
+    shaders &= Load(&CreateShader, "glCreateShader");
+    shaders &= Load(&DeleteShader, "glDeleteShader");
+    shaders &= Load(&ShaderSource, "glShaderSource");
+    shaders &= Load(&CompileShader, "glCompileShader");
+    shaders &= Load(&GetShaderiv, "glGetShaderiv");
+    shaders &= Load(&GetShaderInfoLog, "glGetShaderInfoLog");
+    shaders &= Load(&CreateProgram, "glCreateProgram");
+    shaders &= Load(&DeleteProgram, "glDeleteProgram");
+    shaders &= Load(&AttachShader, "glAttachShader");
+    shaders &= Load(&BindAttribLocation, "glBindAttribLocation");
+    shaders &= Load(&LinkProgram, "glLinkProgram");
+    shaders &= Load(&GetProgramiv, "glGetProgramiv");
+    shaders &= Load(&GetProgramInfoLog, "glGetProgramInfoLog");
+    shaders &= Load(&UseProgram, "glUseProgram");
+    shaders &= Load(&GetUniformLocation, "glGetUniformLocation");
+    shaders &= Load(&Uniform1i, "glUniform1i");
+    shaders &= Load(&Uniform1f, "glUniform1f");
+    shaders &= Load(&Uniform3f, "glUniform3f");
+    shaders &= Load(&Uniform1fv, "glUniform1fv");
+    shaders &= Load(&Uniform3fv, "glUniform3fv");
+    shaders &= Load(&UniformMatrix4fv, "glUniformMatrix4fv");
+    shaders &= Load(&EnableVertexAttribArray, "glEnableVertexAttribArray");
+    shaders &= Load(&DisableVertexAttribArray, "glDisableVertexAttribArray");
+    shaders &= Load(&VertexAttribPointer, "glVertexAttribPointer");
+    shaders_loaded = shaders;
+
+    bool texture_buffers = version_major > 3 || (version_major == 3 && version_minor >= 1);
+    texture_buffers &= Load(&ActiveTexture, "glActiveTexture");
+    texture_buffers &= Load(&TexBuffer, "glTexBuffer");
+    texture_buffers_loaded = texture_buffers && shaders && buffers;
+
+    // Core names from 3.3, the ARB suffix on older contexts that expose the
+    // extension (its instanced draw entry point is shared with
+    // ARB_draw_instanced)
+    bool instancing = false;
+    if (version_major > 3 || (version_major == 3 && version_minor >= 3)) {
+        instancing = Load(&VertexAttribDivisor, "glVertexAttribDivisor") &&
+                     Load(&DrawElementsInstanced, "glDrawElementsInstanced");
+    }
+    if (!instancing && HasExtension("GL_ARB_instanced_arrays")) {
+        instancing = Load(&VertexAttribDivisor, "glVertexAttribDivisorARB") &&
+                     Load(&DrawElementsInstanced, "glDrawElementsInstancedARB");
+    }
+    instancing_loaded = instancing && shaders && buffers;
+
+    // The extension uses the core names without a suffix
+    bool multi_draw = version_major > 3 || (version_major == 3 && version_minor >= 2) ||
+                      HasExtension("GL_ARB_draw_elements_base_vertex");
+    multi_draw &= Load(&MultiDrawElementsBaseVertex, "glMultiDrawElementsBaseVertex");
+    multi_draw_loaded = multi_draw && buffers;
+
+    // Same story for ARB_copy_buffer
+    bool copy_buffer = version_major > 3 || (version_major == 3 && version_minor >= 1) ||
+                       HasExtension("GL_ARB_copy_buffer");
+    copy_buffer &= Load(&CopyBufferSubData, "glCopyBufferSubData");
+    copy_buffer_loaded = copy_buffer && buffers;
+
+    // ARB_map_buffer_range, ARB_sync and ARB_buffer_storage also share the
+    // core names; glUnmapBuffer is core since 1.5
+    bool map_range = version_major >= 3 || HasExtension("GL_ARB_map_buffer_range");
+    map_range &= Load(&MapBufferRange, "glMapBufferRange");
+    map_range &= Load(&UnmapBuffer, "glUnmapBuffer");
+    map_range_loaded = map_range && buffers;
+
+    bool sync = version_major > 3 || (version_major == 3 && version_minor >= 2) ||
+                HasExtension("GL_ARB_sync");
+    sync &= Load(&FenceSync, "glFenceSync");
+    sync &= Load(&ClientWaitSync, "glClientWaitSync");
+    sync &= Load(&DeleteSync, "glDeleteSync");
+    sync_loaded = sync;
+
+    bool buffer_storage = version_major > 4 || (version_major == 4 && version_minor >= 4) ||
+                          HasExtension("GL_ARB_buffer_storage");
+    buffer_storage &= Load(&BufferStorage, "glBufferStorage");
+    buffer_storage_loaded = buffer_storage && buffers;
+
+    return buffers_loaded && shaders_loaded;
+}
+
+bool HasBufferObjects() {
+    return buffers_loaded;
+}
+
+bool HasShaders() {
+    return shaders_loaded;
+}
+
+bool HasTextureBuffers() {
+    return texture_buffers_loaded;
+}
+
+bool HasInstancing() {
+    return instancing_loaded;
+}
+
+bool HasMultiDrawBaseVertex() {
+    return multi_draw_loaded;
+}
+
+bool HasCopyBuffer() {
+    return copy_buffer_loaded;
+}
+
+bool HasMapBufferRange() {
+    return map_range_loaded;
+}
+
+bool HasSync() {
+    return sync_loaded;
+}
+
+bool HasBufferStorage() {
+    return buffer_storage_loaded;
+}
+
+void GetVersion(int* major, int* minor) {
+    *major = version_major;
+    *minor = version_minor;
+}
+
+} // namespace gl
+} // namespace render
+} // namespace blec
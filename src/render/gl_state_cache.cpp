@@ -0,0 +1,124 @@
+// render/gl_state_cache.cpp
+// Implementation of redundant GL state call elimination
+
+#include "render/gl_state_cache.h"
+
+namespace blec {
+namespace render {
+
+namespace {
+
+// Shadow value that matches no real value
+constexpr int64_t kUnknown = -1;
+
+} // anonymous namespace
+
+GlStateCache::GlStateCache() : issued_(0), skipped_(0), last_issued_(0), last_skipped_(0) {
+    Invalidate();
+}
+
+GlStateCache& GlStateCache::ForCurrentContext() {
+    static GlStateCache cache;
+    return cache;
+}
+
+void GlStateCache::Invalidate() {
+    for (int64_t& value : values_) {
+        value = kUnknown;
+    }
+}
+
+bool GlStateCache::Change(Slot slot, int64_t value) {
+    if (values_[slot] == value) {
+        skipped_ += 1;
+        return false;
+    }
+    values_[slot] = value;
+    issued_ += 1;
+    return true;
+}
+
+void GlStateCache::SetCapability(Slot slot, GLenum capability, bool enabled) {
+    if (!Change(slot, enabled ? 1 : 0)) {
+        return;
+    }
+    if (enabled) {
+        glEnable(capability);
+    } else {
+        glDisable(capability);
+    }
+}
+
+void GlStateCache::Apply(RenderState state) {
+    SetDepthTest((state & kStateDepthTest) != 0);
+    SetDepthWrite((state & kStateDepthWrite) != 0);
+    SetCullFace((state & kStateCullFace) != 0);
+    SetBlend((state & kStateBlend) != 0);
+}
+
+void GlStateCache::SetDepthTest(bool enabled) {
+    SetCapability(kSlotDepthTest, GL_DEPTH_TEST, enabled);
+    if (enabled && Change(kSlotDepthFunc, GL_LESS)) {
+        glDepthFunc(GL_LESS);
+    }
+}
+
+void GlStateCache::SetDepthWrite(bool enabled) {
+    if (Change(kSlotDepthWrite, enabled ? 1 : 0)) {
+        glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+    }
+}
+
+void GlStateCache::SetCullFace(bool enabled) {
+    SetCapability(kSlotCullFace, GL_CULL_FACE, enabled);
+    if (!enabled) {
+        return;
+    }
+    if (Change(kSlotCullMode, GL_BACK)) {
+        glCullFace(GL_BACK);
+    }
+    if (Change(kSlotFrontFace, GL_CCW)) {
+        glFrontFace(GL_CCW);
+    }
+}
+
+void GlStateCache::SetBlend(bool enabled) {
+    SetCapability(kSlotBlend, GL_BLEND, enabled);
+    if (enabled && Change(kSlotBlendFunc,
+                          (static_cast<int64_t>(GL_SRC_ALPHA) << 32) | GL_ONE_MINUS_SRC_ALPHA)) {
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
+}
+
+void GlStateCache::SetMatrixMode(GLenum mode) {
+    if (Change(kSlotMatrixMode, mode)) {
+        glMatrixMode(mode);
+    }
+}
+
+void GlStateCache::SetTexture2D(bool enabled) {
+    SetCapability(kSlotTexture2D, GL_TEXTURE_2D, enabled);
+}
+
+void GlStateCache::BindTexture2D(GLuint texture) {
+    if (Change(kSlotTextureBinding, texture)) {
+        glBindTexture(GL_TEXTURE_2D, texture);
+    }
+}
+
+void GlStateCache::SetAlphaTest(bool enabled) {
+    SetCapability(kSlotAlphaTest, GL_ALPHA_TEST, enabled);
+    if (enabled && Change(kSlotAlphaFunc, GL_GREATER)) {
+        glAlphaFunc(GL_GREATER, 0.0f);
+    }
+}
+
+void GlStateCache::EndFrame() {
+    last_issued_ = issued_;
+    last_skipped_ = skipped_;
+    issued_ = 0;
+    skipped_ = 0;
+}
+
+} // namespace render
+} // namespace blec
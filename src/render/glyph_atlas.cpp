@@ -0,0 +1,120 @@
+// render/glyph_atlas.cpp
+// Implementation of glyph atlas rasterization and upload
+
+#include "render/glyph_atlas.h"
+#include "render/font.h"
+#include "render/gl_state_cache.h"
+#include <GLFW/glfw3.h>
+
+namespace blec {
+namespace render {
+
+namespace {
+
+// Top-left texel of a cell
+void GetCellOrigin(int cell, int* x, int* y) {
+    *x = (cell % kGlyphAtlasColumns) * kGlyphCellSize;
+    *y = (cell / kGlyphAtlasColumns) * kGlyphCellSize;
+}
+
+// Set one texel to white with the given alpha
+void SetTexel(std::vector<uint8_t>* texels, int x, int y, uint8_t alpha) {
+    uint8_t* texel = texels->data() + (static_cast<size_t>(y) * kGlyphAtlasWidth + x) * 4;
+    texel[0] = 255;
+    texel[1] = 255;
+    texel[2] = 255;
+    texel[3] = alpha;
+}
+
+} // anonymous namespace
+
+GlyphAtlas::GlyphAtlas() : texture_(0) {
+}
+
+bool GlyphAtlas::Initialize() {
+    if (texture_ != 0) {
+        return true;
+    }
+
+    std::vector<uint8_t> texels;
+    Rasterize(&texels);
+
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    if (texture == 0) {
+        return false;
+    }
+
+    // Nearest sampling keeps glyph pixels square at every integer scale
+    GlStateCache::ForCurrentContext().BindTexture2D(texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, kGlyphAtlasWidth, kGlyphAtlasHeight, 0, GL_RGBA,
+                 GL_UNSIGNED_BYTE, texels.data());
+    texture_ = texture;
+    return true;
+}
+
+void GlyphAtlas::Release() {
+    if (texture_ == 0) {
+        return;
+    }
+    // Deleting a bound texture rebinds 0 behind the cache's back
+    GlStateCache::ForCurrentContext().BindTexture2D(0);
+    GLuint texture = texture_;
+    glDeleteTextures(1, &texture);
+    texture_ = 0;
+}
+
+void GlyphAtlas::Rasterize(std::vector<uint8_t>* texels) {
+    texels->assign(static_cast<size_t>(kGlyphAtlasWidth) * kGlyphAtlasHeight * 4, 0);
+
+    for (char c = 32; c <= 126; ++c) {
+        const unsigned char* glyph = BitmapFont::GetGlyph(c);
+        int cell_x = 0;
+        int cell_y = 0;
+        GetCellOrigin(c - 32, &cell_x, &cell_y);
+
+        // Each glyph byte is a column, bit 0 the top row
+        for (int col = 0; col < kGlyphWidth; ++col) {
+            for (int row = 0; row < kGlyphHeight; ++row) {
+                const bool lit = (glyph[col] & (1u << row)) != 0;
+                SetTexel(texels, cell_x + col, cell_y + row, lit ? 255 : 0);
+            }
+        }
+    }
+
+    int solid_x = 0;
+    int solid_y = 0;
+    GetCellOrigin(kSolidCell, &solid_x, &solid_y);
+    for (int y = 0; y < kGlyphCellSize; ++y) {
+        for (int x = 0; x < kGlyphCellSize; ++x) {
+            SetTexel(texels, solid_x + x, solid_y + y, 255);
+        }
+    }
+}
+
+bool GlyphAtlas::GetGlyphRect(char c, GlyphRect* rect) {
+    if (c < 32 || c > 126) {
+        return false;
+    }
+    int x = 0;
+    int y = 0;
+    GetCellOrigin(c - 32, &x, &y);
+    rect->u0 = static_cast<float>(x) / kGlyphAtlasWidth;
+    rect->v0 = static_cast<float>(y) / kGlyphAtlasHeight;
+    rect->u1 = static_cast<float>(x + kGlyphWidth) / kGlyphAtlasWidth;
+    rect->v1 = static_cast<float>(y + kGlyphHeight) / kGlyphAtlasHeight;
+    return true;
+}
+
+void GlyphAtlas::GetSolidTexel(float* u, float* v) {
+    int x = 0;
+    int y = 0;
+    GetCellOrigin(kSolidCell, &x, &y);
+    *u = (static_cast<float>(x) + kGlyphCellSize * 0.5f) / kGlyphAtlasWidth;
+    *v = (static_cast<float>(y) + kGlyphCellSize * 0.5f) / kGlyphAtlasHeight;
+}
+
+} // namespace render
+} // namespace blec
@@ -2,101 +2,288 @@
 // Implementation of 3D mesh creation and rendering
 
 #include "../include/render/mesh.h"
+#include "render/gl_functions.h"
+#include "render/gl_state_cache.h"
+#include "render/mesh_builder.h"
+#include "render/shader_manager.h"
+#include "render/vertex_streams.h"
+#include <algorithm>
+#include <cstddef>
+#include <utility>
 #include <GLFW/glfw3.h>
 #include <glm/gtc/matrix_transform.hpp>
 
 namespace blec {
 namespace render {
 
-Mesh::Mesh() : culling_enabled_(false) {
+namespace {
+
+// Vertices staged per batch in Mesh::ApplyTransform (fits in L1 cache)
+constexpr size_t kTransformBlockSize = 256;
+
+} // anonymous namespace
+
+Mesh::Mesh()
+    : culling_enabled_(false), vertex_buffer_(0), index_buffer_(0), uploaded_(false),
+      gpu_vertex_bytes_(0), gpu_index_bytes_(0), gpu_index_count_(0) {
 }
 
 Mesh::~Mesh() {
-    // No OpenGL resources to clean up in immediate mode
+    // GL buffers must be released explicitly while the context is current
 }
 
-Mesh Mesh::CreateCube() {
-    Mesh cube;
+Mesh::Mesh(Mesh&& other) noexcept
+    : vertices_(std::move(other.vertices_)), indices_(std::move(other.indices_)),
+      culling_enabled_(other.culling_enabled_), vertex_buffer_(other.vertex_buffer_),
+      index_buffer_(other.index_buffer_), uploaded_(other.uploaded_),
+      gpu_vertex_bytes_(other.gpu_vertex_bytes_), gpu_index_bytes_(other.gpu_index_bytes_),
+      gpu_index_count_(other.gpu_index_count_) {
+    other.vertex_buffer_ = 0;
+    other.index_buffer_ = 0;
+    other.uploaded_ = false;
+    other.gpu_vertex_bytes_ = 0;
+    other.gpu_index_bytes_ = 0;
+    other.gpu_index_count_ = 0;
+}
 
+Mesh& Mesh::operator=(Mesh&& other) noexcept {
+    if (this != &other) {
+        // The destructor never deletes buffers, so handing ours to other
+        // would leak them
+        Release();
+        vertices_ = std::move(other.vertices_);
+        indices_ = std::move(other.indices_);
+        culling_enabled_ = other.culling_enabled_;
+        vertex_buffer_ = other.vertex_buffer_;
+        index_buffer_ = other.index_buffer_;
+        uploaded_ = other.uploaded_;
+        gpu_vertex_bytes_ = other.gpu_vertex_bytes_;
+        gpu_index_bytes_ = other.gpu_index_bytes_;
+        gpu_index_count_ = other.gpu_index_count_;
+        other.vertex_buffer_ = 0;
+        other.index_buffer_ = 0;
+        other.uploaded_ = false;
+        other.gpu_vertex_bytes_ = 0;
+        other.gpu_index_bytes_ = 0;
+        other.gpu_index_count_ = 0;
+    }
+    return *this;
+}
+
+Mesh Mesh::CreateCube() {
     // Define a unit cube centered at origin (-0.5 to 0.5 on each axis)
     // Each face will have a different color for easy visualization
 
     const float s = 0.5f;  // Half-size
 
     // Color for each face (RGB)
-    glm::vec3 red(1.0f, 0.0f, 0.0f);      // Front face
-    glm::vec3 green(0.0f, 1.0f, 0.0f);    // Back face
-    glm::vec3 blue(0.0f, 0.0f, 1.0f);     // Right face
-    glm::vec3 yellow(1.0f, 1.0f, 0.0f);   // Left face
-    glm::vec3 cyan(0.0f, 1.0f, 1.0f);     // Top face
-    glm::vec3 magenta(1.0f, 0.0f, 1.0f);  // Bottom face
-
-    // Front face (Z+)  - RED
-    cube.vertices_.push_back(Vertex(glm::vec3(-s, -s,  s), red, glm::vec3(0, 0, 1)));  // 0
-    cube.vertices_.push_back(Vertex(glm::vec3( s, -s,  s), red, glm::vec3(0, 0, 1)));  // 1
-    cube.vertices_.push_back(Vertex(glm::vec3( s,  s,  s), red, glm::vec3(0, 0, 1)));  // 2
-    cube.vertices_.push_back(Vertex(glm::vec3(-s,  s,  s), red, glm::vec3(0, 0, 1)));  // 3
-
-    // Back face (Z-) - GREEN
-    cube.vertices_.push_back(Vertex(glm::vec3( s, -s, -s), green, glm::vec3(0, 0, -1)));  // 4
-    cube.vertices_.push_back(Vertex(glm::vec3(-s, -s, -s), green, glm::vec3(0, 0, -1)));  // 5
-    cube.vertices_.push_back(Vertex(glm::vec3(-s,  s, -s), green, glm::vec3(0, 0, -1)));  // 6
-    cube.vertices_.push_back(Vertex(glm::vec3( s,  s, -s), green, glm::vec3(0, 0, -1)));  // 7
-
-    // Right face (X+) - BLUE
-    cube.vertices_.push_back(Vertex(glm::vec3( s, -s,  s), blue, glm::vec3(1, 0, 0)));  // 8
-    cube.vertices_.push_back(Vertex(glm::vec3( s, -s, -s), blue, glm::vec3(1, 0, 0)));  // 9
-    cube.vertices_.push_back(Vertex(glm::vec3( s,  s, -s), blue, glm::vec3(1, 0, 0)));  // 10
-    cube.vertices_.push_back(Vertex(glm::vec3( s,  s,  s), blue, glm::vec3(1, 0, 0)));  // 11
-
-    // Left face (X-) - YELLOW
-    cube.vertices_.push_back(Vertex(glm::vec3(-s, -s, -s), yellow, glm::vec3(-1, 0, 0)));  // 12
-    cube.vertices_.push_back(Vertex(glm::vec3(-s, -s,  s), yellow, glm::vec3(-1, 0, 0)));  // 13
-    cube.vertices_.push_back(Vertex(glm::vec3(-s,  s,  s), yellow, glm::vec3(-1, 0, 0)));  // 14
-    cube.vertices_.push_back(Vertex(glm::vec3(-s,  s, -s), yellow, glm::vec3(-1, 0, 0)));  // 15
-
-    // Top face (Y+) - CYAN
-    cube.vertices_.push_back(Vertex(glm::vec3(-s,  s,  s), cyan, glm::vec3(0, 1, 0)));  // 16
-    cube.vertices_.push_back(Vertex(glm::vec3( s,  s,  s), cyan, glm::vec3(0, 1, 0)));  // 17
-    cube.vertices_.push_back(Vertex(glm::vec3( s,  s, -s), cyan, glm::vec3(0, 1, 0)));  // 18
-    cube.vertices_.push_back(Vertex(glm::vec3(-s,  s, -s), cyan, glm::vec3(0, 1, 0)));  // 19
-
-    // Bottom face (Y-) - MAGENTA
-    cube.vertices_.push_back(Vertex(glm::vec3(-s, -s, -s), magenta, glm::vec3(0, -1, 0)));  // 20
-    cube.vertices_.push_back(Vertex(glm::vec3( s, -s, -s), magenta, glm::vec3(0, -1, 0)));  // 21
-    cube.vertices_.push_back(Vertex(glm::vec3( s, -s,  s), magenta, glm::vec3(0, -1, 0)));  // 22
-    cube.vertices_.push_back(Vertex(glm::vec3(-s, -s,  s), magenta, glm::vec3(0, -1, 0)));  // 23
-
-    // Define triangles (2 per face, 12 total)
-    // Each face needs proper winding order for back-face culling
-    // Counter-clockwise when viewed from outside
-
-    // Front face (0, 1, 2), (0, 2, 3)
-    cube.indices_ = {
-        0, 1, 2, 0, 2, 3,
-        // Back face (4, 5, 6), (4, 6, 7)
-        4, 5, 6, 4, 6, 7,
-        // Right face (8, 9, 10), (8, 10, 11)
-        8, 9, 10, 8, 10, 11,
-        // Left face (12, 13, 14), (12, 14, 15)
-        12, 13, 14, 12, 14, 15,
-        // Top face (16, 17, 18), (16, 18, 19)
-        16, 17, 18, 16, 18, 19,
-        // Bottom face (20, 21, 22), (20, 22, 23)
-        20, 21, 22, 20, 22, 23
+    const glm::vec3 red(1.0f, 0.0f, 0.0f);      // Front face
+    const glm::vec3 green(0.0f, 1.0f, 0.0f);    // Back face
+    const glm::vec3 blue(0.0f, 0.0f, 1.0f);     // Right face
+    const glm::vec3 yellow(1.0f, 1.0f, 0.0f);   // Left face
+    const glm::vec3 cyan(0.0f, 1.0f, 1.0f);     // Top face
+    const glm::vec3 magenta(1.0f, 0.0f, 1.0f);  // Bottom face
+
+    // Four corners per face, counter-clockwise when viewed from outside so
+    // back-face culling works; each face becomes triangles 0-1-2 and 0-2-3
+    const Vertex corners[24] = {
+        // Front face (Z+) - RED
+        Vertex(glm::vec3(-s, -s,  s), red, glm::vec3(0, 0, 1)),
+        Vertex(glm::vec3( s, -s,  s), red, glm::vec3(0, 0, 1)),
+        Vertex(glm::vec3( s,  s,  s), red, glm::vec3(0, 0, 1)),
+        Vertex(glm::vec3(-s,  s,  s), red, glm::vec3(0, 0, 1)),
+
+        // Back face (Z-) - GREEN
+        Vertex(glm::vec3( s, -s, -s), green, glm::vec3(0, 0, -1)),
+        Vertex(glm::vec3(-s, -s, -s), green, glm::vec3(0, 0, -1)),
+        Vertex(glm::vec3(-s,  s, -s), green, glm::vec3(0, 0, -1)),
+        Vertex(glm::vec3( s,  s, -s), green, glm::vec3(0, 0, -1)),
+
+        // Right face (X+) - BLUE
+        Vertex(glm::vec3( s, -s,  s), blue, glm::vec3(1, 0, 0)),
+        Vertex(glm::vec3( s, -s, -s), blue, glm::vec3(1, 0, 0)),
+        Vertex(glm::vec3( s,  s, -s), blue, glm::vec3(1, 0, 0)),
+        Vertex(glm::vec3( s,  s,  s), blue, glm::vec3(1, 0, 0)),
+
+        // Left face (X-) - YELLOW
+        Vertex(glm::vec3(-s, -s, -s), yellow, glm::vec3(-1, 0, 0)),
+        Vertex(glm::vec3(-s, -s,  s), yellow, glm::vec3(-1, 0, 0)),
+        Vertex(glm::vec3(-s,  s,  s), yellow, glm::vec3(-1, 0, 0)),
+        Vertex(glm::vec3(-s,  s, -s), yellow, glm::vec3(-1, 0, 0)),
+
+        // Top face (Y+) - CYAN
+        Vertex(glm::vec3(-s,  s,  s), cyan, glm::vec3(0, 1, 0)),
+        Vertex(glm::vec3( s,  s,  s), cyan, glm::vec3(0, 1, 0)),
+        Vertex(glm::vec3( s,  s, -s), cyan, glm::vec3(0, 1, 0)),
+        Vertex(glm::vec3(-s,  s, -s), cyan, glm::vec3(0, 1, 0)),
+
+        // Bottom face (Y-) - MAGENTA
+        Vertex(glm::vec3(-s, -s, -s), magenta, glm::vec3(0, -1, 0)),
+        Vertex(glm::vec3( s, -s, -s), magenta, glm::vec3(0, -1, 0)),
+        Vertex(glm::vec3( s, -s,  s), magenta, glm::vec3(0, -1, 0)),
+        Vertex(glm::vec3(-s, -s,  s), magenta, glm::vec3(0, -1, 0)),
     };
 
+    Mesh cube;
+    MeshBuilder builder;
+    builder.ReserveQuads(6);
+    builder.AddQuads(corners, 6);
+    builder.Build(&cube);
     return cube;
 }
 
-void Mesh::Render() const {
-    // Enable back-face culling if requested
-    if (culling_enabled_) {
-        glEnable(GL_CULL_FACE);
-        glCullFace(GL_BACK);
-        glFrontFace(GL_CCW);  // Counter-clockwise is front-facing
+void Mesh::Clear() {
+    vertices_.clear();
+    indices_.clear();
+    uploaded_ = false;
+}
+
+void Mesh::Reserve(size_t vertex_count, size_t index_count) {
+    vertices_.reserve(vertex_count);
+    indices_.reserve(index_count);
+}
+
+uint32_t Mesh::AddVertex(const Vertex& vertex) {
+    vertices_.push_back(vertex);
+    uploaded_ = false;
+    return static_cast<uint32_t>(vertices_.size() - 1);
+}
+
+void Mesh::AddTriangle(uint32_t a, uint32_t b, uint32_t c) {
+    indices_.push_back(a);
+    indices_.push_back(b);
+    indices_.push_back(c);
+    uploaded_ = false;
+}
+
+void Mesh::SwapGeometry(std::vector<Vertex>* vertices, std::vector<uint32_t>* indices) {
+    vertices_.swap(*vertices);
+    indices_.swap(*indices);
+    uploaded_ = false;
+}
+
+void Mesh::Upload() {
+    if (vertex_buffer_ == 0) {
+        gl::GenBuffers(1, &vertex_buffer_);
+    }
+    if (index_buffer_ == 0) {
+        gl::GenBuffers(1, &index_buffer_);
+    }
+
+    // Same-size updates overwrite the existing storage in place
+    const size_t vertex_bytes = vertices_.size() * sizeof(Vertex);
+    const size_t index_bytes = indices_.size() * sizeof(uint32_t);
+    gl::BindBuffer(GL_ARRAY_BUFFER, vertex_buffer_);
+    if (vertex_bytes == gpu_vertex_bytes_ && vertex_bytes > 0) {
+        gl::BufferSubData(GL_ARRAY_BUFFER, 0, static_cast<std::ptrdiff_t>(vertex_bytes),
+                          vertices_.data());
+    } else {
+        gl::BufferData(GL_ARRAY_BUFFER, static_cast<std::ptrdiff_t>(vertex_bytes),
+                       vertices_.data(), GL_STATIC_DRAW);
     }
+    gl::BindBuffer(GL_ARRAY_BUFFER, 0);
 
+    gl::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer_);
+    if (index_bytes == gpu_index_bytes_ && index_bytes > 0) {
+        gl::BufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, static_cast<std::ptrdiff_t>(index_bytes),
+                          indices_.data());
+    } else {
+        gl::BufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<std::ptrdiff_t>(index_bytes),
+                       indices_.data(), GL_STATIC_DRAW);
+    }
+    gl::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    uploaded_ = true;
+    gpu_vertex_bytes_ = vertex_bytes;
+    gpu_index_bytes_ = index_bytes;
+    gpu_index_count_ = indices_.size();
+}
+
+void Mesh::Release() {
+    if (vertex_buffer_ != 0) {
+        gl::DeleteBuffers(1, &vertex_buffer_);
+        vertex_buffer_ = 0;
+    }
+    if (index_buffer_ != 0) {
+        gl::DeleteBuffers(1, &index_buffer_);
+        index_buffer_ = 0;
+    }
+    uploaded_ = false;
+    gpu_vertex_bytes_ = 0;
+    gpu_index_bytes_ = 0;
+    gpu_index_count_ = 0;
+}
+
+void Mesh::Render() {
+    // Culling is left as set for the next draw; the cache skips the call when
+    // consecutive meshes agree
+    GlStateCache::ForCurrentContext().SetCullFace(culling_enabled_);
+
+    if (gl::HasBufferObjects()) {
+        if (!uploaded_) {
+            Upload();
+        }
+        RenderBuffers(false);
+    } else {
+        RenderVertices();
+    }
+}
+
+void Mesh::Draw() {
+    GlStateCache::ForCurrentContext().SetCullFace(culling_enabled_);
+    if (!uploaded_) {
+        Upload();
+    }
+    RenderBuffers(true);
+}
+
+void Mesh::RenderBuffers(bool generic_attributes) const {
+    if (gpu_index_count_ == 0) {
+        return;
+    }
+
+    // Arrays are sourced from the bound buffer (offsets, not pointers)
+    const void* position_offset = reinterpret_cast<const void*>(offsetof(Vertex, position));
+    const void* color_offset = reinterpret_cast<const void*>(offsetof(Vertex, color));
+    const void* normal_offset = reinterpret_cast<const void*>(offsetof(Vertex, normal));
+    gl::BindBuffer(GL_ARRAY_BUFFER, vertex_buffer_);
+    gl::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer_);
+    if (generic_attributes) {
+        gl::EnableVertexAttribArray(kPositionAttribute);
+        gl::EnableVertexAttribArray(kColorAttribute);
+        gl::EnableVertexAttribArray(kNormalAttribute);
+        gl::VertexAttribPointer(kPositionAttribute, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                                position_offset);
+        gl::VertexAttribPointer(kColorAttribute, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                                color_offset);
+        gl::VertexAttribPointer(kNormalAttribute, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                                normal_offset);
+    } else {
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_COLOR_ARRAY);
+        glEnableClientState(GL_NORMAL_ARRAY);
+        glVertexPointer(3, GL_FLOAT, sizeof(Vertex), position_offset);
+        glColorPointer(3, GL_FLOAT, sizeof(Vertex), color_offset);
+        glNormalPointer(GL_FLOAT, sizeof(Vertex), normal_offset);
+    }
+
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(gpu_index_count_), GL_UNSIGNED_INT,
+                   nullptr);
+
+    if (generic_attributes) {
+        gl::DisableVertexAttribArray(kNormalAttribute);
+        gl::DisableVertexAttribArray(kColorAttribute);
+        gl::DisableVertexAttribArray(kPositionAttribute);
+    } else {
+        glDisableClientState(GL_NORMAL_ARRAY);
+        glDisableClientState(GL_COLOR_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
+    }
+    gl::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    gl::BindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void Mesh::RenderVertices() const {
     // Use immediate mode for OpenGL 2.1 compatibility
     glBegin(GL_TRIANGLES);
 
@@ -115,22 +302,41 @@ void Mesh::Render() const {
     }
 
     glEnd();
-
-    // Disable culling after rendering
-    if (culling_enabled_) {
-        glDisable(GL_CULL_FACE);
-    }
 }
 
 void Mesh::ApplyTransform(const glm::mat4& transform) {
-    // Transform all vertices by the matrix
-    for (auto& vertex : vertices_) {
-        glm::vec4 pos = transform * glm::vec4(vertex.position, 1.0f);
-        vertex.position = glm::vec3(pos) / pos.w;
-
-        // For normals, use inverse transpose (3x3)
-        glm::mat3 normalMatrix = glm::mat3(glm::transpose(glm::inverse(transform)));
-        vertex.normal = glm::normalize(normalMatrix * vertex.normal);
+    // For normals, use inverse transpose (3x3), computed once per call
+    const glm::mat3 normal_matrix = ComputeNormalMatrix(transform);
+
+    // Split blocks of vertices into stack-resident component arrays so the
+    // batch transforms can run four vertices per SIMD operation
+    float px[kTransformBlockSize];
+    float py[kTransformBlockSize];
+    float pz[kTransformBlockSize];
+    float nx[kTransformBlockSize];
+    float ny[kTransformBlockSize];
+    float nz[kTransformBlockSize];
+
+    uploaded_ = false;
+    for (size_t first = 0; first < vertices_.size(); first += kTransformBlockSize) {
+        const size_t count = std::min(kTransformBlockSize, vertices_.size() - first);
+        Vertex* block = vertices_.data() + first;
+        for (size_t i = 0; i < count; ++i) {
+            px[i] = block[i].position.x;
+            py[i] = block[i].position.y;
+            pz[i] = block[i].position.z;
+            nx[i] = block[i].normal.x;
+            ny[i] = block[i].normal.y;
+            nz[i] = block[i].normal.z;
+        }
+
+        TransformPositions(transform, px, py, pz, count);
+        TransformNormals(normal_matrix, nx, ny, nz, count);
+
+        for (size_t i = 0; i < count; ++i) {
+            block[i].position = glm::vec3(px[i], py[i], pz[i]);
+            block[i].normal = glm::vec3(nx[i], ny[i], nz[i]);
+        }
     }
 }
 
@@ -0,0 +1,119 @@
+// render/mesh_builder.cpp
+// Implementation of pooled mesh building
+
+#include "render/mesh_builder.h"
+#include <utility>
+
+namespace blec {
+namespace render {
+
+namespace {
+
+// Triangle corners of a quad, relative to its first vertex
+constexpr uint32_t kQuadIndexPattern[6] = {0, 1, 2, 0, 2, 3};
+
+} // anonymous namespace
+
+MeshStagingPool& MeshStagingPool::ForCurrentThread() {
+    thread_local MeshStagingPool pool;
+    return pool;
+}
+
+void MeshStagingPool::Acquire(std::vector<Vertex>* vertices, std::vector<uint32_t>* indices) {
+    if (free_vertices_.empty()) {
+        return;
+    }
+    vertices->swap(free_vertices_.back());
+    indices->swap(free_indices_.back());
+    free_vertices_.pop_back();
+    free_indices_.pop_back();
+}
+
+void MeshStagingPool::Release(std::vector<Vertex>* vertices, std::vector<uint32_t>* indices) {
+    if (free_vertices_.size() >= kMaxPooledStagingBuffers) {
+        return;  // Storage is freed with the caller's vectors
+    }
+    vertices->clear();
+    indices->clear();
+    free_vertices_.push_back(std::move(*vertices));
+    free_indices_.push_back(std::move(*indices));
+}
+
+MeshBuilder::MeshBuilder() : MeshBuilder(&MeshStagingPool::ForCurrentThread()) {
+}
+
+MeshBuilder::MeshBuilder(MeshStagingPool* pool) : pool_(pool) {
+    pool_->Acquire(&vertices_, &indices_);
+}
+
+MeshBuilder::~MeshBuilder() {
+    pool_->Release(&vertices_, &indices_);
+}
+
+void MeshBuilder::NoteAppend(size_t vertex_count, size_t index_count) {
+    if (vertices_.size() + vertex_count > vertices_.capacity() ||
+        indices_.size() + index_count > indices_.capacity()) {
+        pool_->RecordGrowth();
+    }
+}
+
+void MeshBuilder::Reserve(size_t vertex_count, size_t index_count) {
+    if (vertex_count > vertices_.capacity() || index_count > indices_.capacity()) {
+        pool_->RecordGrowth();
+    }
+    vertices_.reserve(vertex_count);
+    indices_.reserve(index_count);
+}
+
+void MeshBuilder::ReserveQuads(size_t quad_count) {
+    Reserve(quad_count * 4, quad_count * 6);
+}
+
+uint32_t MeshBuilder::AddVertex(const Vertex& vertex) {
+    NoteAppend(1, 0);
+    vertices_.push_back(vertex);
+    return static_cast<uint32_t>(vertices_.size() - 1);
+}
+
+void MeshBuilder::AddTriangle(uint32_t a, uint32_t b, uint32_t c) {
+    NoteAppend(0, 3);
+    indices_.push_back(a);
+    indices_.push_back(b);
+    indices_.push_back(c);
+}
+
+void MeshBuilder::AddQuad(const glm::vec3* corners, const glm::vec3& color,
+                          const glm::vec3& normal) {
+    const Vertex quad[4] = {
+        Vertex(corners[0], color, normal), Vertex(corners[1], color, normal),
+        Vertex(corners[2], color, normal), Vertex(corners[3], color, normal)
+    };
+    AddQuads(quad, 1);
+}
+
+void MeshBuilder::AddQuads(const Vertex* vertices, size_t quad_count) {
+    NoteAppend(quad_count * 4, quad_count * 6);
+
+    const size_t first_vertex = vertices_.size();
+    const size_t first_index = indices_.size();
+    vertices_.insert(vertices_.end(), vertices, vertices + quad_count * 4);
+    indices_.resize(first_index + quad_count * 6);
+
+    // Fill the indices in place instead of pushing them one at a time
+    uint32_t* out = indices_.data() + first_index;
+    for (size_t quad = 0; quad < quad_count; ++quad) {
+        const uint32_t base = static_cast<uint32_t>(first_vertex + quad * 4);
+        for (uint32_t corner : kQuadIndexPattern) {
+            *out++ = base + corner;
+        }
+    }
+}
+
+void MeshBuilder::Build(Mesh* mesh) {
+    mesh->SwapGeometry(&vertices_, &indices_);
+    vertices_.clear();
+    indices_.clear();
+}
+
+} // namespace render
+} // namespace blec
@@ -0,0 +1,155 @@
+// render/mesh_worker_pool.cpp
+// Implementation of background section meshing
+
+#include "render/mesh_worker_pool.h"
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace blec {
+namespace render {
+
+MeshWorkerPool::MeshWorkerPool() : active_jobs_(0), stop_(false) {
+}
+
+MeshWorkerPool::~MeshWorkerPool() {
+    Stop();
+}
+
+bool MeshWorkerPool::Start(uint32_t thread_count) {
+    if (!workers_.empty()) {
+        return true;
+    }
+
+    if (thread_count == 0) {
+        // Leave one hardware thread for the main loop
+        const uint32_t hardware = std::thread::hardware_concurrency();
+        thread_count = std::max(1u, hardware > 1 ? hardware - 1 : 1u);
+    }
+
+    stop_ = false;
+    for (uint32_t i = 0; i < thread_count; ++i) {
+        workers_.emplace_back(&MeshWorkerPool::WorkerLoop, this);
+    }
+    return !workers_.empty();
+}
+
+void MeshWorkerPool::Stop() {
+    if (workers_.empty()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+        jobs_.clear();
+    }
+    job_ready_.notify_all();
+    idle_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+
+    std::lock_guard<std::mutex> lock(results_mutex_);
+    results_.clear();
+}
+
+void MeshWorkerPool::Submit(const MeshJob& job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push_back(job);
+    }
+    job_ready_.notify_one();
+}
+
+void MeshWorkerPool::CollectResults(std::vector<MeshResult>* results) {
+    std::vector<MeshResult> finished;
+    {
+        std::lock_guard<std::mutex> lock(results_mutex_);
+        finished.swap(results_);
+    }
+    results->insert(results->end(), std::make_move_iterator(finished.begin()),
+                    std::make_move_iterator(finished.end()));
+}
+
+void MeshWorkerPool::RecycleResults(std::vector<MeshResult>* results) {
+    {
+        std::lock_guard<std::mutex> lock(results_mutex_);
+        for (MeshResult& result : *results) {
+            if (free_results_.size() >= kMaxRecycledResults) {
+                break;  // The rest is freed with the caller's list
+            }
+            result.mesh.Clear();
+            result.faces.Clear();
+            free_results_.push_back(std::move(result));
+        }
+    }
+    results->clear();
+}
+
+size_t MeshWorkerPool::GetRecycledCount() const {
+    std::lock_guard<std::mutex> lock(results_mutex_);
+    return free_results_.size();
+}
+
+void MeshWorkerPool::WaitForIdle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return jobs_.empty() && active_jobs_ == 0; });
+}
+
+uint32_t MeshWorkerPool::GetPendingJobCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<uint32_t>(jobs_.size()) + active_jobs_;
+}
+
+void MeshWorkerPool::WorkerLoop() {
+    MeshJob job;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            job_ready_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+            if (stop_) {
+                return;
+            }
+            job = jobs_.front();
+            jobs_.pop_front();
+            active_jobs_ += 1;
+        }
+
+        // Build into recycled storage when the main thread returned some
+        MeshResult result;
+        {
+            std::lock_guard<std::mutex> lock(results_mutex_);
+            if (!free_results_.empty()) {
+                result = std::move(free_results_.back());
+                free_results_.pop_back();
+            }
+        }
+        result.section_index = job.section_index;
+        result.version = job.version;
+        result.build_faces = job.build_faces;
+        if (job.build_faces) {
+            result.stats = ChunkMesher::BuildSectionMesh(job.snapshot, &result.faces, job.mode);
+        } else {
+            result.stats = ChunkMesher::BuildSectionMesh(job.snapshot, &result.mesh, job.mode);
+        }
+
+        // Publish the result before reporting the job finished, so that
+        // WaitForIdle() guarantees CollectResults() sees it
+        {
+            std::lock_guard<std::mutex> lock(results_mutex_);
+            results_.push_back(std::move(result));
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            active_jobs_ -= 1;
+            if (jobs_.empty() && active_jobs_ == 0) {
+                idle_.notify_all();
+            }
+        }
+    }
+}
+
+} // namespace render
+} // namespace blec
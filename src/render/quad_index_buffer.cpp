@@ -0,0 +1,71 @@
+// render/quad_index_buffer.cpp
+// Implementation of the shared quad index buffer
+
+#include "render/quad_index_buffer.h"
+#include "render/gl_functions.h"
+#include <vector>
+
+namespace blec {
+namespace render {
+
+namespace {
+
+// Vertex of the quad used by each index (triangles 0-1-2 and 0-2-3)
+constexpr uint32_t kQuadPattern[kIndicesPerQuad] = {0, 1, 2, 0, 2, 3};
+
+// Every vertex of a full section must be addressable with 16 bits
+static_assert(kMaxQuadsPerSection * kVerticesPerQuad <= 65536,
+              "Section vertices must fit 16-bit indices");
+
+} // anonymous namespace
+
+QuadIndexBuffer::QuadIndexBuffer() : buffer_(0) {
+}
+
+QuadIndexBuffer::~QuadIndexBuffer() {
+    // GL buffers must be released explicitly while the context is current
+}
+
+void QuadIndexBuffer::Upload() {
+    if (buffer_ != 0) {
+        return;
+    }
+
+    std::vector<uint16_t> indices(static_cast<size_t>(kMaxQuadsPerSection) * kIndicesPerQuad);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        indices[i] = static_cast<uint16_t>(GetIndex(i));
+    }
+
+    gl::GenBuffers(1, &buffer_);
+    gl::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer_);
+    gl::BufferData(GL_ELEMENT_ARRAY_BUFFER,
+                   static_cast<std::ptrdiff_t>(indices.size() * sizeof(uint16_t)),
+                   indices.data(), GL_STATIC_DRAW);
+    gl::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+void QuadIndexBuffer::Release() {
+    if (buffer_ != 0) {
+        gl::DeleteBuffers(1, &buffer_);
+        buffer_ = 0;
+    }
+}
+
+size_t QuadIndexBuffer::GetGpuBytes() const {
+    if (buffer_ == 0) {
+        return 0;
+    }
+    return static_cast<size_t>(kMaxQuadsPerSection) * kIndicesPerQuad * sizeof(uint16_t);
+}
+
+void QuadIndexBuffer::Bind() const {
+    gl::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer_);
+}
+
+uint32_t QuadIndexBuffer::GetIndex(size_t position) {
+    const size_t quad = position / kIndicesPerQuad;
+    return static_cast<uint32_t>(quad * kVerticesPerQuad) + kQuadPattern[position % kIndicesPerQuad];
+}
+
+} // namespace render
+} // namespace blec
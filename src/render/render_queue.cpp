@@ -0,0 +1,111 @@
+// render/render_queue.cpp
+// Implementation of sort-key construction and radix sorting
+
+#include "render/render_queue.h"
+#include <algorithm>
+
+namespace blec {
+namespace render {
+
+namespace {
+
+// Field positions and masks (see render_queue.h)
+constexpr int kPassShift = 60;
+constexpr int kShaderShift = 48;
+constexpr int kStateShift = 40;
+constexpr int kDepthShift = 16;
+constexpr uint64_t kShaderMask = 0xFFFu;
+constexpr uint64_t kIndexMask = 0xFFFFu;
+constexpr uint32_t kDepthMax = 0xFFFFFFu;
+
+} // anonymous namespace
+
+bool RenderQueue::Submit(const RenderCommand& command) {
+    if (commands_.size() >= kMaxRenderCommands) {
+        return false;
+    }
+    const uint32_t index = static_cast<uint32_t>(commands_.size());
+    commands_.push_back(command);
+    keys_.push_back(
+        MakeSortKey(command.pass, command.shader, command.state, command.depth, index));
+    return true;
+}
+
+void RenderQueue::Clear() {
+    commands_.clear();
+    keys_.clear();
+}
+
+void RenderQueue::Sort() {
+    sort_passes_ = RadixSort(&keys_, &scratch_);
+}
+
+const RenderCommand& RenderQueue::GetSortedCommand(size_t i) const {
+    return commands_[keys_[i] & kIndexMask];
+}
+
+uint32_t RenderQueue::QuantizeDepth(float depth) {
+    const float normalized = std::min(std::max(depth / kSortDepthRange, 0.0f), 1.0f);
+    return static_cast<uint32_t>(normalized * static_cast<float>(kDepthMax));
+}
+
+uint64_t RenderQueue::MakeSortKey(RenderPass pass, ShaderId shader, RenderState state,
+                                  float depth, uint32_t index) {
+    uint32_t depth_bits = QuantizeDepth(depth);
+    if (pass == RenderPass::Translucent) {
+        depth_bits = kDepthMax - depth_bits;
+    }
+    // kInvalidShader wraps to the largest field value
+    const uint64_t shader_bits = static_cast<uint64_t>(static_cast<uint32_t>(shader)) & kShaderMask;
+    return (static_cast<uint64_t>(pass) << kPassShift) | (shader_bits << kShaderShift) |
+           (static_cast<uint64_t>(state) << kStateShift) |
+           (static_cast<uint64_t>(depth_bits) << kDepthShift) | (index & kIndexMask);
+}
+
+uint32_t RenderQueue::RadixSort(std::vector<uint64_t>* keys, std::vector<uint64_t>* scratch) {
+    const size_t count = keys->size();
+    if (count < 2) {
+        return 0;
+    }
+    scratch->resize(count);
+
+    // Histograms of all eight digits in one read
+    uint32_t histograms[8][256] = {};
+    for (uint64_t key : *keys) {
+        for (int digit = 0; digit < 8; ++digit) {
+            histograms[digit][(key >> (digit * 8)) & 0xFF] += 1;
+        }
+    }
+
+    uint64_t* source = keys->data();
+    uint64_t* destination = scratch->data();
+    uint32_t passes = 0;
+    for (int digit = 0; digit < 8; ++digit) {
+        const int shift = digit * 8;
+        uint32_t* histogram = histograms[digit];
+        if (histogram[(source[0] >> shift) & 0xFF] == count) {
+            continue;
+        }
+
+        uint32_t offsets[256];
+        uint32_t total = 0;
+        for (int bucket = 0; bucket < 256; ++bucket) {
+            offsets[bucket] = total;
+            total += histogram[bucket];
+        }
+        for (size_t i = 0; i < count; ++i) {
+            const uint64_t key = source[i];
+            destination[offsets[(key >> shift) & 0xFF]++] = key;
+        }
+        std::swap(source, destination);
+        passes += 1;
+    }
+
+    if (source != keys->data()) {
+        std::copy(source, source + count, keys->data());
+    }
+    return passes;
+}
+
+} // namespace render
+} // namespace blec
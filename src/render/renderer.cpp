@@ -2,6 +2,11 @@
 // Implementation of basic rendering operations
 
 #include "render/renderer.h"
+#include "render/batch_2d.h"
+#include "render/block_instancer.h"
+#include "render/chunk_renderer.h"
+#include "render/gl_functions.h"
+#include "render/mesh.h"
 #include <GLFW/glfw3.h>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
@@ -9,9 +14,32 @@
 namespace blec {
 namespace render {
 
+Renderer::Renderer() : shader_pipeline_(false), flushed_commands_(0) {
+}
+
 void Renderer::Initialize() {
-    // No special initialization needed for basic OpenGL 2.1
-    // Future: could load shaders, setup buffers, etc.
+    // Resolve buffer and shader entry points; drawing code falls back to
+    // immediate mode when they are missing
+    gl::LoadFunctions();
+    GlStateCache::ForCurrentContext().Invalidate();
+    shader_pipeline_ = gl::HasBufferObjects() && gl::HasShaders() &&
+                       shaders_.InitializeBuiltins();
+
+    // Rasterize the font once so text draws as one quad per character
+    Batch2D::ForCurrentContext().Initialize();
+}
+
+void Renderer::ReleaseGpuResources() {
+    shaders_.Release();
+    stream_.Release();
+    Batch2D::ForCurrentContext().Release();
+    shader_pipeline_ = false;
+}
+
+void Renderer::EndFrame() {
+    stream_.EndFrame();
+    Batch2D::ForCurrentContext().EndFrame();
+    GlStateCache::ForCurrentContext().EndFrame();
 }
 
 void Renderer::SetViewport(int width, int height) {
@@ -24,23 +52,127 @@ void Renderer::Clear(float r, float g, float b, float a) {
 }
 
 void Renderer::SetProjection(const glm::mat4& projection) {
-    glMatrixMode(GL_PROJECTION);
+    shaders_.SetProjection(projection);
+    if (shader_pipeline_) {
+        return;
+    }
+    GlStateCache& state = GlStateCache::ForCurrentContext();
+    state.SetMatrixMode(GL_PROJECTION);
     glLoadMatrixf(glm::value_ptr(projection));
-    glMatrixMode(GL_MODELVIEW);
+    state.SetMatrixMode(GL_MODELVIEW);
 }
 
 void Renderer::SetView(const glm::mat4& view) {
-    glMatrixMode(GL_MODELVIEW);
+    shaders_.SetView(view);
+    if (shader_pipeline_) {
+        return;
+    }
+    GlStateCache::ForCurrentContext().SetMatrixMode(GL_MODELVIEW);
     glLoadMatrixf(glm::value_ptr(view));
 }
 
 void Renderer::SetModel(const glm::mat4& model) {
+    shaders_.SetModel(model);
+    if (shader_pipeline_) {
+        return;
+    }
+    GlStateCache::ForCurrentContext().SetMatrixMode(GL_MODELVIEW);
     glMultMatrixf(glm::value_ptr(model));
 }
 
+void Renderer::DrawMesh(Mesh* mesh) {
+    if (!shader_pipeline_) {
+        mesh->Render();
+        return;
+    }
+    shaders_.Use(shaders_.GetColorShader());
+    mesh->Draw();
+    shaders_.Unuse();
+}
+
+bool Renderer::Submit(const RenderCommand& command) {
+    return queue_.Submit(command);
+}
+
+bool Renderer::SubmitMesh(Mesh* mesh, const glm::mat4& model, float depth, RenderPass pass) {
+    RenderCommand command{};
+    command.type = RenderCommandType::Mesh;
+    command.pass = pass;
+    command.state = (pass == RenderPass::Opaque) ? kStateDepthTest | kStateDepthWrite
+                                                 : kStateTranslucent;
+    if (mesh->IsBackfaceCullingEnabled()) {
+        command.state |= kStateCullFace;
+    }
+    command.shader = shader_pipeline_ ? shaders_.GetColorShader() : kInvalidShader;
+    command.depth = depth;
+    command.mesh = mesh;
+    command.model = model;
+    return queue_.Submit(command);
+}
+
+bool Renderer::SubmitChunks(ChunkRenderer* chunks, const std::vector<uint32_t>* sections) {
+    RenderCommand command{};
+    command.type = RenderCommandType::Chunks;
+    command.pass = RenderPass::Opaque;
+    command.state = kStateOpaque;
+    command.shader = kInvalidShader;
+    command.chunks = chunks;
+    command.sections = sections;
+    return queue_.Submit(command);
+}
+
+bool Renderer::SubmitInstances(BlockInstancer* instancer) {
+    RenderCommand command{};
+    command.type = RenderCommandType::Instances;
+    command.pass = RenderPass::Opaque;
+    command.state = kStateOpaque;
+    command.shader = kInvalidShader;
+    command.instancer = instancer;
+    return queue_.Submit(command);
+}
+
+void Renderer::Flush() {
+    queue_.Sort();
+    GlStateCache& state = GlStateCache::ForCurrentContext();
+    for (size_t i = 0; i < queue_.GetCommandCount(); ++i) {
+        const RenderCommand& command = queue_.GetSortedCommand(i);
+        state.Apply(command.state);
+        switch (command.type) {
+            case RenderCommandType::Mesh:
+                if (shader_pipeline_) {
+                    // Meshes sharing the color program stay sorted together,
+                    // so it is only made current once per run
+                    shaders_.SetModel(command.model);
+                    shaders_.Use(shaders_.GetColorShader());
+                    command.mesh->Draw();
+                } else {
+                    state.SetMatrixMode(GL_MODELVIEW);
+                    glPushMatrix();
+                    glMultMatrixf(glm::value_ptr(command.model));
+                    command.mesh->Render();
+                    glPopMatrix();
+                }
+                break;
+            case RenderCommandType::Chunks:
+                shaders_.Unuse();
+                command.chunks->Render(*command.sections, GetViewProjection());
+                break;
+            case RenderCommandType::Instances:
+                command.instancer->Render(&shaders_, &stream_);
+                break;
+        }
+    }
+    shaders_.Unuse();
+    shaders_.SetModel(glm::mat4(1.0f));
+    flushed_commands_ = queue_.GetCommandCount();
+    queue_.Clear();
+}
+
 void Renderer::Begin2D(int screenWidth, int screenHeight) {
+    GlStateCache& state = GlStateCache::ForCurrentContext();
+
     // Save current matrices
-    glMatrixMode(GL_PROJECTION);
+    state.SetMatrixMode(GL_PROJECTION);
     glPushMatrix();
     glLoadIdentity();
 
@@ -49,23 +181,32 @@ void Renderer::Begin2D(int screenWidth, int screenHeight) {
             static_cast<double>(screenHeight), 0.0,
             -1.0, 1.0);
 
-    glMatrixMode(GL_MODELVIEW);
+    state.SetMatrixMode(GL_MODELVIEW);
     glPushMatrix();
     glLoadIdentity();
 
-    // Disable depth testing for 2D
-    glDisable(GL_DEPTH_TEST);
+    // 2D draws neither depth test nor cull (the Y flip reverses winding)
+    state.SetDepthTest(false);
+    state.SetCullFace(false);
+
+    // Collect the 2D draws until End2D
+    Batch2D::ForCurrentContext().Begin();
 }
 
 void Renderer::End2D() {
+    // Draw the batch while the 2D matrices are still loaded
+    Batch2D::ForCurrentContext().End();
+
+    GlStateCache& state = GlStateCache::ForCurrentContext();
+
     // Restore previous matrices
-    glMatrixMode(GL_MODELVIEW);
+    state.SetMatrixMode(GL_MODELVIEW);
     glPopMatrix();
 
-    glMatrixMode(GL_PROJECTION);
+    state.SetMatrixMode(GL_PROJECTION);
     glPopMatrix();
 
-    glMatrixMode(GL_MODELVIEW);
+    state.SetMatrixMode(GL_MODELVIEW);
 }
 
 void Renderer::Begin3D(int screenWidth, int screenHeight, float fovDegrees) {
@@ -73,11 +214,16 @@ void Renderer::Begin3D(int screenWidth, int screenHeight, float fovDegrees) {
     float aspect = static_cast<float>(screenWidth) / static_cast<float>(screenHeight);
     glm::mat4 projection = glm::perspective(glm::radians(fovDegrees), aspect, 0.1f, 100.0f);
 
-    glMatrixMode(GL_PROJECTION);
-    glLoadMatrixf(glm::value_ptr(projection));
+    shaders_.SetProjection(projection);
+    shaders_.SetModel(glm::mat4(1.0f));
+    if (!shader_pipeline_) {
+        GlStateCache& state = GlStateCache::ForCurrentContext();
+        state.SetMatrixMode(GL_PROJECTION);
+        glLoadMatrixf(glm::value_ptr(projection));
 
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
+        state.SetMatrixMode(GL_MODELVIEW);
+        glLoadIdentity();
+    }
 
     // Enable depth testing for proper 3D rendering
     EnableDepthTest();
@@ -90,50 +236,44 @@ void Renderer::End3D() {
 }
 
 void Renderer::DrawFilledRect(float x, float y, float w, float h) {
-    glBegin(GL_QUADS);
-    glVertex2f(x, y);
-    glVertex2f(x + w, y);
-    glVertex2f(x + w, y + h);
-    glVertex2f(x, y + h);
-    glEnd();
+    Batch2D::ForCurrentContext().AddRect(x, y, w, h);
 }
 
 void Renderer::DrawLine(float x1, float y1, float x2, float y2) {
-    glBegin(GL_LINES);
-    glVertex2f(x1, y1);
-    glVertex2f(x2, y2);
-    glEnd();
+    Batch2D::ForCurrentContext().AddLine(x1, y1, x2, y2);
 }
 
 void Renderer::SetColor(float r, float g, float b, float a) {
-    glColor4f(r, g, b, a);
+    Batch2D::ForCurrentContext().SetColor(r, g, b, a);
 }
 
 void Renderer::EnableBlending() {
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    // Batched draws so far were recorded without blending
+    Batch2D::ForCurrentContext().Flush();
+    GlStateCache::ForCurrentContext().SetBlend(true);
 }
 
 void Renderer::DisableBlending() {
-    glDisable(GL_BLEND);
+    Batch2D::ForCurrentContext().Flush();
+    GlStateCache::ForCurrentContext().SetBlend(false);
 }
 
 void Renderer::EnableDepthTest() {
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LESS);
+    GlStateCache& state = GlStateCache::ForCurrentContext();
+    state.SetDepthTest(true);
+    state.SetDepthWrite(true);
 }
 
 void Renderer::DisableDepthTest() {
-    glDisable(GL_DEPTH_TEST);
+    GlStateCache::ForCurrentContext().SetDepthTest(false);
 }
 
 void Renderer::EnableBackfaceCulling() {
-    glEnable(GL_CULL_FACE);
-    glCullFace(GL_BACK);
+    GlStateCache::ForCurrentContext().SetCullFace(true);
 }
 
 void Renderer::DisableBackfaceCulling() {
-    glDisable(GL_CULL_FACE);
+    GlStateCache::ForCurrentContext().SetCullFace(false);
 }
 
 } // namespace render
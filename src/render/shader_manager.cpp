@@ -0,0 +1,156 @@
+// render/shader_manager.cpp
+// Implementation of the shader registry and matrix uniform upload
+
+#include "render/shader_manager.h"
+#include <cstring>
+#include <utility>
+
+namespace blec {
+namespace render {
+
+namespace {
+
+// Attribute names bound to kPositionAttribute..kNormalAttribute
+const char* const kColorAttributes[] = {"a_position", "a_color", "a_normal"};
+
+// Colored render::Vertex geometry placed by the CPU-side matrices
+const char* const kColorVertexShader = R"(#version 120
+attribute vec3 a_position;
+attribute vec3 a_color;
+attribute vec3 a_normal;
+uniform mat4 u_view_projection;
+uniform mat4 u_model;
+varying vec3 v_color;
+void main() {
+    v_color = a_color;
+    gl_Position = u_view_projection * (u_model * vec4(a_position, 1.0));
+}
+)";
+
+const char* const kColorFragmentShader = R"(#version 120
+varying vec3 v_color;
+void main() {
+    gl_FragColor = vec4(v_color, 1.0);
+}
+)";
+
+} // anonymous namespace
+
+ShaderManager::ShaderManager()
+    : projection_(1.0f), view_(1.0f), view_projection_(1.0f), model_(1.0f),
+      view_projection_dirty_(false), view_projection_serial_(1), model_serial_(1),
+      concatenations_(0), active_(kInvalidShader), color_shader_(kInvalidShader) {
+}
+
+ShaderId ShaderManager::Add(const char* name, const char* vertex_source,
+                            const char* fragment_source, const char* const* attributes,
+                            int attribute_count) {
+    std::unique_ptr<ShaderProgram> program(new ShaderProgram());
+    if (!program->Build(vertex_source, fragment_source, attributes, attribute_count)) {
+        return kInvalidShader;
+    }
+
+    Entry entry;
+    entry.name = name;
+    entry.view_projection_location = program->GetUniformLocation("u_view_projection");
+    entry.model_location = program->GetUniformLocation("u_model");
+    entry.view_projection_serial = 0;
+    entry.model_serial = 0;
+    entry.program = std::move(program);
+    entries_.push_back(std::move(entry));
+    return static_cast<ShaderId>(entries_.size() - 1);
+}
+
+bool ShaderManager::InitializeBuiltins() {
+    if (color_shader_ == kInvalidShader) {
+        color_shader_ = Add("color", kColorVertexShader, kColorFragmentShader,
+                            kColorAttributes, 3);
+    }
+    return color_shader_ != kInvalidShader;
+}
+
+ShaderId ShaderManager::Find(const char* name) const {
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        if (std::strcmp(entries_[i].name.c_str(), name) == 0) {
+            return static_cast<ShaderId>(i);
+        }
+    }
+    return kInvalidShader;
+}
+
+const ShaderProgram* ShaderManager::Get(ShaderId id) const {
+    if (id < 0 || static_cast<size_t>(id) >= entries_.size()) {
+        return nullptr;
+    }
+    return entries_[id].program.get();
+}
+
+void ShaderManager::SetProjection(const glm::mat4& projection) {
+    projection_ = projection;
+    view_projection_dirty_ = true;
+}
+
+void ShaderManager::SetView(const glm::mat4& view) {
+    view_ = view;
+    view_projection_dirty_ = true;
+}
+
+void ShaderManager::SetModel(const glm::mat4& model) {
+    model_ = model;
+    model_serial_ += 1;
+    if (active_ != kInvalidShader) {
+        UploadMatrices(&entries_[active_]);
+    }
+}
+
+const glm::mat4& ShaderManager::GetViewProjection() {
+    if (view_projection_dirty_) {
+        view_projection_ = projection_ * view_;
+        view_projection_dirty_ = false;
+        view_projection_serial_ += 1;
+        concatenations_ += 1;
+    }
+    return view_projection_;
+}
+
+void ShaderManager::Use(ShaderId id) {
+    if (id < 0 || static_cast<size_t>(id) >= entries_.size()) {
+        return;
+    }
+    if (active_ != id) {
+        entries_[id].program->Use();
+        active_ = id;
+    }
+    UploadMatrices(&entries_[id]);
+}
+
+void ShaderManager::Unuse() {
+    if (active_ != kInvalidShader) {
+        ShaderProgram::Unuse();
+        active_ = kInvalidShader;
+    }
+}
+
+void ShaderManager::UploadMatrices(Entry* entry) {
+    GetViewProjection();
+    if (entry->view_projection_serial != view_projection_serial_) {
+        ShaderProgram::SetUniform(entry->view_projection_location, view_projection_);
+        entry->view_projection_serial = view_projection_serial_;
+    }
+    if (entry->model_serial != model_serial_) {
+        ShaderProgram::SetUniform(entry->model_location, model_);
+        entry->model_serial = model_serial_;
+    }
+}
+
+void ShaderManager::Release() {
+    Unuse();
+    for (Entry& entry : entries_) {
+        entry.program->Release();
+    }
+    entries_.clear();
+    color_shader_ = kInvalidShader;
+}
+
+} // namespace render
+} // namespace blec
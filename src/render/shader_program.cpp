@@ -0,0 +1,147 @@
+// render/shader_program.cpp
+// Implementation of GLSL program compilation and uniform upload
+
+#include "render/shader_program.h"
+#include "render/gl_functions.h"
+#include <glm/gtc/type_ptr.hpp>
+#include <cstdio>
+#include <vector>
+
+namespace blec {
+namespace render {
+
+ShaderProgram::ShaderProgram() : program_(0) {
+}
+
+ShaderProgram::~ShaderProgram() {
+    // GL objects must be released explicitly while the context is current
+}
+
+bool ShaderProgram::Build(const char* vertex_source, const char* fragment_source,
+                          const char* const* attributes, int attribute_count) {
+    Release();
+    log_.clear();
+    if (!gl::HasShaders()) {
+        log_ = "Shaders are not supported by this context";
+        return false;
+    }
+
+    const GLuint vertex_shader = CompileStage(GL_VERTEX_SHADER, vertex_source);
+    const GLuint fragment_shader = CompileStage(GL_FRAGMENT_SHADER, fragment_source);
+    if (vertex_shader == 0 || fragment_shader == 0) {
+        gl::DeleteShader(vertex_shader);
+        gl::DeleteShader(fragment_shader);
+        std::fprintf(stderr, "Shader compilation failed:\n%s\n", log_.c_str());
+        return false;
+    }
+
+    const GLuint program = gl::CreateProgram();
+    gl::AttachShader(program, vertex_shader);
+    gl::AttachShader(program, fragment_shader);
+    for (int i = 0; i < attribute_count; ++i) {
+        gl::BindAttribLocation(program, static_cast<GLuint>(i), attributes[i]);
+    }
+    gl::LinkProgram(program);
+
+    // Shaders are no longer needed once linked
+    gl::DeleteShader(vertex_shader);
+    gl::DeleteShader(fragment_shader);
+
+    GLint linked = GL_FALSE;
+    gl::GetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (linked != GL_TRUE) {
+        GLint length = 0;
+        gl::GetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
+        std::vector<char> message(static_cast<size_t>(length) + 1, '\0');
+        gl::GetProgramInfoLog(program, length, nullptr, message.data());
+        log_ += message.data();
+        gl::DeleteProgram(program);
+        std::fprintf(stderr, "Shader link failed:\n%s\n", log_.c_str());
+        return false;
+    }
+
+    program_ = program;
+    return true;
+}
+
+uint32_t ShaderProgram::CompileStage(uint32_t type, const char* source) {
+    const GLuint shader = gl::CreateShader(type);
+    gl::ShaderSource(shader, 1, &source, nullptr);
+    gl::CompileShader(shader);
+
+    GLint compiled = GL_FALSE;
+    gl::GetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+    if (compiled != GL_TRUE) {
+        GLint length = 0;
+        gl::GetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+        std::vector<char> message(static_cast<size_t>(length) + 1, '\0');
+        gl::GetShaderInfoLog(shader, length, nullptr, message.data());
+        log_ += message.data();
+        gl::DeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+void ShaderProgram::Release() {
+    if (program_ != 0) {
+        gl::DeleteProgram(program_);
+        program_ = 0;
+    }
+}
+
+void ShaderProgram::Use() const {
+    gl::UseProgram(program_);
+}
+
+void ShaderProgram::Unuse() {
+    if (gl::HasShaders()) {
+        gl::UseProgram(0);
+    }
+}
+
+int32_t ShaderProgram::GetUniformLocation(const char* name) const {
+    if (program_ == 0) {
+        return -1;
+    }
+    return gl::GetUniformLocation(program_, name);
+}
+
+void ShaderProgram::SetUniform(int32_t location, int value) {
+    if (location >= 0) {
+        gl::Uniform1i(location, value);
+    }
+}
+
+void ShaderProgram::SetUniform(int32_t location, float value) {
+    if (location >= 0) {
+        gl::Uniform1f(location, value);
+    }
+}
+
+void ShaderProgram::SetUniform(int32_t location, const glm::vec3& value) {
+    if (location >= 0) {
+        gl::Uniform3f(location, value.x, value.y, value.z);
+    }
+}
+
+void ShaderProgram::SetUniform(int32_t location, const glm::mat4& value) {
+    if (location >= 0) {
+        gl::UniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+    }
+}
+
+void ShaderProgram::SetUniformArray(int32_t location, const float* values, int count) {
+    if (location >= 0) {
+        gl::Uniform1fv(location, count, values);
+    }
+}
+
+void ShaderProgram::SetUniformArray(int32_t location, const glm::vec3* values, int count) {
+    if (location >= 0) {
+        gl::Uniform3fv(location, count, &values[0].x);
+    }
+}
+
+} // namespace render
+} // namespace blec
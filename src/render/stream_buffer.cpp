@@ -0,0 +1,275 @@
+// render/stream_buffer.cpp
+// Implementation of the per-frame upload ring
+
+#include "render/stream_buffer.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace blec {
+namespace render {
+
+namespace {
+
+// Access flags of the persistent mapping; coherent writes need no flush
+constexpr GLbitfield kPersistentFlags =
+    GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+// Access flags of one span in MapRange mode; the ring guarantees no draw
+// reads the span, so the driver must not wait for one
+constexpr GLbitfield kSpanFlags =
+    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+
+size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // anonymous namespace
+
+StreamBuffer::StreamBuffer(size_t capacity)
+    : capacity_(std::max(capacity, kStreamAlignment)), head_(0), tail_(0), frame_bytes_(0),
+      last_frame_bytes_(0), orphan_count_(0), growth_count_(0), gpu_checked_(false),
+      mode_(StreamMode::Client), buffer_(0), mapped_(nullptr), span_mapped_(false) {
+}
+
+StreamBuffer::~StreamBuffer() {
+    // GL buffers and fences must be released explicitly while the context is
+    // current
+}
+
+const char* StreamBuffer::GetModeName(StreamMode mode) {
+    switch (mode) {
+        case StreamMode::Persistent:
+            return "Persistent";
+        case StreamMode::MapRange:
+            return "Map Range";
+        case StreamMode::Orphan:
+            return "Orphan";
+        case StreamMode::Client:
+            break;
+    }
+    return "Client";
+}
+
+void StreamBuffer::InitializeGpu() {
+    gpu_checked_ = true;
+    if (!gl::HasBufferObjects()) {
+        mode_ = StreamMode::Client;
+    } else if (gl::HasBufferStorage() && gl::HasMapBufferRange() && gl::HasSync()) {
+        mode_ = StreamMode::Persistent;
+    } else if (gl::HasMapBufferRange()) {
+        mode_ = StreamMode::MapRange;
+    } else {
+        mode_ = StreamMode::Orphan;
+    }
+    CreateStorage();
+}
+
+void StreamBuffer::CreateStorage() {
+    if (mode_ == StreamMode::Client) {
+        client_.assign(capacity_, 0);
+        return;
+    }
+
+    if (buffer_ == 0) {
+        gl::GenBuffers(1, &buffer_);
+    }
+    gl::BindBuffer(GL_ARRAY_BUFFER, buffer_);
+    if (mode_ == StreamMode::Persistent) {
+        gl::BufferStorage(GL_ARRAY_BUFFER, static_cast<std::ptrdiff_t>(capacity_), nullptr,
+                          kPersistentFlags);
+        mapped_ = static_cast<uint8_t*>(gl::MapBufferRange(
+            GL_ARRAY_BUFFER, 0, static_cast<std::ptrdiff_t>(capacity_), kPersistentFlags));
+        if (mapped_ == nullptr) {
+            // Immutable storage cannot be respecified, so start over with a
+            // mutable buffer
+            std::fprintf(stderr, "StreamBuffer: persistent mapping failed, mapping per span\n");
+            gl::BindBuffer(GL_ARRAY_BUFFER, 0);
+            gl::DeleteBuffers(1, &buffer_);
+            buffer_ = 0;
+            mode_ = StreamMode::MapRange;
+            CreateStorage();
+            return;
+        }
+    } else {
+        gl::BufferData(GL_ARRAY_BUFFER, static_cast<std::ptrdiff_t>(capacity_), nullptr,
+                       GL_STREAM_DRAW);
+    }
+    gl::BindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+StreamSpan StreamBuffer::Allocate(size_t bytes, size_t alignment) {
+    if (!gpu_checked_) {
+        InitializeGpu();
+    }
+    if (bytes == 0) {
+        return StreamSpan{nullptr, 0, 0};
+    }
+    if (bytes > capacity_) {
+        Grow(bytes);
+    }
+
+    // Spans never straddle the end of the ring
+    const size_t head_offset = static_cast<size_t>(head_ % capacity_);
+    size_t offset = AlignUp(head_offset, std::max<size_t>(alignment, 1));
+    uint64_t position = head_ - head_offset + offset;
+    if (offset + bytes > capacity_) {
+        position = head_ - head_offset + capacity_;
+        offset = 0;
+    }
+
+    if (position + bytes > tail_ + capacity_) {
+        if (mode_ == StreamMode::Persistent) {
+            RetireFinishedFrames();
+            if (position + bytes > tail_ + capacity_) {
+                // The GPU may still read every other span: grow rather than
+                // wait for it
+                Grow(capacity_ + bytes);
+                position = 0;
+                offset = 0;
+            }
+        } else {
+            // Client arrays are consumed by the draw call itself; buffers get
+            // fresh storage while draws already issued keep the old one
+            tail_ = position;
+            if (mode_ != StreamMode::Client) {
+                gl::BindBuffer(GL_ARRAY_BUFFER, buffer_);
+                gl::BufferData(GL_ARRAY_BUFFER, static_cast<std::ptrdiff_t>(capacity_), nullptr,
+                               GL_STREAM_DRAW);
+                orphan_count_ += 1;
+            }
+        }
+    }
+    head_ = position + bytes;
+    frame_bytes_ += bytes;
+
+    StreamSpan span{nullptr, offset, bytes};
+    if (mode_ == StreamMode::Persistent) {
+        span.data = mapped_ + offset;
+    } else if (mode_ == StreamMode::Client) {
+        span.data = client_.data() + offset;
+    } else {
+        if (mode_ == StreamMode::MapRange) {
+            gl::BindBuffer(GL_ARRAY_BUFFER, buffer_);
+            span.data = gl::MapBufferRange(GL_ARRAY_BUFFER, static_cast<std::ptrdiff_t>(offset),
+                                           static_cast<std::ptrdiff_t>(bytes), kSpanFlags);
+            span_mapped_ = span.data != nullptr;
+        }
+        if (span.data == nullptr) {
+            staging_.resize(bytes);
+            span.data = staging_.data();
+        }
+    }
+    return span;
+}
+
+void StreamBuffer::Commit(const StreamSpan& span) {
+    if (mode_ == StreamMode::Client) {
+        return;
+    }
+    gl::BindBuffer(GL_ARRAY_BUFFER, buffer_);
+    if (mode_ == StreamMode::Persistent || span.size == 0) {
+        return;
+    }
+    if (span_mapped_) {
+        gl::UnmapBuffer(GL_ARRAY_BUFFER);
+        span_mapped_ = false;
+    } else {
+        // The span lies in storage no issued draw reads, so this does not
+        // stall on the GPU
+        gl::BufferSubData(GL_ARRAY_BUFFER, static_cast<std::ptrdiff_t>(span.offset),
+                          static_cast<std::ptrdiff_t>(span.size), span.data);
+    }
+}
+
+void StreamBuffer::Bind() const {
+    if (mode_ != StreamMode::Client) {
+        gl::BindBuffer(GL_ARRAY_BUFFER, buffer_);
+    }
+}
+
+const void* StreamBuffer::GetPointer(size_t offset) const {
+    if (mode_ == StreamMode::Client) {
+        return client_.data() + offset;
+    }
+    return reinterpret_cast<const void*>(offset);
+}
+
+void StreamBuffer::EndFrame() {
+    last_frame_bytes_ = frame_bytes_;
+    frame_bytes_ = 0;
+    if (mode_ != StreamMode::Persistent) {
+        return;
+    }
+
+    const uint64_t fenced = frames_.empty() ? tail_ : frames_.back().end;
+    if (head_ != fenced) {
+        frames_.push_back(Frame{gl::FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), head_});
+    }
+    RetireFinishedFrames();
+}
+
+void StreamBuffer::RetireFinishedFrames() {
+    while (!frames_.empty()) {
+        // A zero timeout only polls; a failed wait (lost context) retires too
+        const Frame& frame = frames_.front();
+        const GLenum status = gl::ClientWaitSync(frame.fence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED &&
+            status != GL_WAIT_FAILED) {
+            break;
+        }
+        gl::DeleteSync(frame.fence);
+        tail_ = frame.end;
+        frames_.pop_front();
+    }
+}
+
+void StreamBuffer::DropFrames() {
+    for (const Frame& frame : frames_) {
+        gl::DeleteSync(frame.fence);
+    }
+    frames_.clear();
+}
+
+void StreamBuffer::Grow(size_t bytes) {
+    DropFrames();
+    do {
+        capacity_ *= 2;
+    } while (capacity_ < bytes);
+
+    if (mode_ == StreamMode::Persistent && buffer_ != 0) {
+        // Immutable storage cannot be resized; deleting the buffer is safe
+        // since GL keeps it alive until draws reading it complete
+        gl::BindBuffer(GL_ARRAY_BUFFER, buffer_);
+        gl::UnmapBuffer(GL_ARRAY_BUFFER);
+        gl::BindBuffer(GL_ARRAY_BUFFER, 0);
+        gl::DeleteBuffers(1, &buffer_);
+        buffer_ = 0;
+        mapped_ = nullptr;
+    }
+    head_ = 0;
+    tail_ = 0;
+    growth_count_ += 1;
+    CreateStorage();
+}
+
+void StreamBuffer::Release() {
+    DropFrames();
+    if (buffer_ != 0) {
+        if (mapped_ != nullptr || span_mapped_) {
+            gl::BindBuffer(GL_ARRAY_BUFFER, buffer_);
+            gl::UnmapBuffer(GL_ARRAY_BUFFER);
+            gl::BindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+        gl::DeleteBuffers(1, &buffer_);
+        buffer_ = 0;
+    }
+    mapped_ = nullptr;
+    span_mapped_ = false;
+    gpu_checked_ = false;
+    mode_ = StreamMode::Client;
+    head_ = 0;
+    tail_ = 0;
+}
+
+} // namespace render
+} // namespace blec
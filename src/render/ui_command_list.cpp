@@ -0,0 +1,84 @@
+// render/ui_command_list.cpp
+// Implementation of 2D command recording and replay
+
+#include "render/ui_command_list.h"
+#include "render/font.h"
+#include "render/renderer.h"
+
+namespace blec {
+namespace render {
+
+void UiCommandList::Push(UiCommandType type, float a, float b, float c, float d) {
+    UiCommand command{};
+    command.type = type;
+    command.values[0] = a;
+    command.values[1] = b;
+    command.values[2] = c;
+    command.values[3] = d;
+    commands_.push_back(command);
+}
+
+void UiCommandList::SetColor(float r, float g, float b, float a) {
+    Push(UiCommandType::SetColor, r, g, b, a);
+}
+
+void UiCommandList::DrawFilledRect(float x, float y, float w, float h) {
+    Push(UiCommandType::FilledRect, x, y, w, h);
+}
+
+void UiCommandList::DrawLine(float x1, float y1, float x2, float y2) {
+    Push(UiCommandType::Line, x1, y1, x2, y2);
+}
+
+void UiCommandList::DrawText(float x, float y, float scale, const std::string& text) {
+    Push(UiCommandType::Text, x, y, scale);
+    commands_.back().text_offset = static_cast<uint32_t>(text_.size());
+    commands_.back().text_length = static_cast<uint32_t>(text.size());
+    text_ += text;
+}
+
+void UiCommandList::EnableBlending() {
+    Push(UiCommandType::EnableBlending);
+}
+
+void UiCommandList::DisableBlending() {
+    Push(UiCommandType::DisableBlending);
+}
+
+void UiCommandList::Clear() {
+    commands_.clear();
+    text_.clear();
+}
+
+std::string UiCommandList::GetText(const UiCommand& command) const {
+    return text_.substr(command.text_offset, command.text_length);
+}
+
+void UiCommandList::Execute(const BitmapFont& font) const {
+    for (const UiCommand& command : commands_) {
+        const float* v = command.values;
+        switch (command.type) {
+            case UiCommandType::SetColor:
+                Renderer::SetColor(v[0], v[1], v[2], v[3]);
+                break;
+            case UiCommandType::FilledRect:
+                Renderer::DrawFilledRect(v[0], v[1], v[2], v[3]);
+                break;
+            case UiCommandType::Line:
+                Renderer::DrawLine(v[0], v[1], v[2], v[3]);
+                break;
+            case UiCommandType::Text:
+                font.DrawText(v[0], v[1], v[2], GetText(command));
+                break;
+            case UiCommandType::EnableBlending:
+                Renderer::EnableBlending();
+                break;
+            case UiCommandType::DisableBlending:
+                Renderer::DisableBlending();
+                break;
+        }
+    }
+}
+
+} // namespace render
+} // namespace blec
@@ -0,0 +1,192 @@
+// render/vertex_streams.cpp
+// Implementation of structure-of-arrays vertex transforms
+
+#include "render/vertex_streams.h"
+#include <cmath>
+
+// Transforms process 4 vertices at a time with SSE2 when the target supports
+// it; the scalar loop handles the remainder with the same arithmetic
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BLEC_VERTEX_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace blec {
+namespace render {
+
+namespace {
+
+// Whether the bottom row of a transform is (0, 0, 0, 1), so w stays 1
+bool IsAffine(const glm::mat4& transform) {
+    return transform[0][3] == 0.0f && transform[1][3] == 0.0f &&
+           transform[2][3] == 0.0f && transform[3][3] == 1.0f;
+}
+
+} // anonymous namespace
+
+void TransformPositions(const glm::mat4& transform, float* x, float* y, float* z,
+                        size_t count) {
+    const glm::mat4& m = transform;
+    const bool affine = IsAffine(m);
+    size_t i = 0;
+
+#if BLEC_VERTEX_SSE2
+    // Matrix entries broadcast once; glm is column-major (m[column][row])
+    const __m128 m00 = _mm_set1_ps(m[0][0]), m01 = _mm_set1_ps(m[0][1]),
+                 m02 = _mm_set1_ps(m[0][2]), m03 = _mm_set1_ps(m[0][3]);
+    const __m128 m10 = _mm_set1_ps(m[1][0]), m11 = _mm_set1_ps(m[1][1]),
+                 m12 = _mm_set1_ps(m[1][2]), m13 = _mm_set1_ps(m[1][3]);
+    const __m128 m20 = _mm_set1_ps(m[2][0]), m21 = _mm_set1_ps(m[2][1]),
+                 m22 = _mm_set1_ps(m[2][2]), m23 = _mm_set1_ps(m[2][3]);
+    const __m128 m30 = _mm_set1_ps(m[3][0]), m31 = _mm_set1_ps(m[3][1]),
+                 m32 = _mm_set1_ps(m[3][2]), m33 = _mm_set1_ps(m[3][3]);
+
+    for (; i + 4 <= count; i += 4) {
+        const __m128 px = _mm_loadu_ps(x + i);
+        const __m128 py = _mm_loadu_ps(y + i);
+        const __m128 pz = _mm_loadu_ps(z + i);
+
+        __m128 ox = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, px), _mm_mul_ps(m10, py)),
+                               _mm_add_ps(_mm_mul_ps(m20, pz), m30));
+        __m128 oy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m01, px), _mm_mul_ps(m11, py)),
+                               _mm_add_ps(_mm_mul_ps(m21, pz), m31));
+        __m128 oz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m02, px), _mm_mul_ps(m12, py)),
+                               _mm_add_ps(_mm_mul_ps(m22, pz), m32));
+        if (!affine) {
+            const __m128 w = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m03, px), _mm_mul_ps(m13, py)),
+                                        _mm_add_ps(_mm_mul_ps(m23, pz), m33));
+            ox = _mm_div_ps(ox, w);
+            oy = _mm_div_ps(oy, w);
+            oz = _mm_div_ps(oz, w);
+        }
+
+        _mm_storeu_ps(x + i, ox);
+        _mm_storeu_ps(y + i, oy);
+        _mm_storeu_ps(z + i, oz);
+    }
+#endif
+
+    for (; i < count; ++i) {
+        const float px = x[i];
+        const float py = y[i];
+        const float pz = z[i];
+        float ox = (m[0][0] * px + m[1][0] * py) + (m[2][0] * pz + m[3][0]);
+        float oy = (m[0][1] * px + m[1][1] * py) + (m[2][1] * pz + m[3][1]);
+        float oz = (m[0][2] * px + m[1][2] * py) + (m[2][2] * pz + m[3][2]);
+        if (!affine) {
+            const float w = (m[0][3] * px + m[1][3] * py) + (m[2][3] * pz + m[3][3]);
+            ox /= w;
+            oy /= w;
+            oz /= w;
+        }
+        x[i] = ox;
+        y[i] = oy;
+        z[i] = oz;
+    }
+}
+
+void TransformNormals(const glm::mat3& normal_matrix, float* x, float* y, float* z,
+                      size_t count) {
+    const glm::mat3& m = normal_matrix;
+    size_t i = 0;
+
+#if BLEC_VERTEX_SSE2
+    const __m128 m00 = _mm_set1_ps(m[0][0]), m01 = _mm_set1_ps(m[0][1]),
+                 m02 = _mm_set1_ps(m[0][2]);
+    const __m128 m10 = _mm_set1_ps(m[1][0]), m11 = _mm_set1_ps(m[1][1]),
+                 m12 = _mm_set1_ps(m[1][2]);
+    const __m128 m20 = _mm_set1_ps(m[2][0]), m21 = _mm_set1_ps(m[2][1]),
+                 m22 = _mm_set1_ps(m[2][2]);
+
+    for (; i + 4 <= count; i += 4) {
+        const __m128 nx = _mm_loadu_ps(x + i);
+        const __m128 ny = _mm_loadu_ps(y + i);
+        const __m128 nz = _mm_loadu_ps(z + i);
+
+        const __m128 ox = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, nx), _mm_mul_ps(m10, ny)),
+                                     _mm_mul_ps(m20, nz));
+        const __m128 oy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m01, nx), _mm_mul_ps(m11, ny)),
+                                     _mm_mul_ps(m21, nz));
+        const __m128 oz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m02, nx), _mm_mul_ps(m12, ny)),
+                                     _mm_mul_ps(m22, nz));
+
+        // Full-precision square root; the rsqrt estimate would drift
+        const __m128 length = _mm_sqrt_ps(_mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(ox, ox), _mm_mul_ps(oy, oy)), _mm_mul_ps(oz, oz)));
+        _mm_storeu_ps(x + i, _mm_div_ps(ox, length));
+        _mm_storeu_ps(y + i, _mm_div_ps(oy, length));
+        _mm_storeu_ps(z + i, _mm_div_ps(oz, length));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        const float nx = x[i];
+        const float ny = y[i];
+        const float nz = z[i];
+        const float ox = (m[0][0] * nx + m[1][0] * ny) + m[2][0] * nz;
+        const float oy = (m[0][1] * nx + m[1][1] * ny) + m[2][1] * nz;
+        const float oz = (m[0][2] * nx + m[1][2] * ny) + m[2][2] * nz;
+        const float length = std::sqrt((ox * ox + oy * oy) + oz * oz);
+        x[i] = ox / length;
+        y[i] = oy / length;
+        z[i] = oz / length;
+    }
+}
+
+glm::mat3 ComputeNormalMatrix(const glm::mat4& transform) {
+    return glm::mat3(glm::transpose(glm::inverse(transform)));
+}
+
+void VertexStreams::Resize(size_t count) {
+    position_x.resize(count, 0.0f);
+    position_y.resize(count, 0.0f);
+    position_z.resize(count, 0.0f);
+    color_r.resize(count, 0.0f);
+    color_g.resize(count, 0.0f);
+    color_b.resize(count, 0.0f);
+    normal_x.resize(count, 0.0f);
+    normal_y.resize(count, 0.0f);
+    normal_z.resize(count, 0.0f);
+}
+
+void VertexStreams::CopyFrom(const std::vector<Vertex>& vertices) {
+    Resize(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        SetVertex(i, vertices[i]);
+    }
+}
+
+void VertexStreams::CopyTo(std::vector<Vertex>* vertices) const {
+    vertices->resize(GetCount());
+    for (size_t i = 0; i < GetCount(); ++i) {
+        (*vertices)[i] = GetVertex(i);
+    }
+}
+
+Vertex VertexStreams::GetVertex(size_t index) const {
+    return Vertex(glm::vec3(position_x[index], position_y[index], position_z[index]),
+                  glm::vec3(color_r[index], color_g[index], color_b[index]),
+                  glm::vec3(normal_x[index], normal_y[index], normal_z[index]));
+}
+
+void VertexStreams::SetVertex(size_t index, const Vertex& vertex) {
+    position_x[index] = vertex.position.x;
+    position_y[index] = vertex.position.y;
+    position_z[index] = vertex.position.z;
+    color_r[index] = vertex.color.x;
+    color_g[index] = vertex.color.y;
+    color_b[index] = vertex.color.z;
+    normal_x[index] = vertex.normal.x;
+    normal_y[index] = vertex.normal.y;
+    normal_z[index] = vertex.normal.z;
+}
+
+void VertexStreams::ApplyTransform(const glm::mat4& transform) {
+    TransformPositions(transform, position_x.data(), position_y.data(), position_z.data(),
+                       GetCount());
+    TransformNormals(ComputeNormalMatrix(transform), normal_x.data(), normal_y.data(),
+                     normal_z.data(), GetCount());
+}
+
+} // namespace render
+} // namespace blec
@@ -0,0 +1,62 @@
+// render/voxel_mesh.cpp
+// Implementation of packed section meshes
+
+#include "render/voxel_mesh.h"
+
+namespace blec {
+namespace render {
+
+namespace {
+
+// Outward normal per face (NegX, PosX, NegY, PosY, NegZ, PosZ)
+constexpr float kFaceNormals[6][3] = {
+    {-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1}
+};
+
+// Bit layout of VoxelVertex::normal_ao
+constexpr uint8_t kFaceMask = 0x07;
+constexpr int kAmbientOcclusionShift = 3;
+
+} // anonymous namespace
+
+void VoxelMesh::Clear() {
+    vertices_.clear();
+}
+
+void VoxelMesh::TakeGeometry(VoxelMesh* source) {
+    vertices_.swap(source->vertices_);
+    source->vertices_.clear();
+}
+
+void VoxelMesh::AddQuad(const glm::ivec3* corners, int face, uint8_t color, const uint8_t* ao) {
+    for (int corner = 0; corner < 4; ++corner) {
+        const uint8_t occlusion = (ao != nullptr) ? ao[corner] : 0;
+        VoxelVertex vertex{};
+        vertex.x = static_cast<uint8_t>(corners[corner].x);
+        vertex.y = static_cast<uint8_t>(corners[corner].y);
+        vertex.z = static_cast<uint8_t>(corners[corner].z);
+        vertex.normal_ao = static_cast<uint8_t>((face & kFaceMask) |
+                                                (occlusion << kAmbientOcclusionShift));
+        vertex.color = color;
+        vertices_.push_back(vertex);
+    }
+}
+
+glm::vec3 VoxelMesh::DecodePosition(const VoxelVertex& vertex) {
+    return glm::vec3(vertex.x, vertex.y, vertex.z);
+}
+
+int VoxelMesh::DecodeFace(const VoxelVertex& vertex) {
+    return vertex.normal_ao & kFaceMask;
+}
+
+int VoxelMesh::DecodeAmbientOcclusion(const VoxelVertex& vertex) {
+    return vertex.normal_ao >> kAmbientOcclusionShift;
+}
+
+glm::vec3 VoxelMesh::GetFaceNormal(int face) {
+    return glm::vec3(kFaceNormals[face][0], kFaceNormals[face][1], kFaceNormals[face][2]);
+}
+
+} // namespace render
+} // namespace blec
@@ -1,6 +1,7 @@
 #include "ui/ui_manager.h"
 #include "render/renderer.h"
 #include "render/font.h"
+#include "render/ui_command_list.h"
 
 namespace blec {
 namespace ui {
@@ -81,32 +82,46 @@ UIManager::ButtonAction UIManager::HandleMouseClick(float mouse_x, float mouse_y
 }
 
 void UIManager::RenderCrosshair(render::Renderer& renderer) const {
+    (void)renderer;
+    render::UiCommandList commands;
+    RecordCrosshair(&commands);
+    commands.Execute(render::BitmapFont());
+}
+
+void UIManager::RenderPauseMenu(render::Renderer& renderer, render::BitmapFont& font) const {
+    (void)renderer;
+    render::UiCommandList commands;
+    RecordPauseMenu(&commands);
+    commands.Execute(font);
+}
+
+void UIManager::RecordCrosshair(render::UiCommandList* commands) const {
     float center_x = screen_width_ / 2.0f;
     float center_y = screen_height_ / 2.0f;
     
     // Set white color with transparency for crosshair
-    renderer.SetColor(1.0f, 1.0f, 1.0f, 0.7f);
+    commands->SetColor(1.0f, 1.0f, 1.0f, 0.7f);
     
     // Draw horizontal line of crosshair (using DrawLine)
     // Left part (gap in center)
-    renderer.DrawLine(center_x - kCrosshairSize, center_y,
-                      center_x - 5.0f, center_y);
+    commands->DrawLine(center_x - kCrosshairSize, center_y,
+                       center_x - 5.0f, center_y);
     
     // Right part
-    renderer.DrawLine(center_x + 5.0f, center_y,
-                      center_x + kCrosshairSize, center_y);
+    commands->DrawLine(center_x + 5.0f, center_y,
+                       center_x + kCrosshairSize, center_y);
     
     // Draw vertical line of crosshair
     // Top part
-    renderer.DrawLine(center_x, center_y - kCrosshairSize,
-                      center_x, center_y - 5.0f);
+    commands->DrawLine(center_x, center_y - kCrosshairSize,
+                       center_x, center_y - 5.0f);
     
     // Bottom part
-    renderer.DrawLine(center_x, center_y + 5.0f,
-                      center_x, center_y + kCrosshairSize);
+    commands->DrawLine(center_x, center_y + 5.0f,
+                       center_x, center_y + kCrosshairSize);
 }
 
-void UIManager::RenderPauseMenu(render::Renderer& renderer, render::BitmapFont& font) const {
+void UIManager::RecordPauseMenu(render::UiCommandList* commands) const {
     // Only render if paused
     if (!is_paused_) {
         return;
@@ -116,36 +131,36 @@ void UIManager::RenderPauseMenu(render::Renderer& renderer, render::BitmapFont&
     float center_y = screen_height_ / 2.0f;
     
     // Draw semi-transparent dark background overlay
-    renderer.SetColor(0.0f, 0.0f, 0.0f, kMenuBackgroundAlpha);
-    renderer.DrawFilledRect(0.0f, 0.0f,
-                            static_cast<float>(screen_width_), 
-                            static_cast<float>(screen_height_));
+    commands->SetColor(0.0f, 0.0f, 0.0f, kMenuBackgroundAlpha);
+    commands->DrawFilledRect(0.0f, 0.0f,
+                             static_cast<float>(screen_width_), 
+                             static_cast<float>(screen_height_));
     
     // Draw "PAUSED" title at top of menu
     // Position it above the buttons
     float title_y = center_y - 80.0f;
-    renderer.SetColor(1.0f, 1.0f, 1.0f, 1.0f);  // White text
-    font.DrawText(center_x - 30.0f, title_y, 1.0f, "PAUSED");
+    commands->SetColor(1.0f, 1.0f, 1.0f, 1.0f);  // White text
+    commands->DrawText(center_x - 30.0f, title_y, 1.0f, "PAUSED");
     
     // Draw Resume button (green)
-    renderer.SetColor(0.2f, 0.6f, 0.2f, 0.9f);
-    renderer.DrawFilledRect(resume_button_.x, resume_button_.y,
-                            resume_button_.width, resume_button_.height);
+    commands->SetColor(0.2f, 0.6f, 0.2f, 0.9f);
+    commands->DrawFilledRect(resume_button_.x, resume_button_.y,
+                             resume_button_.width, resume_button_.height);
     
     // Draw Resume button text (centered in button)
-    renderer.SetColor(1.0f, 1.0f, 1.0f, 1.0f);  // White text
-    font.DrawText(resume_button_.x + 35.0f, resume_button_.y + 12.0f, 
-                  1.0f, "Resume");
+    commands->SetColor(1.0f, 1.0f, 1.0f, 1.0f);  // White text
+    commands->DrawText(resume_button_.x + 35.0f, resume_button_.y + 12.0f, 
+                       1.0f, "Resume");
     
     // Draw Quit button (red)
-    renderer.SetColor(0.6f, 0.2f, 0.2f, 0.9f);
-    renderer.DrawFilledRect(quit_button_.x, quit_button_.y,
-                            quit_button_.width, quit_button_.height);
+    commands->SetColor(0.6f, 0.2f, 0.2f, 0.9f);
+    commands->DrawFilledRect(quit_button_.x, quit_button_.y,
+                             quit_button_.width, quit_button_.height);
     
     // Draw Quit button text (centered in button)
-    renderer.SetColor(1.0f, 1.0f, 1.0f, 1.0f);  // White text
-    font.DrawText(quit_button_.x + 48.0f, quit_button_.y + 12.0f, 
-                  1.0f, "Quit");
+    commands->SetColor(1.0f, 1.0f, 1.0f, 1.0f);  // White text
+    commands->DrawText(quit_button_.x + 48.0f, quit_button_.y + 12.0f, 
+                       1.0f, "Quit");
 }
 
 void UIManager::UpdateScreenDimensions(int screen_width, int screen_height) {
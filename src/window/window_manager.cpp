@@ -56,6 +56,12 @@ void WindowManager::MakeContextCurrent() {
     }
 }
 
+void WindowManager::ReleaseContext() {
+    if (window_ && glfwGetCurrentContext() == window_) {
+        glfwMakeContextCurrent(nullptr);
+    }
+}
+
 void WindowManager::SetVSync(int interval) {
     glfwSwapInterval(interval);
 }
@@ -2,6 +2,7 @@
 // Block system implementation with frustum culling
 
 #include "world/block_system.h"
+#include "world/voxel_octree.h"
 #include <algorithm>
 #include <cmath>
 
@@ -48,12 +49,39 @@ bool ViewFrustum::IntersectsAABB(const AABB& aabb) const {
     return true;  // AABB intersects frustum
 }
 
+void ViewFrustum::Expand(float padding) {
+    // Planes are normalized, so raising d moves each plane outward by padding
+    for (int i = 0; i < 6; ++i) {
+        planes[i].distance += padding;
+    }
+}
+
+bool ViewFrustum::ContainsAABB(const AABB& aabb) const {
+    // Fully inside when the corner farthest behind each plane is still in front
+    for (int i = 0; i < 6; ++i) {
+        const FrustumPlane& plane = planes[i];
+
+        glm::vec3 farthest(aabb.max);
+
+        if (plane.normal.x > 0.0f) farthest.x = aabb.min.x;
+        if (plane.normal.y > 0.0f) farthest.y = aabb.min.y;
+        if (plane.normal.z > 0.0f) farthest.z = aabb.min.z;
+
+        if (glm::dot(plane.normal, farthest) + plane.distance < 0.0f) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 // ============================================================================
 // BlockSystem Implementation
 // ============================================================================
 
 BlockSystem::BlockSystem()
     : grid_width_(0), grid_height_(0), grid_depth_(0), block_size_(1.0f),
+      section_count_x_(0), section_count_y_(0), section_count_z_(0),
       total_blocks_(0), visible_blocks_(0) {
     // Initialize frustum planes to default values
     for (int i = 0; i < 6; ++i) {
@@ -62,6 +90,8 @@ BlockSystem::BlockSystem()
     }
 }
 
+BlockSystem::~BlockSystem() = default;
+
 bool BlockSystem::Initialize(uint32_t grid_width, uint32_t grid_height, uint32_t grid_depth,
                              float block_size) {
     // Validate parameters
@@ -79,12 +109,41 @@ bool BlockSystem::Initialize(uint32_t grid_width, uint32_t grid_height, uint32_t
     blocks_.resize(total_size);
     std::fill(blocks_.begin(), blocks_.end(), Block{0});
 
+    // Partial sections at the far edges are allowed when the grid size is not
+    // a multiple of kSectionSize
+    section_count_x_ = (grid_width_ + kSectionSize - 1) / kSectionSize;
+    section_count_y_ = (grid_height_ + kSectionSize - 1) / kSectionSize;
+    section_count_z_ = (grid_depth_ + kSectionSize - 1) / kSectionSize;
+    section_block_counts_.assign(GetSectionCount(), 0);
+    section_revisions_.assign(GetSectionCount(), 0);
+    section_mesh_revisions_.assign(GetSectionCount(), 0);
+
     total_blocks_ = 0;
     visible_blocks_ = 0;
+    visible_sections_.clear();
+    previous_visible_sections_.clear();
+    entered_sections_.clear();
+    left_sections_.clear();
+
+    // Grid is all air again; rebuild so the index matches the new dimensions
+    if (spatial_index_) {
+        spatial_index_->Build(*this);
+    }
 
     return true;
 }
 
+void BlockSystem::EnableSpatialIndex() {
+    if (!spatial_index_) {
+        spatial_index_.reset(new VoxelOctree());
+    }
+    spatial_index_->Build(*this);
+}
+
+void BlockSystem::DisableSpatialIndex() {
+    spatial_index_.reset();
+}
+
 void BlockSystem::CreateTestBlocks() {
     // Create a cube of solid blocks at the center of the grid
     // This provides test geometry for frustum culling
@@ -140,17 +199,138 @@ bool BlockSystem::SetBlock(int32_t x, int32_t y, int32_t z, Block block) {
     }
 
     const uint8_t previous_type = blocks_[idx].type;
+    if (previous_type == block.type) {
+        return true;  // No change, keep section revision stable
+    }
     blocks_[idx] = block;
 
+    const uint32_t section = SectionIndexForBlock(x, y, z);
+    section_revisions_[section] += 1;
+    MarkSectionMeshesDirty(x, y, z);
+
     if (previous_type == 0 && block.type != 0) {
         total_blocks_ += 1;
+        section_block_counts_[section] += 1;
     } else if (previous_type != 0 && block.type == 0) {
         total_blocks_ -= 1;
+        section_block_counts_[section] -= 1;
+    }
+
+    if (spatial_index_ && ((previous_type == 0) != (block.type == 0))) {
+        spatial_index_->SetSolid(x, y, z, block.type != 0);
     }
 
     return true;
 }
 
+uint32_t BlockSystem::SectionIndexForBlock(int32_t x, int32_t y, int32_t z) const {
+    return static_cast<uint32_t>(GetSectionIndex(x / kSectionSize, y / kSectionSize,
+                                                 z / kSectionSize));
+}
+
+void BlockSystem::MarkSectionMeshesDirty(int32_t x, int32_t y, int32_t z) {
+    const int32_t coords[3] = {x / kSectionSize, y / kSectionSize, z / kSectionSize};
+    const int32_t local[3] = {x % kSectionSize, y % kSectionSize, z % kSectionSize};
+
+    // Every section whose padded snapshot holds the block: per axis the
+    // owner, plus the neighbor on that side when the block is on the border
+    // (ambient occlusion reads edge and corner cells, not only face cells)
+    int32_t low[3];
+    int32_t high[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        low[axis] = coords[axis] - (local[axis] == 0 ? 1 : 0);
+        high[axis] = coords[axis] + (local[axis] == kSectionSize - 1 ? 1 : 0);
+    }
+
+    for (int32_t sz = low[2]; sz <= high[2]; ++sz) {
+        for (int32_t sy = low[1]; sy <= high[1]; ++sy) {
+            for (int32_t sx = low[0]; sx <= high[0]; ++sx) {
+                const int32_t index = GetSectionIndex(sx, sy, sz);
+                if (index >= 0) {
+                    section_mesh_revisions_[index] += 1;
+                }
+            }
+        }
+    }
+}
+
+int32_t BlockSystem::GetSectionIndex(int32_t sx, int32_t sy, int32_t sz) const {
+    if (sx < 0 || sx >= static_cast<int32_t>(section_count_x_) ||
+        sy < 0 || sy >= static_cast<int32_t>(section_count_y_) ||
+        sz < 0 || sz >= static_cast<int32_t>(section_count_z_)) {
+        return -1;
+    }
+
+    // Same ordering as blocks: X fastest, then Y, then Z
+    return sx + sy * static_cast<int32_t>(section_count_x_) +
+           sz * static_cast<int32_t>(section_count_x_ * section_count_y_);
+}
+
+void BlockSystem::GetSectionCoordinates(uint32_t section_index,
+                                        int32_t* sx, int32_t* sy, int32_t* sz) const {
+    const uint32_t layer = section_count_x_ * section_count_y_;
+    *sx = static_cast<int32_t>(section_index % section_count_x_);
+    *sy = static_cast<int32_t>((section_index % layer) / section_count_x_);
+    *sz = static_cast<int32_t>(section_index / layer);
+}
+
+void BlockSystem::GatherPaddedSection(uint32_t section_index, uint8_t* types) const {
+    int32_t sx = 0;
+    int32_t sy = 0;
+    int32_t sz = 0;
+    GetSectionCoordinates(section_index, &sx, &sy, &sz);
+
+    // Grid coordinates of padded cell (0, 0, 0)
+    const int32_t x0 = sx * kSectionSize - 1;
+    const int32_t y0 = sy * kSectionSize - 1;
+    const int32_t z0 = sz * kSectionSize - 1;
+
+    // Padded X range that lies inside the grid (same for every row)
+    const int32_t first_x = std::max(0, -x0);
+    const int32_t last_x = std::min(kPaddedSectionSize,
+                                    static_cast<int32_t>(grid_width_) - x0);
+
+    std::fill(types, types + kPaddedSectionVolume, uint8_t{0});
+    for (int32_t pz = 0; pz < kPaddedSectionSize; ++pz) {
+        const int32_t z = z0 + pz;
+        if (z < 0 || z >= static_cast<int32_t>(grid_depth_)) {
+            continue;
+        }
+        for (int32_t py = 0; py < kPaddedSectionSize; ++py) {
+            const int32_t y = y0 + py;
+            if (y < 0 || y >= static_cast<int32_t>(grid_height_)) {
+                continue;
+            }
+
+            // Copy one contiguous run of the row
+            const Block* row = &blocks_[CoordinatesToIndex(x0 + first_x, y, z)];
+            uint8_t* out = types + (py + pz * kPaddedSectionSize) * kPaddedSectionSize;
+            for (int32_t px = first_x; px < last_x; ++px) {
+                out[px] = row[px - first_x].type;
+            }
+        }
+    }
+}
+
+AABB BlockSystem::GetSectionAABB(uint32_t section_index) const {
+    int32_t sx = 0;
+    int32_t sy = 0;
+    int32_t sz = 0;
+    GetSectionCoordinates(section_index, &sx, &sy, &sz);
+
+    // Clamp the far corner so edge sections hug the grid instead of
+    // extending into empty space
+    const glm::vec3 grid_max = GetBlockWorldPosition(static_cast<int32_t>(grid_width_),
+                                                     static_cast<int32_t>(grid_height_),
+                                                     static_cast<int32_t>(grid_depth_));
+    const glm::vec3 min = GetBlockWorldPosition(sx * kSectionSize, sy * kSectionSize,
+                                                sz * kSectionSize);
+    const glm::vec3 max = GetBlockWorldPosition((sx + 1) * kSectionSize,
+                                                (sy + 1) * kSectionSize,
+                                                (sz + 1) * kSectionSize);
+    return AABB{min, glm::min(max, grid_max)};
+}
+
 glm::vec3 BlockSystem::GetBlockWorldPosition(int32_t grid_x, int32_t grid_y,
                                              int32_t grid_z) const {
     // Convert grid coordinates to world position
@@ -179,8 +359,21 @@ void BlockSystem::RecalculateTotalBlockCount() {
 
 void BlockSystem::ExtractFrustum(const glm::mat4& view_matrix,
                                   const glm::mat4& projection_matrix) {
+    frustum_ = ComputeFrustum(view_matrix, projection_matrix);
+}
+
+ViewFrustum BlockSystem::ComputeFrustum(const glm::mat4& view_matrix,
+                                        const glm::mat4& projection_matrix) {
+    ViewFrustum frustum;
+    for (int i = 0; i < 6; ++i) {
+        frustum.planes[i].normal = glm::vec3(0.0f);
+        frustum.planes[i].distance = 0.0f;
+    }
+
     // Combine projection and view matrices
-    glm::mat4 clip_matrix = projection_matrix * view_matrix;
+    // GLM matrices are column-major, so transpose to make clip_matrix[i] the
+    // i-th row of the clip transform
+    glm::mat4 clip_matrix = glm::transpose(projection_matrix * view_matrix);
 
     // Extract frustum planes from clip matrix
     // Each row of clip matrix contains plane equations after normalization
@@ -192,8 +385,8 @@ void BlockSystem::ExtractFrustum(const glm::mat4& view_matrix,
         float length = glm::length(normal);
         if (length > 0.0001f) {
             normal /= length;
-            frustum_.planes[2].normal = normal;  // Left plane
-            frustum_.planes[2].distance = plane_eq.w / length;
+            frustum.planes[2].normal = normal;  // Left plane
+            frustum.planes[2].distance = plane_eq.w / length;
         }
     }
 
@@ -204,8 +397,8 @@ void BlockSystem::ExtractFrustum(const glm::mat4& view_matrix,
         float length = glm::length(normal);
         if (length > 0.0001f) {
             normal /= length;
-            frustum_.planes[3].normal = normal;  // Right plane
-            frustum_.planes[3].distance = plane_eq.w / length;
+            frustum.planes[3].normal = normal;  // Right plane
+            frustum.planes[3].distance = plane_eq.w / length;
         }
     }
 
@@ -216,8 +409,8 @@ void BlockSystem::ExtractFrustum(const glm::mat4& view_matrix,
         float length = glm::length(normal);
         if (length > 0.0001f) {
             normal /= length;
-            frustum_.planes[4].normal = normal;  // Top plane
-            frustum_.planes[4].distance = plane_eq.w / length;
+            frustum.planes[4].normal = normal;  // Top plane
+            frustum.planes[4].distance = plane_eq.w / length;
         }
     }
 
@@ -228,8 +421,8 @@ void BlockSystem::ExtractFrustum(const glm::mat4& view_matrix,
         float length = glm::length(normal);
         if (length > 0.0001f) {
             normal /= length;
-            frustum_.planes[5].normal = normal;  // Bottom plane
-            frustum_.planes[5].distance = plane_eq.w / length;
+            frustum.planes[5].normal = normal;  // Bottom plane
+            frustum.planes[5].distance = plane_eq.w / length;
         }
     }
 
@@ -240,8 +433,8 @@ void BlockSystem::ExtractFrustum(const glm::mat4& view_matrix,
         float length = glm::length(normal);
         if (length > 0.0001f) {
             normal /= length;
-            frustum_.planes[0].normal = normal;  // Near plane
-            frustum_.planes[0].distance = plane_eq.w / length;
+            frustum.planes[0].normal = normal;  // Near plane
+            frustum.planes[0].distance = plane_eq.w / length;
         }
     }
 
@@ -252,35 +445,99 @@ void BlockSystem::ExtractFrustum(const glm::mat4& view_matrix,
         float length = glm::length(normal);
         if (length > 0.0001f) {
             normal /= length;
-            frustum_.planes[1].normal = normal;  // Far plane
-            frustum_.planes[1].distance = plane_eq.w / length;
+            frustum.planes[1].normal = normal;  // Far plane
+            frustum.planes[1].distance = plane_eq.w / length;
         }
     }
+
+    return frustum;
 }
 
 void BlockSystem::UpdateVisibility() {
+    // Keep last frame's set (and its storage) around for the enter/leave diff
+    visible_sections_.swap(previous_visible_sections_);
+    visible_blocks_ = CollectVisibleSections(frustum_, &visible_sections_);
+    DiffSections(previous_visible_sections_, visible_sections_,
+                 &entered_sections_, &left_sections_);
+}
+
+void BlockSystem::DiffSections(const std::vector<uint32_t>& previous,
+                               const std::vector<uint32_t>& current,
+                               std::vector<uint32_t>* entered, std::vector<uint32_t>* left) {
+    entered->clear();
+    left->clear();
+
+    // Merge walk over both sorted lists
+    size_t i = 0;
+    size_t j = 0;
+    while (i < previous.size() && j < current.size()) {
+        if (previous[i] == current[j]) {
+            ++i;
+            ++j;
+        } else if (previous[i] < current[j]) {
+            left->push_back(previous[i++]);
+        } else {
+            entered->push_back(current[j++]);
+        }
+    }
+    left->insert(left->end(), previous.begin() + i, previous.end());
+    entered->insert(entered->end(), current.begin() + j, current.end());
+}
+
+uint32_t BlockSystem::CollectVisibleSections(const ViewFrustum& frustum,
+                                             std::vector<uint32_t>* sections) const {
     // Count non-air blocks visible in frustum
     uint32_t visible_count = 0;
+    sections->clear();
+
+    for (uint32_t section = 0; section < GetSectionCount(); ++section) {
+        // Empty sections and sections outside the frustum cannot contain
+        // visible blocks, so skip their per-block tests entirely
+        if (section_block_counts_[section] == 0 ||
+            !frustum.IntersectsAABB(GetSectionAABB(section))) {
+            continue;
+        }
+        sections->push_back(section);
 
-    for (uint32_t z = 0; z < grid_depth_; ++z) {
-        for (uint32_t y = 0; y < grid_height_; ++y) {
-            for (uint32_t x = 0; x < grid_width_; ++x) {
-                const Block& block = GetBlock(x, y, z);
-
-                // Only test non-air blocks
-                if (block.type != 0) {
-                    AABB block_aabb = GetBlockAABB(x, y, z);
+        // The octree answers the block count below in one pass
+        if (spatial_index_) {
+            continue;
+        }
 
-                    // Test against frustum
-                    if (frustum_.IntersectsAABB(block_aabb)) {
-                        visible_count++;
+        int32_t sx = 0;
+        int32_t sy = 0;
+        int32_t sz = 0;
+        GetSectionCoordinates(section, &sx, &sy, &sz);
+        const int32_t x0 = sx * kSectionSize;
+        const int32_t y0 = sy * kSectionSize;
+        const int32_t z0 = sz * kSectionSize;
+        const int32_t x1 = std::min(x0 + kSectionSize, static_cast<int32_t>(grid_width_));
+        const int32_t y1 = std::min(y0 + kSectionSize, static_cast<int32_t>(grid_height_));
+        const int32_t z1 = std::min(z0 + kSectionSize, static_cast<int32_t>(grid_depth_));
+
+        for (int32_t z = z0; z < z1; ++z) {
+            for (int32_t y = y0; y < y1; ++y) {
+                for (int32_t x = x0; x < x1; ++x) {
+                    const Block& block = GetBlock(x, y, z);
+
+                    // Only test non-air blocks
+                    if (block.type != 0) {
+                        AABB block_aabb = GetBlockAABB(x, y, z);
+
+                        // Test against frustum
+                        if (frustum.IntersectsAABB(block_aabb)) {
+                            visible_count++;
+                        }
                     }
                 }
             }
         }
     }
 
-    visible_blocks_ = visible_count;
+    if (spatial_index_) {
+        visible_count = spatial_index_->CountInFrustum(frustum);
+    }
+    return visible_count;
 }
 
 } // namespace world
@@ -0,0 +1,220 @@
+// src/world/culling_pipeline.cpp
+// Pipelined visibility culling implementation
+
+#include "world/culling_pipeline.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace blec {
+namespace world {
+
+namespace {
+
+// Widest half-angle a padded frustum may use (keeps tan() finite)
+constexpr float kMaxHalfAngle = 1.48f;  // ~85 degrees
+
+// Tolerance when comparing projection parameters
+constexpr float kProjectionEpsilon = 1e-4f;
+
+// Angle between two normalized directions
+float AngleBetween(const glm::vec3& a, const glm::vec3& b) {
+    return std::acos(std::max(-1.0f, std::min(1.0f, glm::dot(a, b))));
+}
+
+} // anonymous namespace
+
+CullingPipeline::CullingPipeline(const BlockSystem& blocks)
+    : blocks_(blocks), result_(), pending_result_(), has_result_(false),
+      result_ready_(false), mispredictions_(0), pending_view_(), job_pending_(false),
+      stop_(false) {
+}
+
+CullingPipeline::~CullingPipeline() {
+    Stop();
+}
+
+bool CullingPipeline::Start() {
+    if (worker_.joinable()) {
+        return true;
+    }
+
+    stop_ = false;
+    worker_ = std::thread(&CullingPipeline::WorkerLoop, this);
+    return worker_.joinable();
+}
+
+void CullingPipeline::Stop() {
+    if (!worker_.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    job_ready_.notify_one();
+    worker_.join();
+}
+
+void CullingPipeline::Submit(const CullingView& view) {
+    if (!worker_.joinable()) {
+        CullNow(view);
+        return;
+    }
+
+    // Only one pass is in flight at a time
+    WaitForResult();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_view_ = view;
+        job_pending_ = true;
+    }
+    job_ready_.notify_one();
+}
+
+bool CullingPipeline::WaitForResult() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    job_done_.wait(lock, [this] { return !job_pending_; });
+
+    // Publish on the caller's thread so GetResult() never changes underneath
+    // a frame that is still reading it
+    if (result_ready_) {
+        std::swap(result_, pending_result_);
+        result_ready_ = false;
+        has_result_ = true;
+    }
+    return has_result_;
+}
+
+void CullingPipeline::CullNow(const CullingView& view) {
+    // Never race the worker for the culling stages
+    WaitForResult();
+    RunPass(view, &result_);
+    has_result_ = true;
+}
+
+const CullingResult& CullingPipeline::Acquire(const CullingView& actual) {
+    const bool has_result = WaitForResult();
+    if (!has_result || !Covers(result_.view, actual)) {
+        if (has_result) {
+            mispredictions_ += 1;
+        }
+        CullNow(actual);
+    }
+
+    // Diff against what the caller saw last frame, whichever pass produced it
+    BlockSystem::DiffSections(acquired_sections_, result_.visible_sections,
+                              &result_.entered_sections, &result_.left_sections);
+    acquired_sections_ = result_.visible_sections;
+    return result_;
+}
+
+void CullingPipeline::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        job_ready_.wait(lock, [this] { return job_pending_ || stop_; });
+        if (job_pending_) {
+            const CullingView view = pending_view_;
+            lock.unlock();
+            RunPass(view, &pending_result_);
+            lock.lock();
+
+            result_ready_ = true;
+            job_pending_ = false;
+            job_done_.notify_all();
+            continue;  // Finish queued work before honoring stop
+        }
+        if (stop_) {
+            return;
+        }
+    }
+}
+
+void CullingPipeline::RunPass(const CullingView& view, CullingResult* result) {
+    using clock = std::chrono::steady_clock;
+    const auto start_time = clock::now();
+
+    // Frustum stage against the padded frustum
+    const ViewFrustum frustum = BuildFrustum(view);
+    result->visible_block_count = blocks_.CollectVisibleSections(frustum, &frustum_sections_);
+
+    // Cave culling from the predicted camera position
+    connectivity_.Traverse(blocks_, view.position);
+    connectivity_.FilterSections(frustum_sections_, &reachable_sections_);
+
+    // Occlusion from the predicted viewpoint; the culler widens tested boxes
+    // by the position padding scaled with their depth behind the nearest
+    // occluder, so the result holds for any camera inside the padding
+    // The occlusion screen covers the padded field of view: boxes are clamped
+    // to the screen, so with the unpadded one a section sticking out past the
+    // predicted edge would be judged by its on-screen part alone and pop in
+    // late when the camera turns within angle_padding
+    const glm::mat4 view_matrix = glm::lookAt(view.position, view.position + view.forward, view.up);
+    const glm::mat4 projection = BuildPaddedProjection(view);
+    occlusion_culler_.SetTestPadding(view.position_padding);
+    occlusion_culler_.Cull(blocks_, projection * view_matrix, view.position,
+                           reachable_sections_, &result->visible_sections);
+
+    result->view = view;
+    result->frustum_section_count = static_cast<uint32_t>(frustum_sections_.size());
+    result->reachable_section_count = static_cast<uint32_t>(reachable_sections_.size());
+    result->occluded_section_count = occlusion_culler_.GetOccludedSectionCount();
+
+    const std::chrono::duration<double, std::milli> elapsed = clock::now() - start_time;
+    result->cull_time_ms = elapsed.count();
+}
+
+CullingView CullingPipeline::PredictView(const CullingView& previous, const CullingView& current,
+                                         float min_padding) {
+    CullingView predicted = current;
+
+    // Constant velocity extrapolation of position and view direction
+    const glm::vec3 displacement = current.position - previous.position;
+    predicted.position = current.position + displacement;
+
+    const glm::vec3 turned = current.forward + (current.forward - previous.forward);
+    if (glm::length(turned) > 1e-4f) {
+        predicted.forward = glm::normalize(turned);
+    }
+
+    // One more frame of motion as slack on top of the extrapolation
+    predicted.position_padding = min_padding + glm::length(displacement);
+    predicted.angle_padding = AngleBetween(previous.forward, current.forward) +
+                              AngleBetween(current.forward, predicted.forward);
+    return predicted;
+}
+
+bool CullingPipeline::Covers(const CullingView& culled, const CullingView& actual) {
+    if (std::abs(culled.aspect - actual.aspect) > kProjectionEpsilon ||
+        actual.fov_y > culled.fov_y + kProjectionEpsilon ||
+        actual.near_plane < culled.near_plane - kProjectionEpsilon ||
+        actual.far_plane > culled.far_plane + kProjectionEpsilon) {
+        return false;
+    }
+
+    return glm::length(actual.position - culled.position) <= culled.position_padding &&
+           AngleBetween(actual.forward, culled.forward) <= culled.angle_padding + kProjectionEpsilon;
+}
+
+ViewFrustum CullingPipeline::BuildFrustum(const CullingView& view) {
+    const glm::mat4 view_matrix = glm::lookAt(view.position, view.position + view.forward, view.up);
+    ViewFrustum frustum = BlockSystem::ComputeFrustum(view_matrix, BuildPaddedProjection(view));
+    frustum.Expand(view.position_padding);
+    return frustum;
+}
+
+glm::mat4 CullingPipeline::BuildPaddedProjection(const CullingView& view) {
+    // Widen both half-angles by the angular padding; the aspect is recomputed
+    // so the horizontal extent grows by the same angle as the vertical one
+    const float half_y = view.fov_y * 0.5f;
+    const float half_x = std::atan(view.aspect * std::tan(half_y));
+    const float padded_y = std::min(half_y + view.angle_padding, kMaxHalfAngle);
+    const float padded_x = std::min(half_x + view.angle_padding, kMaxHalfAngle);
+    return glm::perspective(padded_y * 2.0f, std::tan(padded_x) / std::tan(padded_y),
+                            view.near_plane, view.far_plane);
+}
+
+} // namespace world
+} // namespace blec
@@ -0,0 +1,443 @@
+// src/world/occlusion_culler.cpp
+// Software occlusion culling implementation (depth rasterizer + hi-Z test)
+
+#include "world/occlusion_culler.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// The rasterizer inner loop processes 4 pixels at a time with SSE2 when the
+// target supports it; the scalar loop below produces identical results
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BLEC_OCCLUSION_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace blec {
+namespace world {
+
+namespace {
+
+// Clip-space W below which a point counts as behind the camera
+constexpr float kMinClipW = 1e-4f;
+
+// Box corner indices for each face, in cyclic order
+// Corner bit 0 selects max X, bit 1 max Y, bit 2 max Z
+constexpr int kFaceCorners[6][4] = {
+    {0, 2, 6, 4},  // -X
+    {1, 3, 7, 5},  // +X
+    {0, 1, 5, 4},  // -Y
+    {2, 3, 7, 6},  // +Y
+    {0, 1, 3, 2},  // -Z
+    {4, 5, 7, 6}   // +Z
+};
+
+glm::vec3 BoxCorner(const AABB& box, int corner) {
+    return glm::vec3((corner & 1) ? box.max.x : box.min.x,
+                     (corner & 2) ? box.max.y : box.min.y,
+                     (corner & 4) ? box.max.z : box.min.z);
+}
+
+// Find the longest run of consecutive full layers
+// @return Run length; *start receives the first layer of the run
+int LongestFullRun(const uint32_t* counts, int layers, uint32_t full_count, int* start) {
+    int best = 0;
+    int run = 0;
+    for (int i = 0; i < layers; ++i) {
+        run = (counts[i] == full_count) ? run + 1 : 0;
+        if (run > best) {
+            best = run;
+            *start = i - run + 1;
+        }
+    }
+    return best;
+}
+
+} // anonymous namespace
+
+OcclusionCuller::OcclusionCuller()
+    : view_projection_(1.0f), camera_position_(0.0f),
+      nearest_occluder_(std::numeric_limits<float>::max()),
+      max_occluders_(kDefaultMaxOccluders), test_padding_(0.0f), tested_sections_(0),
+      occluded_sections_(0), occluder_count_(0) {
+    // Allocate every pyramid level once; each level halves both dimensions
+    int width = kDepthWidth;
+    int height = kDepthHeight;
+    while (true) {
+        depth_levels_.emplace_back(static_cast<size_t>(width) * height, 1.0f);
+        level_widths_.push_back(width);
+        level_heights_.push_back(height);
+        if (width == 1 && height == 1) {
+            break;
+        }
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+}
+
+void OcclusionCuller::Cull(const BlockSystem& blocks, const glm::mat4& view_projection,
+                           const glm::vec3& camera_position,
+                           const std::vector<uint32_t>& candidate_sections,
+                           std::vector<uint32_t>* visible_sections) {
+    BeginFrame(view_projection, camera_position);
+
+    if (occluders_.size() != blocks.GetSectionCount()) {
+        occluders_.assign(blocks.GetSectionCount(), SectionOccluder{0, false, false, AABB{}});
+    }
+
+    // Nearest sections first: they cover the most screen area and are the
+    // most likely to hide what lies behind them
+    sorted_candidates_.clear();
+    for (uint32_t section : candidate_sections) {
+        const AABB bounds = blocks.GetSectionAABB(section);
+        const glm::vec3 closest = glm::clamp(camera_position, bounds.min, bounds.max);
+        const glm::vec3 offset = closest - camera_position;
+        sorted_candidates_.emplace_back(glm::dot(offset, offset), section);
+    }
+    std::sort(sorted_candidates_.begin(), sorted_candidates_.end());
+
+    occluder_count_ = 0;
+    for (const auto& candidate : sorted_candidates_) {
+        if (occluder_count_ >= max_occluders_) {
+            break;
+        }
+
+        const uint32_t section = candidate.second;
+        SectionOccluder& occluder = occluders_[section];
+        const uint32_t revision = blocks.GetSectionRevision(section);
+        if (!occluder.valid || occluder.revision != revision) {
+            occluder.has_box = ComputeSectionOccluder(blocks, section, &occluder.box);
+            occluder.revision = revision;
+            occluder.valid = true;
+        }
+
+        if (occluder.has_box) {
+            RasterizeOccluder(occluder.box);
+            occluder_count_ += 1;
+        }
+    }
+
+    BuildHierarchy();
+
+    // Test every candidate, including the occluders themselves: an occluder
+    // box lies inside its own section, so a section never hides itself
+    visible_sections->clear();
+    tested_sections_ = static_cast<uint32_t>(candidate_sections.size());
+    occluded_sections_ = 0;
+    for (uint32_t section : candidate_sections) {
+        if (IsOccluded(blocks.GetSectionAABB(section))) {
+            occluded_sections_ += 1;
+        } else {
+            visible_sections->push_back(section);
+        }
+    }
+}
+
+void OcclusionCuller::BeginFrame(const glm::mat4& view_projection,
+                                 const glm::vec3& camera_position) {
+    view_projection_ = view_projection;
+    camera_position_ = camera_position;
+    nearest_occluder_ = std::numeric_limits<float>::max();
+    std::fill(depth_levels_[0].begin(), depth_levels_[0].end(), 1.0f);
+}
+
+bool OcclusionCuller::ComputeSectionOccluder(const BlockSystem& blocks, uint32_t section,
+                                             AABB* box) {
+    // Only fully solid layers are used as occluders: they are guaranteed to
+    // block every ray passing through them, so the result stays conservative
+    if (blocks.GetSectionBlockCount(section) == 0) {
+        return false;
+    }
+
+    int32_t sx = 0;
+    int32_t sy = 0;
+    int32_t sz = 0;
+    blocks.GetSectionCoordinates(section, &sx, &sy, &sz);
+    const int32_t x0 = sx * kSectionSize;
+    const int32_t y0 = sy * kSectionSize;
+    const int32_t z0 = sz * kSectionSize;
+    const int32_t size_x = std::min(kSectionSize, static_cast<int32_t>(blocks.GetGridWidth()) - x0);
+    const int32_t size_y = std::min(kSectionSize, static_cast<int32_t>(blocks.GetGridHeight()) - y0);
+    const int32_t size_z = std::min(kSectionSize, static_cast<int32_t>(blocks.GetGridDepth()) - z0);
+
+    // Solid block count per layer along each axis
+    uint32_t counts_x[kSectionSize] = {};
+    uint32_t counts_y[kSectionSize] = {};
+    uint32_t counts_z[kSectionSize] = {};
+    for (int32_t z = 0; z < size_z; ++z) {
+        for (int32_t y = 0; y < size_y; ++y) {
+            for (int32_t x = 0; x < size_x; ++x) {
+                if (blocks.GetBlock(x0 + x, y0 + y, z0 + z).type != 0) {
+                    counts_x[x] += 1;
+                    counts_y[y] += 1;
+                    counts_z[z] += 1;
+                }
+            }
+        }
+    }
+
+    // A run of consecutive full layers forms a solid box; keep the biggest
+    int start_x = 0;
+    int start_y = 0;
+    int start_z = 0;
+    const int run_x = LongestFullRun(counts_x, size_x, static_cast<uint32_t>(size_y * size_z), &start_x);
+    const int run_y = LongestFullRun(counts_y, size_y, static_cast<uint32_t>(size_x * size_z), &start_y);
+    const int run_z = LongestFullRun(counts_z, size_z, static_cast<uint32_t>(size_x * size_y), &start_z);
+
+    const int volume_x = run_x * size_y * size_z;
+    const int volume_y = run_y * size_x * size_z;
+    const int volume_z = run_z * size_x * size_y;
+    if (volume_x == 0 && volume_y == 0 && volume_z == 0) {
+        return false;
+    }
+
+    glm::ivec3 box_min(x0, y0, z0);
+    glm::ivec3 box_max(x0 + size_x, y0 + size_y, z0 + size_z);
+    if (volume_x >= volume_y && volume_x >= volume_z) {
+        box_min.x = x0 + start_x;
+        box_max.x = box_min.x + run_x;
+    } else if (volume_y >= volume_z) {
+        box_min.y = y0 + start_y;
+        box_max.y = box_min.y + run_y;
+    } else {
+        box_min.z = z0 + start_z;
+        box_max.z = box_min.z + run_z;
+    }
+
+    box->min = blocks.GetBlockWorldPosition(box_min.x, box_min.y, box_min.z);
+    box->max = blocks.GetBlockWorldPosition(box_max.x, box_max.y, box_max.z);
+    return true;
+}
+
+bool OcclusionCuller::ProjectPoint(const glm::vec3& point, ScreenVertex* out) const {
+    const glm::vec4 clip = view_projection_ * glm::vec4(point, 1.0f);
+    if (clip.w < kMinClipW) {
+        return false;
+    }
+
+    const float inv_w = 1.0f / clip.w;
+    out->x = (clip.x * inv_w * 0.5f + 0.5f) * static_cast<float>(kDepthWidth);
+    out->y = (clip.y * inv_w * 0.5f + 0.5f) * static_cast<float>(kDepthHeight);
+    out->z = clip.z * inv_w;
+    return true;
+}
+
+void OcclusionCuller::RasterizeOccluder(const AABB& box) {
+    ScreenVertex corners[8];
+    for (int i = 0; i < 8; ++i) {
+        if (!ProjectPoint(BoxCorner(box, i), &corners[i])) {
+            return;
+        }
+    }
+
+    // Only faces whose outside the camera is on can be nearest; back faces
+    // are always behind them and would only waste fill rate
+    const bool face_visible[6] = {
+        camera_position_.x < box.min.x, camera_position_.x > box.max.x,
+        camera_position_.y < box.min.y, camera_position_.y > box.max.y,
+        camera_position_.z < box.min.z, camera_position_.z > box.max.z
+    };
+
+    const glm::vec3 closest = glm::clamp(camera_position_, box.min, box.max);
+    nearest_occluder_ = std::min(nearest_occluder_, glm::length(closest - camera_position_));
+
+    for (int face = 0; face < 6; ++face) {
+        if (!face_visible[face]) {
+            continue;
+        }
+        const int* quad = kFaceCorners[face];
+        RasterizeTriangle(corners[quad[0]], corners[quad[1]], corners[quad[2]]);
+        RasterizeTriangle(corners[quad[0]], corners[quad[2]], corners[quad[3]]);
+    }
+}
+
+void OcclusionCuller::RasterizeTriangle(const ScreenVertex& v0, const ScreenVertex& v1,
+                                        const ScreenVertex& v2) {
+    // Edge function of edge (a, b): A * px + B * py + C, positive on the inside
+    // for counter-clockwise triangles
+    float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+    if (std::fabs(area) < 1e-6f) {
+        return;  // Degenerate or edge-on
+    }
+
+    // Normalize winding so the same inside test works for both orientations
+    const ScreenVertex& a = v0;
+    const ScreenVertex& b = (area > 0.0f) ? v1 : v2;
+    const ScreenVertex& c = (area > 0.0f) ? v2 : v1;
+    area = std::fabs(area);
+
+    const int min_x = std::max(0, static_cast<int>(std::floor(std::min({a.x, b.x, c.x}))));
+    const int max_x = std::min(kDepthWidth - 1, static_cast<int>(std::ceil(std::max({a.x, b.x, c.x}))));
+    const int min_y = std::max(0, static_cast<int>(std::floor(std::min({a.y, b.y, c.y}))));
+    const int max_y = std::min(kDepthHeight - 1, static_cast<int>(std::ceil(std::max({a.y, b.y, c.y}))));
+    if (min_x > max_x || min_y > max_y) {
+        return;  // Fully off-screen
+    }
+
+    // Edge equations opposite each vertex (weights for barycentric depth)
+    const float ea_a = b.y - c.y, ea_b = c.x - b.x, ea_c = b.x * c.y - b.y * c.x;
+    const float eb_a = c.y - a.y, eb_b = a.x - c.x, eb_c = c.x * a.y - c.y * a.x;
+    const float ec_a = a.y - b.y, ec_b = b.x - a.x, ec_c = a.x * b.y - a.y * b.x;
+
+    // Depth is affine in screen space after the perspective divide
+    const float inv_area = 1.0f / area;
+    const float z_a = (a.z * ea_a + b.z * eb_a + c.z * ec_a) * inv_area;
+    const float z_b = (a.z * ea_b + b.z * eb_b + c.z * ec_b) * inv_area;
+    const float z_c = (a.z * ea_c + b.z * eb_c + c.z * ec_c) * inv_area;
+
+    float* depth = depth_levels_[0].data();
+
+#if BLEC_OCCLUSION_SSE2
+    // Start on a 4-pixel boundary; kDepthWidth is a multiple of 4 so every
+    // group stays inside the row
+    const int start_x = min_x & ~3;
+    const __m128 lane_offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 ea_a4 = _mm_set1_ps(ea_a);
+    const __m128 eb_a4 = _mm_set1_ps(eb_a);
+    const __m128 ec_a4 = _mm_set1_ps(ec_a);
+    const __m128 z_a4 = _mm_set1_ps(z_a);
+
+    for (int y = min_y; y <= max_y; ++y) {
+        const float py = static_cast<float>(y) + 0.5f;
+        const __m128 ea_row = _mm_set1_ps(ea_b * py + ea_c);
+        const __m128 eb_row = _mm_set1_ps(eb_b * py + eb_c);
+        const __m128 ec_row = _mm_set1_ps(ec_b * py + ec_c);
+        const __m128 z_row = _mm_set1_ps(z_b * py + z_c);
+        float* row = depth + y * kDepthWidth;
+
+        for (int x = start_x; x <= max_x; x += 4) {
+            const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), lane_offsets);
+            const __m128 wa = _mm_add_ps(_mm_mul_ps(ea_a4, px), ea_row);
+            const __m128 wb = _mm_add_ps(_mm_mul_ps(eb_a4, px), eb_row);
+            const __m128 wc = _mm_add_ps(_mm_mul_ps(ec_a4, px), ec_row);
+            const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(wa, zero),
+                                                        _mm_cmpge_ps(wb, zero)),
+                                             _mm_cmpge_ps(wc, zero));
+            if (_mm_movemask_ps(inside) == 0) {
+                continue;
+            }
+
+            const __m128 z = _mm_add_ps(_mm_mul_ps(z_a4, px), z_row);
+            const __m128 old_depth = _mm_loadu_ps(row + x);
+            const __m128 new_depth = _mm_min_ps(old_depth, z);
+            _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, new_depth),
+                                             _mm_andnot_ps(inside, old_depth)));
+        }
+    }
+#else
+    for (int y = min_y; y <= max_y; ++y) {
+        const float py = static_cast<float>(y) + 0.5f;
+        float* row = depth + y * kDepthWidth;
+
+        for (int x = min_x; x <= max_x; ++x) {
+            const float px = static_cast<float>(x) + 0.5f;
+            const float wa = ea_a * px + ea_b * py + ea_c;
+            const float wb = eb_a * px + eb_b * py + eb_c;
+            const float wc = ec_a * px + ec_b * py + ec_c;
+            if (wa >= 0.0f && wb >= 0.0f && wc >= 0.0f) {
+                const float z = z_a * px + z_b * py + z_c;
+                row[x] = std::min(row[x], z);
+            }
+        }
+    }
+#endif
+}
+
+void OcclusionCuller::BuildHierarchy() {
+    // Each coarser texel keeps the farthest depth of the texels it covers,
+    // so a box nearer than that value cannot be hidden by anything inside
+    for (size_t level = 1; level < depth_levels_.size(); ++level) {
+        const std::vector<float>& src = depth_levels_[level - 1];
+        std::vector<float>& dst = depth_levels_[level];
+        const int src_width = level_widths_[level - 1];
+        const int src_height = level_heights_[level - 1];
+        const int dst_width = level_widths_[level];
+        const int dst_height = level_heights_[level];
+
+        for (int y = 0; y < dst_height; ++y) {
+            const int y0 = std::min(y * 2, src_height - 1);
+            const int y1 = std::min(y * 2 + 1, src_height - 1);
+            for (int x = 0; x < dst_width; ++x) {
+                const int x0 = std::min(x * 2, src_width - 1);
+                const int x1 = std::min(x * 2 + 1, src_width - 1);
+                dst[y * dst_width + x] = std::max(
+                    std::max(src[y0 * src_width + x0], src[y0 * src_width + x1]),
+                    std::max(src[y1 * src_width + x0], src[y1 * src_width + x1]));
+            }
+        }
+    }
+}
+
+bool OcclusionCuller::IsOccluded(const AABB& box) const {
+    // A camera displaced by test_padding_ sees the silhouette of an occluder
+    // at distance d_o shifted by up to test_padding_ * (d / d_o - 1) at the
+    // box's distance d; inflating by test_padding_ * d / d_o covers that and
+    // the shift of the box itself
+    AABB padded = box;
+    if (test_padding_ > 0.0f) {
+        if (nearest_occluder_ <= test_padding_) {
+            return false;  // The camera may reach or pass the occluder
+        }
+        const glm::vec3 far_corner(
+            std::max(std::abs(box.min.x - camera_position_.x), std::abs(box.max.x - camera_position_.x)),
+            std::max(std::abs(box.min.y - camera_position_.y), std::abs(box.max.y - camera_position_.y)),
+            std::max(std::abs(box.min.z - camera_position_.z), std::abs(box.max.z - camera_position_.z)));
+        const float margin =
+            test_padding_ * std::max(1.0f, glm::length(far_corner) / nearest_occluder_);
+        padded.min -= glm::vec3(margin);
+        padded.max += glm::vec3(margin);
+    }
+
+    float min_x = static_cast<float>(kDepthWidth);
+    float min_y = static_cast<float>(kDepthHeight);
+    float max_x = 0.0f;
+    float max_y = 0.0f;
+    float min_z = 1.0f;
+
+    for (int i = 0; i < 8; ++i) {
+        ScreenVertex corner;
+        if (!ProjectPoint(BoxCorner(padded, i), &corner)) {
+            return false;  // Crosses the camera plane, assume visible
+        }
+        min_x = std::min(min_x, corner.x);
+        min_y = std::min(min_y, corner.y);
+        max_x = std::max(max_x, corner.x);
+        max_y = std::max(max_y, corner.y);
+        min_z = std::min(min_z, corner.z);
+    }
+
+    // Clamp the screen rectangle; a box fully off-screen is left to the
+    // frustum test rather than reported as occluded
+    const int x0 = std::max(0, static_cast<int>(std::floor(min_x)));
+    const int y0 = std::max(0, static_cast<int>(std::floor(min_y)));
+    const int x1 = std::min(kDepthWidth - 1, static_cast<int>(std::floor(max_x)));
+    const int y1 = std::min(kDepthHeight - 1, static_cast<int>(std::floor(max_y)));
+    if (x0 > x1 || y0 > y1) {
+        return false;
+    }
+
+    // Pick the level where the rectangle touches at most 2 texels per axis,
+    // so the test reads at most 4 values regardless of box size; the span is
+    // measured on the shifted bounds, since an unaligned rectangle can touch
+    // 3 texels even when its extent fits in 2
+    size_t level = 0;
+    while (level + 1 < depth_levels_.size() &&
+           ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1)) {
+        ++level;
+    }
+
+    const std::vector<float>& depth = depth_levels_[level];
+    const int width = level_widths_[level];
+    float max_depth = 0.0f;
+    for (int y = y0 >> level; y <= (y1 >> level); ++y) {
+        for (int x = x0 >> level; x <= (x1 >> level); ++x) {
+            max_depth = std::max(max_depth, depth[y * width + x]);
+        }
+    }
+
+    return min_z > max_depth;
+}
+
+} // namespace world
+} // namespace blec
@@ -0,0 +1,217 @@
+// src/world/section_connectivity.cpp
+// Section face connectivity (flood fill) and cave culling traversal
+
+#include "world/section_connectivity.h"
+#include <algorithm>
+#include <cmath>
+
+namespace blec {
+namespace world {
+
+namespace {
+
+// Every face pair connected (result for sections without opaque blocks)
+constexpr uint64_t kAllFacesConnected = (uint64_t{1} << (kSectionFaceCount * kSectionFaceCount)) - 1;
+
+// Section grid step for each SectionFace
+constexpr int32_t kFaceOffsets[kSectionFaceCount][3] = {
+    {-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1}
+};
+
+// Local cell index inside a section (fixed stride even for partial sections)
+inline uint32_t CellIndex(int32_t x, int32_t y, int32_t z) {
+    return static_cast<uint32_t>(x + y * kSectionSize + z * kSectionSize * kSectionSize);
+}
+
+} // anonymous namespace
+
+SectionConnectivity::SectionConnectivity()
+    : reachable_count_(0) {
+}
+
+uint64_t SectionConnectivity::ComputeFaceConnections(const BlockSystem& blocks,
+                                                     uint32_t section_index) {
+    int32_t sx = 0;
+    int32_t sy = 0;
+    int32_t sz = 0;
+    blocks.GetSectionCoordinates(section_index, &sx, &sy, &sz);
+    const int32_t x0 = sx * kSectionSize;
+    const int32_t y0 = sy * kSectionSize;
+    const int32_t z0 = sz * kSectionSize;
+    const int32_t size_x = std::min(kSectionSize, static_cast<int32_t>(blocks.GetGridWidth()) - x0);
+    const int32_t size_y = std::min(kSectionSize, static_cast<int32_t>(blocks.GetGridHeight()) - y0);
+    const int32_t size_z = std::min(kSectionSize, static_cast<int32_t>(blocks.GetGridDepth()) - z0);
+
+    // Trivial cases skip the flood fill
+    const uint32_t solid = blocks.GetSectionBlockCount(section_index);
+    if (solid == 0) {
+        return kAllFacesConnected;
+    }
+    if (solid == static_cast<uint32_t>(size_x * size_y * size_z)) {
+        return 0;
+    }
+
+    // Mark opaque cells as already visited so the fill never enters them
+    uint8_t visited[kSectionVolume] = {};
+    for (int32_t z = 0; z < size_z; ++z) {
+        for (int32_t y = 0; y < size_y; ++y) {
+            for (int32_t x = 0; x < size_x; ++x) {
+                if (blocks.GetBlock(x0 + x, y0 + y, z0 + z).type != 0) {
+                    visited[CellIndex(x, y, z)] = 1;
+                }
+            }
+        }
+    }
+
+    // Flood fill each air pocket and link every pair of faces it touches
+    uint64_t connections = 0;
+    uint16_t stack[kSectionVolume];
+    for (int32_t z = 0; z < size_z; ++z) {
+        for (int32_t y = 0; y < size_y; ++y) {
+            for (int32_t x = 0; x < size_x; ++x) {
+                if (visited[CellIndex(x, y, z)]) {
+                    continue;
+                }
+
+                uint32_t touched_faces = 0;
+                uint32_t stack_size = 0;
+                visited[CellIndex(x, y, z)] = 1;
+                stack[stack_size++] = static_cast<uint16_t>(CellIndex(x, y, z));
+
+                while (stack_size > 0) {
+                    const uint32_t cell = stack[--stack_size];
+                    const int32_t cx = static_cast<int32_t>(cell % kSectionSize);
+                    const int32_t cy = static_cast<int32_t>((cell / kSectionSize) % kSectionSize);
+                    const int32_t cz = static_cast<int32_t>(cell / (kSectionSize * kSectionSize));
+
+                    for (int face = 0; face < kSectionFaceCount; ++face) {
+                        const int32_t nx = cx + kFaceOffsets[face][0];
+                        const int32_t ny = cy + kFaceOffsets[face][1];
+                        const int32_t nz = cz + kFaceOffsets[face][2];
+                        if (nx < 0 || ny < 0 || nz < 0 ||
+                            nx >= size_x || ny >= size_y || nz >= size_z) {
+                            touched_faces |= 1u << face;  // Pocket reaches this face
+                            continue;
+                        }
+
+                        const uint32_t neighbor = CellIndex(nx, ny, nz);
+                        if (!visited[neighbor]) {
+                            visited[neighbor] = 1;
+                            stack[stack_size++] = static_cast<uint16_t>(neighbor);
+                        }
+                    }
+                }
+
+                for (int a = 0; a < kSectionFaceCount; ++a) {
+                    if (!(touched_faces & (1u << a))) {
+                        continue;
+                    }
+                    for (int b = 0; b < kSectionFaceCount; ++b) {
+                        if (touched_faces & (1u << b)) {
+                            connections |= uint64_t{1} << (a * kSectionFaceCount + b);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return connections;
+}
+
+uint64_t SectionConnectivity::GetFaceConnections(const BlockSystem& blocks,
+                                                 uint32_t section_index) {
+    if (links_.size() != blocks.GetSectionCount()) {
+        links_.assign(blocks.GetSectionCount(), SectionLinks{0, false, 0});
+    }
+
+    // Recompute lazily when the section was edited since the last query
+    SectionLinks& links = links_[section_index];
+    const uint32_t revision = blocks.GetSectionRevision(section_index);
+    if (!links.valid || links.revision != revision) {
+        links.connections = ComputeFaceConnections(blocks, section_index);
+        links.revision = revision;
+        links.valid = true;
+    }
+    return links.connections;
+}
+
+void SectionConnectivity::Traverse(const BlockSystem& blocks, const glm::vec3& camera_position) {
+    const uint32_t section_count = blocks.GetSectionCount();
+    reachable_.assign(section_count, 0);
+    reachable_count_ = 0;
+    queue_.clear();
+
+    // Locate the camera's section
+    const glm::vec3 grid_position = camera_position / blocks.GetBlockSize();
+    const int32_t bx = static_cast<int32_t>(std::floor(grid_position.x));
+    const int32_t by = static_cast<int32_t>(std::floor(grid_position.y));
+    const int32_t bz = static_cast<int32_t>(std::floor(grid_position.z));
+    const int32_t start = (bx < 0 || by < 0 || bz < 0)
+        ? -1
+        : blocks.GetSectionIndex(bx / kSectionSize, by / kSectionSize, bz / kSectionSize);
+
+    if (start < 0) {
+        // Outside the grid there is no section to start from; disable culling
+        std::fill(reachable_.begin(), reachable_.end(), static_cast<uint8_t>(1));
+        reachable_count_ = section_count;
+        return;
+    }
+
+    reachable_[start] = 1;
+    reachable_count_ = 1;
+    queue_.push_back(QueueEntry{static_cast<uint32_t>(start), -1, 0});
+
+    for (size_t head = 0; head < queue_.size(); ++head) {
+        const QueueEntry entry = queue_[head];
+        const uint64_t connections = (entry.entry_face < 0)
+            ? 0
+            : GetFaceConnections(blocks, entry.section);
+
+        int32_t sx = 0;
+        int32_t sy = 0;
+        int32_t sz = 0;
+        blocks.GetSectionCoordinates(entry.section, &sx, &sy, &sz);
+
+        for (int face = 0; face < kSectionFaceCount; ++face) {
+            // Stepping opposite to an earlier step would lead back toward the
+            // camera, which can only reach sections already seen from closer
+            if (entry.directions & (1u << (face ^ 1))) {
+                continue;
+            }
+            // Leave only through faces linked to the entry face; the camera's
+            // own section may be left through any face
+            if (entry.entry_face >= 0 &&
+                !AreFacesConnected(connections, static_cast<SectionFace>(entry.entry_face),
+                                   static_cast<SectionFace>(face))) {
+                continue;
+            }
+
+            const int32_t neighbor = blocks.GetSectionIndex(sx + kFaceOffsets[face][0],
+                                                            sy + kFaceOffsets[face][1],
+                                                            sz + kFaceOffsets[face][2]);
+            if (neighbor < 0 || reachable_[neighbor]) {
+                continue;
+            }
+
+            reachable_[neighbor] = 1;
+            reachable_count_ += 1;
+            queue_.push_back(QueueEntry{static_cast<uint32_t>(neighbor),
+                                        static_cast<int8_t>(face ^ 1),
+                                        static_cast<uint8_t>(entry.directions | (1u << face))});
+        }
+    }
+}
+
+void SectionConnectivity::FilterSections(const std::vector<uint32_t>& sections,
+                                         std::vector<uint32_t>* reachable_sections) const {
+    reachable_sections->clear();
+    for (uint32_t section : sections) {
+        if (section < reachable_.size() && reachable_[section]) {
+            reachable_sections->push_back(section);
+        }
+    }
+}
+
+} // namespace world
+} // namespace blec
@@ -0,0 +1,483 @@
+// src/world/voxel_octree.cpp
+// Sparse voxel octree implementation
+
+#include "world/voxel_octree.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace blec {
+namespace world {
+
+namespace {
+
+// Number of set bits in a leaf occupancy mask
+inline uint32_t CountBits(uint64_t mask) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    return static_cast<uint32_t>(__popcnt64(mask));
+#elif defined(__GNUC__) || defined(__clang__)
+    return static_cast<uint32_t>(__builtin_popcountll(mask));
+#else
+    uint32_t count = 0;
+    for (; mask != 0; mask &= mask - 1) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+// Bit of a cell inside a 4x4x4 leaf brick (X fastest, like the block grid)
+inline uint64_t LeafBit(int32_t lx, int32_t ly, int32_t lz) {
+    return uint64_t{1} << (lx + ly * VoxelOctree::kLeafSize +
+                           lz * VoxelOctree::kLeafSize * VoxelOctree::kLeafSize);
+}
+
+// Grid position of a leaf bit
+inline glm::ivec3 LeafCell(const glm::ivec3& origin, int bit) {
+    return origin + glm::ivec3(bit & 3, (bit >> 2) & 3, bit >> 4);
+}
+
+// Offset of child c inside a node whose children have edge length half
+inline glm::ivec3 ChildOffset(int child, int32_t half) {
+    return glm::ivec3((child & 1) ? half : 0, (child & 2) ? half : 0, (child & 4) ? half : 0);
+}
+
+// Slab test of a ray against a box
+// @return true on intersection; *t_enter is clamped to 0 when the origin is inside
+bool IntersectRayBox(const glm::vec3& origin, const glm::vec3& direction,
+                     const AABB& box, float* t_enter, int* enter_axis) {
+    float t_min = 0.0f;
+    float t_max = std::numeric_limits<float>::max();
+    int axis = -1;
+
+    for (int a = 0; a < 3; ++a) {
+        if (direction[a] == 0.0f) {
+            // Parallel to the slab: hit only if the origin lies within it
+            if (origin[a] < box.min[a] || origin[a] > box.max[a]) {
+                return false;
+            }
+            continue;
+        }
+
+        const float inv = 1.0f / direction[a];
+        float t_near = (box.min[a] - origin[a]) * inv;
+        float t_far = (box.max[a] - origin[a]) * inv;
+        if (t_near > t_far) {
+            std::swap(t_near, t_far);
+        }
+        if (t_near > t_min) {
+            t_min = t_near;
+            axis = a;
+        }
+        t_max = std::min(t_max, t_far);
+        if (t_min > t_max) {
+            return false;
+        }
+    }
+
+    *t_enter = t_min;
+    *enter_axis = axis;
+    return true;
+}
+
+} // anonymous namespace
+
+VoxelOctree::VoxelOctree()
+    : root_size_(2 * kLeafSize), block_size_(1.0f) {
+    nodes_.push_back(Node{});
+    std::fill(std::begin(nodes_[kRootNode].children), std::end(nodes_[kRootNode].children),
+              kEmptyChild);
+    nodes_[kRootNode].solid_count = 0;
+}
+
+void VoxelOctree::Build(const BlockSystem& blocks) {
+    // Root must have interior children, so it spans at least two leaf bricks
+    const int32_t largest = static_cast<int32_t>(std::max({blocks.GetGridWidth(),
+                                                           blocks.GetGridHeight(),
+                                                           blocks.GetGridDepth()}));
+    root_size_ = 2 * kLeafSize;
+    while (root_size_ < largest) {
+        root_size_ *= 2;
+    }
+    block_size_ = blocks.GetBlockSize();
+
+    nodes_.resize(1);
+    leaves_.clear();
+    free_nodes_.clear();
+    free_leaves_.clear();
+    std::fill(std::begin(nodes_[kRootNode].children), std::end(nodes_[kRootNode].children),
+              kEmptyChild);
+    nodes_[kRootNode].solid_count = 0;
+
+    for (int32_t z = 0; z < static_cast<int32_t>(blocks.GetGridDepth()); ++z) {
+        for (int32_t y = 0; y < static_cast<int32_t>(blocks.GetGridHeight()); ++y) {
+            for (int32_t x = 0; x < static_cast<int32_t>(blocks.GetGridWidth()); ++x) {
+                if (blocks.GetBlock(x, y, z).type != 0) {
+                    SetSolid(x, y, z, true);
+                }
+            }
+        }
+    }
+}
+
+uint32_t VoxelOctree::AllocateNode() {
+    Node node;
+    std::fill(std::begin(node.children), std::end(node.children), kEmptyChild);
+    node.solid_count = 0;
+
+    if (!free_nodes_.empty()) {
+        const uint32_t index = free_nodes_.back();
+        free_nodes_.pop_back();
+        nodes_[index] = node;
+        return index;
+    }
+    nodes_.push_back(node);
+    return static_cast<uint32_t>(nodes_.size() - 1);
+}
+
+uint32_t VoxelOctree::AllocateLeaf() {
+    if (!free_leaves_.empty()) {
+        const uint32_t index = free_leaves_.back();
+        free_leaves_.pop_back();
+        leaves_[index] = 0;
+        return index;
+    }
+    leaves_.push_back(0);
+    return static_cast<uint32_t>(leaves_.size() - 1);
+}
+
+uint32_t VoxelOctree::GetNodeCount() const {
+    return static_cast<uint32_t>(nodes_.size() - free_nodes_.size() +
+                                 leaves_.size() - free_leaves_.size());
+}
+
+void VoxelOctree::SetSolid(int32_t x, int32_t y, int32_t z, bool solid) {
+    if (x < 0 || y < 0 || z < 0 || x >= root_size_ || y >= root_size_ || z >= root_size_) {
+        return;
+    }
+
+    // Descend to the leaf, remembering the path for the count update
+    uint32_t path_nodes[32];
+    int path_children[32];
+    int depth = 0;
+
+    uint32_t node = kRootNode;
+    glm::ivec3 origin(0);
+    int32_t size = root_size_;
+
+    while (true) {
+        const int32_t half = size / 2;
+        const int child = ((x - origin.x) >= half ? 1 : 0) |
+                          ((y - origin.y) >= half ? 2 : 0) |
+                          ((z - origin.z) >= half ? 4 : 0);
+        path_nodes[depth] = node;
+        path_children[depth] = child;
+        ++depth;
+        origin += ChildOffset(child, half);
+
+        if (half == kLeafSize) {
+            uint32_t leaf = nodes_[node].children[child];
+            if (leaf == kEmptyChild) {
+                if (!solid) {
+                    return;  // Already empty
+                }
+                leaf = AllocateLeaf();
+                nodes_[node].children[child] = leaf;
+            }
+
+            const uint64_t bit = LeafBit(x - origin.x, y - origin.y, z - origin.z);
+            if (((leaves_[leaf] & bit) != 0) == solid) {
+                return;  // No change
+            }
+            leaves_[leaf] ^= bit;
+
+            if (leaves_[leaf] == 0) {
+                free_leaves_.push_back(leaf);
+                nodes_[node].children[child] = kEmptyChild;
+            }
+            break;
+        }
+
+        uint32_t next = nodes_[node].children[child];
+        if (next == kEmptyChild) {
+            if (!solid) {
+                return;  // Already empty
+            }
+            next = AllocateNode();  // May reallocate nodes_, so index again below
+            nodes_[node].children[child] = next;
+        }
+        node = next;
+        size = half;
+    }
+
+    // Update subtree counts bottom-up and release nodes that became empty
+    for (int i = depth - 1; i >= 0; --i) {
+        Node& path_node = nodes_[path_nodes[i]];
+        path_node.solid_count = solid ? path_node.solid_count + 1 : path_node.solid_count - 1;
+        if (i > 0 && path_node.solid_count == 0) {
+            free_nodes_.push_back(path_nodes[i]);
+            nodes_[path_nodes[i - 1]].children[path_children[i - 1]] = kEmptyChild;
+        }
+    }
+}
+
+bool VoxelOctree::IsSolid(int32_t x, int32_t y, int32_t z) const {
+    if (x < 0 || y < 0 || z < 0 || x >= root_size_ || y >= root_size_ || z >= root_size_) {
+        return false;
+    }
+
+    uint32_t node = kRootNode;
+    glm::ivec3 origin(0);
+    int32_t size = root_size_;
+    while (true) {
+        const int32_t half = size / 2;
+        const int child = ((x - origin.x) >= half ? 1 : 0) |
+                          ((y - origin.y) >= half ? 2 : 0) |
+                          ((z - origin.z) >= half ? 4 : 0);
+        origin += ChildOffset(child, half);
+
+        const uint32_t next = nodes_[node].children[child];
+        if (next == kEmptyChild) {
+            return false;
+        }
+        if (half == kLeafSize) {
+            return (leaves_[next] & LeafBit(x - origin.x, y - origin.y, z - origin.z)) != 0;
+        }
+        node = next;
+        size = half;
+    }
+}
+
+AABB VoxelOctree::NodeBounds(const glm::ivec3& origin, int32_t size) const {
+    const glm::vec3 min = glm::vec3(origin) * block_size_;
+    return AABB{min, min + glm::vec3(static_cast<float>(size) * block_size_)};
+}
+
+uint32_t VoxelOctree::CountInFrustum(const ViewFrustum& frustum) const {
+    return CountInFrustumNode(kRootNode, glm::ivec3(0), root_size_, frustum);
+}
+
+uint32_t VoxelOctree::CountInFrustumNode(uint32_t node, const glm::ivec3& origin, int32_t size,
+                                         const ViewFrustum& frustum) const {
+    const AABB bounds = NodeBounds(origin, size);
+    if (!frustum.IntersectsAABB(bounds)) {
+        return 0;
+    }
+    if (frustum.ContainsAABB(bounds)) {
+        return nodes_[node].solid_count;  // Whole subtree visible
+    }
+
+    const int32_t half = size / 2;
+    uint32_t count = 0;
+    for (int child = 0; child < 8; ++child) {
+        const uint32_t index = nodes_[node].children[child];
+        if (index == kEmptyChild) {
+            continue;
+        }
+
+        const glm::ivec3 child_origin = origin + ChildOffset(child, half);
+        if (half != kLeafSize) {
+            count += CountInFrustumNode(index, child_origin, half, frustum);
+            continue;
+        }
+
+        // Leaf brick: whole brick at once when possible, else per block
+        const AABB brick = NodeBounds(child_origin, half);
+        if (!frustum.IntersectsAABB(brick)) {
+            continue;
+        }
+        uint64_t mask = leaves_[index];
+        if (frustum.ContainsAABB(brick)) {
+            count += CountBits(mask);
+            continue;
+        }
+        for (int bit = 0; bit < 64; ++bit) {
+            if ((mask >> bit) & 1u) {
+                if (frustum.IntersectsAABB(NodeBounds(LeafCell(child_origin, bit), 1))) {
+                    ++count;
+                }
+            }
+        }
+    }
+    return count;
+}
+
+void VoxelOctree::QueryFrustum(const ViewFrustum& frustum, std::vector<glm::ivec3>* blocks) const {
+    QueryFrustumNode(kRootNode, glm::ivec3(0), root_size_, frustum, false, blocks);
+}
+
+void VoxelOctree::QueryFrustumNode(uint32_t node, const glm::ivec3& origin, int32_t size,
+                                   const ViewFrustum& frustum, bool fully_inside,
+                                   std::vector<glm::ivec3>* blocks) const {
+    if (!fully_inside) {
+        const AABB bounds = NodeBounds(origin, size);
+        if (!frustum.IntersectsAABB(bounds)) {
+            return;
+        }
+        // Once a node is inside, its descendants skip plane tests
+        fully_inside = frustum.ContainsAABB(bounds);
+    }
+
+    const int32_t half = size / 2;
+    for (int child = 0; child < 8; ++child) {
+        const uint32_t index = nodes_[node].children[child];
+        if (index == kEmptyChild) {
+            continue;
+        }
+
+        const glm::ivec3 child_origin = origin + ChildOffset(child, half);
+        if (half != kLeafSize) {
+            QueryFrustumNode(index, child_origin, half, frustum, fully_inside, blocks);
+            continue;
+        }
+
+        const uint64_t mask = leaves_[index];
+        for (int bit = 0; bit < 64; ++bit) {
+            if (!((mask >> bit) & 1u)) {
+                continue;
+            }
+            const glm::ivec3 cell = LeafCell(child_origin, bit);
+            if (fully_inside || frustum.IntersectsAABB(NodeBounds(cell, 1))) {
+                blocks->push_back(cell);
+            }
+        }
+    }
+}
+
+void VoxelOctree::QueryAABB(const AABB& box, std::vector<glm::ivec3>* blocks) const {
+    QueryAABBNode(kRootNode, glm::ivec3(0), root_size_, box, blocks);
+}
+
+bool VoxelOctree::OverlapsSolid(const AABB& box) const {
+    return QueryAABBNode(kRootNode, glm::ivec3(0), root_size_, box, nullptr);
+}
+
+bool VoxelOctree::QueryAABBNode(uint32_t node, const glm::ivec3& origin, int32_t size,
+                                const AABB& box, std::vector<glm::ivec3>* blocks) const {
+    // Returns true to stop the walk early (first hit when blocks is null)
+    if (!NodeBounds(origin, size).IntersectsAABB(box)) {
+        return false;
+    }
+
+    const int32_t half = size / 2;
+    for (int child = 0; child < 8; ++child) {
+        const uint32_t index = nodes_[node].children[child];
+        if (index == kEmptyChild) {
+            continue;
+        }
+
+        const glm::ivec3 child_origin = origin + ChildOffset(child, half);
+        if (half != kLeafSize) {
+            if (QueryAABBNode(index, child_origin, half, box, blocks)) {
+                return true;
+            }
+            continue;
+        }
+
+        if (!NodeBounds(child_origin, half).IntersectsAABB(box)) {
+            continue;
+        }
+        const uint64_t mask = leaves_[index];
+        for (int bit = 0; bit < 64; ++bit) {
+            if (!((mask >> bit) & 1u)) {
+                continue;
+            }
+            const glm::ivec3 cell = LeafCell(child_origin, bit);
+            if (NodeBounds(cell, 1).IntersectsAABB(box)) {
+                if (!blocks) {
+                    return true;
+                }
+                blocks->push_back(cell);
+            }
+        }
+    }
+    return false;
+}
+
+bool VoxelOctree::Raycast(const glm::vec3& origin, const glm::vec3& direction, float max_distance,
+                          RayHit* hit) const {
+    if (nodes_[kRootNode].solid_count == 0) {
+        return false;
+    }
+
+    RayHit best{glm::ivec3(0), glm::ivec3(0), max_distance};
+    bool found = false;
+    RaycastNode(kRootNode, glm::ivec3(0), root_size_, origin, direction, &best, &found);
+    if (found) {
+        *hit = best;
+    }
+    return found;
+}
+
+void VoxelOctree::RaycastNode(uint32_t node, const glm::ivec3& origin, int32_t size,
+                              const glm::vec3& ray_origin, const glm::vec3& ray_direction,
+                              RayHit* best, bool* found) const {
+    // Visit non-empty children nearest-first so farther subtrees can be
+    // rejected once a closer hit is known
+    struct ChildEntry {
+        float t_enter;
+        int child;
+    };
+    ChildEntry entries[8];
+    int entry_count = 0;
+
+    const int32_t half = size / 2;
+    for (int child = 0; child < 8; ++child) {
+        if (nodes_[node].children[child] == kEmptyChild) {
+            continue;
+        }
+        float t_enter = 0.0f;
+        int axis = -1;
+        const AABB bounds = NodeBounds(origin + ChildOffset(child, half), half);
+        if (IntersectRayBox(ray_origin, ray_direction, bounds, &t_enter, &axis) &&
+            t_enter <= best->distance) {
+            int slot = entry_count++;
+            while (slot > 0 && entries[slot - 1].t_enter > t_enter) {
+                entries[slot] = entries[slot - 1];
+                --slot;
+            }
+            entries[slot] = ChildEntry{t_enter, child};
+        }
+    }
+
+    for (int i = 0; i < entry_count; ++i) {
+        if (entries[i].t_enter > best->distance) {
+            break;  // Everything left starts beyond the current hit
+        }
+
+        const int child = entries[i].child;
+        const uint32_t index = nodes_[node].children[child];
+        const glm::ivec3 child_origin = origin + ChildOffset(child, half);
+        if (half != kLeafSize) {
+            RaycastNode(index, child_origin, half, ray_origin, ray_direction, best, found);
+            continue;
+        }
+
+        const uint64_t mask = leaves_[index];
+        for (int bit = 0; bit < 64; ++bit) {
+            if (!((mask >> bit) & 1u)) {
+                continue;
+            }
+            const glm::ivec3 cell = LeafCell(child_origin, bit);
+            float t_enter = 0.0f;
+            int axis = -1;
+            if (IntersectRayBox(ray_origin, ray_direction, NodeBounds(cell, 1), &t_enter, &axis) &&
+                t_enter <= best->distance && (!*found || t_enter < best->distance)) {
+                best->block = cell;
+                best->distance = t_enter;
+                best->normal = glm::ivec3(0);
+                if (axis >= 0) {
+                    best->normal[axis] = (ray_direction[axis] > 0.0f) ? -1 : 1;
+                }
+                *found = true;
+            }
+        }
+    }
+}
+
+} // namespace world
+} // namespace blec